@@ -43,6 +43,8 @@ CoreStringNames::CoreStringNames() :
 		get_rid(StaticCString::create("get_rid")),
 		_to_string(StaticCString::create("_to_string")),
 		_custom_features(StaticCString::create("_custom_features")),
+		_set(StaticCString::create("_set")),
+		_get(StaticCString::create("_get")),
 
 		x(StaticCString::create("x")),
 		y(StaticCString::create("y")),
@@ -60,6 +60,8 @@ public:
 	StringName get_rid;
 	StringName _to_string;
 	StringName _custom_features;
+	StringName _set;
+	StringName _get;
 
 	StringName x;
 	StringName y;
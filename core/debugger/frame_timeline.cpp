@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  frame_timeline.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_timeline.h"
+
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+namespace {
+
+struct Event {
+	const char *name;
+	uint64_t begin;
+	uint64_t end;
+};
+
+struct ThreadBuffer {
+	Event events[FrameTimeline::EVENTS_PER_THREAD];
+	// Only written by the owner thread.
+	std::atomic<uint64_t> write_position = { 0 };
+	std::atomic<const char *> name = { nullptr };
+	Thread::ID thread_id = 0;
+};
+
+// Buffers are kept after their threads exit, until the timeline is finished.
+BinaryMutex buffers_mutex;
+LocalVector<ThreadBuffer *> buffers;
+thread_local ThreadBuffer *thread_buffer = nullptr;
+
+ThreadBuffer *get_thread_buffer() {
+	if (likely(thread_buffer)) {
+		return thread_buffer;
+	}
+	thread_buffer = memnew(ThreadBuffer);
+	thread_buffer->thread_id = Thread::get_caller_id();
+	if (Thread::is_main_thread()) {
+		thread_buffer->name.store("Main", std::memory_order_relaxed);
+	}
+	MutexLock lock(buffers_mutex);
+	buffers.push_back(thread_buffer);
+	return thread_buffer;
+}
+
+} // namespace
+
+std::atomic<bool> FrameTimeline::enabled = { false };
+String FrameTimeline::trace_path;
+
+uint64_t FrameTimeline::_get_time() {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+void FrameTimeline::_record(const char *p_name, uint64_t p_begin, uint64_t p_end) {
+	ThreadBuffer *buffer = get_thread_buffer();
+	const uint64_t position = buffer->write_position.load(std::memory_order_relaxed);
+	Event &event = buffer->events[position & (EVENTS_PER_THREAD - 1)];
+	event.name = p_name;
+	event.begin = p_begin;
+	event.end = p_end;
+	buffer->write_position.store(position + 1, std::memory_order_release);
+}
+
+void FrameTimeline::start(const String &p_trace_path) {
+	trace_path = p_trace_path;
+	enabled.store(true, std::memory_order_relaxed);
+}
+
+void FrameTimeline::set_thread_name(const char *p_name) {
+	if (is_enabled()) {
+		get_thread_buffer()->name.store(p_name, std::memory_order_relaxed);
+	}
+}
+
+Error FrameTimeline::save_trace(const String &p_path) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_CREATE, vformat("Can't save the frame timeline to \"%s\".", p_path));
+
+	MutexLock lock(buffers_mutex);
+	f->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	bool first = true;
+	for (ThreadBuffer *buffer : buffers) {
+		const String tid = itos(buffer->thread_id);
+		const char *name = buffer->name.load(std::memory_order_relaxed);
+		const String thread_name = name ? String(name) : "Thread " + tid;
+		f->store_string(String(first ? "" : ",\n") + "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":" + thread_name.json_escape().quote() + "}}");
+		first = false;
+
+		// Threads still running may overwrite the oldest events meanwhile.
+		const uint64_t end = buffer->write_position.load(std::memory_order_acquire);
+		const uint64_t begin = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+		String chunk;
+		for (uint64_t i = begin; i < end; i++) {
+			const Event &event = buffer->events[i & (EVENTS_PER_THREAD - 1)];
+			chunk += ",\n{\"name\":" + String(event.name).json_escape().quote() + ",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid + ",\"ts\":" + itos(event.begin) + ",\"dur\":" + itos(event.end - event.begin) + "}";
+			if (chunk.length() > 65536) {
+				f->store_string(chunk);
+				chunk = String();
+			}
+		}
+		f->store_string(chunk);
+	}
+	f->store_string("\n]}\n");
+	return OK;
+}
+
+void FrameTimeline::finish() {
+	if (!is_enabled()) {
+		return;
+	}
+	enabled.store(false, std::memory_order_relaxed);
+	if (!trace_path.is_empty()) {
+		if (save_trace(trace_path) == OK) {
+			print_line(vformat("Frame timeline saved to \"%s\".", trace_path));
+		}
+		trace_path = String();
+	}
+	// Threads may still be running, so their buffers are left allocated.
+}
@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*  frame_timeline.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_TIMELINE_H
+#define FRAME_TIMELINE_H
+
+#include "core/string/ustring.h"
+
+#include <atomic>
+
+// Records when instrumented zones of the engine start and end on every thread,
+// to find stalls between threads without a debugger attached (e.g. on headless servers).
+// Each thread writes into its own ring buffer without locking, so only the most recent
+// events are kept. The timeline is saved in Chrome trace format, which Perfetto can open.
+//
+// Zones cost a single check while the timeline is disabled.
+class FrameTimeline {
+public:
+	static constexpr uint32_t EVENTS_PER_THREAD = 1 << 16;
+
+	class Zone {
+		const char *name = nullptr;
+		uint64_t begin = 0;
+
+	public:
+		_FORCE_INLINE_ Zone(const char *p_name) {
+			if (unlikely(enabled.load(std::memory_order_relaxed))) {
+				name = p_name;
+				begin = _get_time();
+			}
+		}
+		_FORCE_INLINE_ ~Zone() {
+			if (unlikely(name)) {
+				_record(name, begin, _get_time());
+			}
+		}
+	};
+
+private:
+	static std::atomic<bool> enabled;
+	static String trace_path;
+
+	static uint64_t _get_time();
+	static void _record(const char *p_name, uint64_t p_begin, uint64_t p_end);
+
+public:
+	// Starts recording. If a path is given, the timeline is saved there by finish().
+	static void start(const String &p_trace_path = String());
+	static bool is_enabled() { return enabled.load(std::memory_order_relaxed); }
+	// Name shown for the calling thread, must be a static string.
+	static void set_thread_name(const char *p_name);
+
+	static Error save_trace(const String &p_path);
+	static void finish();
+};
+
+// Records the rest of the enclosing scope as a zone. Names must be static strings.
+#define FRAME_TIMELINE_ZONE(m_name) FrameTimeline::Zone _frame_timeline_zone(m_name)
+// Same as above, for opening more than one zone in the same scope.
+#define FRAME_TIMELINE_ZONE_NAMED(m_var, m_name) FrameTimeline::Zone m_var(m_name)
+
+#endif // FRAME_TIMELINE_H
@@ -35,6 +35,7 @@
 #include "core/io/image_loader.h"
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_map.h"
 #include "core/variant/dictionary.h"
@@ -465,15 +466,76 @@ int Image::get_mipmap_count() const {
 	}
 }
 
+// Images with at least this many pixels are processed in blocks of rows on the WorkerThreadPool.
+#define IMAGE_PARALLEL_MIN_PIXELS (256 * 256)
+
+// Calls `p_process_rows(from, to)` for row ranges covering `[0, p_height)`. Every row must be
+// independent from the others, since large images are split across worker threads.
+template <typename F>
+static void _process_rows_parallel(uint32_t p_width, uint32_t p_height, const F &p_process_rows) {
+	WorkerThreadPool *wtp = WorkerThreadPool::get_singleton();
+	// Don't wait for other tasks from a pool thread, this could starve the pool if many images are processed in parallel.
+	if (uint64_t(p_width) * p_height < IMAGE_PARALLEL_MIN_PIXELS || p_height < 2 || !wtp || wtp->get_thread_count() < 2 || WorkerThreadPool::get_thread_index() != -1) {
+		p_process_rows(0, p_height);
+		return;
+	}
+
+	struct RowBlocks {
+		const F *process_rows = nullptr;
+		uint32_t height = 0;
+		uint32_t count = 0;
+
+		static void process(void *p_userdata, uint32_t p_index) {
+			const RowBlocks *blocks = static_cast<const RowBlocks *>(p_userdata);
+			const uint32_t from = uint64_t(blocks->height) * p_index / blocks->count;
+			const uint32_t to = uint64_t(blocks->height) * (p_index + 1) / blocks->count;
+			(*blocks->process_rows)(from, to);
+		}
+	};
+
+	RowBlocks blocks;
+	blocks.process_rows = &p_process_rows;
+	blocks.height = p_height;
+	// A few blocks per thread balance the load, while keeping them large enough to be worth a task.
+	blocks.count = MIN(p_height, uint32_t(wtp->get_thread_count()) * 4);
+
+	WorkerThreadPool::GroupID group_task = wtp->add_native_group_task(&RowBlocks::process, &blocks, blocks.count, -1, true, String("ImageProcessRows"));
+	wtp->wait_for_group_task_completion(group_task);
+}
+
 //using template generates perfectly optimized code due to constant expression reduction and unused variable removal present in all compilers
 template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
-static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+static void _convert_rows(int p_width, int p_y_from, int p_y_to, const uint8_t *__restrict p_src, uint8_t *__restrict p_dst) {
 	constexpr uint32_t max_bytes = MAX(read_bytes, write_bytes);
+	constexpr uint32_t read_stride = read_bytes + (read_alpha ? 1 : 0);
+	constexpr uint32_t write_stride = write_bytes + (write_alpha ? 1 : 0);
+
+	for (int y = p_y_from; y < p_y_to; y++) {
+		const uint8_t *__restrict rrow = &p_src[y * p_width * read_stride];
+		uint8_t *__restrict wrow = &p_dst[y * p_width * write_stride];
+
+		if constexpr (read_bytes == 3 && read_alpha && write_bytes == 3 && !write_alpha && !read_gray && !write_gray) {
+			// RGBA8 -> RGB8, straight copy of the color channels.
+			for (int x = 0; x < p_width; x++) {
+				wrow[x * 3 + 0] = rrow[x * 4 + 0];
+				wrow[x * 3 + 1] = rrow[x * 4 + 1];
+				wrow[x * 3 + 2] = rrow[x * 4 + 2];
+			}
+			continue;
+		} else if constexpr (read_bytes == 3 && !read_alpha && write_bytes == 3 && write_alpha && !read_gray && !write_gray) {
+			// RGB8 -> RGBA8, straight copy of the color channels and opaque alpha.
+			for (int x = 0; x < p_width; x++) {
+				wrow[x * 4 + 0] = rrow[x * 3 + 0];
+				wrow[x * 4 + 1] = rrow[x * 3 + 1];
+				wrow[x * 4 + 2] = rrow[x * 3 + 2];
+				wrow[x * 4 + 3] = 255;
+			}
+			continue;
+		}
 
-	for (int y = 0; y < p_height; y++) {
 		for (int x = 0; x < p_width; x++) {
-			const uint8_t *rofs = &p_src[((y * p_width) + x) * (read_bytes + (read_alpha ? 1 : 0))];
-			uint8_t *wofs = &p_dst[((y * p_width) + x) * (write_bytes + (write_alpha ? 1 : 0))];
+			const uint8_t *rofs = &rrow[x * read_stride];
+			uint8_t *wofs = &wrow[x * write_stride];
 
 			uint8_t rgba[4] = { 0, 0, 0, 255 };
 
@@ -508,6 +570,13 @@ static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p
 	}
 }
 
+template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
+static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+	_process_rows_parallel(p_width, p_height, [&](uint32_t p_from, uint32_t p_to) {
+		_convert_rows<read_bytes, read_alpha, write_bytes, write_alpha, read_gray, write_gray>(p_width, p_from, p_to, p_src, p_dst);
+	});
+}
+
 void Image::convert(Format p_new_format) {
 	ERR_FAIL_INDEX_MSG(p_new_format, FORMAT_MAX, "The Image format specified (" + itos(p_new_format) + ") is out of range. See Image's Format enum.");
 	if (data.size() == 0) {
@@ -680,7 +749,7 @@ static double _bicubic_interp_kernel(double x) {
 }
 
 template <int CC, typename T>
-static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_dst_y_from, uint32_t p_dst_y_to) {
 	// get source image size
 	int width = p_src_width;
 	int height = p_src_height;
@@ -695,7 +764,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int xmax = width - 1;
 	// temporary pointer
 
-	for (uint32_t y = 0; y < p_dst_height; y++) {
+	for (uint32_t y = p_dst_y_from; y < p_dst_y_to; y++) {
 		// Y coordinates
 		oy = (double)y * yfac - 0.5f;
 		oy1 = (int)oy;
@@ -767,7 +836,14 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 }
 
 template <int CC, typename T>
-static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows_parallel(p_dst_width, p_dst_height, [&](uint32_t p_from, uint32_t p_to) {
+		_scale_cubic_rows<CC, T>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, p_from, p_to);
+	});
+}
+
+template <int CC, typename T>
+static void _scale_bilinear_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_dst_y_from, uint32_t p_dst_y_to) {
 	enum {
 		FRAC_BITS = 8,
 		FRAC_LEN = (1 << FRAC_BITS),
@@ -775,7 +851,7 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 		FRAC_MASK = FRAC_LEN - 1
 	};
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+	for (uint32_t i = p_dst_y_from; i < p_dst_y_to; i++) {
 		// Add 0.5 in order to interpolate based on pixel center
 		uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
 		// Calculate nearest src pixel center above current, and truncate to get y index
@@ -857,8 +933,15 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 }
 
 template <int CC, typename T>
-static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows_parallel(p_dst_width, p_dst_height, [&](uint32_t p_from, uint32_t p_to) {
+		_scale_bilinear_rows<CC, T>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, p_from, p_to);
+	});
+}
+
+template <int CC, typename T>
+static void _scale_nearest_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_dst_y_from, uint32_t p_dst_y_to) {
+	for (uint32_t i = p_dst_y_from; i < p_dst_y_to; i++) {
 		uint32_t src_yofs = i * p_src_height / p_dst_height;
 		uint32_t y_ofs = src_yofs * p_src_width * CC;
 
@@ -877,6 +960,13 @@ static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict
 	}
 }
 
+template <int CC, typename T>
+static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows_parallel(p_dst_width, p_dst_height, [&](uint32_t p_from, uint32_t p_to) {
+		_scale_nearest_rows<CC, T>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, p_from, p_to);
+	});
+}
+
 #define LANCZOS_TYPE 3
 
 static float _lanczos(float p_x) {
@@ -899,48 +989,69 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 
 		float scale_factor = MAX(x_scale, 1); // A larger kernel is required only when downscaling
 		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
+		int32_t kernel_size = half_kernel * 2;
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+		// The kernel of a column is the same for every row, so build them all once and then walk
+		// the source image row by row, which keeps memory accesses sequential.
+		float *kernels = memnew_arr(float, dst_width * kernel_size);
+		int32_t *kernel_start = memnew_arr(int32_t, dst_width);
+		int32_t *kernel_end = memnew_arr(int32_t, dst_width);
 
 		for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
 			// The corresponding point on the source image
 			float src_x = (buffer_x + 0.5f) * x_scale; // Offset by 0.5 so it uses the pixel's center
 			int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
 			int32_t end_x = MIN(src_width - 1, int32_t(src_x) + half_kernel);
+			kernel_start[buffer_x] = start_x;
+			kernel_end[buffer_x] = end_x;
 
 			// Create the kernel used by all the pixels of the column
+			float *kernel = &kernels[buffer_x * kernel_size];
 			for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
 				kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
 			}
+		}
 
-			for (int32_t buffer_y = 0; buffer_y < src_height; buffer_y++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+		_process_rows_parallel(dst_width, src_height, [&](uint32_t p_from, uint32_t p_to) {
+			for (int32_t buffer_y = p_from; buffer_y < int32_t(p_to); buffer_y++) {
+				const T *__restrict src_row = ((const T *)p_src) + buffer_y * src_width * CC;
+				float *__restrict dst_row = buffer + buffer_y * dst_width * CC;
 
-				for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-					float lanczos_val = kernel[target_x - start_x];
-					weight += lanczos_val;
+				for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
+					const float *kernel = &kernels[buffer_x * kernel_size];
+					const int32_t start_x = kernel_start[buffer_x];
+					const int32_t end_x = kernel_end[buffer_x];
 
-					const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
+					float pixel[CC] = { 0 };
+					float weight = 0;
 
-					for (uint32_t i = 0; i < CC; i++) {
-						if constexpr (sizeof(T) == 2) { //half float
-							pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
-						} else {
-							pixel[i] += src_data[i] * lanczos_val;
+					for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
+						float lanczos_val = kernel[target_x - start_x];
+						weight += lanczos_val;
+
+						const T *__restrict src_data = src_row + target_x * CC;
+
+						for (uint32_t i = 0; i < CC; i++) {
+							if constexpr (sizeof(T) == 2) { //half float
+								pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
+							} else {
+								pixel[i] += src_data[i] * lanczos_val;
+							}
 						}
 					}
-				}
 
-				float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
+					float *dst_data = dst_row + buffer_x * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
+					for (uint32_t i = 0; i < CC; i++) {
+						dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
+					}
 				}
 			}
-		}
+		});
 
-		memdelete_arr(kernel);
+		memdelete_arr(kernel_end);
+		memdelete_arr(kernel_start);
+		memdelete_arr(kernels);
 	} // End of first pass
 
 	{ // SECOND PASS (vertical + result)
@@ -950,49 +1061,51 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 		float scale_factor = MAX(y_scale, 1);
 		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+		_process_rows_parallel(dst_width, dst_height, [&](uint32_t p_from, uint32_t p_to) {
+			float *kernel = memnew_arr(float, half_kernel * 2);
 
-		for (int32_t dst_y = 0; dst_y < dst_height; dst_y++) {
-			float buffer_y = (dst_y + 0.5f) * y_scale;
-			int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
-			int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
+			for (int32_t dst_y = p_from; dst_y < int32_t(p_to); dst_y++) {
+				float buffer_y = (dst_y + 0.5f) * y_scale;
+				int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
+				int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
 
-			for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-				kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
-			}
+				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+					kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
+				}
 
-			for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+				for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
+					float pixel[CC] = { 0 };
+					float weight = 0;
 
-				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-					float lanczos_val = kernel[target_y - start_y];
-					weight += lanczos_val;
+					for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+						float lanczos_val = kernel[target_y - start_y];
+						weight += lanczos_val;
 
-					float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
+						float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
 
-					for (uint32_t i = 0; i < CC; i++) {
-						pixel[i] += buffer_data[i] * lanczos_val;
+						for (uint32_t i = 0; i < CC; i++) {
+							pixel[i] += buffer_data[i] * lanczos_val;
+						}
 					}
-				}
-
-				T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					pixel[i] /= weight;
+					T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
 
-					if constexpr (sizeof(T) == 1) { //byte
-						dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
-					} else if constexpr (sizeof(T) == 2) { //half float
-						dst_data[i] = Math::make_half_float(pixel[i]);
-					} else { // float
-						dst_data[i] = pixel[i];
+					for (uint32_t i = 0; i < CC; i++) {
+						pixel[i] /= weight;
+
+						if constexpr (sizeof(T) == 1) { //byte
+							dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
+						} else if constexpr (sizeof(T) == 2) { //half float
+							dst_data[i] = Math::make_half_float(pixel[i]);
+						} else { // float
+							dst_data[i] = pixel[i];
+						}
 					}
 				}
 			}
-		}
 
-		memdelete_arr(kernel);
+			memdelete_arr(kernel);
+		});
 	} // End of second pass
 
 	memdelete_arr(buffer);
@@ -1676,27 +1789,30 @@ static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint3
 	int right_step = (p_width == 1) ? 0 : CC;
 	int down_step = (p_height == 1) ? 0 : (p_width * CC);
 
-	for (uint32_t i = 0; i < dst_h; i++) {
-		const Component *rup_ptr = &p_src[i * 2 * down_step];
-		const Component *rdown_ptr = rup_ptr + down_step;
-		Component *dst_ptr = &p_dst[i * dst_w * CC];
-		uint32_t count = dst_w;
+	// Each destination row only reads its own pair of source rows, so large levels are split across threads.
+	_process_rows_parallel(dst_w, dst_h, [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			const Component *rup_ptr = &p_src[i * 2 * down_step];
+			const Component *rdown_ptr = rup_ptr + down_step;
+			Component *dst_ptr = &p_dst[i * dst_w * CC];
+			uint32_t count = dst_w;
+
+			while (count) {
+				count--;
+				for (int j = 0; j < CC; j++) {
+					average_func(dst_ptr[j], rup_ptr[j], rup_ptr[j + right_step], rdown_ptr[j], rdown_ptr[j + right_step]);
+				}
 
-		while (count) {
-			count--;
-			for (int j = 0; j < CC; j++) {
-				average_func(dst_ptr[j], rup_ptr[j], rup_ptr[j + right_step], rdown_ptr[j], rdown_ptr[j + right_step]);
-			}
+				if (renormalize) {
+					renormalize_func(dst_ptr);
+				}
 
-			if (renormalize) {
-				renormalize_func(dst_ptr);
+				dst_ptr += CC;
+				rup_ptr += right_step * 2;
+				rdown_ptr += right_step * 2;
 			}
-
-			dst_ptr += CC;
-			rup_ptr += right_step * 2;
-			rdown_ptr += right_step * 2;
 		}
-	}
+	});
 }
 
 void Image::shrink_x2() {
@@ -31,6 +31,7 @@
 #include "json.h"
 
 #include "core/config/engine.h"
+#include "core/io/file_access.h"
 #include "core/string/print_string.h"
 
 const char *JSON::tk_name[TK_MAX] = {
@@ -558,6 +559,569 @@ Error JSON::parse(const String &p_json_string, bool p_keep_text) {
 	return err;
 }
 
+// Builds the Variant tree of a document read by JSONReader.
+// When `packed_arrays` is enabled, arrays of numbers and arrays of strings are
+// collected without boxing each element and returned as packed arrays.
+class JSONVariantBuilder : public JSONReader::Handler {
+	enum Contents {
+		CONTENTS_EMPTY,
+		CONTENTS_NUMBERS,
+		CONTENTS_STRINGS,
+		CONTENTS_MIXED,
+	};
+
+	struct Container {
+		bool is_object = false;
+		Contents contents = CONTENTS_EMPTY;
+		Dictionary object;
+		Array array;
+		LocalVector<double> numbers;
+		LocalVector<String> strings;
+		String key;
+	};
+
+	LocalVector<Container> stack;
+	bool packed_arrays = false;
+	Variant result;
+
+	void _make_mixed(Container &p_container) {
+		if (p_container.contents == CONTENTS_NUMBERS) {
+			for (double number : p_container.numbers) {
+				p_container.array.push_back(number);
+			}
+			p_container.numbers.clear();
+		} else if (p_container.contents == CONTENTS_STRINGS) {
+			for (const String &string : p_container.strings) {
+				p_container.array.push_back(string);
+			}
+			p_container.strings.clear();
+		}
+		p_container.contents = CONTENTS_MIXED;
+	}
+
+	void _add_value(const Variant &p_value) {
+		if (stack.is_empty()) {
+			result = p_value;
+			return;
+		}
+		Container &container = stack[stack.size() - 1];
+		if (container.is_object) {
+			container.object[container.key] = p_value;
+		} else {
+			if (container.contents != CONTENTS_MIXED) {
+				_make_mixed(container);
+			}
+			container.array.push_back(p_value);
+		}
+	}
+
+	Error _begin_container(bool p_is_object) {
+		Container container;
+		container.is_object = p_is_object;
+		container.contents = packed_arrays ? CONTENTS_EMPTY : CONTENTS_MIXED;
+		stack.push_back(container);
+		return OK;
+	}
+
+public:
+	virtual Error begin_object() override {
+		return _begin_container(true);
+	}
+
+	virtual Error end_object() override {
+		Dictionary object = stack[stack.size() - 1].object;
+		stack.resize(stack.size() - 1);
+		_add_value(object);
+		return OK;
+	}
+
+	virtual Error begin_array() override {
+		return _begin_container(false);
+	}
+
+	virtual Error end_array() override {
+		Container &container = stack[stack.size() - 1];
+		Variant array;
+		if (container.contents == CONTENTS_NUMBERS) {
+			PackedFloat64Array packed;
+			packed.resize(container.numbers.size());
+			memcpy(packed.ptrw(), container.numbers.ptr(), container.numbers.size() * sizeof(double));
+			array = packed;
+		} else if (container.contents == CONTENTS_STRINGS) {
+			PackedStringArray packed;
+			packed.resize(container.strings.size());
+			String *w = packed.ptrw();
+			for (uint32_t i = 0; i < container.strings.size(); i++) {
+				w[i] = container.strings[i];
+			}
+			array = packed;
+		} else {
+			array = container.array;
+		}
+		stack.resize(stack.size() - 1);
+		_add_value(array);
+		return OK;
+	}
+
+	virtual Error key(const char *p_utf8, int p_len) override {
+		stack[stack.size() - 1].key = String::utf8(p_utf8, p_len);
+		return OK;
+	}
+
+	virtual Error string_value(const char *p_utf8, int p_len) override {
+		if (!stack.is_empty()) {
+			Container &container = stack[stack.size() - 1];
+			if (container.contents == CONTENTS_EMPTY || container.contents == CONTENTS_STRINGS) {
+				container.contents = CONTENTS_STRINGS;
+				container.strings.push_back(String::utf8(p_utf8, p_len));
+				return OK;
+			}
+		}
+		_add_value(String::utf8(p_utf8, p_len));
+		return OK;
+	}
+
+	virtual Error number_value(double p_value) override {
+		if (!stack.is_empty()) {
+			Container &container = stack[stack.size() - 1];
+			if (container.contents == CONTENTS_EMPTY || container.contents == CONTENTS_NUMBERS) {
+				container.contents = CONTENTS_NUMBERS;
+				container.numbers.push_back(p_value);
+				return OK;
+			}
+		}
+		_add_value(p_value);
+		return OK;
+	}
+
+	virtual Error bool_value(bool p_value) override {
+		_add_value(p_value);
+		return OK;
+	}
+
+	virtual Error null_value() override {
+		_add_value(Variant());
+		return OK;
+	}
+
+	Variant get_result() const { return result; }
+
+	JSONVariantBuilder(bool p_packed_arrays) {
+		packed_arrays = p_packed_arrays;
+	}
+};
+
+Error JSON::_set_reader_result(const JSONReader &p_reader, Error p_error, const Variant &p_result) {
+	text.clear();
+	if (p_error != OK) {
+		data = Variant();
+		err_str = p_reader.get_error_message();
+		err_line = p_reader.get_error_line();
+		return p_error;
+	}
+	data = p_result;
+	err_str = String();
+	err_line = 0;
+	return OK;
+}
+
+Error JSON::parse_utf8(const PackedByteArray &p_json_buffer, bool p_packed_arrays) {
+	JSONVariantBuilder builder(p_packed_arrays);
+	JSONReader reader;
+	Error err = reader.parse_buffer(p_json_buffer.ptr(), p_json_buffer.size(), &builder);
+	return _set_reader_result(reader, err, builder.get_result());
+}
+
+Error JSON::parse_file(const String &p_path, bool p_packed_arrays) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "Cannot open JSON file '" + p_path + "'.");
+
+	JSONVariantBuilder builder(p_packed_arrays);
+	JSONReader reader;
+	err = reader.parse_file(f, &builder);
+	return _set_reader_result(reader, err, builder.get_result());
+}
+
+////
+
+bool JSONReader::_refill() {
+	if (file.is_null()) {
+		return false;
+	}
+	if (chunk.is_empty()) {
+		chunk.resize(READ_CHUNK_SIZE);
+	}
+	uint64_t read = file->get_buffer(chunk.ptr(), READ_CHUNK_SIZE);
+	if (read == 0) {
+		return false;
+	}
+	data = chunk.ptr();
+	data_size = read;
+	pos = 0;
+	return true;
+}
+
+int JSONReader::_skip_whitespace() {
+	while (true) {
+		int c = _peek();
+		if (c == 0) {
+			// Like in the String parser, a null character ends the document.
+			return -1;
+		}
+		if (c < 0 || c > 32) {
+			return c;
+		}
+		if (c == '\n') {
+			line++;
+		}
+		pos++;
+	}
+}
+
+void JSONReader::_append_text(const uint8_t *p_data, int64_t p_len) {
+	uint32_t size = text.size();
+	text.resize(size + p_len);
+	memcpy(text.ptr() + size, p_data, p_len);
+}
+
+void JSONReader::_append_utf8(char32_t p_char) {
+	if (p_char <= 0x7f) {
+		text.push_back(p_char);
+	} else if (p_char <= 0x7ff) {
+		text.push_back(uint32_t(0xc0 | ((p_char >> 6) & 0x1f)));
+		text.push_back(uint32_t(0x80 | (p_char & 0x3f)));
+	} else if (p_char <= 0xffff) {
+		text.push_back(uint32_t(0xe0 | ((p_char >> 12) & 0x0f)));
+		text.push_back(uint32_t(0x80 | ((p_char >> 6) & 0x3f)));
+		text.push_back(uint32_t(0x80 | (p_char & 0x3f)));
+	} else {
+		text.push_back(uint32_t(0xf0 | ((p_char >> 18) & 0x07)));
+		text.push_back(uint32_t(0x80 | ((p_char >> 12) & 0x3f)));
+		text.push_back(uint32_t(0x80 | ((p_char >> 6) & 0x3f)));
+		text.push_back(uint32_t(0x80 | (p_char & 0x3f)));
+	}
+}
+
+Error JSONReader::_read_hex(char32_t &r_value) {
+	r_value = 0;
+	for (int j = 0; j < 4; j++) {
+		int c = _peek();
+		if (c <= 0) {
+			err_str = "Unterminated String";
+			return ERR_PARSE_ERROR;
+		}
+		if (!is_hex_digit(c)) {
+			err_str = "Malformed hex constant in string";
+			return ERR_PARSE_ERROR;
+		}
+		pos++;
+
+		char32_t v;
+		if (is_digit(c)) {
+			v = c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			v = c - 'a' + 10;
+		} else {
+			v = c - 'A' + 10;
+		}
+		r_value = (r_value << 4) | v;
+	}
+	return OK;
+}
+
+Error JSONReader::_read_string() {
+	// The opening quote was already consumed.
+	text.clear();
+	while (true) {
+		// Copy runs of plain characters at once, they are already valid UTF-8.
+		int64_t from = pos;
+		while (pos < data_size) {
+			uint8_t c = data[pos];
+			if (c == '"' || c == '\\' || c == '\n' || c == 0) {
+				break;
+			}
+			pos++;
+		}
+		if (pos > from) {
+			_append_text(data + from, pos - from);
+		}
+
+		int c = _peek();
+		if (c <= 0) {
+			err_str = "Unterminated String";
+			return ERR_PARSE_ERROR;
+		}
+		pos++;
+
+		if (c == '"') {
+			return OK;
+		} else if (c == '\n') {
+			line++;
+			text.push_back('\n');
+			continue;
+		} else if (c != '\\') {
+			// End of a chunk, the run continues in the next one.
+			text.push_back(c);
+			continue;
+		}
+
+		//escaped characters...
+		int next = _peek();
+		if (next <= 0) {
+			err_str = "Unterminated String";
+			return ERR_PARSE_ERROR;
+		}
+		pos++;
+
+		switch (next) {
+			case 'b':
+				text.push_back(8);
+				break;
+			case 't':
+				text.push_back(9);
+				break;
+			case 'n':
+				text.push_back(10);
+				break;
+			case 'f':
+				text.push_back(12);
+				break;
+			case 'r':
+				text.push_back(13);
+				break;
+			case '"':
+			case '\\':
+			case '/':
+				text.push_back(next);
+				break;
+			case 'u': {
+				char32_t res;
+				Error err = _read_hex(res);
+				if (err != OK) {
+					return err;
+				}
+				if ((res & 0xfffffc00) == 0xd800) {
+					if (_peek() != '\\') {
+						err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+						return ERR_PARSE_ERROR;
+					}
+					pos++;
+					if (_peek() != 'u') {
+						err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+						return ERR_PARSE_ERROR;
+					}
+					pos++;
+					char32_t trail;
+					err = _read_hex(trail);
+					if (err != OK) {
+						return err;
+					}
+					if ((trail & 0xfffffc00) != 0xdc00) {
+						err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+						return ERR_PARSE_ERROR;
+					}
+					res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+				} else if ((res & 0xfffffc00) == 0xdc00) {
+					err_str = "Invalid UTF-16 sequence in string, unpaired trail surrogate";
+					return ERR_PARSE_ERROR;
+				}
+				_append_utf8(res);
+			} break;
+			default: {
+				err_str = "Invalid escape sequence.";
+				return ERR_PARSE_ERROR;
+			}
+		}
+	}
+}
+
+Error JSONReader::_read_number(double &r_value) {
+	text.clear();
+	while (true) {
+		int c = _peek();
+		if (!is_digit(c) && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') {
+			break;
+		}
+		text.push_back(c);
+		pos++;
+	}
+	text.push_back(0);
+
+	const char *end;
+	r_value = String::to_float(text.ptr(), &end);
+	if (end != text.ptr() + text.size() - 1) {
+		err_str = "Malformed number.";
+		return ERR_PARSE_ERROR;
+	}
+	return OK;
+}
+
+void JSONReader::_read_identifier() {
+	text.clear();
+	while (true) {
+		int c = _peek();
+		if (!is_ascii_alphabet_char(c)) {
+			break;
+		}
+		text.push_back(c);
+		pos++;
+	}
+}
+
+Error JSONReader::_parse(Handler *p_handler) {
+	line = 0;
+	err_str = String();
+	text.reserve(256);
+
+	// Skip the UTF-8 byte order mark.
+	if (_peek() == 0xef && data_size - pos >= 3 && data[pos + 1] == 0xbb && data[pos + 2] == 0xbf) {
+		pos += 3;
+	}
+
+	// Open containers, `true` for objects. Nesting is tracked here instead of
+	// recursing, so deep documents don't grow the call stack.
+	LocalVector<bool> stack;
+	bool expect_value = true;
+	bool at_key = false;
+	bool can_close = false;
+
+	while (true) {
+		int c = _skip_whitespace();
+		Error err = OK;
+
+		if (!expect_value) {
+			if (stack.is_empty()) {
+				if (c < 0) {
+					return OK;
+				}
+				err_str = "Expected 'EOF'";
+				return ERR_PARSE_ERROR;
+			}
+			bool in_object = stack[stack.size() - 1];
+			if (c == ',') {
+				pos++;
+				expect_value = true;
+				at_key = in_object;
+				// Trailing commas are accepted, like in JSON::parse().
+				can_close = true;
+				continue;
+			}
+			if (c != (in_object ? '}' : ']')) {
+				err_str = in_object ? "Expected '}' or ','" : "Expected ','";
+				return ERR_PARSE_ERROR;
+			}
+			can_close = true;
+		}
+
+		if (can_close && c == (stack[stack.size() - 1] ? '}' : ']')) {
+			pos++;
+			err = stack[stack.size() - 1] ? p_handler->end_object() : p_handler->end_array();
+			stack.resize(stack.size() - 1);
+			expect_value = false;
+			at_key = false;
+			can_close = false;
+		} else if (at_key) {
+			if (c != '"') {
+				err_str = "Expected key";
+				return ERR_PARSE_ERROR;
+			}
+			pos++;
+			err = _read_string();
+			if (err != OK) {
+				return err;
+			}
+			if (_skip_whitespace() != ':') {
+				err_str = "Expected ':'";
+				return ERR_PARSE_ERROR;
+			}
+			pos++;
+			err = p_handler->key(text.ptr(), text.size());
+			at_key = false;
+			can_close = false;
+		} else if (c == '{' || c == '[') {
+			if (stack.size() >= Variant::MAX_RECURSION_DEPTH) {
+				err_str = "JSON structure is too deep. Bailing.";
+				return ERR_OUT_OF_MEMORY;
+			}
+			pos++;
+			stack.push_back(c == '{');
+			err = c == '{' ? p_handler->begin_object() : p_handler->begin_array();
+			at_key = c == '{';
+			can_close = true;
+		} else if (c == '"') {
+			pos++;
+			err = _read_string();
+			if (err != OK) {
+				return err;
+			}
+			err = p_handler->string_value(text.ptr(), text.size());
+			expect_value = false;
+			can_close = false;
+		} else if (c == '-' || is_digit(c)) {
+			double number;
+			err = _read_number(number);
+			if (err != OK) {
+				return err;
+			}
+			err = p_handler->number_value(number);
+			expect_value = false;
+			can_close = false;
+		} else if (is_ascii_alphabet_char(c)) {
+			_read_identifier();
+			text.push_back(0);
+			if (strcmp(text.ptr(), "true") == 0) {
+				err = p_handler->bool_value(true);
+			} else if (strcmp(text.ptr(), "false") == 0) {
+				err = p_handler->bool_value(false);
+			} else if (strcmp(text.ptr(), "null") == 0) {
+				err = p_handler->null_value();
+			} else {
+				err_str = "Expected 'true','false' or 'null', got '" + String::utf8(text.ptr()) + "'.";
+				return ERR_PARSE_ERROR;
+			}
+			expect_value = false;
+			can_close = false;
+		} else if (c < 0) {
+			if (stack.is_empty()) {
+				err_str = "Expected value, got EOF.";
+			} else {
+				err_str = stack[stack.size() - 1] ? "Expected '}'" : "Expected ']'";
+			}
+			return ERR_PARSE_ERROR;
+		} else {
+			err_str = "Unexpected character.";
+			return ERR_PARSE_ERROR;
+		}
+
+		if (err != OK) {
+			err_str = "Parsing stopped by the handler.";
+			return err;
+		}
+	}
+}
+
+Error JSONReader::parse_buffer(const uint8_t *p_data, int64_t p_size, Handler *p_handler) {
+	ERR_FAIL_NULL_V(p_handler, ERR_INVALID_PARAMETER);
+	file.unref();
+	data = p_data;
+	data_size = p_data ? p_size : 0;
+	pos = 0;
+	return _parse(p_handler);
+}
+
+Error JSONReader::parse_file(const Ref<FileAccess> &p_file, Handler *p_handler) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_NULL_V(p_handler, ERR_INVALID_PARAMETER);
+	file = p_file;
+	data = nullptr;
+	data_size = 0;
+	pos = 0;
+	Error err = _parse(p_handler);
+	file.unref();
+	return err;
+}
+
 String JSON::get_parsed_text() const {
 	return text;
 }
@@ -581,6 +1145,8 @@ void JSON::_bind_methods() {
 	ClassDB::bind_static_method("JSON", D_METHOD("stringify", "data", "indent", "sort_keys", "full_precision"), &JSON::stringify, DEFVAL(""), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_static_method("JSON", D_METHOD("parse_string", "json_string"), &JSON::parse_string);
 	ClassDB::bind_method(D_METHOD("parse", "json_text", "keep_text"), &JSON::parse, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("parse_utf8", "json_buffer", "packed_arrays"), &JSON::parse_utf8, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("parse_file", "path", "packed_arrays"), &JSON::parse_file, DEFVAL(false));
 
 	ClassDB::bind_method(D_METHOD("get_data"), &JSON::get_data);
 	ClassDB::bind_method(D_METHOD("set_data", "data"), &JSON::set_data);
@@ -608,7 +1174,13 @@ Ref<Resource> ResourceFormatLoaderJSON::load(const String &p_path, const String
 	Ref<JSON> json;
 	json.instantiate();
 
-	Error err = json->parse(FileAccess::get_file_as_string(p_path), Engine::get_singleton()->is_editor_hint());
+	Error err;
+	if (Engine::get_singleton()->is_editor_hint()) {
+		// Keep the text so it can be edited and saved back as is.
+		err = json->parse(FileAccess::get_file_as_string(p_path), true);
+	} else {
+		err = json->parse_file(p_path);
+	}
 	if (err != OK) {
 		String err_text = "Error parsing JSON file at '" + p_path + "', on line " + itos(json->get_error_line()) + ": " + json->get_error_message();
 
@@ -34,8 +34,72 @@
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/variant.h"
 
+class FileAccess;
+
+// Event based JSON reader. It works directly on UTF-8 data, either from memory
+// or streamed from a file, and never builds Variants for the values it reads.
+class JSONReader {
+public:
+	// Receives the contents of the document in order. Returning anything other
+	// than OK from a callback stops the parse with that error.
+	class Handler {
+	public:
+		virtual Error begin_object() { return OK; }
+		virtual Error end_object() { return OK; }
+		virtual Error begin_array() { return OK; }
+		virtual Error end_array() { return OK; }
+		// Strings are UTF-8 with escape sequences already decoded, and are only valid during the call.
+		virtual Error key(const char *p_utf8, int p_len) { return OK; }
+		virtual Error string_value(const char *p_utf8, int p_len) { return OK; }
+		virtual Error number_value(double p_value) { return OK; }
+		virtual Error bool_value(bool p_value) { return OK; }
+		virtual Error null_value() { return OK; }
+
+		virtual ~Handler() {}
+	};
+
+private:
+	static constexpr uint64_t READ_CHUNK_SIZE = 65536;
+
+	const uint8_t *data = nullptr;
+	int64_t data_size = 0;
+	int64_t pos = 0;
+
+	Ref<FileAccess> file;
+	LocalVector<uint8_t> chunk;
+
+	LocalVector<char> text; // Decoded string, number or identifier being read.
+	int line = 0;
+	String err_str;
+
+	bool _refill();
+	_FORCE_INLINE_ int _peek() {
+		if (likely(pos < data_size)) {
+			return data[pos];
+		}
+		return _refill() ? data[pos] : -1;
+	}
+
+	int _skip_whitespace();
+	void _append_text(const uint8_t *p_data, int64_t p_len);
+	void _append_utf8(char32_t p_char);
+	Error _read_hex(char32_t &r_value);
+	Error _read_string();
+	Error _read_number(double &r_value);
+	void _read_identifier();
+	Error _parse(Handler *p_handler);
+
+public:
+	Error parse_buffer(const uint8_t *p_data, int64_t p_size, Handler *p_handler);
+	Error parse_file(const Ref<FileAccess> &p_file, Handler *p_handler);
+
+	int get_error_line() const { return line; }
+	String get_error_message() const { return err_str; }
+};
+
 class JSON : public Resource {
 	GDCLASS(JSON, Resource);
 
@@ -79,12 +143,15 @@ class JSON : public Resource {
 	static Error _parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
 	static Error _parse_object(Dictionary &object, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
 	static Error _parse_string(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line);
+	Error _set_reader_result(const JSONReader &p_reader, Error p_error, const Variant &p_result);
 
 protected:
 	static void _bind_methods();
 
 public:
 	Error parse(const String &p_json_string, bool p_keep_text = false);
+	Error parse_utf8(const PackedByteArray &p_json_buffer, bool p_packed_arrays = false);
+	Error parse_file(const String &p_path, bool p_packed_arrays = false);
 	String get_parsed_text() const;
 
 	static String stringify(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
@@ -37,6 +37,7 @@
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
@@ -448,10 +449,11 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
 					} else {
-						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
-						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
+						const ExtResource &er = external_resources[erindex];
+						if (er.load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
+							// Dependencies are completed up front when decoding in threads, see _load_threaded().
 							Error err;
-							Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
+							Ref<Resource> res = er.completed ? er.resource : ResourceLoader::_load_complete(*er.load_token.ptr(), &err);
 							if (res.is_null()) {
 								if (!ResourceLoader::is_cleaning_tasks()) {
 									if (!ResourceLoader::get_abort_on_missing_resources()) {
@@ -680,6 +682,143 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
+bool ResourceLoaderBinary::_resolve_internal_resource_path(int p_index, String &r_path, String &r_id) {
+	bool main = p_index == (internal_resources.size() - 1);
+
+	//maybe it is loaded already
+	if (!main) {
+		r_path = internal_resources[p_index].path;
+
+		if (r_path.begins_with("local://")) {
+			r_path = r_path.replace_first("local://", "");
+			r_id = r_path;
+			r_path = res_path + "::" + r_path;
+
+			internal_resources.write[p_index].path = r_path; // Update path.
+		}
+
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(r_path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(r_path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				error = OK;
+				internal_index_cache[r_path] = cached;
+				return false;
+			}
+		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			r_path = res_path;
+		}
+	}
+
+	return true;
+}
+
+Ref<Resource> ResourceLoaderBinary::_instantiate_resource(const String &p_type, const String &p_path, const String &p_id, MissingResource *&r_missing_resource) {
+	Ref<Resource> res;
+
+	if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(p_path)) {
+		//use the existing one
+		Ref<Resource> cached = ResourceCache::get_ref(p_path);
+		if (cached->get_class() == p_type) {
+			cached->reset_state();
+			res = cached;
+		}
+	}
+
+	r_missing_resource = nullptr;
+
+	if (res.is_null()) {
+		//did not replace
+
+		Object *obj = ClassDB::instantiate(p_type);
+		if (!obj) {
+			if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+				//create a missing resource
+				r_missing_resource = memnew(MissingResource);
+				r_missing_resource->set_original_class(p_type);
+				r_missing_resource->set_recording_properties(true);
+				obj = r_missing_resource;
+			} else {
+				error = ERR_FILE_CORRUPT;
+				ERR_FAIL_V_MSG(Ref<Resource>(), local_path + ":Resource of unrecognized type in file: " + p_type + ".");
+			}
+		}
+
+		Resource *r = Object::cast_to<Resource>(obj);
+		if (!r) {
+			String obj_class = obj->get_class();
+			error = ERR_FILE_CORRUPT;
+			memdelete(obj); //bye
+			ERR_FAIL_V_MSG(Ref<Resource>(), local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+		}
+
+		res = Ref<Resource>(r);
+		if (!p_path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(p_path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(p_path);
+			}
+		}
+		r->set_scene_unique_id(p_id);
+	}
+
+	return res;
+}
+
+void ResourceLoaderBinary::_set_resource_property(const Ref<Resource> &p_res, const StringName &p_name, Variant &p_value, MissingResource *p_missing_resource, Dictionary &r_missing_resource_properties) {
+	bool set_valid = true;
+	if (p_value.get_type() == Variant::OBJECT && p_missing_resource != nullptr) {
+		// If the property being set is a missing resource (and the parent is not),
+		// then setting it will most likely not work.
+		// Instead, save it as metadata.
+
+		Ref<MissingResource> mr = p_value;
+		if (mr.is_valid()) {
+			r_missing_resource_properties[p_name] = mr;
+			set_valid = false;
+		}
+	}
+
+	if (p_value.get_type() == Variant::ARRAY) {
+		Array set_array = p_value;
+		bool is_get_valid = false;
+		Variant get_value = p_res->get(p_name, &is_get_valid);
+		if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+			Array get_array = get_value;
+			if (!set_array.is_same_typed(get_array)) {
+				p_value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+			}
+		}
+	}
+
+	if (set_valid) {
+		p_res->set(p_name, p_value);
+	}
+}
+
+void ResourceLoaderBinary::_finish_resource(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const Dictionary &p_missing_resource_properties, int p_index) {
+	if (p_missing_resource) {
+		p_missing_resource->set_recording_properties(false);
+	}
+
+	if (!p_missing_resource_properties.is_empty()) {
+		p_res->set_meta(META_MISSING_RESOURCES, p_missing_resource_properties);
+	}
+
+#ifdef TOOLS_ENABLED
+	p_res->set_edited(false);
+#endif
+
+	if (progress) {
+		*progress = (p_index + 1) / float(internal_resources.size());
+	}
+
+	resource_cache.push_back(p_res);
+}
+
 Error ResourceLoaderBinary::load() {
 	if (error != OK) {
 		return error;
@@ -709,37 +848,17 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
+	if (use_sub_threads && !compressed && !file_path.is_empty() && internal_resources.size() > 2 && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		return _load_threaded();
+	}
+
 	for (int i = 0; i < internal_resources.size(); i++) {
 		bool main = i == (internal_resources.size() - 1);
 
-		//maybe it is loaded already
 		String path;
 		String id;
-
-		if (!main) {
-			path = internal_resources[i].path;
-
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
-
-				internal_resources.write[i].path = path; // Update path.
-			}
-
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
-				}
-			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
-			}
+		if (!_resolve_internal_resource_path(i, path, id)) {
+			continue;
 		}
 
 		uint64_t offset = internal_resources[i].offset;
@@ -748,53 +867,10 @@ Error ResourceLoaderBinary::load() {
 
 		String t = get_unicode_string();
 
-		Ref<Resource> res;
-
-		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-			//use the existing one
-			Ref<Resource> cached = ResourceCache::get_ref(path);
-			if (cached->get_class() == t) {
-				cached->reset_state();
-				res = cached;
-			}
-		}
-
 		MissingResource *missing_resource = nullptr;
-
+		Ref<Resource> res = _instantiate_resource(t, path, id, missing_resource);
 		if (res.is_null()) {
-			//did not replace
-
-			Object *obj = ClassDB::instantiate(t);
-			if (!obj) {
-				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-					//create a missing resource
-					missing_resource = memnew(MissingResource);
-					missing_resource->set_original_class(t);
-					missing_resource->set_recording_properties(true);
-					obj = missing_resource;
-				} else {
-					error = ERR_FILE_CORRUPT;
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-				}
-			}
-
-			Resource *r = Object::cast_to<Resource>(obj);
-			if (!r) {
-				String obj_class = obj->get_class();
-				error = ERR_FILE_CORRUPT;
-				memdelete(obj); //bye
-				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
-			}
-
-			res = Ref<Resource>(r);
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
-				} else {
-					r->set_path_cache(path);
-				}
-			}
-			r->set_scene_unique_id(id);
+			return error;
 		}
 
 		if (!main) {
@@ -822,57 +898,157 @@ Error ResourceLoaderBinary::load() {
 				return error;
 			}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+			_set_resource_property(res, name, value, missing_resource, missing_resource_properties);
+		}
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+		_finish_resource(res, missing_resource, missing_resource_properties, i);
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
-			}
+		if (main) {
+			f.unref();
+			resource = res;
+			resource->set_as_translation_remapped(translation_remapped);
+			error = OK;
+			return OK;
+		}
+	}
+
+	return ERR_FILE_EOF;
+}
+
+Error ResourceLoaderBinary::_decode_properties(DecodedResource &r_resource) {
+	f->seek(r_resource.properties_offset);
+
+	int pc = f->get_32();
+	r_resource.properties.reserve(pc);
+
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
+		ERR_FAIL_COND_V(name == StringName(), ERR_FILE_CORRUPT);
+
+		Variant value;
+		Error err = parse_variant(value);
+		if (err) {
+			return err;
+		}
+
+		r_resource.properties.push_back(Pair<StringName, Variant>(name, value));
+	}
+
+	return OK;
+}
+
+void ResourceLoaderBinary::_decode_task(void *p_data) {
+	DecodeTaskData *data = (DecodeTaskData *)p_data;
+	while (true) {
+		uint32_t index = data->next->postincrement();
+		if (index >= data->resources->size()) {
+			break;
+		}
+		DecodedResource &decoded = (*data->resources)[index];
+		decoded.error = data->decoder->_decode_properties(decoded);
+	}
+}
 
-			if (set_valid) {
-				res->set(name, value);
+Error ResourceLoaderBinary::_load_threaded() {
+	// Create the sub-resources first, in file order, so they can be referred to while decoding
+	// the properties of the others.
+	LocalVector<DecodedResource> decoded;
+	for (int i = 0; i < internal_resources.size(); i++) {
+		DecodedResource dr;
+		dr.index = i;
+		if (!_resolve_internal_resource_path(i, dr.path, dr.id)) {
+			continue;
+		}
+
+		f->seek(internal_resources[i].offset);
+		dr.type = get_unicode_string();
+		dr.properties_offset = f->get_position();
+
+		// The main resource is only created once everything is decoded, as it's cached under the path being loaded.
+		if (i < internal_resources.size() - 1) {
+			dr.resource = _instantiate_resource(dr.type, dr.path, dr.id, dr.missing_resource);
+			if (dr.resource.is_null()) {
+				return error;
 			}
+			internal_index_cache[dr.path] = dr.resource;
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		decoded.push_back(dr);
+	}
+
+	// Decoding threads can't wait for dependencies, since a dependency may be waiting for this
+	// resource, so wait for all of them now.
+	for (int i = 0; i < external_resources.size(); i++) {
+		ExtResource &er = external_resources.write[i];
+		if (er.load_token.is_valid()) {
+			Error err;
+			er.resource = ResourceLoader::_load_complete(*er.load_token.ptr(), &err);
+			er.completed = true;
 		}
+	}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	// Each decoding thread reads the file on its own.
+	SafeNumeric<uint32_t> next;
+	const int decoder_count = MIN(WorkerThreadPool::get_singleton()->get_thread_count(), (int)decoded.size());
+	LocalVector<ResourceLoaderBinary> decoders;
+	decoders.resize(decoder_count);
+	LocalVector<DecodeTaskData> task_data;
+	task_data.resize(decoder_count);
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+
+	for (int i = 1; i < decoder_count; i++) {
+		Ref<FileAccess> decoder_file = FileAccess::open(file_path, FileAccess::READ);
+		if (decoder_file.is_null()) {
+			break;
 		}
+		decoder_file->set_big_endian(f->is_big_endian());
+		decoder_file->real_is_double = f->real_is_double;
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+		decoders[i] = *this;
+		decoders[i].f = decoder_file;
+		task_data[i].decoder = &decoders[i];
+		task_data[i].resources = &decoded;
+		task_data[i].next = &next;
+		tasks.push_back(WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoaderBinary::_decode_task, &task_data[i], false, "Decode binary resource"));
+	}
 
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+	// This thread decodes as well, so loading goes on even if the pool is busy.
+	task_data[0].decoder = this;
+	task_data[0].resources = &decoded;
+	task_data[0].next = &next;
+	_decode_task(&task_data[0]);
+
+	for (WorkerThreadPool::TaskID task : tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+
+	// Properties are set in file order, like when decoding in this thread only.
+	for (uint32_t i = 0; i < decoded.size(); i++) {
+		DecodedResource &dr = decoded[i];
+		if (dr.error != OK) {
+			error = dr.error;
+			return error;
 		}
 
-		resource_cache.push_back(res);
+		const bool main = dr.index == internal_resources.size() - 1;
+		if (main) {
+			dr.resource = _instantiate_resource(dr.type, dr.path, dr.id, dr.missing_resource);
+			if (dr.resource.is_null()) {
+				return error;
+			}
+		}
+
+		Dictionary missing_resource_properties;
+		for (Pair<StringName, Variant> &property : dr.properties) {
+			_set_resource_property(dr.resource, property.first, property.second, dr.missing_resource, missing_resource_properties);
+		}
+		dr.properties.clear();
+
+		_finish_resource(dr.resource, dr.missing_resource, missing_resource_properties, dr.index);
 
 		if (main) {
 			f.unref();
-			resource = res;
+			resource = dr.resource;
 			resource->set_as_translation_remapped(translation_remapped);
 			error = OK;
 			return OK;
@@ -971,6 +1147,7 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 	f->get_buffer(header, 4);
 	if (header[0] == 'R' && header[1] == 'S' && header[2] == 'C' && header[3] == 'C') {
 		// Compressed.
+		compressed = true;
 		Ref<FileAccessCompressed> fac;
 		fac.instantiate();
 		error = fac->open_after_magic(f);
@@ -1225,6 +1402,7 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	String path = !p_original_path.is_empty() ? p_original_path : p_path;
 	loader.local_path = ProjectSettings::get_singleton()->localize_path(path);
 	loader.res_path = loader.local_path;
+	loader.file_path = p_path;
 	loader.open(f);
 
 	err = loader.load();
@@ -34,6 +34,11 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
+
+class MissingResource;
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -61,6 +66,9 @@ class ResourceLoaderBinary {
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<ResourceLoader::LoadToken> load_token;
+		// Set once the load is completed, when decoding in threads.
+		Ref<Resource> resource;
+		bool completed = false;
 	};
 
 	bool using_named_scene_ids = false;
@@ -93,6 +101,37 @@ class ResourceLoaderBinary {
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
+	// With sub-threads, the properties of internal resources are decoded in parallel, each thread
+	// reading the file on its own, and then set in file order.
+	bool compressed = false;
+	String file_path;
+
+	struct DecodedResource {
+		int index = 0;
+		String path;
+		String id;
+		String type;
+		uint64_t properties_offset = 0;
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		LocalVector<Pair<StringName, Variant>> properties;
+		Error error = OK;
+	};
+
+	struct DecodeTaskData {
+		ResourceLoaderBinary *decoder = nullptr;
+		LocalVector<DecodedResource> *resources = nullptr;
+		SafeNumeric<uint32_t> *next = nullptr;
+	};
+
+	bool _resolve_internal_resource_path(int p_index, String &r_path, String &r_id);
+	Ref<Resource> _instantiate_resource(const String &p_type, const String &p_path, const String &p_id, MissingResource *&r_missing_resource);
+	void _set_resource_property(const Ref<Resource> &p_res, const StringName &p_name, Variant &p_value, MissingResource *p_missing_resource, Dictionary &r_missing_resource_properties);
+	void _finish_resource(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const Dictionary &p_missing_resource_properties, int p_index);
+	Error _decode_properties(DecodedResource &r_resource);
+	static void _decode_task(void *p_data);
+	Error _load_threaded();
+
 public:
 	Ref<Resource> get_resource();
 	Error load();
@@ -1095,6 +1095,7 @@ void Object::add_user_signal(const MethodInfo &p_signal) {
 	SignalData s;
 	s.user = p_signal;
 	signal_map[p_signal.name] = s;
+	_signal_map_version++;
 }
 
 bool Object::_has_user_signal(const StringName &p_name) const {
@@ -1116,6 +1117,7 @@ void Object::_remove_user_signal(const StringName &p_name) {
 	}
 
 	signal_map.erase(p_name);
+	_signal_map_version++;
 }
 
 Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
@@ -1146,6 +1148,22 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+void Object::SignalData::update_emit_slots() {
+	Vector<EmitSlot> slots;
+	slots.resize(slot_map.size());
+	EmitSlot *w = slots.ptrw();
+	has_one_shot = false;
+	for (const KeyValue<Callable, Slot> &slot_kv : slot_map) {
+		w->callable = slot_kv.value.conn.callable;
+		w->flags = slot_kv.value.conn.flags;
+		has_one_shot = has_one_shot || (w->flags & CONNECT_ONE_SHOT);
+		w++;
+	}
+	// Emissions in progress keep the previous array.
+	emit_slots = slots;
+	emit_slots_dirty = false;
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
@@ -1162,45 +1180,76 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		return ERR_UNAVAILABLE;
 	}
 
+	return _emit_signal_data(p_name, s, p_args, p_argcount);
+}
+
+Error Object::emit_signalp(SignalHandle &r_handle, const Variant **p_args, int p_argcount) {
+	if (_block_signals) {
+		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
+	}
+
+	if (r_handle.object_id != _instance_id || r_handle.version != _signal_map_version) {
+		r_handle.object_id = _instance_id;
+		r_handle.version = _signal_map_version;
+		r_handle.data = signal_map.getptr(r_handle.name);
+		if (!r_handle.data) {
+			// Reports nonexistent signals.
+			return emit_signalp(r_handle.name, p_args, p_argcount);
+		}
+	}
+
+	if (!r_handle.data) {
+		//not connected? just return
+		return ERR_UNAVAILABLE;
+	}
+
+	return _emit_signal_data(r_handle.name, r_handle.data, p_args, p_argcount);
+}
+
+Error Object::_emit_signal_data(const StringName &p_name, SignalData *p_signal_data, const Variant **p_args, int p_argcount) {
+	if (p_signal_data->emit_slots_dirty) {
+		p_signal_data->update_emit_slots();
+	}
+	if (p_signal_data->emit_slots.is_empty()) {
+		return OK;
+	}
+
 	// If this is a ref-counted object, prevent it from being destroyed during signal emission,
 	// which is needed in certain edge cases; e.g., https://github.com/godotengine/godot/issues/73889.
 	Ref<RefCounted> rc = Ref<RefCounted>(Object::cast_to<RefCounted>(this));
 
 	// Ensure that disconnecting the signal or even deleting the object
-	// will not affect the signal calling.
-	Callable *slot_callables = (Callable *)alloca(sizeof(Callable) * s->slot_map.size());
-	uint32_t *slot_flags = (uint32_t *)alloca(sizeof(uint32_t) * s->slot_map.size());
-	uint32_t slot_count = 0;
-
-	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-		memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-		slot_flags[slot_count] = slot_kv.value.conn.flags;
-		++slot_count;
-	}
-
-	DEV_ASSERT(slot_count == s->slot_map.size());
+	// will not affect the signal calling. This only references the slots,
+	// changing the connections makes the signal data use a new array.
+	const Vector<SignalData::EmitSlot> slots = p_signal_data->emit_slots;
+	const SignalData::EmitSlot *slot_ptr = slots.ptr();
+	const uint32_t slot_count = slots.size();
 
 	// Disconnect all one-shot connections before emitting to prevent recursion.
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+	if (p_signal_data->has_one_shot) {
+		for (uint32_t i = 0; i < slot_count; ++i) {
+			bool disconnect = slot_ptr[i].flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-		if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
-			// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
-			disconnect = false;
-		}
+			if (disconnect && (slot_ptr[i].flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
+				disconnect = false;
+			}
 #endif
-		if (disconnect) {
-			_disconnect(p_name, slot_callables[i]);
+			if (disconnect) {
+				_disconnect(p_name, slot_ptr[i].callable);
+			}
 		}
 	}
+	// The signal data may be gone now.
+	p_signal_data = nullptr;
 
 	OBJ_DEBUG_LOCK
 
 	Error err = OK;
 
 	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+		const Callable &callable = slot_ptr[i].callable;
+		const uint32_t &flags = slot_ptr[i].flags;
 
 		if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
@@ -1236,10 +1285,6 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
 	return err;
 }
 
@@ -1423,6 +1468,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 		signal_map[p_signal] = SignalData();
 		s = &signal_map[p_signal];
+		_signal_map_version++;
 	}
 
 	//compare with the base callable, so binds can be ignored
@@ -1453,6 +1499,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->emit_slots_dirty = true;
 
 	return OK;
 }
@@ -1510,10 +1557,12 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->emit_slots_dirty = true;
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
 		signal_map.erase(p_signal);
+		_signal_map_version++;
 	}
 
 	return true;
@@ -2125,6 +2174,7 @@ Object::~Object() {
 
 		signal_map.erase(E.key);
 	}
+	_signal_map_version++;
 
 	// Disconnect signals that connect to this object.
 	while (connections.size()) {
@@ -2164,8 +2214,9 @@ void ObjectDB::debug_objects(DebugFunc p_func) {
 	spin_lock.lock();
 
 	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object);
+		ObjectSlot &object_slot = _get_slot(i);
+		if (object_slot.validator.load(std::memory_order_relaxed)) {
+			p_func(object_slot.object.load(std::memory_order_relaxed));
 			count--;
 		}
 	}
@@ -2221,7 +2272,7 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 SpinLock ObjectDB::spin_lock;
 uint32_t ObjectDB::slot_count = 0;
 uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::object_slot_chunks[OBJECTDB_SLOT_MAX_CHUNKS] = {};
 uint64_t ObjectDB::validator_counter = 0;
 
 int ObjectDB::get_object_count() {
@@ -2233,29 +2284,30 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 	if (unlikely(slot_count == slot_max)) {
 		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+		ObjectSlot *chunk = memnew_arr(ObjectSlot, OBJECTDB_SLOT_CHUNK_SIZE);
+		for (uint32_t i = 0; i < OBJECTDB_SLOT_CHUNK_SIZE; i++) {
+			chunk[i].object.store(nullptr, std::memory_order_relaxed);
+			chunk[i].validator.store(0, std::memory_order_relaxed);
+			chunk[i].next_free = slot_max + i;
 		}
-		slot_max = new_slot_max;
+		// Published last, so lookups never see an uninitialized chunk.
+		object_slot_chunks[slot_max >> OBJECTDB_SLOT_CHUNK_BITS].store(chunk, std::memory_order_release);
+		slot_max += OBJECTDB_SLOT_CHUNK_SIZE;
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
+	uint32_t slot = _get_slot(slot_count).next_free;
+	ObjectSlot &object_slot = _get_slot(slot);
+	if (object_slot.object.load(std::memory_order_relaxed) != nullptr) {
 		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+		ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.is_ref_counted = p_object->is_ref_counted();
 	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
 	if (unlikely(validator_counter == 0)) {
 		validator_counter = 1;
 	}
-	object_slots[slot].validator = validator_counter;
+	object_slot.validator.store(validator_counter, std::memory_order_release);
 
 	uint64_t id = validator_counter;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
@@ -2278,17 +2330,19 @@ void ObjectDB::remove_instance(Object *p_object) {
 
 	spin_lock.lock();
 
+	ObjectSlot &object_slot = _get_slot(slot);
+
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
+	if (object_slot.object.load(std::memory_order_relaxed) != p_object) {
 		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
+		ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	}
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
+		if (object_slot.validator.load(std::memory_order_relaxed) != validator) {
 			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
+			ERR_FAIL_COND(object_slot.validator.load(std::memory_order_relaxed) != validator);
 		}
 	}
 
@@ -2296,11 +2350,11 @@ void ObjectDB::remove_instance(Object *p_object) {
 	//decrease slot count
 	slot_count--;
 	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
+	_get_slot(slot_count).next_free = slot;
 	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	object_slot.validator.store(0, std::memory_order_release);
+	object_slot.is_ref_counted = false;
+	object_slot.object.store(nullptr, std::memory_order_release);
 
 	spin_lock.unlock();
 }
@@ -2323,8 +2377,9 @@ void ObjectDB::cleanup() {
 			Callable::CallError call_error;
 
 			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+				ObjectSlot &object_slot = _get_slot(i);
+				if (object_slot.validator.load(std::memory_order_relaxed)) {
+					Object *obj = object_slot.object.load(std::memory_order_relaxed);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2334,7 +2389,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Resource path: " + String(resource_get_path->call(obj, nullptr, 0, call_error));
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | (object_slot.validator.load(std::memory_order_relaxed) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slot.is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
 					DEV_ASSERT(id == (uint64_t)obj->get_instance_id()); // We could just use the id from the object, but this check may help catching memory corruption catastrophes.
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + uitos(id) + extra_info);
 
@@ -2345,9 +2400,10 @@ void ObjectDB::cleanup() {
 		}
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	for (uint32_t i = 0; i < slot_max; i += OBJECTDB_SLOT_CHUNK_SIZE) {
+		memdelete_arr(object_slot_chunks[i >> OBJECTDB_SLOT_CHUNK_BITS].exchange(nullptr));
 	}
+	slot_max = 0;
 
 	spin_lock.unlock();
 }
@@ -36,6 +36,7 @@
 #include "core/object/object_id.h"
 #include "core/os/rw_lock.h"
 #include "core/os/spin_lock.h"
+#include "core/templates/flat_hash_map.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -618,12 +619,26 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		struct EmitSlot {
+			Callable callable;
+			uint32_t flags = 0;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		// Flat copy of the connections, rebuilt by the first emission after they change.
+		// Emitting holds a reference to it, so connecting and disconnecting during emission
+		// doesn't affect it, and no copy is needed when nothing changes.
+		Vector<EmitSlot> emit_slots;
+		bool emit_slots_dirty = false;
+		bool has_one_shot = false;
 		bool removable = false;
+
+		void update_emit_slots();
 	};
 
-	HashMap<StringName, SignalData> signal_map;
+	FlatHashMap<StringName, SignalData> signal_map;
+	uint32_t _signal_map_version = 0; // Changes whenever SignalData pointers may be invalidated.
 	List<Connection> connections;
 #ifdef DEBUG_ENABLED
 	SafeRefCount _lock_index;
@@ -650,6 +665,7 @@ private:
 	bool _has_user_signal(const StringName &p_name) const;
 	void _remove_user_signal(const StringName &p_name);
 	Error _emit_signal(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	Error _emit_signal_data(const StringName &p_name, SignalData *p_signal_data, const Variant **p_args, int p_argcount);
 	TypedArray<Dictionary> _get_signal_list() const;
 	TypedArray<Dictionary> _get_signal_connection_list(const StringName &p_signal) const;
 	TypedArray<Dictionary> _get_incoming_connections() const;
@@ -768,6 +784,7 @@ protected:
 
 	friend class ClassDB;
 	friend class PlaceholderExtensionInstance;
+	friend class PropertyHandle;
 
 	bool _disconnect(const StringName &p_signal, const Callable &p_callable, bool p_force = false);
 
@@ -937,6 +954,35 @@ public:
 	}
 
 	MTVIRTUAL Error emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount);
+
+	// Remembers where the connections of a signal are, for code that emits it repeatedly.
+	// Only valid for one object at a time, using it with another object looks the signal up again.
+	class SignalHandle {
+		friend class Object;
+
+		StringName name;
+		ObjectID object_id;
+		uint32_t version = 0;
+		SignalData *data = nullptr;
+
+	public:
+		const StringName &get_name() const { return name; }
+
+		explicit SignalHandle(const StringName &p_name) :
+				name(p_name) {}
+	};
+
+	template <typename... VarArgs>
+	Error emit_signal(SignalHandle &r_handle, VarArgs... p_args) {
+		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
+		const Variant *argptrs[sizeof...(p_args) + 1];
+		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
+			argptrs[i] = &args[i];
+		}
+		return emit_signalp(r_handle, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
+	}
+
+	MTVIRTUAL Error emit_signalp(SignalHandle &r_handle, const Variant **p_args, int p_argcount);
 	MTVIRTUAL bool has_signal(const StringName &p_name) const;
 	MTVIRTUAL void get_signal_list(List<MethodInfo> *p_signals) const;
 	MTVIRTUAL void get_signal_connection_list(const StringName &p_signal, List<Connection> *p_connections) const;
@@ -1014,19 +1060,32 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
 
-	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+	// Slots live in chunks that never move once allocated, so lookups can read them
+	// without taking the lock. Only adding and removing instances is serialized.
+#define OBJECTDB_SLOT_CHUNK_BITS 12
+#define OBJECTDB_SLOT_CHUNK_SIZE (1 << OBJECTDB_SLOT_CHUNK_BITS)
+#define OBJECTDB_SLOT_CHUNK_MASK (OBJECTDB_SLOT_CHUNK_SIZE - 1)
+#define OBJECTDB_SLOT_MAX_CHUNKS (1 << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_SLOT_CHUNK_BITS))
+
+	struct ObjectSlot {
+		// Zero while the slot is free. Always written after the object when adding
+		// an instance, and before it when removing one.
+		std::atomic<uint64_t> validator;
+		std::atomic<Object *> object;
+		uint32_t next_free = 0;
+		bool is_ref_counted = false;
 	};
 
 	static SpinLock spin_lock;
 	static uint32_t slot_count;
 	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
+	static std::atomic<ObjectSlot *> object_slot_chunks[OBJECTDB_SLOT_MAX_CHUNKS];
 	static uint64_t validator_counter;
 
+	_FORCE_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return object_slot_chunks[p_slot >> OBJECTDB_SLOT_CHUNK_BITS].load(std::memory_order_relaxed)[p_slot & OBJECTDB_SLOT_CHUNK_MASK];
+	}
+
 	friend class Object;
 	friend void unregister_core_types();
 	static void cleanup();
@@ -1044,20 +1103,22 @@ public:
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); // This should never happen unless RID is corrupted.
-
-		spin_lock.lock();
+		ObjectSlot *chunk = object_slot_chunks[slot >> OBJECTDB_SLOT_CHUNK_BITS].load(std::memory_order_acquire);
+		ERR_FAIL_NULL_V(chunk, nullptr); // This should never happen unless RID is corrupted.
 
+		ObjectSlot &object_slot = chunk[slot & OBJECTDB_SLOT_CHUNK_MASK];
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		if (unlikely(object_slot.validator.load(std::memory_order_acquire) != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_acquire);
 
-		spin_lock.unlock();
+		// The slot may have been freed, and maybe reused, while reading the object.
+		if (unlikely(object_slot.validator.load(std::memory_order_relaxed) != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
@@ -0,0 +1,204 @@
+/**************************************************************************/
+/*  property_handle.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "property_handle.h"
+
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/object/script_language.h"
+
+void PropertyHandle::_resolve(const Object *p_object) {
+	object_id = p_object->get_instance_id();
+	script_id = ObjectID(p_object->script);
+	setter = nullptr;
+	getter = nullptr;
+	index = -1;
+	direct = false;
+
+	if (path.is_empty()) {
+		return;
+	}
+	const StringName &property = path[0];
+
+	// Extensions and scripts are asked before the class, so they can't be skipped if they may handle the property.
+	if (p_object->_extension && (p_object->_extension->set || p_object->_extension->get)) {
+		return;
+	}
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (script_instance) {
+		if (script_instance->is_placeholder() || script_instance->has_method(CoreStringName(_set)) || script_instance->has_method(CoreStringName(_get))) {
+			return;
+		}
+		bool is_script_property = false;
+		script_instance->get_property_type(property, &is_script_property);
+		if (is_script_property) {
+			return;
+		}
+	}
+
+	ClassDB::PropertySetGet setget;
+	if (!ClassDB::get_property_setget(p_object->get_class_name(), property, &setget)) {
+		return;
+	}
+	if (!setget._setptr || !setget._getptr) {
+		return;
+	}
+	setter = setget._setptr;
+	getter = setget._getptr;
+	index = setget.index;
+	direct = true;
+}
+
+void PropertyHandle::_set_base(Object *p_object, const Variant &p_value, bool *r_valid) {
+	if (!direct) {
+		p_object->set(path[0], p_value, r_valid);
+		return;
+	}
+
+#ifdef TOOLS_ENABLED
+	p_object->_edited = true;
+#endif
+
+	Callable::CallError ce;
+	if (index >= 0) {
+		Variant index_arg = index;
+		const Variant *args[2] = { &index_arg, &p_value };
+		setter->call(p_object, args, 2, ce);
+	} else {
+		const Variant *args[1] = { &p_value };
+		setter->call(p_object, args, 1, ce);
+	}
+	if (r_valid) {
+		*r_valid = ce.error == Callable::CallError::CALL_OK;
+	}
+}
+
+Variant PropertyHandle::_get_base(const Object *p_object, bool *r_valid) {
+	if (!direct) {
+		return p_object->get(path[0], r_valid);
+	}
+
+	Callable::CallError ce;
+	Variant ret;
+	if (index >= 0) {
+		Variant index_arg = index;
+		const Variant *args[1] = { &index_arg };
+		ret = getter->call(const_cast<Object *>(p_object), args, 1, ce);
+	} else {
+		ret = getter->call(const_cast<Object *>(p_object), nullptr, 0, ce);
+	}
+	if (r_valid) {
+		*r_valid = ce.error == Callable::CallError::CALL_OK;
+	}
+	return ret;
+}
+
+void PropertyHandle::set(Object *p_object, const Variant &p_value, bool *r_valid) {
+	ERR_FAIL_NULL(p_object);
+	if (path.is_empty()) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		return;
+	}
+	_ensure_resolved(p_object);
+
+	if (path.size() == 1) {
+		_set_base(p_object, p_value, r_valid);
+		return;
+	}
+
+	// Same as Object::set_indexed().
+	bool valid = false;
+	if (!r_valid) {
+		r_valid = &valid;
+	}
+
+	LocalVector<Variant> value_stack;
+	value_stack.push_back(_get_base(p_object, r_valid));
+	if (!*r_valid) {
+		return;
+	}
+
+	for (int i = 1; i < path.size() - 1; i++) {
+		value_stack.push_back(value_stack[value_stack.size() - 1].get_named(path[i], valid));
+		*r_valid = valid;
+		if (!valid) {
+			return;
+		}
+	}
+
+	value_stack.push_back(p_value);
+
+	for (int i = path.size() - 1; i > 0; i--) {
+		value_stack[i - 1].set_named(path[i], value_stack[i], valid);
+		*r_valid = valid;
+		if (!valid) {
+			return;
+		}
+	}
+
+	_set_base(p_object, value_stack[0], r_valid);
+}
+
+Variant PropertyHandle::get(const Object *p_object, bool *r_valid) {
+	ERR_FAIL_NULL_V(p_object, Variant());
+	if (path.is_empty()) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		return Variant();
+	}
+	_ensure_resolved(p_object);
+
+	bool valid = false;
+	Variant value = _get_base(p_object, &valid);
+	for (int i = 1; i < path.size() && valid; i++) {
+		value = value.get_named(path[i], valid);
+	}
+	if (r_valid) {
+		*r_valid = valid;
+	}
+	return value;
+}
+
+void PropertyHandle::set_path(const Vector<StringName> &p_path) {
+	path = p_path;
+	object_id = ObjectID();
+	direct = false;
+}
+
+PropertyHandle::PropertyHandle(const Vector<StringName> &p_path) :
+		path(p_path) {
+}
+
+PropertyHandle::PropertyHandle(const StringName &p_property) {
+	path.push_back(p_property);
+}
@@ -0,0 +1,78 @@
+/**************************************************************************/
+/*  property_handle.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PROPERTY_HANDLE_H
+#define PROPERTY_HANDLE_H
+
+#include "core/object/object.h"
+
+class MethodBind;
+
+// Resolves a property path (a property followed by optional subnames, like "position:x")
+// once, so it can be set and read repeatedly without looking it up by name every time.
+// When the property is a native one and neither a script nor an extension can intercept it,
+// the setter and getter are called directly. Otherwise this falls back to Object::set/get.
+// The resolution is kept for one object at a time, and redone when the object or its script changes.
+class PropertyHandle {
+	Vector<StringName> path;
+
+	ObjectID object_id;
+	ObjectID script_id;
+	MethodBind *setter = nullptr;
+	MethodBind *getter = nullptr;
+	int index = -1;
+	bool direct = false;
+
+	void _resolve(const Object *p_object);
+	_FORCE_INLINE_ void _ensure_resolved(const Object *p_object) {
+		if (unlikely(object_id != p_object->get_instance_id() || script_id != ObjectID(p_object->script))) {
+			_resolve(p_object);
+		}
+	}
+
+	void _set_base(Object *p_object, const Variant &p_value, bool *r_valid);
+	Variant _get_base(const Object *p_object, bool *r_valid);
+
+public:
+	void set_path(const Vector<StringName> &p_path);
+	const Vector<StringName> &get_path() const { return path; }
+
+	void set(Object *p_object, const Variant &p_value, bool *r_valid = nullptr);
+	Variant get(const Object *p_object, bool *r_valid = nullptr);
+
+	// Whether the last object is accessed through its setter and getter directly.
+	bool is_direct() const { return direct; }
+
+	PropertyHandle() {}
+	PropertyHandle(const Vector<StringName> &p_path);
+	PropertyHandle(const StringName &p_property);
+};
+
+#endif // PROPERTY_HANDLE_H
@@ -30,6 +30,7 @@
 
 #include "worker_thread_pool.h"
 
+#include "core/debugger/frame_timeline.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/os/thread_safe.h"
@@ -49,6 +50,7 @@ WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 thread_local CommandQueueMT *WorkerThreadPool::flushing_cmd_queue = nullptr;
 
 void WorkerThreadPool::_process_task(Task *p_task) {
+	FRAME_TIMELINE_ZONE("WorkerThreadPool task");
 #ifdef THREADS_ENABLED
 	int pool_thread_index = thread_ids[Thread::get_caller_id()];
 	ThreadData &curr_thread = threads[pool_thread_index];
@@ -173,6 +175,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
+	FrameTimeline::set_thread_name("WorkerThreadPool");
 	ThreadData *thread_data = (ThreadData *)p_user;
 	while (true) {
 		Task *task_to_process = nullptr;
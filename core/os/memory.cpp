@@ -33,8 +33,13 @@
 #include "core/error/error_macros.h"
 #include "core/templates/safe_refcount.h"
 
+#ifdef SMALL_ALLOCATOR_ENABLED
+#include "core/os/small_allocator.h"
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
@@ -65,6 +70,52 @@ SafeNumeric<uint64_t> Memory::max_usage;
 
 SafeNumeric<uint64_t> Memory::alloc_count;
 
+// System allocation functions, small blocks go to SmallAllocator if enabled.
+
+static _FORCE_INLINE_ void *_alloc_system(size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	if (p_bytes <= SmallAllocator::MAX_SIZE) {
+		void *mem = SmallAllocator::alloc(p_bytes);
+		if (likely(mem)) {
+			return mem;
+		}
+	}
+#endif
+	return malloc(p_bytes);
+}
+
+static _FORCE_INLINE_ void _free_system(void *p_mem) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	if (SmallAllocator::owns(p_mem)) {
+		SmallAllocator::free(p_mem);
+		return;
+	}
+#endif
+	free(p_mem);
+}
+
+static _FORCE_INLINE_ void *_realloc_system(void *p_mem, size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	if (SmallAllocator::owns(p_mem)) {
+		const size_t block_size = SmallAllocator::get_block_size(p_mem);
+		if (p_bytes == 0) {
+			SmallAllocator::free(p_mem);
+			return nullptr;
+		}
+		if (p_bytes <= block_size) {
+			return p_mem;
+		}
+		void *new_mem = _alloc_system(p_bytes);
+		if (new_mem) {
+			memcpy(new_mem, p_mem, block_size);
+			SmallAllocator::free(p_mem);
+		}
+		return new_mem;
+	}
+#endif
+	return realloc(p_mem, p_bytes);
+}
+
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 	bool prepad = true;
@@ -72,7 +123,7 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+	void *mem = _alloc_system(p_bytes + (prepad ? DATA_OFFSET : 0));
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 
@@ -121,12 +172,12 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			_free_system(mem);
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+			mem = (uint8_t *)_realloc_system(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
@@ -136,7 +187,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 			return mem + DATA_OFFSET;
 		}
 	} else {
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		mem = (uint8_t *)_realloc_system(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 
@@ -165,9 +216,9 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 		mem_usage.sub(*s);
 #endif
 
-		free(mem);
+		_free_system(mem);
 	} else {
-		free(mem);
+		_free_system(mem);
 	}
 }
 
@@ -178,6 +229,9 @@ uint64_t Memory::get_mem_available() {
 uint64_t Memory::get_mem_usage() {
 #ifdef DEBUG_ENABLED
 	return mem_usage.get();
+#elif defined(SMALL_ALLOCATOR_ENABLED)
+	// Only small allocations are tracked without the debug padding.
+	return SmallAllocator::get_used_bytes();
 #else
 	return 0;
 #endif
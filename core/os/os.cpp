@@ -639,6 +639,7 @@ String OS::get_benchmark_file() {
 
 void OS::benchmark_begin_measure(const String &p_context, const String &p_what) {
 #ifdef TOOLS_ENABLED
+	MutexLock lock(benchmark_mutex);
 	Pair<String, String> mark_key(p_context, p_what);
 	ERR_FAIL_COND_MSG(benchmark_marks_from.has(mark_key), vformat("Benchmark key '%s:%s' already exists.", p_context, p_what));
 
@@ -647,6 +648,7 @@ void OS::benchmark_begin_measure(const String &p_context, const String &p_what)
 }
 void OS::benchmark_end_measure(const String &p_context, const String &p_what) {
 #ifdef TOOLS_ENABLED
+	MutexLock lock(benchmark_mutex);
 	Pair<String, String> mark_key(p_context, p_what);
 	ERR_FAIL_COND_MSG(!benchmark_marks_from.has(mark_key), vformat("Benchmark key '%s:%s' doesn't exist.", p_context, p_what));
 
@@ -656,12 +658,25 @@ void OS::benchmark_end_measure(const String &p_context, const String &p_what) {
 #endif
 }
 
+void OS::benchmark_add_measure(const String &p_context, const String &p_what, uint64_t p_usec) {
+#ifdef TOOLS_ENABLED
+	MutexLock lock(benchmark_mutex);
+	Pair<String, String> mark_key(p_context, p_what);
+	HashMap<Pair<String, String>, double, PairHash<String, String>>::Iterator E = benchmark_marks_final.find(mark_key);
+	if (!E) {
+		E = benchmark_marks_final.insert(mark_key, 0.0);
+	}
+	E->value += double(p_usec) / double(1000000);
+#endif
+}
+
 void OS::benchmark_dump() {
 #ifdef TOOLS_ENABLED
 	if (!use_benchmark) {
 		return;
 	}
 
+	MutexLock lock(benchmark_mutex);
 	if (!benchmark_file.is_empty()) {
 		Ref<FileAccess> f = FileAccess::open(benchmark_file, FileAccess::WRITE);
 		if (f.is_valid()) {
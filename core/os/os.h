@@ -35,6 +35,7 @@
 #include "core/io/image.h"
 #include "core/io/logger.h"
 #include "core/io/remote_filesystem_client.h"
+#include "core/os/mutex.h"
 #include "core/os/time_enums.h"
 #include "core/string/ustring.h"
 #include "core/templates/list.h"
@@ -83,6 +84,7 @@ class OS {
 	String benchmark_file;
 	HashMap<Pair<String, String>, uint64_t, PairHash<String, String>> benchmark_marks_from;
 	HashMap<Pair<String, String>, double, PairHash<String, String>> benchmark_marks_final;
+	Mutex benchmark_mutex;
 
 protected:
 	void _set_logger(CompositeLogger *p_logger);
@@ -326,6 +328,8 @@ public:
 	String get_benchmark_file();
 	virtual void benchmark_begin_measure(const String &p_context, const String &p_what);
 	virtual void benchmark_end_measure(const String &p_context, const String &p_what);
+	// Adds to a measure made of many short spans, such as loading each script. Can be called from any thread.
+	void benchmark_add_measure(const String &p_context, const String &p_what, uint64_t p_usec);
 	virtual void benchmark_dump();
 
 	virtual void process_and_drop_events() {}
@@ -0,0 +1,374 @@
+/**************************************************************************/
+/*  small_allocator.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_allocator.h"
+
+#include "core/os/spin_lock.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+
+constexpr uint32_t CHUNK_SHIFT = 16;
+constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_SHIFT;
+// Chunks are found through a two level bitmap covering 48 bit addresses.
+constexpr uint32_t ADDRESS_BITS = 48;
+constexpr uint32_t CHUNK_MAP_SHIFT = 32;
+constexpr uint32_t CHUNK_MAP_SIZE = 1 << (ADDRESS_BITS - CHUNK_MAP_SHIFT);
+constexpr uint32_t CHUNK_BITS_SIZE = (1 << (CHUNK_MAP_SHIFT - CHUNK_SHIFT)) / 64;
+
+constexpr uint32_t SIZE_CLASSES[SmallAllocator::SIZE_CLASS_COUNT] = { 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512 };
+
+struct ThreadHeap;
+
+struct Block {
+	Block *next;
+};
+
+struct Chunk {
+	uint32_t size_class = 0;
+	uint32_t block_size = 0;
+	std::atomic<ThreadHeap *> owner; // Null while abandoned.
+	Chunk *next = nullptr; // In the owner's list for the size class, or in the abandoned list.
+
+	// Only used by the owner.
+	Block *free_list = nullptr;
+	uint8_t *bump = nullptr; // First block that was never allocated.
+	uint8_t *end = nullptr;
+
+	std::atomic<Block *> remote_free; // Blocks freed by other threads.
+};
+
+constexpr size_t CHUNK_HEADER_SIZE = (sizeof(Chunk) + 63) & ~size_t(63);
+
+struct ThreadHeap {
+	Chunk *chunks[SmallAllocator::SIZE_CLASS_COUNT] = {}; // The first one is used for allocations.
+	// Only written by the owner thread. Blocks freed from another thread are subtracted from its own heap,
+	// so a heap alone can be negative but the sum is right.
+	std::atomic<int64_t> used_bytes;
+	ThreadHeap *next_heap = nullptr;
+};
+
+std::atomic<std::atomic<uint64_t> *> chunk_map[CHUNK_MAP_SIZE];
+
+SpinLock heaps_lock;
+ThreadHeap *heaps = nullptr;
+Chunk *abandoned_chunks[SmallAllocator::SIZE_CLASS_COUNT] = {};
+std::atomic<int64_t> retired_used_bytes;
+std::atomic<uint64_t> reserved_bytes;
+
+thread_local ThreadHeap *thread_heap = nullptr;
+thread_local bool thread_heap_released = false;
+
+_FORCE_INLINE_ uint32_t get_size_class(size_t p_bytes) {
+	if (p_bytes <= 128) {
+		return p_bytes ? uint32_t(p_bytes - 1) >> 4 : 0;
+	} else if (p_bytes <= 256) {
+		return 8 + (uint32_t(p_bytes - 129) >> 5);
+	} else {
+		return 12 + (uint32_t(p_bytes - 257) >> 6);
+	}
+}
+
+_FORCE_INLINE_ Chunk *get_chunk(const void *p_ptr) {
+	return reinterpret_cast<Chunk *>(uintptr_t(p_ptr) & ~uintptr_t(CHUNK_SIZE - 1));
+}
+
+_FORCE_INLINE_ void add_used_bytes(ThreadHeap *p_heap, int64_t p_bytes) {
+	if (likely(p_heap)) {
+		p_heap->used_bytes.store(p_heap->used_bytes.load(std::memory_order_relaxed) + p_bytes, std::memory_order_relaxed);
+	} else {
+		retired_used_bytes.fetch_add(p_bytes, std::memory_order_relaxed);
+	}
+}
+
+void register_chunk(Chunk *p_chunk) {
+	const uint64_t address = uint64_t(uintptr_t(p_chunk));
+	std::atomic<uint64_t> *bits = chunk_map[address >> CHUNK_MAP_SHIFT].load(std::memory_order_acquire);
+	if (!bits) {
+		std::atomic<uint64_t> *new_bits = static_cast<std::atomic<uint64_t> *>(calloc(CHUNK_BITS_SIZE, sizeof(std::atomic<uint64_t>)));
+		if (chunk_map[address >> CHUNK_MAP_SHIFT].compare_exchange_strong(bits, new_bits, std::memory_order_acq_rel)) {
+			bits = new_bits;
+		} else {
+			::free(new_bits);
+		}
+	}
+	const uint32_t index = uint32_t(address >> CHUNK_SHIFT) & (CHUNK_BITS_SIZE * 64 - 1);
+	bits[index / 64].fetch_or(uint64_t(1) << (index % 64), std::memory_order_release);
+}
+
+Chunk *create_chunk(ThreadHeap *p_heap, uint32_t p_size_class) {
+	void *mem = nullptr;
+#ifdef _WIN32
+	mem = _aligned_malloc(CHUNK_SIZE, CHUNK_SIZE);
+#else
+	if (posix_memalign(&mem, CHUNK_SIZE, CHUNK_SIZE) != 0) {
+		mem = nullptr;
+	}
+#endif
+	if (!mem) {
+		return nullptr;
+	}
+	if (uint64_t(uintptr_t(mem)) >> ADDRESS_BITS) {
+		// Outside the range covered by the chunk map.
+#ifdef _WIN32
+		_aligned_free(mem);
+#else
+		::free(mem);
+#endif
+		return nullptr;
+	}
+
+	Chunk *chunk = new (mem) Chunk;
+	chunk->size_class = p_size_class;
+	chunk->block_size = SIZE_CLASSES[p_size_class];
+	chunk->owner.store(p_heap, std::memory_order_relaxed);
+	chunk->bump = static_cast<uint8_t *>(mem) + CHUNK_HEADER_SIZE;
+	chunk->end = chunk->bump + (CHUNK_SIZE - CHUNK_HEADER_SIZE) / chunk->block_size * chunk->block_size;
+	chunk->remote_free.store(nullptr, std::memory_order_relaxed);
+
+	register_chunk(chunk);
+	reserved_bytes.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+	return chunk;
+}
+
+void collect_remote_free(Chunk *p_chunk) {
+	Block *remote = p_chunk->remote_free.exchange(nullptr, std::memory_order_acquire);
+	if (!remote) {
+		return;
+	}
+	Block *last = remote;
+	while (last->next) {
+		last = last->next;
+	}
+	last->next = p_chunk->free_list;
+	p_chunk->free_list = remote;
+}
+
+_FORCE_INLINE_ void *alloc_from_chunk(Chunk *p_chunk) {
+	Block *block = p_chunk->free_list;
+	if (block) {
+		p_chunk->free_list = block->next;
+		return block;
+	}
+	if (p_chunk->bump < p_chunk->end) {
+		void *mem = p_chunk->bump;
+		p_chunk->bump += p_chunk->block_size;
+		return mem;
+	}
+	return nullptr;
+}
+
+void release_thread_heap() {
+	ThreadHeap *heap = thread_heap;
+	if (!heap) {
+		return;
+	}
+	thread_heap = nullptr;
+	thread_heap_released = true;
+
+	heaps_lock.lock();
+	for (uint32_t i = 0; i < SmallAllocator::SIZE_CLASS_COUNT; i++) {
+		Chunk *chunk = heap->chunks[i];
+		while (chunk) {
+			Chunk *next = chunk->next;
+			chunk->owner.store(nullptr, std::memory_order_relaxed);
+			chunk->next = abandoned_chunks[i];
+			abandoned_chunks[i] = chunk;
+			chunk = next;
+		}
+	}
+	for (ThreadHeap **E = &heaps; *E; E = &(*E)->next_heap) {
+		if (*E == heap) {
+			*E = heap->next_heap;
+			break;
+		}
+	}
+	retired_used_bytes.fetch_add(heap->used_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	heaps_lock.unlock();
+
+	::free(heap);
+}
+
+struct ThreadHeapReleaser {
+	~ThreadHeapReleaser() {
+		release_thread_heap();
+	}
+};
+
+thread_local ThreadHeapReleaser thread_heap_releaser;
+
+ThreadHeap *create_thread_heap() {
+	if (thread_heap_released) {
+		// The thread is exiting, let the remaining allocations use the system allocator.
+		return nullptr;
+	}
+	void *mem = malloc(sizeof(ThreadHeap));
+	if (!mem) {
+		return nullptr;
+	}
+	ThreadHeap *heap = new (mem) ThreadHeap;
+	heap->used_bytes.store(0, std::memory_order_relaxed);
+
+	heaps_lock.lock();
+	heap->next_heap = heaps;
+	heaps = heap;
+	heaps_lock.unlock();
+
+	thread_heap = heap;
+	(void)&thread_heap_releaser; // Registers the release on thread exit.
+	return heap;
+}
+
+void *alloc_slow(ThreadHeap *p_heap, uint32_t p_size_class) {
+	// Look for a chunk with free blocks, and move it to the front.
+	Chunk **prev = &p_heap->chunks[p_size_class];
+	for (Chunk *chunk = *prev; chunk; prev = &chunk->next, chunk = chunk->next) {
+		collect_remote_free(chunk);
+		void *mem = alloc_from_chunk(chunk);
+		if (mem) {
+			if (chunk != p_heap->chunks[p_size_class]) {
+				*prev = chunk->next;
+				chunk->next = p_heap->chunks[p_size_class];
+				p_heap->chunks[p_size_class] = chunk;
+			}
+			return mem;
+		}
+	}
+
+	// Adopt a chunk from an exited thread, or create a new one.
+	heaps_lock.lock();
+	Chunk *chunk = abandoned_chunks[p_size_class];
+	if (chunk) {
+		abandoned_chunks[p_size_class] = chunk->next;
+		chunk->owner.store(p_heap, std::memory_order_relaxed);
+	}
+	heaps_lock.unlock();
+
+	if (chunk) {
+		collect_remote_free(chunk);
+	} else {
+		chunk = create_chunk(p_heap, p_size_class);
+		if (!chunk) {
+			return nullptr;
+		}
+	}
+	chunk->next = p_heap->chunks[p_size_class];
+	p_heap->chunks[p_size_class] = chunk;
+
+	void *mem = alloc_from_chunk(chunk);
+	if (!mem) {
+		// Full abandoned chunk, try again with the next one.
+		return alloc_slow(p_heap, p_size_class);
+	}
+	return mem;
+}
+
+} // namespace
+
+void *SmallAllocator::alloc(size_t p_bytes) {
+	if (p_bytes > MAX_SIZE) {
+		return nullptr;
+	}
+	ThreadHeap *heap = thread_heap;
+	if (unlikely(!heap)) {
+		heap = create_thread_heap();
+		if (!heap) {
+			return nullptr;
+		}
+	}
+
+	const uint32_t size_class = get_size_class(p_bytes);
+	Chunk *chunk = heap->chunks[size_class];
+	void *mem = chunk ? alloc_from_chunk(chunk) : nullptr;
+	if (unlikely(!mem)) {
+		mem = alloc_slow(heap, size_class);
+		if (!mem) {
+			return nullptr;
+		}
+	}
+	add_used_bytes(heap, SIZE_CLASSES[size_class]);
+	return mem;
+}
+
+void SmallAllocator::free(void *p_ptr) {
+	Chunk *chunk = get_chunk(p_ptr);
+	Block *block = static_cast<Block *>(p_ptr);
+	ThreadHeap *heap = thread_heap;
+
+	if (likely(heap && chunk->owner.load(std::memory_order_relaxed) == heap)) {
+		block->next = chunk->free_list;
+		chunk->free_list = block;
+	} else {
+		Block *head = chunk->remote_free.load(std::memory_order_relaxed);
+		do {
+			block->next = head;
+		} while (!chunk->remote_free.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+	}
+	add_used_bytes(heap, -int64_t(chunk->block_size));
+}
+
+bool SmallAllocator::owns(const void *p_ptr) {
+	const uint64_t address = uint64_t(uintptr_t(p_ptr));
+	if (address >> ADDRESS_BITS) {
+		return false;
+	}
+	const std::atomic<uint64_t> *bits = chunk_map[address >> CHUNK_MAP_SHIFT].load(std::memory_order_acquire);
+	if (!bits) {
+		return false;
+	}
+	const uint32_t index = uint32_t(address >> CHUNK_SHIFT) & (CHUNK_BITS_SIZE * 64 - 1);
+	return bits[index / 64].load(std::memory_order_relaxed) & (uint64_t(1) << (index % 64));
+}
+
+size_t SmallAllocator::get_block_size(const void *p_ptr) {
+	return get_chunk(p_ptr)->block_size;
+}
+
+uint64_t SmallAllocator::get_used_bytes() {
+	int64_t used = retired_used_bytes.load(std::memory_order_relaxed);
+	heaps_lock.lock();
+	for (const ThreadHeap *heap = heaps; heap; heap = heap->next_heap) {
+		used += heap->used_bytes.load(std::memory_order_relaxed);
+	}
+	heaps_lock.unlock();
+	return used > 0 ? uint64_t(used) : 0;
+}
+
+uint64_t SmallAllocator::get_reserved_bytes() {
+	return reserved_bytes.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,66 @@
+/**************************************************************************/
+/*  small_allocator.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SMALL_ALLOCATOR_H
+#define SMALL_ALLOCATOR_H
+
+#include "core/typedefs.h"
+
+// Thread caching allocator for small blocks, used by Memory when the engine
+// is built with `small_allocator=yes`.
+//
+// Blocks are carved from 64 KiB chunks, each holding a single size class and
+// owned by one thread, which allocates and frees from it without locking.
+// Blocks freed by other threads are pushed to a lock-free list in their chunk
+// and collected by the owner when it runs out of blocks. Chunks of exiting
+// threads are handed over to the next thread needing that size class.
+//
+// Chunks are kept once allocated, so memory isn't returned to the system.
+class SmallAllocator {
+public:
+	static constexpr size_t MAX_SIZE = 512;
+	static constexpr uint32_t SIZE_CLASS_COUNT = 16;
+
+	// Returns nullptr if the size is too large or memory couldn't be allocated.
+	static void *alloc(size_t p_bytes);
+	static void free(void *p_ptr);
+
+	// Whether the pointer was returned by alloc(). Can be called with any pointer.
+	static bool owns(const void *p_ptr);
+	// Usable size of a block returned by alloc().
+	static size_t get_block_size(const void *p_ptr);
+
+	// Bytes in blocks currently allocated, including rounding to their size class.
+	static uint64_t get_used_bytes();
+	// Bytes reserved from the system for chunks.
+	static uint64_t get_reserved_bytes();
+};
+
+#endif // SMALL_ALLOCATOR_H
@@ -32,28 +32,72 @@
 
 #include <string.h>
 
+template <typename T>
+void StringBuilder::_append_characters(const T *p_src, uint32_t p_length) {
+	string_length += p_length;
+	appended_count++;
+
+	while (p_length > 0) {
+		if (chunks.is_empty() || !chunks[chunks.size() - 1].string.is_empty() || chunks[chunks.size() - 1].characters.size() == CHUNK_SIZE) {
+			chunks.push_back(Chunk());
+			chunks[chunks.size() - 1].characters.reserve(CHUNK_SIZE);
+		}
+
+		LocalVector<char32_t> &characters = chunks[chunks.size() - 1].characters;
+		uint32_t size = characters.size();
+		uint32_t count = MIN(CHUNK_SIZE - size, p_length);
+		characters.resize(size + count);
+
+		char32_t *dst = characters.ptr() + size;
+		for (uint32_t i = 0; i < count; i++) {
+			dst[i] = p_src[i];
+		}
+
+		p_src += count;
+		p_length -= count;
+	}
+}
+
 StringBuilder &StringBuilder::append(const String &p_string) {
-	if (p_string.is_empty()) {
+	int length = p_string.length();
+	if (length == 0) {
 		return *this;
 	}
 
-	strings.push_back(p_string);
-	appended_strings.push_back(-1);
+	if (length < REFERENCE_MIN_LENGTH) {
+		return append(p_string.ptr(), length);
+	}
+
+	Chunk chunk;
+	chunk.string = p_string;
+	chunks.push_back(chunk);
 
-	string_length += p_string.length();
+	string_length += length;
+	appended_count++;
 
 	return *this;
 }
 
 StringBuilder &StringBuilder::append(const char *p_cstring) {
-	int32_t len = strlen(p_cstring);
+	_append_characters((const uint8_t *)p_cstring, strlen(p_cstring));
+	return *this;
+}
 
-	c_strings.push_back(p_cstring);
-	appended_strings.push_back(len);
+StringBuilder &StringBuilder::append(const char32_t *p_string, int p_length) {
+	if (p_length > 0) {
+		_append_characters(p_string, p_length);
+	}
+	return *this;
+}
 
-	string_length += len;
+StringBuilder &StringBuilder::append(char32_t p_char) {
+	return append(&p_char, 1);
+}
 
-	return *this;
+void StringBuilder::clear() {
+	chunks.clear();
+	string_length = 0;
+	appended_count = 0;
 }
 
 String StringBuilder::as_string() const {
@@ -61,39 +105,24 @@ String StringBuilder::as_string() const {
 		return "";
 	}
 
-	char32_t *buffer = memnew_arr(char32_t, string_length);
-
-	int current_position = 0;
-
-	int godot_string_elem = 0;
-	int c_string_elem = 0;
-
-	for (int i = 0; i < appended_strings.size(); i++) {
-		if (appended_strings[i] == -1) {
-			// Godot string
-			const String &s = strings[godot_string_elem];
-
-			memcpy(buffer + current_position, s.ptr(), s.length() * sizeof(char32_t));
+	if (chunks.size() == 1 && !chunks[0].string.is_empty()) {
+		return chunks[0].string;
+	}
 
-			current_position += s.length();
+	String final_string;
+	final_string.resize(string_length + 1);
+	char32_t *buffer = final_string.ptrw();
 
-			godot_string_elem++;
+	for (const Chunk &chunk : chunks) {
+		if (!chunk.string.is_empty()) {
+			memcpy(buffer, chunk.string.ptr(), chunk.string.length() * sizeof(char32_t));
+			buffer += chunk.string.length();
 		} else {
-			const char *s = c_strings[c_string_elem];
-
-			for (int32_t j = 0; j < appended_strings[i]; j++) {
-				buffer[current_position + j] = s[j];
-			}
-
-			current_position += appended_strings[i];
-
-			c_string_elem++;
+			memcpy(buffer, chunk.characters.ptr(), chunk.characters.size() * sizeof(char32_t));
+			buffer += chunk.characters.size();
 		}
 	}
-
-	String final_string = String(buffer, string_length);
-
-	memdelete_arr(buffer);
+	*buffer = 0;
 
 	return final_string;
 }
@@ -32,21 +32,34 @@
 #define STRING_BUILDER_H
 
 #include "core/string/ustring.h"
-#include "core/templates/vector.h"
+#include "core/templates/local_vector.h"
 
+// Rope used to assemble a String from many pieces. Short pieces are copied
+// into fixed size chunks, so appending never moves what was already written,
+// and long Strings are referenced instead of copied. The final String is
+// allocated once, in as_string().
 class StringBuilder {
-	uint32_t string_length = 0;
+	static constexpr uint32_t CHUNK_SIZE = 1024;
+	// Strings at least this long are referenced instead of copied.
+	static constexpr int REFERENCE_MIN_LENGTH = 256;
+
+	struct Chunk {
+		String string; // Referenced string, if not empty.
+		LocalVector<char32_t> characters; // Copied characters otherwise.
+	};
 
-	Vector<String> strings;
-	Vector<const char *> c_strings;
+	LocalVector<Chunk> chunks;
+	uint32_t string_length = 0;
+	int appended_count = 0;
 
-	// -1 means it's a Godot String
-	// a natural number means C string.
-	Vector<int32_t> appended_strings;
+	template <typename T>
+	void _append_characters(const T *p_src, uint32_t p_length);
 
 public:
 	StringBuilder &append(const String &p_string);
 	StringBuilder &append(const char *p_cstring);
+	StringBuilder &append(const char32_t *p_string, int p_length);
+	StringBuilder &append(char32_t p_char);
 
 	_FORCE_INLINE_ StringBuilder &operator+(const String &p_string) {
 		return append(p_string);
@@ -64,14 +77,19 @@ public:
 		append(p_cstring);
 	}
 
+	_FORCE_INLINE_ void operator+=(char32_t p_char) {
+		append(p_char);
+	}
+
 	_FORCE_INLINE_ int num_strings_appended() const {
-		return appended_strings.size();
+		return appended_count;
 	}
 
 	_FORCE_INLINE_ uint32_t get_string_length() const {
 		return string_length;
 	}
 
+	void clear();
 	String as_string() const;
 
 	_FORCE_INLINE_ operator String() const {
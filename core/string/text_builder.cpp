@@ -0,0 +1,69 @@
+/**************************************************************************/
+/*  text_builder.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "text_builder.h"
+
+void TextBuilder::append(const String &p_text) {
+	builder.append(p_text);
+}
+
+void TextBuilder::append_line(const String &p_text) {
+	builder.append(p_text);
+	builder.append('\n');
+}
+
+void TextBuilder::clear() {
+	builder.clear();
+}
+
+int TextBuilder::get_length() const {
+	return builder.get_string_length();
+}
+
+bool TextBuilder::is_empty() const {
+	return builder.get_string_length() == 0;
+}
+
+String TextBuilder::get_text() const {
+	return builder.as_string();
+}
+
+String TextBuilder::to_string() {
+	return builder.as_string();
+}
+
+void TextBuilder::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("append", "text"), &TextBuilder::append);
+	ClassDB::bind_method(D_METHOD("append_line", "text"), &TextBuilder::append_line, DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("clear"), &TextBuilder::clear);
+	ClassDB::bind_method(D_METHOD("get_length"), &TextBuilder::get_length);
+	ClassDB::bind_method(D_METHOD("is_empty"), &TextBuilder::is_empty);
+	ClassDB::bind_method(D_METHOD("get_text"), &TextBuilder::get_text);
+}
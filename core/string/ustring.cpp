@@ -35,6 +35,7 @@
 #include "core/math/math_funcs.h"
 #include "core/os/memory.h"
 #include "core/string/print_string.h"
+#include "core/string/string_builder.h"
 #include "core/string/string_name.h"
 #include "core/string/translation.h"
 #include "core/string/ucaps.h"
@@ -1989,6 +1990,33 @@ CharString String::ascii(bool p_allow_extended) const {
 	return cs;
 }
 
+// Word-at-a-time helpers for the UTF-8 fast paths, most text is plain ASCII.
+#define UTF8_ASCII_BLOCK 8
+
+static _FORCE_INLINE_ bool _utf8_is_ascii_block(const char *p_ptr, bool p_skip_cr) {
+	uint64_t block;
+	memcpy(&block, p_ptr, sizeof(block));
+	if (block & 0x8080808080808080ULL) {
+		return false;
+	}
+	if (p_skip_cr) {
+		// Zero byte test on the block XOR'ed with '\r' in every byte.
+		uint64_t cr = block ^ 0x0d0d0d0d0d0d0d0dULL;
+		if ((cr - 0x0101010101010101ULL) & ~cr & 0x8080808080808080ULL) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static _FORCE_INLINE_ bool _utf32_is_ascii_block(const char32_t *p_ptr) {
+	uint32_t bits = 0;
+	for (int i = 0; i < UTF8_ASCII_BLOCK; i++) {
+		bits |= p_ptr[i];
+	}
+	return bits <= 0x7f;
+}
+
 String String::utf8(const char *p_utf8, int p_len) {
 	String ret;
 	ret.parse_utf8(p_utf8, p_len);
@@ -2018,14 +2046,30 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 		}
 	}
 
+	// Decoding stops at the first NUL byte, find where the data really ends.
+	if (p_len < 0) {
+		p_len = strlen(p_utf8);
+	} else {
+		const char *nul = (const char *)memchr(p_utf8, 0, p_len);
+		if (nul) {
+			p_len = nul - p_utf8;
+		}
+	}
+
 	bool decode_error = false;
 	bool decode_failed = false;
 	{
 		const char *ptrtmp = p_utf8;
-		const char *ptrtmp_limit = p_len >= 0 ? &p_utf8[p_len] : nullptr;
+		const char *ptrtmp_limit = &p_utf8[p_len];
 		int skip = 0;
 		uint8_t c_start = 0;
-		while (ptrtmp != ptrtmp_limit && *ptrtmp) {
+		while (ptrtmp != ptrtmp_limit) {
+			if (skip == 0 && ptrtmp_limit - ptrtmp >= UTF8_ASCII_BLOCK && _utf8_is_ascii_block(ptrtmp, p_skip_cr)) {
+				str_size += UTF8_ASCII_BLOCK;
+				cstr_size += UTF8_ASCII_BLOCK;
+				ptrtmp += UTF8_ASCII_BLOCK;
+				continue;
+			}
 #if CHAR_MIN == 0
 			uint8_t c = *ptrtmp;
 #else
@@ -2104,6 +2148,16 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 		uint8_t c = *p_utf8 >= 0 ? *p_utf8 : uint8_t(256 + *p_utf8);
 #endif
 
+		if (skip == 0 && c < 0x80 && cstr_size >= UTF8_ASCII_BLOCK && _utf8_is_ascii_block(p_utf8, p_skip_cr)) {
+			for (int i = 0; i < UTF8_ASCII_BLOCK; i++) {
+				dst[i] = uint8_t(p_utf8[i]);
+			}
+			dst += UTF8_ASCII_BLOCK;
+			p_utf8 += UTF8_ASCII_BLOCK;
+			cstr_size -= UTF8_ASCII_BLOCK;
+			continue;
+		}
+
 		if (skip == 0) {
 			if (p_skip_cr && c == '\r') {
 				p_utf8++;
@@ -2185,6 +2239,11 @@ CharString String::utf8() const {
 	const char32_t *d = &operator[](0);
 	int fl = 0;
 	for (int i = 0; i < l; i++) {
+		if (d[i] <= 0x7f && i + UTF8_ASCII_BLOCK <= l && _utf32_is_ascii_block(&d[i])) {
+			fl += UTF8_ASCII_BLOCK;
+			i += UTF8_ASCII_BLOCK - 1;
+			continue;
+		}
 		uint32_t c = d[i];
 		if (c <= 0x7f) { // 7 bits.
 			fl += 1;
@@ -2217,6 +2276,14 @@ CharString String::utf8() const {
 #define APPEND_CHAR(m_c) *(cdst++) = m_c
 
 	for (int i = 0; i < l; i++) {
+		if (d[i] <= 0x7f && i + UTF8_ASCII_BLOCK <= l && _utf32_is_ascii_block(&d[i])) {
+			for (int j = 0; j < UTF8_ASCII_BLOCK; j++) {
+				cdst[j] = d[i + j];
+			}
+			cdst += UTF8_ASCII_BLOCK;
+			i += UTF8_ASCII_BLOCK - 1;
+			continue;
+		}
 		uint32_t c = d[i];
 
 		if (c <= 0x7f) { // 7 bits.
@@ -2886,8 +2953,8 @@ done:
 #define READING_EXP 3
 #define READING_DONE 4
 
-double String::to_float(const char *p_str) {
-	return built_in_strtod<char>(p_str);
+double String::to_float(const char *p_str, const char **r_end) {
+	return built_in_strtod<char>(p_str, (char **)r_end);
 }
 
 double String::to_float(const char32_t *p_str, const char32_t **r_end) {
@@ -5321,7 +5388,7 @@ String String::lpad(int min_length, const String &character) const {
 //   "fish %s %d pie" % ["frog", 12]
 // In case of an error, the string returned is the error description and "error" is true.
 String String::sprintf(const Array &values, bool *error) const {
-	String formatted;
+	StringBuilder formatted;
 	char32_t *self = (char32_t *)get_data();
 	bool in_format = false;
 	int value_index = 0;
@@ -5343,7 +5410,7 @@ String String::sprintf(const Array &values, bool *error) const {
 		if (in_format) { // We have % - let's see what else we get.
 			switch (c) {
 				case '%': { // Replace %% with %
-					formatted += chr(c);
+					formatted += c;
 					in_format = false;
 					break;
 				}
@@ -5677,8 +5744,15 @@ String String::sprintf(const Array &values, bool *error) const {
 					show_sign = false;
 					in_decimals = false;
 					break;
-				default:
-					formatted += chr(c);
+				default: {
+					// Copy the text up to the next placeholder at once.
+					const char32_t *run_end = self + 1;
+					while (*run_end && *run_end != '%') {
+						run_end++;
+					}
+					formatted.append(self, run_end - self);
+					self = (char32_t *)run_end - 1;
+				}
 			}
 		}
 	}
@@ -5694,7 +5768,7 @@ String String::sprintf(const Array &values, bool *error) const {
 	if (error) {
 		*error = false;
 	}
-	return formatted;
+	return formatted.as_string();
 }
 
 String String::quote(const String &quotechar) const {
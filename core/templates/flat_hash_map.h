@@ -0,0 +1,545 @@
+/**************************************************************************/
+/*  flat_hash_map.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+/**
+ * A flat HashMap that stores keys and values inline, in insertion order.
+ *
+ * Entries live in a single dense array, so inserting doesn't allocate per
+ * element and iterating walks contiguous memory. They are found through an
+ * open addressing index laid out like a Swiss table: one control byte per slot
+ * holds 7 bits of the hash, and groups of 8 control bytes are compared at
+ * once with word-at-a-time operations before touching any entry.
+ *
+ * Erasing leaves a hole in the entry array, which is compacted on the next
+ * rehash. Unlike HashMap, inserting can move existing entries in memory, so
+ * pointers to keys or values are only valid until the next insertion.
+ */
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class FlatHashMap {
+public:
+	static constexpr uint32_t GROUP_SIZE = 8;
+	static constexpr uint32_t MIN_CAPACITY = GROUP_SIZE;
+	static constexpr uint32_t EMPTY_HASH = 0;
+
+private:
+	static constexpr uint8_t CONTROL_EMPTY = 0x80;
+	static constexpr uint8_t CONTROL_DELETED = 0xfe;
+	static constexpr uint64_t GROUP_LSBS = 0x0101010101010101ULL;
+	static constexpr uint64_t GROUP_MSBS = 0x8080808080808080ULL;
+
+	typedef KeyValue<TKey, TValue> Entry;
+
+	// Dense entries, in insertion order. Holes left by erased entries have an empty hash.
+	Entry *entries = nullptr;
+	uint32_t *entry_hashes = nullptr;
+	uint32_t entries_used = 0;
+	uint32_t num_elements = 0;
+
+	// Index, with one control byte per slot. Slots keep the full hash, so most
+	// mismatches are rejected without reading the entries.
+	struct Slot {
+		uint32_t hash;
+		uint32_t pos;
+	};
+
+	uint8_t *control = nullptr;
+	Slot *slots = nullptr;
+	uint32_t capacity = 0; // Power of two, at least one group.
+	uint32_t slots_used = 0; // Full and deleted slots.
+
+	static _FORCE_INLINE_ uint32_t _get_max_entries(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8;
+	}
+
+	_FORCE_INLINE_ static uint32_t _hash(const TKey &p_key) {
+		uint32_t hash = Hasher::hash(p_key);
+
+		if (unlikely(hash == EMPTY_HASH)) {
+			hash = EMPTY_HASH + 1;
+		}
+
+		return hash;
+	}
+
+	// The index uses a mixed hash, so weak hashes still spread well over groups and control bytes.
+	static _FORCE_INLINE_ uint32_t _index_hash(uint32_t p_hash) {
+		return hash_fmix32(p_hash);
+	}
+
+	static _FORCE_INLINE_ uint8_t _h2(uint32_t p_index_hash) {
+		return p_index_hash & 0x7f;
+	}
+
+	_FORCE_INLINE_ uint64_t _load_group(uint32_t p_group) const {
+		uint64_t group;
+		memcpy(&group, &control[p_group * GROUP_SIZE], sizeof(group));
+#ifdef BIG_ENDIAN_ENABLED
+		group = BSWAP64(group);
+#endif
+		return group;
+	}
+
+	// Bytes equal to p_h2 get their high bit set. May report false positives, which are discarded by comparing hashes.
+	static _FORCE_INLINE_ uint64_t _match(uint64_t p_group, uint8_t p_h2) {
+		uint64_t x = p_group ^ (GROUP_LSBS * p_h2);
+		return (x - GROUP_LSBS) & ~x & GROUP_MSBS;
+	}
+
+	static _FORCE_INLINE_ uint64_t _match_empty(uint64_t p_group) {
+		return p_group & (~p_group << 6) & GROUP_MSBS;
+	}
+
+	static _FORCE_INLINE_ uint64_t _match_empty_or_deleted(uint64_t p_group) {
+		return p_group & (~p_group << 7) & GROUP_MSBS;
+	}
+
+	static _FORCE_INLINE_ uint32_t _first_byte(uint64_t p_mask) {
+#if defined(__GNUC__)
+		return __builtin_ctzll(p_mask) >> 3;
+#else
+		uint32_t byte = 0;
+		while (!(p_mask & 0xff)) {
+			p_mask >>= 8;
+			byte++;
+		}
+		return byte;
+#endif
+	}
+
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_slot) const {
+		if (num_elements == 0) {
+			return false;
+		}
+
+		const uint32_t hash = _hash(p_key);
+		const uint32_t index_hash = _index_hash(hash);
+		const uint8_t h2 = _h2(index_hash);
+		const uint32_t group_mask = capacity / GROUP_SIZE - 1;
+		uint32_t group_index = (index_hash >> 7) & group_mask;
+
+		// Triangular probing visits every group when their count is a power of two.
+		for (uint32_t step = 1;; step++) {
+			const uint64_t group = _load_group(group_index);
+
+			for (uint64_t match = _match(group, h2); match; match &= match - 1) {
+				const uint32_t slot = group_index * GROUP_SIZE + _first_byte(match);
+				if (control[slot] == h2 && slots[slot].hash == hash && Comparator::compare(entries[slots[slot].pos].key, p_key)) {
+					r_slot = slot;
+					return true;
+				}
+			}
+
+			if (_match_empty(group)) {
+				return false;
+			}
+
+			group_index = (group_index + step) & group_mask;
+		}
+	}
+
+	uint32_t _find_free_slot(uint32_t p_index_hash) const {
+		const uint32_t group_mask = capacity / GROUP_SIZE - 1;
+		uint32_t group_index = (p_index_hash >> 7) & group_mask;
+
+		for (uint32_t step = 1;; step++) {
+			const uint64_t free = _match_empty_or_deleted(_load_group(group_index));
+			if (free) {
+				return group_index * GROUP_SIZE + _first_byte(free);
+			}
+			group_index = (group_index + step) & group_mask;
+		}
+	}
+
+	void _index_entry(uint32_t p_pos) {
+		const uint32_t index_hash = _index_hash(entry_hashes[p_pos]);
+		const uint32_t slot = _find_free_slot(index_hash);
+		if (control[slot] == CONTROL_EMPTY) {
+			slots_used++;
+		}
+		control[slot] = _h2(index_hash);
+		slots[slot].hash = entry_hashes[p_pos];
+		slots[slot].pos = p_pos;
+	}
+
+	// Compacts the entries and rebuilds the index with the given capacity.
+	void _rehash(uint32_t p_capacity) {
+		const uint32_t max_entries = _get_max_entries(p_capacity);
+
+		// Entries are moved as raw memory, like other engine containers do.
+		Entry *new_entries = reinterpret_cast<Entry *>(Memory::alloc_static(sizeof(Entry) * max_entries));
+		uint32_t *new_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_entries));
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < entries_used; i++) {
+			if (entry_hashes[i] == EMPTY_HASH) {
+				continue;
+			}
+			memcpy((void *)&new_entries[count], (const void *)&entries[i], sizeof(Entry));
+			new_hashes[count] = entry_hashes[i];
+			count++;
+		}
+
+		if (entries) {
+			Memory::free_static(entries);
+			Memory::free_static(entry_hashes);
+		}
+		entries = new_entries;
+		entry_hashes = new_hashes;
+		entries_used = count;
+
+		if (capacity != p_capacity) {
+			if (control) {
+				Memory::free_static(control);
+				Memory::free_static(slots);
+			}
+			capacity = p_capacity;
+			control = reinterpret_cast<uint8_t *>(Memory::alloc_static(capacity));
+			slots = reinterpret_cast<Slot *>(Memory::alloc_static(sizeof(Slot) * capacity));
+		}
+		memset(control, CONTROL_EMPTY, capacity);
+		slots_used = 0;
+
+		for (uint32_t i = 0; i < entries_used; i++) {
+			_index_entry(i);
+		}
+	}
+
+	static uint32_t _get_capacity_for(uint32_t p_elements) {
+		uint32_t new_capacity = MIN_CAPACITY;
+		while (_get_max_entries(new_capacity) < p_elements) {
+			new_capacity *= 2;
+		}
+		return new_capacity;
+	}
+
+	Entry *_insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t slot = 0;
+		if (_lookup_pos(p_key, slot)) {
+			Entry *entry = &entries[slots[slot].pos];
+			entry->value = p_value;
+			return entry;
+		}
+
+		const uint32_t max_entries = _get_max_entries(capacity);
+		if (entries_used == max_entries || slots_used >= max_entries) {
+			// The key or value may belong to an entry that the rehash moves, so copy them first.
+			const TKey key = p_key;
+			const TValue value = p_value;
+			// Grow if mostly full, otherwise only reclaim erased entries.
+			_rehash(num_elements >= max_entries / 4 * 3 ? _get_capacity_for(num_elements * 2) : capacity);
+			return _insert_new(key, value);
+		}
+
+		return _insert_new(p_key, p_value);
+	}
+
+	Entry *_insert_new(const TKey &p_key, const TValue &p_value) {
+		const uint32_t pos = entries_used++;
+		memnew_placement(&entries[pos], Entry(p_key, p_value));
+		entry_hashes[pos] = _hash(p_key);
+		_index_entry(pos);
+		num_elements++;
+		return &entries[pos];
+	}
+
+	void _erase_slot(uint32_t p_slot) {
+		const uint32_t pos = slots[p_slot].pos;
+		control[p_slot] = CONTROL_DELETED;
+
+		entries[pos].~Entry();
+		entry_hashes[pos] = EMPTY_HASH;
+		num_elements--;
+
+		// Holes at the end of the entries can be reused right away.
+		while (entries_used > 0 && entry_hashes[entries_used - 1] == EMPTY_HASH) {
+			entries_used--;
+		}
+		if (num_elements == 0) {
+			// No entries left, start with a clean index to get rid of deleted slots.
+			memset(control, CONTROL_EMPTY, capacity);
+			slots_used = 0;
+		}
+	}
+
+	_FORCE_INLINE_ uint32_t _next_pos(uint32_t p_pos) const {
+		do {
+			p_pos++;
+		} while (p_pos < entries_used && entry_hashes[p_pos] == EMPTY_HASH);
+		return p_pos;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (num_elements == 0) {
+			return;
+		}
+		for (uint32_t i = 0; i < entries_used; i++) {
+			if (entry_hashes[i] != EMPTY_HASH) {
+				entries[i].~Entry();
+			}
+		}
+		entries_used = 0;
+		num_elements = 0;
+		memset(control, CONTROL_EMPTY, capacity);
+		slots_used = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t slot = 0;
+		bool exists = _lookup_pos(p_key, slot);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return entries[slots[slot].pos].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t slot = 0;
+		bool exists = _lookup_pos(p_key, slot);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return entries[slots[slot].pos].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t slot = 0;
+		if (_lookup_pos(p_key, slot)) {
+			return &entries[slots[slot].pos].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (_lookup_pos(p_key, slot)) {
+			return &entries[slots[slot].pos].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _slot = 0;
+		return _lookup_pos(p_key, _slot);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (!_lookup_pos(p_key, slot)) {
+			return false;
+		}
+		_erase_slot(slot);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_new_capacity) {
+		if (_get_max_entries(capacity) >= p_new_capacity) {
+			return;
+		}
+		_rehash(_get_capacity_for(p_new_capacity));
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return map->entries[pos];
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return &map->entries[pos]; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pos = map->_next_pos(pos);
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pos == b.pos; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pos != b.pos; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map && pos < map->entries_used;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const FlatHashMap *p_map, uint32_t p_pos) {
+			map = p_map;
+			pos = p_pos;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const FlatHashMap *map = nullptr;
+		uint32_t pos = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return map->entries[pos];
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return &map->entries[pos]; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			pos = map->_next_pos(pos);
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pos == b.pos; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pos != b.pos; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map && pos < map->entries_used;
+		}
+
+		_FORCE_INLINE_ Iterator(FlatHashMap *p_map, uint32_t p_pos) {
+			map = p_map;
+			pos = p_pos;
+		}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(map, pos);
+		}
+
+	private:
+		FlatHashMap *map = nullptr;
+		uint32_t pos = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(this, num_elements ? _next_pos(UINT32_MAX) : entries_used);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(this, entries_used);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (!_lookup_pos(p_key, slot)) {
+			return end();
+		}
+		return Iterator(this, slots[slot].pos);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, num_elements ? _next_pos(UINT32_MAX) : entries_used);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(this, entries_used);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t slot = 0;
+		if (!_lookup_pos(p_key, slot)) {
+			return end();
+		}
+		return ConstIterator(this, slots[slot].pos);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t slot = 0;
+		bool exists = _lookup_pos(p_key, slot);
+		CRASH_COND(!exists);
+		return entries[slots[slot].pos].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t slot = 0;
+		if (_lookup_pos(p_key, slot)) {
+			return entries[slots[slot].pos].value;
+		}
+		return _insert(p_key, TValue())->value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		Entry *entry = _insert(p_key, p_value);
+		return Iterator(this, entry - entries);
+	}
+
+	/* Constructors */
+
+	FlatHashMap(const FlatHashMap &p_other) {
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const FlatHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	FlatHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	FlatHashMap() {}
+
+	~FlatHashMap() {
+		clear();
+
+		if (entries != nullptr) {
+			Memory::free_static(entries);
+			Memory::free_static(entry_hashes);
+		}
+		if (control != nullptr) {
+			Memory::free_static(control);
+			Memory::free_static(slots);
+		}
+	}
+};
+
+#endif // FLAT_HASH_MAP_H
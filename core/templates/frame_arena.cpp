@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include <atomic>
+
+namespace {
+
+struct Page {
+	Page *next = nullptr;
+	size_t size = 0; // Usable bytes after the header.
+
+	uint8_t *get_data() {
+		return reinterpret_cast<uint8_t *>(this) + PAGE_HEADER_SIZE;
+	}
+
+	static constexpr size_t PAGE_HEADER_SIZE = 64;
+};
+
+// Size of allocations made through FrameArenaAllocator, stored before them.
+struct AllocationHeader {
+	uint64_t size;
+	uint64_t padding;
+};
+
+static_assert(sizeof(Page) <= Page::PAGE_HEADER_SIZE);
+static_assert(sizeof(AllocationHeader) % alignof(max_align_t) == 0);
+
+struct ThreadArena {
+	Page *first = nullptr;
+	Page *current = nullptr;
+	uint8_t *position = nullptr;
+	uint8_t *end = nullptr;
+	uint8_t *last_allocation = nullptr; // Last allocation made by FrameArenaAllocator.
+	uint64_t allocation_count = 0;
+	uint32_t scope_depth = 0;
+
+	void set_page(Page *p_page, uint8_t *p_position) {
+		current = p_page;
+		position = p_position;
+		end = p_page ? p_page->get_data() + p_page->size : nullptr;
+		last_allocation = nullptr;
+	}
+
+	void *alloc_slow(size_t p_bytes, size_t p_alignment) {
+		// Use the next page if it fits, or insert a new one after the current page.
+		const size_t needed = p_bytes + p_alignment;
+		Page *next = current ? current->next : first;
+		if (!next || next->size < needed) {
+			const size_t size = MAX(FrameArena::PAGE_SIZE - Page::PAGE_HEADER_SIZE, needed);
+			Page *page = static_cast<Page *>(Memory::alloc_static(Page::PAGE_HEADER_SIZE + size));
+			CRASH_COND_MSG(!page, "Out of memory");
+			page->size = size;
+			page->next = next;
+			if (current) {
+				current->next = page;
+			} else {
+				first = page;
+			}
+			next = page;
+		}
+		set_page(next, next->get_data());
+
+		uint8_t *mem = reinterpret_cast<uint8_t *>((uintptr_t(position) + p_alignment - 1) & ~uintptr_t(p_alignment - 1));
+		position = mem + p_bytes;
+		return mem;
+	}
+
+	_FORCE_INLINE_ void *alloc(size_t p_bytes, size_t p_alignment) {
+		allocation_count++;
+		last_allocation = nullptr;
+		if (likely(current)) {
+			uint8_t *mem = reinterpret_cast<uint8_t *>((uintptr_t(position) + p_alignment - 1) & ~uintptr_t(p_alignment - 1));
+			if (likely(mem + p_bytes <= end)) {
+				position = mem + p_bytes;
+				return mem;
+			}
+		}
+		return alloc_slow(p_bytes, p_alignment);
+	}
+
+	~ThreadArena() {
+		Page *page = first;
+		while (page) {
+			Page *next = page->next;
+			Memory::free_static(page);
+			page = next;
+		}
+	}
+};
+
+thread_local ThreadArena thread_arena;
+
+std::atomic<uint64_t> pending_allocation_count;
+std::atomic<uint64_t> frame_allocation_count;
+
+} // namespace
+
+FrameArena::Scope::Scope() {
+	ThreadArena &arena = thread_arena;
+	page = arena.current;
+	position = arena.position;
+	arena.scope_depth++;
+}
+
+FrameArena::Scope::~Scope() {
+	ThreadArena &arena = thread_arena;
+	arena.scope_depth--;
+	if (page) {
+		arena.set_page(static_cast<Page *>(page), position);
+	} else {
+		arena.set_page(arena.first, arena.first ? arena.first->get_data() : nullptr);
+	}
+	pending_allocation_count.fetch_add(arena.allocation_count, std::memory_order_relaxed);
+	arena.allocation_count = 0;
+}
+
+void *FrameArena::alloc(size_t p_bytes, size_t p_alignment) {
+	return thread_arena.alloc(p_bytes, p_alignment);
+}
+
+void FrameArena::begin_frame() {
+	ThreadArena &arena = thread_arena;
+	if (arena.scope_depth == 0) {
+		arena.set_page(arena.first, arena.first ? arena.first->get_data() : nullptr);
+	}
+	frame_allocation_count.store(pending_allocation_count.exchange(0, std::memory_order_relaxed) + arena.allocation_count, std::memory_order_relaxed);
+	arena.allocation_count = 0;
+}
+
+uint64_t FrameArena::get_frame_allocation_count() {
+	return frame_allocation_count.load(std::memory_order_relaxed);
+}
+
+void *FrameArenaAllocator::alloc(size_t p_bytes) {
+	ThreadArena &arena = thread_arena;
+	uint8_t *mem = static_cast<uint8_t *>(arena.alloc(sizeof(AllocationHeader) + p_bytes, alignof(max_align_t)));
+	reinterpret_cast<AllocationHeader *>(mem)->size = p_bytes;
+	arena.last_allocation = mem + sizeof(AllocationHeader);
+	return arena.last_allocation;
+}
+
+void *FrameArenaAllocator::realloc(void *p_ptr, size_t p_bytes) {
+	if (!p_ptr) {
+		return alloc(p_bytes);
+	}
+	ThreadArena &arena = thread_arena;
+	AllocationHeader *header = reinterpret_cast<AllocationHeader *>(static_cast<uint8_t *>(p_ptr) - sizeof(AllocationHeader));
+	if (p_ptr == arena.last_allocation && static_cast<uint8_t *>(p_ptr) + p_bytes <= arena.end) {
+		// Last allocation, grow or shrink in place.
+		header->size = p_bytes;
+		arena.position = static_cast<uint8_t *>(p_ptr) + p_bytes;
+		return p_ptr;
+	}
+	if (p_bytes <= header->size) {
+		return p_ptr;
+	}
+	const size_t old_size = header->size;
+	void *mem = alloc(p_bytes);
+	memcpy(mem, p_ptr, old_size);
+	return mem;
+}
+
+void FrameArenaAllocator::free(void *p_ptr) {
+	ThreadArena &arena = thread_arena;
+	if (p_ptr && p_ptr == arena.last_allocation) {
+		arena.position = static_cast<uint8_t *>(p_ptr) - sizeof(AllocationHeader);
+		arena.last_allocation = nullptr;
+	}
+}
@@ -0,0 +1,78 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "core/os/memory.h"
+#include "core/templates/local_vector.h"
+
+// Linear allocator for transient data, with one arena per thread.
+//
+// Allocating only bumps a pointer, and memory is released all at once.
+// The arena of the main thread is reset at the start of every Main::iteration(),
+// so anything allocated there must not be used after the frame ends.
+// Other threads must release their allocations with a Scope.
+class FrameArena {
+public:
+	static constexpr size_t PAGE_SIZE = 64 * 1024;
+
+	// Rewinds the arena of the current thread to where it was when created.
+	// Containers using the arena must be declared after the scope.
+	class Scope {
+		void *page = nullptr;
+		uint8_t *position = nullptr;
+
+	public:
+		Scope();
+		~Scope();
+	};
+
+	static void *alloc(size_t p_bytes, size_t p_alignment = alignof(max_align_t));
+
+	// Called by Main::iteration() on the main thread. Doesn't reset the arena while a scope is active.
+	static void begin_frame();
+	// Allocations made on all threads during the last frame.
+	static uint64_t get_frame_allocation_count();
+};
+
+// Allocator for LocalVector and List. Growing the last allocation of the thread is done in place,
+// and freeing it gives the memory back, other allocations stay until the arena is rewound.
+class FrameArenaAllocator {
+public:
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_ptr, size_t p_bytes);
+	static void free(void *p_ptr);
+};
+
+template <typename T, typename U = uint32_t, bool force_trivial = false>
+using FrameLocalVector = LocalVector<T, U, force_trivial, false, FrameArenaAllocator>;
+
+#endif // FRAME_ARENA_H
@@ -36,10 +36,12 @@
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 
+#include <atomic>
 #include <stdio.h>
 #include <typeinfo>
 
@@ -67,64 +69,99 @@ public:
 	virtual ~RID_AllocBase() {}
 };
 
+// In thread safe mode, looking up RIDs doesn't lock. Chunks never move once allocated,
+// and the array of chunks is only replaced when growing, the old one is kept until destruction
+// so lookups that already loaded it can still use it. Validators are read atomically.
+// Allocating and freeing RIDs still takes the lock.
 template <typename T, bool THREAD_SAFE = false>
 class RID_Alloc : public RID_AllocBase {
-	T **chunks = nullptr;
+	struct Chunk {
+		T *data;
+		std::atomic<uint32_t> *validators;
+	};
+
+	std::atomic<Chunk *> chunks = nullptr;
+	uint32_t chunk_capacity = 0;
+	LocalVector<Chunk *> retired_chunks;
 	uint32_t **free_list_chunks = nullptr;
-	uint32_t **validator_chunks = nullptr;
 
 	uint32_t elements_in_chunk;
-	uint32_t max_alloc = 0;
+	std::atomic<uint32_t> max_alloc = 0;
 	uint32_t alloc_count = 0;
 
 	const char *description = nullptr;
 
 	mutable SpinLock spin_lock;
 
+	// Lookups only need to synchronize with other threads in thread safe mode.
+	static constexpr std::memory_order ACQUIRE = THREAD_SAFE ? std::memory_order_acquire : std::memory_order_relaxed;
+	static constexpr std::memory_order RELEASE = THREAD_SAFE ? std::memory_order_release : std::memory_order_relaxed;
+
+	_FORCE_INLINE_ std::atomic<uint32_t> &_get_validator(uint32_t p_index) const {
+		return chunks.load(ACQUIRE)[p_index / elements_in_chunk].validators[p_index % elements_in_chunk];
+	}
+
+	_FORCE_INLINE_ T *_get_data(uint32_t p_index) const {
+		return &chunks.load(ACQUIRE)[p_index / elements_in_chunk].data[p_index % elements_in_chunk];
+	}
+
+	void _add_chunk() {
+		uint32_t chunk_count = max_alloc.load(std::memory_order_relaxed) / elements_in_chunk;
+		Chunk *chunk_array = chunks.load(std::memory_order_relaxed);
+
+		//grow chunks
+		if (chunk_count == chunk_capacity) {
+			chunk_capacity = chunk_capacity ? chunk_capacity * 2 : 4;
+			Chunk *new_chunk_array = (Chunk *)memalloc(sizeof(Chunk) * chunk_capacity);
+			if (chunk_array) {
+				memcpy(new_chunk_array, chunk_array, sizeof(Chunk) * chunk_count);
+				if (THREAD_SAFE) {
+					retired_chunks.push_back(chunk_array); // May still be in use by lookups.
+				} else {
+					memfree(chunk_array);
+				}
+			}
+			chunk_array = new_chunk_array;
+		}
+
+		chunk_array[chunk_count].data = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
+		chunk_array[chunk_count].validators = (std::atomic<uint32_t> *)memalloc(sizeof(std::atomic<uint32_t>) * elements_in_chunk);
+
+		//grow free lists
+		free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
+		free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+
+		//initialize
+		for (uint32_t i = 0; i < elements_in_chunk; i++) {
+			// Don't initialize chunk.
+			chunk_array[chunk_count].validators[i].store(0xFFFFFFFF, std::memory_order_relaxed);
+			free_list_chunks[chunk_count][i] = alloc_count + i;
+		}
+
+		// Publish the chunk before the new size, lookups check the size first.
+		chunks.store(chunk_array, RELEASE);
+		max_alloc.store(max_alloc.load(std::memory_order_relaxed) + elements_in_chunk, RELEASE);
+	}
+
 	_FORCE_INLINE_ RID _allocate_rid() {
 		if (THREAD_SAFE) {
 			spin_lock.lock();
 		}
 
-		if (alloc_count == max_alloc) {
+		if (alloc_count == max_alloc.load(std::memory_order_relaxed)) {
 			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
-
-			//grow chunks
-			chunks = (T **)memrealloc(chunks, sizeof(T *) * (chunk_count + 1));
-			chunks[chunk_count] = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
-
-			//grow validators
-			validator_chunks = (uint32_t **)memrealloc(validator_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			validator_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
-			//grow free lists
-			free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
-
-			//initialize
-			for (uint32_t i = 0; i < elements_in_chunk; i++) {
-				// Don't initialize chunk.
-				validator_chunks[chunk_count][i] = 0xFFFFFFFF;
-				free_list_chunks[chunk_count][i] = alloc_count + i;
-			}
-
-			max_alloc += elements_in_chunk;
+			_add_chunk();
 		}
 
 		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
 
-		uint32_t free_chunk = free_index / elements_in_chunk;
-		uint32_t free_element = free_index % elements_in_chunk;
-
 		uint32_t validator = (uint32_t)(_gen_id() & 0x7FFFFFFF);
 		CRASH_COND_MSG(validator == 0x7FFFFFFF, "Overflow in RID validator");
 		uint64_t id = validator;
 		id <<= 32;
 		id |= free_index;
 
-		validator_chunks[free_chunk][free_element] = validator;
-
-		validator_chunks[free_chunk][free_element] |= 0x80000000; //mark uninitialized bit
+		_get_validator(free_index).store(validator | 0x80000000, std::memory_order_relaxed); //mark uninitialized bit
 
 		alloc_count++;
 
@@ -135,6 +172,30 @@ class RID_Alloc : public RID_AllocBase {
 		return _make_from_id(id);
 	}
 
+	// Checks that the RID was allocated but not initialized yet.
+	T *_get_uninitialized(const RID &p_rid) {
+		uint64_t id = p_rid.get_id();
+		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+		if (unlikely(p_rid == RID() || idx >= max_alloc.load(ACQUIRE))) {
+			return nullptr;
+		}
+
+		uint32_t validator = uint32_t(id >> 32);
+		uint32_t current = _get_validator(idx).load(std::memory_order_relaxed);
+
+		ERR_FAIL_COND_V_MSG(!(current & 0x80000000), nullptr, "Initializing already initialized RID");
+		ERR_FAIL_COND_V_MSG((current & 0x7FFFFFFF) != validator, nullptr, "Attempting to initialize the wrong RID");
+
+		return _get_data(idx);
+	}
+
+	// Makes the RID visible to lookups, once its data is constructed.
+	void _set_initialized(const RID &p_rid) {
+		uint32_t idx = uint32_t(p_rid.get_id() & 0xFFFFFFFF);
+		std::atomic<uint32_t> &validator = _get_validator(idx);
+		validator.store(validator.load(std::memory_order_relaxed) & 0x7FFFFFFF, RELEASE); //initialized
+	}
+
 public:
 	RID make_rid() {
 		RID rid = _allocate_rid();
@@ -156,96 +217,59 @@ public:
 		if (p_rid == RID()) {
 			return nullptr;
 		}
-		if (THREAD_SAFE) {
-			spin_lock.lock();
+
+		if (unlikely(p_initialize)) {
+			T *ptr = _get_uninitialized(p_rid);
+			if (ptr) {
+				_set_initialized(p_rid);
+			}
+			return ptr;
 		}
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		if (unlikely(idx >= max_alloc.load(ACQUIRE))) {
 			return nullptr;
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
+		Chunk &chunk = chunks.load(ACQUIRE)[idx / elements_in_chunk];
 		uint32_t idx_element = idx % elements_in_chunk;
 
 		uint32_t validator = uint32_t(id >> 32);
+		uint32_t current = chunk.validators[idx_element].load(ACQUIRE);
 
-		if (unlikely(p_initialize)) {
-			if (unlikely(!(validator_chunks[idx_chunk][idx_element] & 0x80000000))) {
-				if (THREAD_SAFE) {
-					spin_lock.unlock();
-				}
-				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
-			}
-
-			if (unlikely((validator_chunks[idx_chunk][idx_element] & 0x7FFFFFFF) != validator)) {
-				if (THREAD_SAFE) {
-					spin_lock.unlock();
-				}
-				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
-			}
-
-			validator_chunks[idx_chunk][idx_element] &= 0x7FFFFFFF; //initialized
-
-		} else if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
-			if ((validator_chunks[idx_chunk][idx_element] & 0x80000000) && validator_chunks[idx_chunk][idx_element] != 0xFFFFFFFF) {
+		if (unlikely(current != validator)) {
+			if ((current & 0x80000000) && current != 0xFFFFFFFF) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
 			}
 			return nullptr;
 		}
 
-		T *ptr = &chunks[idx_chunk][idx_element];
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
-		return ptr;
+		return &chunk.data[idx_element];
 	}
 	void initialize_rid(RID p_rid) {
-		T *mem = get_or_null(p_rid, true);
+		T *mem = _get_uninitialized(p_rid);
 		ERR_FAIL_NULL(mem);
 		memnew_placement(mem, T);
+		_set_initialized(p_rid);
 	}
 	void initialize_rid(RID p_rid, const T &p_value) {
-		T *mem = get_or_null(p_rid, true);
+		T *mem = _get_uninitialized(p_rid);
 		ERR_FAIL_NULL(mem);
 		memnew_placement(mem, T(p_value));
+		_set_initialized(p_rid);
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		if (unlikely(idx >= max_alloc.load(ACQUIRE))) {
 			return false;
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
-
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (validator != 0x7FFFFFFF) && (validator_chunks[idx_chunk][idx_element] & 0x7FFFFFFF) == validator;
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
-		return owned;
+		return (validator != 0x7FFFFFFF) && (_get_validator(idx).load(ACQUIRE) & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
@@ -255,31 +279,30 @@ public:
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
+		if (unlikely(idx >= max_alloc.load(std::memory_order_relaxed))) {
 			if (THREAD_SAFE) {
 				spin_lock.unlock();
 			}
 			ERR_FAIL();
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
+		std::atomic<uint32_t> &current = _get_validator(idx);
 
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(validator_chunks[idx_chunk][idx_element] & 0x80000000)) {
+		if (unlikely(current.load(std::memory_order_relaxed) & 0x80000000)) {
 			if (THREAD_SAFE) {
 				spin_lock.unlock();
 			}
 			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID.");
-		} else if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
+		} else if (unlikely(current.load(std::memory_order_relaxed) != validator)) {
 			if (THREAD_SAFE) {
 				spin_lock.unlock();
 			}
 			ERR_FAIL();
 		}
 
-		chunks[idx_chunk][idx_element].~T();
-		validator_chunks[idx_chunk][idx_element] = 0xFFFFFFFF; // go invalid
+		current.store(0xFFFFFFFF, RELEASE); // go invalid
+		_get_data(idx)->~T();
 
 		alloc_count--;
 		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
@@ -296,8 +319,8 @@ public:
 		if (THREAD_SAFE) {
 			spin_lock.lock();
 		}
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+		for (size_t i = 0; i < max_alloc.load(std::memory_order_relaxed); i++) {
+			uint64_t validator = _get_validator(i).load(std::memory_order_relaxed);
 			if (validator != 0xFFFFFFFF) {
 				p_owned->push_back(_make_from_id((validator << 32) | i));
 			}
@@ -313,8 +336,8 @@ public:
 			spin_lock.lock();
 		}
 		uint32_t idx = 0;
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+		for (size_t i = 0; i < max_alloc.load(std::memory_order_relaxed); i++) {
+			uint64_t validator = _get_validator(i).load(std::memory_order_relaxed);
 			if (validator != 0xFFFFFFFF) {
 				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
 				idx++;
@@ -334,32 +357,36 @@ public:
 	}
 
 	~RID_Alloc() {
+		uint32_t total = max_alloc.load(std::memory_order_relaxed);
 		if (alloc_count) {
 			print_error(vformat("ERROR: %d RID allocations of type '%s' were leaked at exit.",
 					alloc_count, description ? description : typeid(T).name()));
 
-			for (size_t i = 0; i < max_alloc; i++) {
-				uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+			for (size_t i = 0; i < total; i++) {
+				uint64_t validator = _get_validator(i).load(std::memory_order_relaxed);
 				if (validator & 0x80000000) {
 					continue; //uninitialized
 				}
 				if (validator != 0xFFFFFFFF) {
-					chunks[i / elements_in_chunk][i % elements_in_chunk].~T();
+					_get_data(i)->~T();
 				}
 			}
 		}
 
-		uint32_t chunk_count = max_alloc / elements_in_chunk;
+		Chunk *chunk_array = chunks.load(std::memory_order_relaxed);
+		uint32_t chunk_count = total / elements_in_chunk;
 		for (uint32_t i = 0; i < chunk_count; i++) {
-			memfree(chunks[i]);
-			memfree(validator_chunks[i]);
+			memfree(chunk_array[i].data);
+			memfree(chunk_array[i].validators);
 			memfree(free_list_chunks[i]);
 		}
 
-		if (chunks) {
-			memfree(chunks);
+		if (chunk_array) {
+			memfree(chunk_array);
 			memfree(free_list_chunks);
-			memfree(validator_chunks);
+		}
+		for (Chunk *retired : retired_chunks) {
+			memfree(retired);
 		}
 	}
 };
@@ -30,7 +30,7 @@
 
 #include "dictionary.h"
 
-#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 // required in this order by VariantInternal, do not remove this comment.
@@ -39,80 +39,384 @@
 #include "core/variant/type_info.h"
 #include "core/variant/variant_internal.h"
 
+// Compact storage, similar to the one used by Python dicts. Entries are kept in
+// pages and found through a small open addressing index of hashes and positions,
+// so there is no allocation per element.
+//
+// Entries never move while they are in the dictionary, so references returned by
+// operator[] or getptr() stay valid until their key is erased. Erased entries are
+// kept in a free list and reused by later inserts, and the insertion order is kept
+// by linking the entries to each other.
 struct DictionaryPrivate {
+	static constexpr uint32_t PAGE_MIN_SHIFT = 2;
+	static constexpr uint32_t PAGE_MIN_SIZE = 1 << PAGE_MIN_SHIFT;
+	static constexpr uint32_t INDEX_MIN_CAPACITY = 8;
+	static constexpr uint32_t EMPTY_HASH = 0;
+	static constexpr uint32_t EMPTY_SLOT = 0;
+	static constexpr uint32_t DELETED_SLOT = UINT32_MAX;
+	static constexpr uint32_t NO_POS = UINT32_MAX;
+
+	struct Entry {
+		Variant key;
+		Variant value;
+		uint32_t hash = EMPTY_HASH; // Erased entries have an empty hash.
+		uint32_t prev = NO_POS;
+		uint32_t next = NO_POS; // Next entry in insertion order, or in the free list when erased.
+		StringName name; // Set when the key was given as a StringName, which makes lookups with it a pointer comparison.
+	};
+
+	struct Slot {
+		uint32_t hash;
+		uint32_t pos; // Entry position plus one, or EMPTY_SLOT / DELETED_SLOT.
+	};
+
 	SafeRefCount refcount;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> variant_map;
-};
 
-void Dictionary::get_key_list(List<Variant> *p_keys) const {
-	if (_p->variant_map.is_empty()) {
-		return;
+	LocalVector<Entry *> pages;
+	uint32_t entries_capacity = 0;
+	uint32_t entries_used = 0; // Entries ever handed out, erased ones included.
+	uint32_t num_entries = 0;
+	uint32_t first_entry = NO_POS;
+	uint32_t last_entry = NO_POS;
+	uint32_t free_entry = NO_POS;
+	bool in_order = true; // No erased entry was reused, so positions follow the insertion order.
+
+	Slot *index = nullptr;
+	uint32_t index_capacity = 0; // Power of two.
+	uint32_t index_used = 0; // Full and deleted slots.
+
+	static _FORCE_INLINE_ uint32_t _get_page(uint32_t p_pos) {
+		const uint32_t x = (p_pos >> PAGE_MIN_SHIFT) + 1;
+#if defined(__GNUC__)
+		return 31 - __builtin_clz(x);
+#else
+		return nearest_shift(x) - 1;
+#endif
 	}
 
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		p_keys->push_back(E.key);
+	_FORCE_INLINE_ Entry &get_entry(uint32_t p_pos) const {
+		const uint32_t page = _get_page(p_pos);
+		return pages[page][p_pos + PAGE_MIN_SIZE - (PAGE_MIN_SIZE << page)];
 	}
-}
 
-Variant Dictionary::get_key_at_index(int p_index) const {
-	int index = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		if (index == p_index) {
-			return E.key;
+	static _FORCE_INLINE_ uint32_t hash_key(const Variant &p_key) {
+		const uint32_t hash = p_key.hash();
+		return hash == EMPTY_HASH ? EMPTY_HASH + 1 : hash;
+	}
+
+	static _FORCE_INLINE_ bool _compare(const Entry &p_entry, const Variant &p_key) {
+		if (p_key.get_type() == Variant::STRING_NAME) {
+			const StringName *sn = VariantInternal::get_string_name(&p_key);
+			if (p_entry.name.data_unique_pointer() && p_entry.name == *sn) {
+				return true;
+			}
 		}
-		index++;
+		return StringLikeVariantComparator::compare(p_entry.key, p_key);
 	}
 
-	return Variant();
-}
+	// Returns the slot holding the key, or -1.
+	int64_t find_slot(const Variant &p_key, uint32_t p_hash) const {
+		if (num_entries == 0) {
+			return -1;
+		}
+		const uint32_t mask = index_capacity - 1;
+		for (uint32_t slot = hash_fmix32(p_hash) & mask;; slot = (slot + 1) & mask) {
+			const Slot &s = index[slot];
+			if (s.pos == EMPTY_SLOT) {
+				return -1;
+			}
+			if (s.hash == p_hash && s.pos != DELETED_SLOT && _compare(get_entry(s.pos - 1), p_key)) {
+				return slot;
+			}
+		}
+	}
 
-Variant Dictionary::get_value_at_index(int p_index) const {
-	int index = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		if (index == p_index) {
-			return E.value;
+	Entry *find(const Variant &p_key) const {
+		const int64_t slot = find_slot(p_key, hash_key(p_key));
+		return slot < 0 ? nullptr : &get_entry(index[slot].pos - 1);
+	}
+
+	int64_t find_pos(const Variant &p_key) const {
+		const int64_t slot = find_slot(p_key, hash_key(p_key));
+		return slot < 0 ? -1 : int64_t(index[slot].pos - 1);
+	}
+
+	void _index_entry(uint32_t p_pos, uint32_t p_hash) {
+		const uint32_t mask = index_capacity - 1;
+		uint32_t slot = hash_fmix32(p_hash) & mask;
+		while (index[slot].pos != EMPTY_SLOT && index[slot].pos != DELETED_SLOT) {
+			slot = (slot + 1) & mask;
+		}
+		if (index[slot].pos == EMPTY_SLOT) {
+			index_used++;
 		}
-		index++;
+		index[slot].hash = p_hash;
+		index[slot].pos = p_pos + 1;
 	}
 
-	return Variant();
+	// Rebuilds the index large enough for p_entries, dropping deleted slots.
+	void _rebuild_index(uint32_t p_entries) {
+		uint32_t capacity = INDEX_MIN_CAPACITY;
+		while (capacity / 2 < p_entries) {
+			capacity *= 2;
+		}
+		if (capacity != index_capacity) {
+			if (index) {
+				Memory::free_static(index);
+			}
+			index_capacity = capacity;
+			index = reinterpret_cast<Slot *>(Memory::alloc_static(sizeof(Slot) * index_capacity));
+		}
+		memset(index, 0, sizeof(Slot) * index_capacity);
+		index_used = 0;
+
+		for (uint32_t i = 0; i < entries_used; i++) {
+			const Entry &entry = get_entry(i);
+			if (entry.hash != EMPTY_HASH) {
+				_index_entry(i, entry.hash);
+			}
+		}
+	}
+
+	void _reserve_entries(uint32_t p_entries) {
+		while (entries_capacity < p_entries) {
+			const uint32_t page_size = PAGE_MIN_SIZE << pages.size();
+			pages.push_back(memnew_arr(Entry, page_size));
+			entries_capacity += page_size;
+		}
+	}
+
+	void reserve(uint32_t p_entries) {
+		_reserve_entries(p_entries);
+		if (index_capacity / 2 < p_entries) {
+			_rebuild_index(p_entries);
+		}
+	}
+
+	// Links the entry at p_pos as the last one in insertion order.
+	_FORCE_INLINE_ void _link_last(Entry &p_entry, uint32_t p_pos) {
+		p_entry.prev = last_entry;
+		p_entry.next = NO_POS;
+		if (last_entry == NO_POS) {
+			first_entry = p_pos;
+		} else {
+			get_entry(last_entry).next = p_pos;
+		}
+		last_entry = p_pos;
+	}
+
+	// Returns the entry for the key, appending it with a null value if missing.
+	Entry &insert(const Variant &p_key) {
+		const uint32_t hash = hash_key(p_key);
+		const int64_t slot = find_slot(p_key, hash);
+		if (slot >= 0) {
+			Entry &entry = get_entry(index[slot].pos - 1);
+			if (p_key.get_type() == Variant::STRING_NAME && !entry.name.data_unique_pointer()) {
+				entry.name = *VariantInternal::get_string_name(&p_key);
+			}
+			return entry;
+		}
+		return _append(p_key, hash);
+	}
+
+	Entry &_append(const Variant &p_key, uint32_t p_hash) {
+		if ((index_used + 1) * 4 > index_capacity * 3) {
+			_rebuild_index(num_entries + 1);
+		}
+
+		uint32_t pos;
+		if (free_entry != NO_POS) {
+			pos = free_entry;
+			free_entry = get_entry(pos).next;
+			in_order = false;
+		} else {
+			_reserve_entries(entries_used + 1);
+			pos = entries_used++;
+		}
+		Entry &entry = get_entry(pos);
+		if (p_key.get_type() == Variant::STRING_NAME) {
+			// Keys are stored as String, so they can be found with either type.
+			entry.name = *VariantInternal::get_string_name(&p_key);
+			entry.key = String(entry.name);
+		} else {
+			entry.key = p_key;
+		}
+		entry.hash = p_hash;
+		_link_last(entry, pos);
+		_index_entry(pos, p_hash);
+		num_entries++;
+		return entry;
+	}
+
+	bool erase(const Variant &p_key) {
+		const int64_t slot = find_slot(p_key, hash_key(p_key));
+		if (slot < 0) {
+			return false;
+		}
+
+		const uint32_t pos = index[slot].pos - 1;
+		Entry &entry = get_entry(pos);
+		if (entry.prev == NO_POS) {
+			first_entry = entry.next;
+		} else {
+			get_entry(entry.prev).next = entry.next;
+		}
+		if (entry.next == NO_POS) {
+			last_entry = entry.prev;
+		} else {
+			get_entry(entry.next).prev = entry.prev;
+		}
+
+		entry.key = Variant();
+		entry.value = Variant();
+		entry.name = StringName();
+		entry.hash = EMPTY_HASH;
+		entry.prev = NO_POS;
+		entry.next = free_entry;
+		free_entry = pos;
+		index[slot].pos = DELETED_SLOT;
+		num_entries--;
+
+		if (num_entries == 0) {
+			_reset();
+		}
+		return true;
+	}
+
+	// Forgets all entries, which must already be erased.
+	void _reset() {
+		entries_used = 0;
+		first_entry = NO_POS;
+		last_entry = NO_POS;
+		free_entry = NO_POS;
+		in_order = true;
+		if (index) {
+			memset(index, 0, sizeof(Slot) * index_capacity);
+		}
+		index_used = 0;
+	}
+
+	_FORCE_INLINE_ uint32_t next_pos(uint32_t p_pos) const {
+		return get_entry(p_pos).next;
+	}
+
+	_FORCE_INLINE_ uint32_t first_pos() const {
+		return first_entry;
+	}
+
+	// Returns the position of the entry at p_index in insertion order.
+	uint32_t pos_at(uint32_t p_index) const {
+		if (in_order && entries_used == num_entries) {
+			return p_index;
+		}
+		uint32_t pos;
+		if (p_index < num_entries / 2) {
+			pos = first_entry;
+			for (uint32_t i = 0; i < p_index; i++) {
+				pos = get_entry(pos).next;
+			}
+		} else {
+			pos = last_entry;
+			for (uint32_t i = num_entries - 1; i > p_index; i--) {
+				pos = get_entry(pos).prev;
+			}
+		}
+		return pos;
+	}
+
+	// Calls p_func with every entry, in insertion order.
+	template <typename F>
+	_FORCE_INLINE_ void for_each(F p_func) const {
+		for (uint32_t pos = first_entry; pos != NO_POS;) {
+			const Entry &entry = get_entry(pos);
+			pos = entry.next;
+			p_func(entry);
+		}
+	}
+
+	void clear() {
+		for (uint32_t i = 0; i < entries_used; i++) {
+			Entry &entry = get_entry(i);
+			entry.key = Variant();
+			entry.value = Variant();
+			entry.name = StringName();
+			entry.hash = EMPTY_HASH;
+		}
+		num_entries = 0;
+		_reset();
+	}
+
+	// Copies all entries, reusing their hashes instead of computing them again.
+	void copy_from(const DictionaryPrivate &p_from) {
+		_reserve_entries(p_from.num_entries);
+		p_from.for_each([&](const Entry &p_entry) {
+			const uint32_t pos = entries_used++;
+			Entry &entry = get_entry(pos);
+			entry.key = p_entry.key;
+			entry.value = p_entry.value;
+			entry.hash = p_entry.hash;
+			entry.name = p_entry.name;
+			_link_last(entry, pos);
+		});
+		num_entries = entries_used;
+		_rebuild_index(num_entries);
+	}
+
+	~DictionaryPrivate() {
+		for (Entry *page : pages) {
+			memdelete_arr(page);
+		}
+		if (index) {
+			Memory::free_static(index);
+		}
+	}
+};
+
+void Dictionary::get_key_list(List<Variant> *p_keys) const {
+	_p->for_each([&](const DictionaryPrivate::Entry &p_entry) {
+		p_keys->push_back(p_entry.key);
+	});
+}
+
+Variant Dictionary::get_key_at_index(int p_index) const {
+	if (p_index < 0 || p_index >= (int)_p->num_entries) {
+		return Variant();
+	}
+	return _p->get_entry(_p->pos_at(p_index)).key;
+}
+
+Variant Dictionary::get_value_at_index(int p_index) const {
+	if (p_index < 0 || p_index >= (int)_p->num_entries) {
+		return Variant();
+	}
+	return _p->get_entry(_p->pos_at(p_index)).value;
 }
 
 Variant &Dictionary::operator[](const Variant &p_key) {
 	if (unlikely(_p->read_only)) {
-		if (p_key.get_type() == Variant::STRING_NAME) {
-			const StringName *sn = VariantInternal::get_string_name(&p_key);
-			const String &key = sn->operator String();
-			if (likely(_p->variant_map.has(key))) {
-				*_p->read_only = _p->variant_map[key];
-			} else {
-				*_p->read_only = Variant();
-			}
-		} else if (likely(_p->variant_map.has(p_key))) {
-			*_p->read_only = _p->variant_map[p_key];
+		const DictionaryPrivate::Entry *E = _p->find(p_key);
+		if (likely(E)) {
+			*_p->read_only = E->value;
 		} else {
 			*_p->read_only = Variant();
 		}
 
 		return *_p->read_only;
 	} else {
-		if (p_key.get_type() == Variant::STRING_NAME) {
-			const StringName *sn = VariantInternal::get_string_name(&p_key);
-			return _p->variant_map[sn->operator String()];
-		} else {
-			return _p->variant_map[p_key];
-		}
+		return _p->insert(p_key).value;
 	}
 }
 
 const Variant &Dictionary::operator[](const Variant &p_key) const {
 	// Will not insert key, so no conversion is necessary.
-	return _p->variant_map[p_key];
+	const DictionaryPrivate::Entry *E = _p->find(p_key);
+	CRASH_COND(!E);
+	return E->value;
 }
 
 const Variant *Dictionary::getptr(const Variant &p_key) const {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(p_key));
+	const DictionaryPrivate::Entry *E = _p->find(p_key);
 	if (!E) {
 		return nullptr;
 	}
@@ -120,7 +424,7 @@ const Variant *Dictionary::getptr(const Variant &p_key) const {
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E(_p->variant_map.find(p_key));
+	DictionaryPrivate::Entry *E = _p->find(p_key);
 	if (!E) {
 		return nullptr;
 	}
@@ -133,7 +437,7 @@ Variant *Dictionary::getptr(const Variant &p_key) {
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(p_key));
+	const DictionaryPrivate::Entry *E = _p->find(p_key);
 
 	if (!E) {
 		return Variant();
@@ -160,15 +464,15 @@ Variant Dictionary::get_or_add(const Variant &p_key, const Variant &p_default) {
 }
 
 int Dictionary::size() const {
-	return _p->variant_map.size();
+	return _p->num_entries;
 }
 
 bool Dictionary::is_empty() const {
-	return !_p->variant_map.size();
+	return !_p->num_entries;
 }
 
 bool Dictionary::has(const Variant &p_key) const {
-	return _p->variant_map.has(p_key);
+	return _p->find(p_key) != nullptr;
 }
 
 bool Dictionary::has_all(const Array &p_keys) const {
@@ -181,7 +485,8 @@ bool Dictionary::has_all(const Array &p_keys) const {
 }
 
 Variant Dictionary::find_key(const Variant &p_value) const {
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
+	for (uint32_t pos = _p->first_pos(); pos != DictionaryPrivate::NO_POS; pos = _p->next_pos(pos)) {
+		const DictionaryPrivate::Entry &E = _p->get_entry(pos);
 		if (E.value == p_value) {
 			return E.key;
 		}
@@ -191,7 +496,7 @@ Variant Dictionary::find_key(const Variant &p_value) const {
 
 bool Dictionary::erase(const Variant &p_key) {
 	ERR_FAIL_COND_V_MSG(_p->read_only, false, "Dictionary is in read-only state.");
-	return _p->variant_map.erase(p_key);
+	return _p->erase(p_key);
 }
 
 bool Dictionary::operator==(const Dictionary &p_dictionary) const {
@@ -207,7 +512,7 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 	if (_p == p_dictionary._p) {
 		return true;
 	}
-	if (_p->variant_map.size() != p_dictionary._p->variant_map.size()) {
+	if (_p->num_entries != p_dictionary._p->num_entries) {
 		return false;
 	}
 
@@ -217,9 +522,17 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 		return true;
 	}
 	recursion_count++;
-	for (const KeyValue<Variant, Variant> &this_E : _p->variant_map) {
-		HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator other_E(p_dictionary._p->variant_map.find(this_E.key));
-		if (!other_E || !this_E.value.hash_compare(other_E->value, recursion_count, false)) {
+	for (uint32_t i = 0; i < _p->entries_used; i++) {
+		const DictionaryPrivate::Entry &this_E = _p->get_entry(i);
+		if (this_E.hash == DictionaryPrivate::EMPTY_HASH) {
+			continue;
+		}
+		const int64_t other_slot = p_dictionary._p->find_slot(this_E.key, this_E.hash);
+		if (other_slot < 0) {
+			return false;
+		}
+		const DictionaryPrivate::Entry &other_E = p_dictionary._p->get_entry(p_dictionary._p->index[other_slot].pos - 1);
+		if (!this_E.value.hash_compare(other_E.value, recursion_count, false)) {
 			return false;
 		}
 	}
@@ -245,16 +558,20 @@ void Dictionary::_ref(const Dictionary &p_from) const {
 
 void Dictionary::clear() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
-	_p->variant_map.clear();
+	_p->clear();
 }
 
 void Dictionary::merge(const Dictionary &p_dictionary, bool p_overwrite) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Dictionary is in read-only state.");
-	for (const KeyValue<Variant, Variant> &E : p_dictionary._p->variant_map) {
-		if (p_overwrite || !has(E.key)) {
-			operator[](E.key) = E.value;
-		}
+	if (p_dictionary._p == _p) {
+		return;
 	}
+	_p->reserve(_p->num_entries + p_dictionary._p->num_entries);
+	p_dictionary._p->for_each([&](const DictionaryPrivate::Entry &p_entry) {
+		if (p_overwrite || !has(p_entry.key)) {
+			_p->insert(p_entry.key).value = p_entry.value;
+		}
+	});
 }
 
 Dictionary Dictionary::merged(const Dictionary &p_dictionary, bool p_overwrite) const {
@@ -287,66 +604,63 @@ uint32_t Dictionary::recursive_hash(int recursion_count) const {
 	uint32_t h = hash_murmur3_one_32(Variant::DICTIONARY);
 
 	recursion_count++;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		h = hash_murmur3_one_32(E.key.recursive_hash(recursion_count), h);
-		h = hash_murmur3_one_32(E.value.recursive_hash(recursion_count), h);
-	}
+	_p->for_each([&](const DictionaryPrivate::Entry &p_entry) {
+		h = hash_murmur3_one_32(p_entry.key.recursive_hash(recursion_count), h);
+		h = hash_murmur3_one_32(p_entry.value.recursive_hash(recursion_count), h);
+	});
 
 	return hash_fmix32(h);
 }
 
 Array Dictionary::keys() const {
 	Array varr;
-	if (_p->variant_map.is_empty()) {
+	if (_p->num_entries == 0) {
 		return varr;
 	}
 
 	varr.resize(size());
 
 	int i = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		varr[i] = E.key;
+	_p->for_each([&](const DictionaryPrivate::Entry &p_entry) {
+		varr[i] = p_entry.key;
 		i++;
-	}
+	});
 
 	return varr;
 }
 
 Array Dictionary::values() const {
 	Array varr;
-	if (_p->variant_map.is_empty()) {
+	if (_p->num_entries == 0) {
 		return varr;
 	}
 
 	varr.resize(size());
 
 	int i = 0;
-	for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-		varr[i] = E.value;
+	_p->for_each([&](const DictionaryPrivate::Entry &p_entry) {
+		varr[i] = p_entry.value;
 		i++;
-	}
+	});
 
 	return varr;
 }
 
 const Variant *Dictionary::next(const Variant *p_key) const {
+	uint32_t pos = 0;
 	if (p_key == nullptr) {
 		// caller wants to get the first element
-		if (_p->variant_map.begin()) {
-			return &_p->variant_map.begin()->key;
+		pos = _p->first_pos();
+	} else {
+		const int64_t current = _p->find_pos(*p_key);
+		if (current < 0) {
+			return nullptr;
 		}
-		return nullptr;
-	}
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E = _p->variant_map.find(*p_key);
-
-	if (!E) {
-		return nullptr;
+		pos = _p->next_pos(current);
 	}
 
-	++E;
-
-	if (E) {
-		return &E->key;
+	if (pos != DictionaryPrivate::NO_POS) {
+		return &_p->get_entry(pos).key;
 	}
 
 	return nullptr;
@@ -375,13 +689,12 @@ Dictionary Dictionary::recursive_duplicate(bool p_deep, int recursion_count) con
 
 	if (p_deep) {
 		recursion_count++;
-		for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-			n[E.key.recursive_duplicate(true, recursion_count)] = E.value.recursive_duplicate(true, recursion_count);
-		}
+		n._p->reserve(_p->num_entries);
+		_p->for_each([&](const DictionaryPrivate::Entry &p_entry) {
+			n[p_entry.key.recursive_duplicate(true, recursion_count)] = p_entry.value.recursive_duplicate(true, recursion_count);
+		});
 	} else {
-		for (const KeyValue<Variant, Variant> &E : _p->variant_map) {
-			n[E.key] = E.value;
-		}
+		n._p->copy_from(*_p);
 	}
 
 	return n;
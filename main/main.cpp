@@ -34,6 +34,7 @@
 #include "core/core_globals.h"
 #include "core/crypto/crypto.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/frame_timeline.h"
 #include "core/extension/extension_api_dump.h"
 #include "core/extension/gdextension_interface_dump.gen.h"
 #include "core/extension/gdextension_manager.h"
@@ -48,6 +49,7 @@
 #include "core/object/message_queue.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
+#include "core/templates/frame_arena.h"
 #include "core/register_core_types.h"
 #include "core/string/translation.h"
 #include "core/version.h"
@@ -614,6 +616,7 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--fixed-fps <fps>", "Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	print_help_option("--delta-smoothing <enable>", "Enable or disable frame delta smoothing [\"enable\", \"disable\"].\n");
 	print_help_option("--print-fps", "Print the frames per second to the stdout.\n");
+	print_help_option("--trace-file <path>", "Record a timeline of the engine's main loop and threads, and save it to a given file in Chrome trace format (viewable in Perfetto) when the engine quits.\n");
 
 	print_help_title("Standalone tools");
 	print_help_option("-s, --script <script>", "Run a script.\n");
@@ -1661,6 +1664,14 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			disable_vsync = true;
 		} else if (arg == "--print-fps") {
 			print_fps = true;
+		} else if (arg == "--trace-file") {
+			if (N) {
+				FrameTimeline::start(N->get());
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <path> argument for --trace-file <path>.\n");
+				goto error;
+			}
 		} else if (arg == "--profile-gpu") {
 			profile_gpu = true;
 		} else if (arg == "--disable-crash-handler") {
@@ -3944,8 +3955,14 @@ static uint64_t navigation_process_max = 0;
 // will terminate the program. In case of failure, the OS exit code needs
 // to be set explicitly here (defaults to EXIT_SUCCESS).
 bool Main::iteration() {
+	FRAME_TIMELINE_ZONE("Main::iteration");
 	iterating++;
 
+	if (iterating == 1) {
+		// Not nested in another iteration (e.g. progress dialogs), so nothing from the last frame is in use.
+		FrameArena::begin_frame();
+	}
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
@@ -3990,6 +4007,7 @@ bool Main::iteration() {
 	NavigationServer3D::get_singleton()->sync();
 
 	for (int iters = 0; iters < advance.physics_steps; ++iters) {
+		FRAME_TIMELINE_ZONE("Main::iteration physics step");
 		if (Input::get_singleton()->is_using_input_buffering() && agile_input_event_flushing) {
 			Input::get_singleton()->flush_buffered_events();
 		}
@@ -4250,6 +4268,8 @@ void Main::cleanup(bool p_force) {
 
 	EngineDebugger::deinitialize();
 
+	FrameTimeline::finish();
+
 #ifndef _3D_DISABLED
 	if (xr_server) {
 		memdelete(xr_server);
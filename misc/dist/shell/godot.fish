@@ -98,6 +98,7 @@ complete -c godot -l disable-render-loop -d "Disable render loop so rendering on
 complete -c godot -l disable-crash-handler -d "Disable crash handler when supported by the platform code"
 complete -c godot -l fixed-fps -d "Force a fixed number of frames per second (this setting disables real-time synchronization)" -x
 complete -c godot -l print-fps -d "Print the frames per second to the stdout"
+complete -c godot -l trace-file -d "Record a timeline of the engine and save it to a given file in Chrome trace format" -x
 
 # Standalone tools:
 complete -c godot -s s -l script -d "Run a script" -r
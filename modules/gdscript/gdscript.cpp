@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -725,12 +726,46 @@ void GDScript::_restore_old_static_data() {
 
 #endif
 
+#ifdef TOOLS_ENABLED
+// Adds the time spent loading scripts to the `--benchmark` report. Dependencies
+// are loaded while their dependents reload, so only the outermost reload on each
+// thread is measured.
+class GDScriptReloadBenchmark {
+	static thread_local int depth;
+	uint64_t start_usec = 0;
+	bool measuring = false;
+
+public:
+	bool from_cache = false;
+
+	GDScriptReloadBenchmark() {
+		if (depth++ == 0 && OS::get_singleton()->is_use_benchmark_set()) {
+			measuring = true;
+			start_usec = OS::get_singleton()->get_ticks_usec();
+		}
+	}
+
+	~GDScriptReloadBenchmark() {
+		depth--;
+		if (measuring) {
+			OS::get_singleton()->benchmark_add_measure("GDScript", from_cache ? "Load Scripts from Bytecode Cache" : "Parse and Compile Scripts", OS::get_singleton()->get_ticks_usec() - start_usec);
+		}
+	}
+};
+
+thread_local int GDScriptReloadBenchmark::depth = 0;
+#endif
+
 Error GDScript::reload(bool p_keep_state) {
 	if (reloading) {
 		return OK;
 	}
 	reloading = true;
 
+#ifdef TOOLS_ENABLED
+	GDScriptReloadBenchmark benchmark;
+#endif
+
 	bool has_instances;
 	{
 		MutexLock lock(GDScriptLanguage::singleton->mutex);
@@ -786,33 +821,79 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	if (has_instances || valid) {
+		// Reloading a script that was already running, previous cache lookups may be stale.
+		GDScriptBytecodeCache::invalidate(get_script_path());
+	} else if (GDScriptBytecodeCache::load(this) == OK) {
+#ifdef TOOLS_ENABLED
+		benchmark.from_cache = true;
+#endif
+		// Nothing will consume a parser warmed up for this script, release it now.
+		if (!path.is_empty()) {
+			GDScriptCache::take_warmed_parser(path);
+		}
+		if (ScriptServer::is_scripting_enabled() || is_tool()) {
+			Error err = _static_init();
+			if (err) {
+				reloading = false;
+				return err;
+			}
+		}
+#ifdef TOOLS_ENABLED
+		else {
+			_static_default_init();
+		}
+#endif
+		reloading = false;
+		return OK;
+	}
+
 	valid = false;
-	GDScriptParser parser;
-	Error err;
-	if (!binary_tokens.is_empty()) {
-		err = parser.parse_binary(binary_tokens, path);
-	} else {
-		err = parser.parse(source, path, false);
+
+	// A parser warmed up at startup holds the same tree, possibly already analyzed in part
+	// because other scripts depend on this one, so only the remaining steps are left.
+	Ref<GDScriptParserRef> warmed_parser;
+	if (!path.is_empty()) {
+		warmed_parser = GDScriptCache::take_warmed_parser(path);
+		const uint32_t source_hash = binary_tokens.is_empty() ? source.hash() : hash_djb2_buffer(binary_tokens.ptr(), binary_tokens.size());
+		if (warmed_parser.is_valid() && warmed_parser->get_source_hash() != source_hash) {
+			warmed_parser.unref();
+		}
+	}
+
+	GDScriptParser local_parser;
+	GDScriptParser *parser = warmed_parser.is_valid() ? warmed_parser->get_parser() : &local_parser;
+	Error err = OK;
+	if (warmed_parser.is_null()) {
+		if (!binary_tokens.is_empty()) {
+			err = parser->parse_binary(binary_tokens, path);
+		} else {
+			err = parser->parse(source, path, false);
+		}
 	}
 	if (err) {
 		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser->get_errors().front()->get().line, "Parser Error: " + parser->get_errors().front()->get().message);
 		}
 		// TODO: Show all error messages.
-		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser.get_errors().front()->get().line, ("Parse Error: " + parser.get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser->get_errors().front()->get().line, ("Parse Error: " + parser->get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
 		reloading = false;
 		return ERR_PARSE_ERROR;
 	}
 
-	GDScriptAnalyzer analyzer(&parser);
-	err = analyzer.analyze();
+	if (warmed_parser.is_valid()) {
+		err = warmed_parser->raise_status(GDScriptParserRef::FULLY_SOLVED);
+	} else {
+		GDScriptAnalyzer analyzer(parser);
+		err = analyzer.analyze();
+	}
 
 	if (err) {
 		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser->get_errors().front()->get().line, "Parser Error: " + parser->get_errors().front()->get().message);
 		}
 
-		const List<GDScriptParser::ParserError>::Element *e = parser.get_errors().front();
+		const List<GDScriptParser::ParserError>::Element *e = parser->get_errors().front();
 		while (e != nullptr) {
 			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), e->get().line, ("Parse Error: " + e->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
 			e = e->next();
@@ -821,10 +902,10 @@ Error GDScript::reload(bool p_keep_state) {
 		return ERR_PARSE_ERROR;
 	}
 
-	can_run = ScriptServer::is_scripting_enabled() || parser.is_tool();
+	can_run = ScriptServer::is_scripting_enabled() || parser->is_tool();
 
 	GDScriptCompiler compiler;
-	err = compiler.compile(&parser, this, p_keep_state);
+	err = compiler.compile(parser, this, p_keep_state);
 
 	if (err) {
 		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), compiler.get_error_line(), ("Compile Error: " + compiler.get_error()).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
@@ -840,14 +921,16 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 	}
 
+	GDScriptBytecodeCache::save(this, parser);
+
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
-	GDScriptDocGen::generate_docs(this, parser.get_tree());
+	GDScriptDocGen::generate_docs(this, parser->get_tree());
 #endif
 
 #ifdef DEBUG_ENABLED
-	for (const GDScriptWarning &warning : parser.get_warnings()) {
+	for (const GDScriptWarning &warning : parser->get_warnings()) {
 		if (EngineDebugger::is_active()) {
 			Vector<ScriptLanguage::StackInfo> si;
 			EngineDebugger::get_script_debugger()->send_error("", get_script_path(), warning.start_line, warning.get_name(), warning.get_message(), false, ERR_HANDLER_WARNING, si);
@@ -2250,6 +2333,23 @@ void GDScriptLanguage::init() {
 		_add_global(E.name, E.ptr);
 	}
 
+	// Most scripts depend on global classes, so parsing them up front lets that work happen in parallel.
+	if (!Engine::get_singleton()->is_editor_hint() && GLOBAL_GET("gdscript/warm_up/enabled")) {
+		OS::get_singleton()->benchmark_begin_measure("GDScript", "Warm Up Global Classes");
+
+		List<StringName> global_classes;
+		ScriptServer::get_global_class_list(&global_classes);
+		Vector<String> paths;
+		for (const StringName &E : global_classes) {
+			if (ScriptServer::get_global_class_language(E) == get_name()) {
+				paths.push_back(ScriptServer::get_global_class_path(E));
+			}
+		}
+		GDScriptCache::warm_up(paths);
+
+		OS::get_singleton()->benchmark_end_measure("GDScript", "Warm Up Global Classes");
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2869,6 +2969,10 @@ GDScriptLanguage::GDScriptLanguage() {
 
 	int dmcs = GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 
+	GLOBAL_DEF("gdscript/bytecode_cache/enabled", false);
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "gdscript/bytecode_cache/path", PROPERTY_HINT_DIR), "user://.gdscript_cache");
+	GLOBAL_DEF("gdscript/warm_up/enabled", false);
+
 	if (EngineDebugger::is_active()) {
 		//debugging enabled!
 
@@ -0,0 +1,2033 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+#include "gdscript_compiler.h"
+#include "gdscript_function.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/dir_access.h"
+#include "core/io/resource_loader.h"
+#include "core/version.h"
+
+GDScriptBytecodeCache *GDScriptBytecodeCache::singleton = nullptr;
+
+// Increase when the layout of cache entries changes.
+static const uint32_t FORMAT_VERSION = 3;
+static const uint8_t ENTRY_MAGIC[4] = { 'G', 'D', 'B', 'C' };
+
+enum VariantTag : uint8_t {
+	VARIANT_VALUE,
+	VARIANT_ARRAY,
+	VARIANT_DICTIONARY,
+	VARIANT_NULL_OBJECT,
+	VARIANT_NATIVE_CLASS,
+	VARIANT_SCRIPT,
+	VARIANT_RESOURCE,
+};
+
+enum ScriptReference : uint8_t {
+	SCRIPT_NONE,
+	SCRIPT_LOCAL, // Class of the script being (de)serialized, by inner class path.
+	SCRIPT_EXTERNAL, // Class of another GDScript file, by path and inner class path.
+	SCRIPT_RESOURCE, // Script of another language, by path.
+};
+
+/* Writer */
+
+class GDScriptBytecodeCache::Writer {
+public:
+	GDScriptBytecodeCache *cache = nullptr;
+	GDScript *root = nullptr;
+	Ref<StreamPeerBuffer> buffer;
+	HashSet<String> dependencies;
+	String error;
+
+	// Writing continues after an error so all dependencies are still collected.
+	void set_error(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+	}
+
+	template <typename K, typename V>
+	static const V *find_key(const RBMap<K, V> &p_map, const K &p_key) {
+		const typename RBMap<K, V>::Element *E = p_map.find(p_key);
+		return E ? &E->value() : nullptr;
+	}
+
+	void write_bool(bool p_value) {
+		buffer->put_u8(p_value ? 1 : 0);
+	}
+
+	void write_string(const String &p_string) {
+		buffer->put_utf8_string(p_string);
+	}
+
+	void write_ints(const Vector<int> &p_ints) {
+		buffer->put_32(p_ints.size());
+		if (!p_ints.is_empty()) {
+			buffer->put_data((const uint8_t *)p_ints.ptr(), p_ints.size() * sizeof(int));
+		}
+	}
+
+	void write_script(Script *p_script) {
+		if (p_script == nullptr) {
+			buffer->put_u8(SCRIPT_NONE);
+			return;
+		}
+
+		GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+		if (gdscript) {
+			GDScript *script_root = gdscript->get_root_script();
+			const String class_path = gdscript->fully_qualified_name.trim_prefix(script_root->fully_qualified_name);
+			if (script_root == root) {
+				buffer->put_u8(SCRIPT_LOCAL);
+				write_string(class_path);
+				return;
+			}
+			if (script_root->path.is_resource_file()) {
+				dependencies.insert(script_root->path);
+			} else {
+				set_error(vformat(R"(References the script "%s", which has no file path.)", script_root->path));
+			}
+			buffer->put_u8(SCRIPT_EXTERNAL);
+			write_string(script_root->path);
+			write_string(class_path);
+			return;
+		}
+
+		if (!p_script->get_path().is_resource_file()) {
+			set_error(vformat(R"(References a built-in script of type "%s".)", p_script->get_class()));
+		}
+		buffer->put_u8(SCRIPT_RESOURCE);
+		write_string(p_script->get_path());
+	}
+
+	void write_variant(const Variant &p_value) {
+		switch (p_value.get_type()) {
+			case Variant::OBJECT: {
+				Object *object = p_value.get_validated_object();
+				if (object == nullptr) {
+					buffer->put_u8(VARIANT_NULL_OBJECT);
+					return;
+				}
+
+				GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(object);
+				if (native_class) {
+					buffer->put_u8(VARIANT_NATIVE_CLASS);
+					write_string(native_class->get_name());
+					return;
+				}
+
+				Script *script = Object::cast_to<Script>(object);
+				if (script) {
+					buffer->put_u8(VARIANT_SCRIPT);
+					write_script(script);
+					return;
+				}
+
+				Resource *resource = Object::cast_to<Resource>(object);
+				if (resource == nullptr || !resource->get_path().is_resource_file()) {
+					set_error(vformat(R"(Holds a constant of type "%s" that can't be loaded by path.)", object->get_class()));
+				}
+				buffer->put_u8(VARIANT_RESOURCE);
+				write_string(resource ? resource->get_path() : String());
+			} break;
+			case Variant::ARRAY: {
+				const Array array = p_value;
+				buffer->put_u8(VARIANT_ARRAY);
+				write_bool(array.is_read_only());
+				buffer->put_u32(array.get_typed_builtin());
+				write_string(array.get_typed_class_name());
+				write_script(Object::cast_to<Script>(array.get_typed_script().get_validated_object()));
+				buffer->put_32(array.size());
+				for (int i = 0; i < array.size(); i++) {
+					write_variant(array[i]);
+				}
+			} break;
+			case Variant::DICTIONARY: {
+				const Dictionary dictionary = p_value;
+				buffer->put_u8(VARIANT_DICTIONARY);
+				write_bool(dictionary.is_read_only());
+				buffer->put_32(dictionary.size());
+				const Variant *key = nullptr;
+				while ((key = dictionary.next(key))) {
+					write_variant(*key);
+					write_variant(dictionary[*key]);
+				}
+			} break;
+			case Variant::CALLABLE:
+			case Variant::SIGNAL:
+			case Variant::RID: {
+				set_error(vformat(R"(Holds a constant of type "%s".)", Variant::get_type_name(p_value.get_type())));
+				buffer->put_u8(VARIANT_VALUE);
+				buffer->put_var(Variant());
+			} break;
+			default: {
+				buffer->put_u8(VARIANT_VALUE);
+				buffer->put_var(p_value);
+			} break;
+		}
+	}
+
+	void write_data_type(const GDScriptDataType &p_type) {
+		buffer->put_u8(p_type.kind);
+		write_bool(p_type.has_type);
+		buffer->put_u32(p_type.builtin_type);
+		write_string(p_type.native_type);
+		write_script(p_type.script_type);
+		buffer->put_32(p_type.container_element_types.size());
+		for (const GDScriptDataType &element_type : p_type.container_element_types) {
+			write_data_type(element_type);
+		}
+	}
+
+	void write_property_info(const PropertyInfo &p_info) {
+		buffer->put_var(Dictionary(p_info));
+	}
+
+	void write_method_info(const MethodInfo &p_info) {
+		write_string(p_info.name);
+		buffer->put_u32(p_info.flags);
+		buffer->put_32(p_info.id);
+		write_property_info(p_info.return_val);
+		buffer->put_32(p_info.arguments.size());
+		for (const PropertyInfo &argument : p_info.arguments) {
+			write_property_info(argument);
+		}
+		buffer->put_32(p_info.default_arguments.size());
+		for (const Variant &default_argument : p_info.default_arguments) {
+			write_variant(default_argument);
+		}
+	}
+
+	void write_member_info(const GDScript::MemberInfo &p_info) {
+		buffer->put_32(p_info.index);
+		write_string(p_info.setter);
+		write_string(p_info.getter);
+		write_data_type(p_info.data_type);
+		write_property_info(p_info.property_info);
+	}
+
+	void write_function(const GDScriptFunction *p_function) {
+		write_string(p_function->name);
+		write_bool(p_function->_static);
+		buffer->put_32(p_function->_initial_line);
+		buffer->put_32(p_function->_argument_count);
+		buffer->put_32(p_function->_stack_size);
+		buffer->put_32(p_function->_instruction_args_size);
+		write_data_type(p_function->return_type);
+		buffer->put_32(p_function->argument_types.size());
+		for (const GDScriptDataType &argument_type : p_function->argument_types) {
+			write_data_type(argument_type);
+		}
+		write_method_info(p_function->method_info);
+		write_variant(p_function->rpc_config);
+
+		buffer->put_32(p_function->temporary_slots.size());
+		for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+			buffer->put_32(E.key);
+			buffer->put_u32(E.value);
+		}
+
+		write_ints(p_function->code);
+		write_ints(p_function->default_arguments);
+
+		buffer->put_32(p_function->constants.size());
+		for (const Variant &constant : p_function->constants) {
+			write_variant(constant);
+		}
+
+		buffer->put_32(p_function->global_names.size());
+		for (const StringName &global_name : p_function->global_names) {
+			write_string(global_name);
+		}
+
+		// Validated calls are stored by the keys they were looked up with.
+		buffer->put_32(p_function->operator_funcs.size());
+		for (const Variant::ValidatedOperatorEvaluator &E : p_function->operator_funcs) {
+			const OperatorKey *key = find_key(cache->operator_keys, E);
+			if (key == nullptr) {
+				set_error("Uses an unknown operator evaluator.");
+			}
+			buffer->put_u8(key ? key->op : Variant::OP_MAX);
+			buffer->put_u8(key ? key->type_a : Variant::NIL);
+			buffer->put_u8(key ? key->type_b : Variant::NIL);
+		}
+		write_member_keys(p_function->setters, cache->setter_keys, "setter");
+		write_member_keys(p_function->getters, cache->getter_keys, "getter");
+		write_type_keys(p_function->keyed_setters, cache->keyed_setter_keys, "keyed setter");
+		write_type_keys(p_function->keyed_getters, cache->keyed_getter_keys, "keyed getter");
+		write_type_keys(p_function->indexed_setters, cache->indexed_setter_keys, "indexed setter");
+		write_type_keys(p_function->indexed_getters, cache->indexed_getter_keys, "indexed getter");
+		write_member_keys(p_function->builtin_methods, cache->builtin_method_keys, "built-in method");
+
+		buffer->put_32(p_function->constructors.size());
+		for (const Variant::ValidatedConstructor &E : p_function->constructors) {
+			const ConstructorKey *key = find_key(cache->constructor_keys, E);
+			if (key == nullptr) {
+				set_error("Uses an unknown constructor.");
+			}
+			buffer->put_u32(key ? key->type : Variant::NIL);
+			buffer->put_32(key ? key->index : 0);
+		}
+		write_name_keys(p_function->utilities, cache->utility_keys, "utility function");
+		write_name_keys(p_function->gds_utilities, cache->gds_utility_keys, "GDScript utility function");
+
+		buffer->put_32(p_function->methods.size());
+		for (MethodBind *method : p_function->methods) {
+			if (ClassDB::get_method(method->get_instance_class(), method->get_name()) != method) {
+				set_error(vformat(R"(Calls the method "%s" that can't be looked up by name.)", method->get_name()));
+			}
+			write_string(method->get_instance_class());
+			write_string(method->get_name());
+		}
+
+		buffer->put_32(p_function->lambdas.size());
+		for (const GDScriptFunction *lambda : p_function->lambdas) {
+			const GDScript::LambdaInfo *info = lambda->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+			if (info == nullptr || lambda->_script != p_function->_script) {
+				set_error("Has a lambda outside of its class.");
+			}
+			buffer->put_32(info ? info->capture_count : 0);
+			write_bool(info ? info->use_self : false);
+			write_function(lambda);
+		}
+	}
+
+	template <typename T>
+	void write_member_keys(const Vector<T> &p_functions, const RBMap<T, MemberKey> &p_keys, const char *p_what) {
+		buffer->put_32(p_functions.size());
+		for (const T &E : p_functions) {
+			const MemberKey *key = find_key(p_keys, E);
+			if (key == nullptr) {
+				set_error(vformat("Uses an unknown %s.", p_what));
+			}
+			buffer->put_u32(key ? key->type : Variant::NIL);
+			write_string(key ? key->name : StringName());
+		}
+	}
+
+	template <typename T>
+	void write_type_keys(const Vector<T> &p_functions, const RBMap<T, Variant::Type> &p_keys, const char *p_what) {
+		buffer->put_32(p_functions.size());
+		for (const T &E : p_functions) {
+			const Variant::Type *key = find_key(p_keys, E);
+			if (key == nullptr) {
+				set_error(vformat("Uses an unknown %s.", p_what));
+			}
+			buffer->put_u32(key ? *key : Variant::NIL);
+		}
+	}
+
+	template <typename T>
+	void write_name_keys(const Vector<T> &p_functions, const RBMap<T, StringName> &p_keys, const char *p_what) {
+		buffer->put_32(p_functions.size());
+		for (const T &E : p_functions) {
+			const StringName *key = find_key(p_keys, E);
+			if (key == nullptr) {
+				set_error(vformat("Uses an unknown %s.", p_what));
+			}
+			write_string(key ? *key : StringName());
+		}
+	}
+
+	void write_optional_function(const GDScriptFunction *p_function) {
+		write_bool(p_function != nullptr);
+		if (p_function) {
+			write_function(p_function);
+		}
+	}
+
+	void write_class_tree(const GDScript *p_script) {
+		write_string(p_script->local_name);
+		write_string(p_script->global_name);
+		write_string(p_script->simplified_icon_path);
+		buffer->put_32(p_script->subclasses.size());
+		for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+			write_string(E.key);
+			write_string(E.value->fully_qualified_name);
+			write_class_tree(E.value.ptr());
+		}
+	}
+
+	void write_class(const GDScript *p_script) {
+		if (!p_script->valid) {
+			set_error(vformat(R"(The class "%s" isn't compiled.)", p_script->fully_qualified_name));
+		}
+
+		write_bool(p_script->tool);
+		write_string(p_script->native.is_valid() ? p_script->native->get_name() : StringName());
+		write_script(p_script->base.ptr());
+
+		buffer->put_32(p_script->member_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+			write_string(E.key);
+			write_member_info(E.value);
+		}
+		buffer->put_32(p_script->members.size());
+		for (const StringName &E : p_script->members) {
+			write_string(E);
+		}
+		buffer->put_32(p_script->static_variables_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+			write_string(E.key);
+			write_member_info(E.value);
+		}
+		buffer->put_32(p_script->constants.size());
+		for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+			write_string(E.key);
+			write_variant(E.value);
+		}
+		buffer->put_32(p_script->_signals.size());
+		for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+			write_string(E.key);
+			write_method_info(E.value);
+		}
+		write_variant(p_script->rpc_config);
+
+#ifdef TOOLS_ENABLED
+		buffer->put_32(p_script->member_default_values.size());
+		for (const KeyValue<StringName, Variant> &E : p_script->member_default_values) {
+			write_string(E.key);
+			write_variant(E.value);
+		}
+#endif
+
+		buffer->put_32(p_script->member_functions.size());
+		for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+			write_function(E.value);
+		}
+		write_optional_function(p_script->implicit_initializer);
+		write_optional_function(p_script->implicit_ready);
+		write_optional_function(p_script->static_initializer);
+
+		for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+			write_class(E.value.ptr());
+		}
+	}
+};
+
+/* Reader */
+
+class GDScriptBytecodeCache::Reader {
+public:
+	GDScript *root = nullptr;
+	Ref<StreamPeerBuffer> buffer;
+	String error;
+
+	// Returns a default value after the first error, callers check `error` once done.
+	bool set_error(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+		return false;
+	}
+
+	bool read_bool() {
+		return buffer->get_u8() != 0;
+	}
+
+	String read_string() {
+		return buffer->get_utf8_string();
+	}
+
+	void read_ints(Vector<int> &r_ints) {
+		const int size = buffer->get_32();
+		if (size < 0 || size * (int)sizeof(int) > buffer->get_size() - buffer->get_position()) {
+			set_error("Corrupt integer array.");
+			return;
+		}
+		r_ints.resize(size);
+		if (size > 0) {
+			buffer->get_data((uint8_t *)r_ints.ptrw(), size * sizeof(int));
+		}
+	}
+
+	int read_count() {
+		const int count = buffer->get_32();
+		if (count < 0 || count > buffer->get_size() - buffer->get_position()) {
+			set_error("Corrupt element count.");
+			return 0;
+		}
+		return count;
+	}
+
+	Ref<Script> read_script() {
+		switch (buffer->get_u8()) {
+			case SCRIPT_NONE: {
+				return Ref<Script>();
+			}
+			case SCRIPT_LOCAL: {
+				const String class_path = read_string();
+				GDScript *script = root->find_class(class_path);
+				if (script == nullptr) {
+					set_error(vformat(R"(Can't find the inner class "%s".)", class_path));
+				}
+				return Ref<Script>(script);
+			}
+			case SCRIPT_EXTERNAL: {
+				const String path = read_string();
+				const String class_path = read_string();
+				Ref<GDScript> script_root = GDScriptCache::get_cached_script(path);
+				if (script_root.is_null()) {
+					Error err = OK;
+					script_root = GDScriptCache::get_full_script(path, err);
+				}
+				GDScript *script = script_root.is_valid() ? script_root->find_class(class_path) : nullptr;
+				if (script == nullptr) {
+					set_error(vformat(R"(Can't find the class "%s%s".)", path, class_path));
+				}
+				return Ref<Script>(script);
+			}
+			case SCRIPT_RESOURCE: {
+				const String path = read_string();
+				Ref<Script> script = ResourceLoader::load(path);
+				if (script.is_null()) {
+					set_error(vformat(R"(Can't load the script "%s".)", path));
+				}
+				return script;
+			}
+			default: {
+				set_error("Corrupt script reference.");
+				return Ref<Script>();
+			}
+		}
+	}
+
+	Variant read_variant() {
+		switch (buffer->get_u8()) {
+			case VARIANT_VALUE: {
+				return buffer->get_var();
+			}
+			case VARIANT_ARRAY: {
+				const bool read_only = read_bool();
+				const uint32_t typed_builtin = buffer->get_u32();
+				const StringName typed_class_name = read_string();
+				const Ref<Script> typed_script = read_script();
+				Array array;
+				if (typed_builtin != Variant::NIL) {
+					array.set_typed(typed_builtin, typed_class_name, typed_script);
+				}
+				const int size = read_count();
+				array.resize(size);
+				for (int i = 0; i < size; i++) {
+					array[i] = read_variant();
+				}
+				if (read_only) {
+					array.make_read_only();
+				}
+				return array;
+			}
+			case VARIANT_DICTIONARY: {
+				const bool read_only = read_bool();
+				Dictionary dictionary;
+				const int size = read_count();
+				for (int i = 0; i < size; i++) {
+					const Variant key = read_variant();
+					dictionary[key] = read_variant();
+				}
+				if (read_only) {
+					dictionary.make_read_only();
+				}
+				return dictionary;
+			}
+			case VARIANT_NULL_OBJECT: {
+				return Variant((Object *)nullptr);
+			}
+			case VARIANT_NATIVE_CLASS: {
+				const StringName name = read_string();
+				const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(name);
+				if (index == nullptr) {
+					set_error(vformat(R"(Unknown native class "%s".)", name));
+					return Variant();
+				}
+				return GDScriptLanguage::get_singleton()->get_global_array()[*index];
+			}
+			case VARIANT_SCRIPT: {
+				return read_script();
+			}
+			case VARIANT_RESOURCE: {
+				const String path = read_string();
+				Ref<Resource> resource = ResourceLoader::load(path);
+				if (resource.is_null()) {
+					set_error(vformat(R"(Can't load the resource "%s".)", path));
+				}
+				return resource;
+			}
+			default: {
+				set_error("Corrupt constant.");
+				return Variant();
+			}
+		}
+	}
+
+	GDScriptDataType read_data_type() {
+		GDScriptDataType type;
+		type.kind = (GDScriptDataType::Kind)buffer->get_u8();
+		type.has_type = read_bool();
+		type.builtin_type = (Variant::Type)buffer->get_u32();
+		type.native_type = read_string();
+
+		Ref<Script> script = read_script();
+		type.script_type = script.ptr();
+		// Same as the compiler, don't hold a reference to classes of this script to avoid cycles.
+		GDScript *gdscript = Object::cast_to<GDScript>(script.ptr());
+		if (gdscript == nullptr || gdscript->get_root_script() != root) {
+			type.script_type_ref = script;
+		}
+
+		const int element_count = read_count();
+		for (int i = 0; i < element_count; i++) {
+			type.container_element_types.push_back(read_data_type());
+		}
+		return type;
+	}
+
+	PropertyInfo read_property_info() {
+		return PropertyInfo::from_dict(buffer->get_var());
+	}
+
+	MethodInfo read_method_info() {
+		MethodInfo info;
+		info.name = read_string();
+		info.flags = buffer->get_u32();
+		info.id = buffer->get_32();
+		info.return_val = read_property_info();
+		const int argument_count = read_count();
+		for (int i = 0; i < argument_count; i++) {
+			info.arguments.push_back(read_property_info());
+		}
+		const int default_argument_count = read_count();
+		for (int i = 0; i < default_argument_count; i++) {
+			info.default_arguments.push_back(read_variant());
+		}
+		return info;
+	}
+
+	GDScript::MemberInfo read_member_info() {
+		GDScript::MemberInfo info;
+		info.index = buffer->get_32();
+		info.setter = read_string();
+		info.getter = read_string();
+		info.data_type = read_data_type();
+		info.property_info = read_property_info();
+		return info;
+	}
+
+	template <typename T>
+	void read_table(Vector<T> &r_table, int &r_count, const T *&r_ptr, const char *p_what, T (*p_lookup)(Reader *)) {
+		const int count = read_count();
+		r_table.resize(count);
+#ifdef DEBUG_ENABLED
+		debug_names.clear();
+#endif
+		for (int i = 0; i < count; i++) {
+			const T function = p_lookup(this);
+			if (function == nullptr) {
+				set_error(vformat("Unknown %s.", p_what));
+			}
+			r_table.write[i] = function;
+#ifdef DEBUG_ENABLED
+			debug_names.push_back(debug_name);
+#endif
+		}
+		r_count = count;
+		r_ptr = count ? r_table.ptr() : nullptr;
+	}
+
+	GDScriptFunction *read_function(GDScript *p_script) {
+		GDScriptFunction *function = memnew(GDScriptFunction);
+		function->_script = p_script;
+		function->name = read_string();
+		function->source = p_script->get_script_path();
+#ifdef DEBUG_ENABLED
+		function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+		function->_func_cname = function->func_cname.get_data();
+#endif
+		function->_static = read_bool();
+		function->_initial_line = buffer->get_32();
+		function->_argument_count = buffer->get_32();
+		function->_stack_size = buffer->get_32();
+		function->_instruction_args_size = buffer->get_32();
+		function->return_type = read_data_type();
+		const int argument_type_count = read_count();
+		for (int i = 0; i < argument_type_count; i++) {
+			function->argument_types.push_back(read_data_type());
+		}
+		function->method_info = read_method_info();
+		function->rpc_config = read_variant();
+
+		const int temporary_slot_count = read_count();
+		for (int i = 0; i < temporary_slot_count; i++) {
+			const int slot = buffer->get_32();
+			function->temporary_slots[slot] = (Variant::Type)buffer->get_u32();
+		}
+
+		read_ints(function->code);
+		function->_code_size = function->code.size();
+		function->_code_ptr = function->_code_size ? function->code.ptrw() : nullptr;
+
+		read_ints(function->default_arguments);
+		function->_default_arg_count = function->default_arguments.is_empty() ? 0 : function->default_arguments.size() - 1;
+		function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+
+		const int constant_count = read_count();
+		function->constants.resize(constant_count);
+		for (int i = 0; i < constant_count; i++) {
+			function->constants.write[i] = read_variant();
+		}
+		function->_constant_count = constant_count;
+		function->_constants_ptr = constant_count ? function->constants.ptrw() : nullptr;
+
+		const int global_name_count = read_count();
+		function->global_names.resize(global_name_count);
+		for (int i = 0; i < global_name_count; i++) {
+			function->global_names.write[i] = read_string();
+		}
+		function->_global_names_count = global_name_count;
+		function->_global_names_ptr = global_name_count ? function->global_names.ptr() : nullptr;
+
+		read_table<Variant::ValidatedOperatorEvaluator>(function->operator_funcs, function->_operator_funcs_count, function->_operator_funcs_ptr, "operator", [](Reader *r) {
+			const Variant::Operator op = (Variant::Operator)r->buffer->get_u8();
+			const Variant::Type type_a = (Variant::Type)r->buffer->get_u8();
+			const Variant::Type type_b = (Variant::Type)r->buffer->get_u8();
+			if (op >= Variant::OP_MAX || type_a >= Variant::VARIANT_MAX || type_b >= Variant::VARIANT_MAX) {
+				return (Variant::ValidatedOperatorEvaluator) nullptr;
+			}
+#ifdef DEBUG_ENABLED
+			r->debug_name = Variant::get_operator_name(op);
+#endif
+			return Variant::get_validated_operator_evaluator(op, type_a, type_b);
+		});
+#ifdef DEBUG_ENABLED
+		function->operator_names = debug_names;
+#endif
+		read_table<Variant::ValidatedSetter>(function->setters, function->_setters_count, function->_setters_ptr, "setter", [](Reader *r) {
+			const Variant::Type type = r->read_type();
+			const StringName member = r->read_debug_name();
+			return type < Variant::VARIANT_MAX ? Variant::get_member_validated_setter(type, member) : nullptr;
+		});
+#ifdef DEBUG_ENABLED
+		function->setter_names = debug_names;
+#endif
+		read_table<Variant::ValidatedGetter>(function->getters, function->_getters_count, function->_getters_ptr, "getter", [](Reader *r) {
+			const Variant::Type type = r->read_type();
+			const StringName member = r->read_debug_name();
+			return type < Variant::VARIANT_MAX ? Variant::get_member_validated_getter(type, member) : nullptr;
+		});
+#ifdef DEBUG_ENABLED
+		function->getter_names = debug_names;
+#endif
+		read_table<Variant::ValidatedKeyedSetter>(function->keyed_setters, function->_keyed_setters_count, function->_keyed_setters_ptr, "keyed setter", [](Reader *r) {
+			const Variant::Type type = r->read_type();
+			return type < Variant::VARIANT_MAX ? Variant::get_member_validated_keyed_setter(type) : nullptr;
+		});
+		read_table<Variant::ValidatedKeyedGetter>(function->keyed_getters, function->_keyed_getters_count, function->_keyed_getters_ptr, "keyed getter", [](Reader *r) {
+			const Variant::Type type = r->read_type();
+			return type < Variant::VARIANT_MAX ? Variant::get_member_validated_keyed_getter(type) : nullptr;
+		});
+		read_table<Variant::ValidatedIndexedSetter>(function->indexed_setters, function->_indexed_setters_count, function->_indexed_setters_ptr, "indexed setter", [](Reader *r) {
+			const Variant::Type type = r->read_type();
+			return type < Variant::VARIANT_MAX ? Variant::get_member_validated_indexed_setter(type) : nullptr;
+		});
+		read_table<Variant::ValidatedIndexedGetter>(function->indexed_getters, function->_indexed_getters_count, function->_indexed_getters_ptr, "indexed getter", [](Reader *r) {
+			const Variant::Type type = r->read_type();
+			return type < Variant::VARIANT_MAX ? Variant::get_member_validated_indexed_getter(type) : nullptr;
+		});
+		read_table<Variant::ValidatedBuiltInMethod>(function->builtin_methods, function->_builtin_methods_count, function->_builtin_methods_ptr, "built-in method", [](Reader *r) {
+			const Variant::Type type = r->read_type();
+			const StringName method = r->read_debug_name();
+			return type < Variant::VARIANT_MAX ? Variant::get_validated_builtin_method(type, method) : nullptr;
+		});
+#ifdef DEBUG_ENABLED
+		function->builtin_methods_names = debug_names;
+#endif
+		read_table<Variant::ValidatedConstructor>(function->constructors, function->_constructors_count, function->_constructors_ptr, "constructor", [](Reader *r) {
+			const Variant::Type type = r->read_type();
+			const int index = r->buffer->get_32();
+			if (type >= Variant::VARIANT_MAX || index < 0 || index >= Variant::get_constructor_count(type)) {
+				return (Variant::ValidatedConstructor) nullptr;
+			}
+#ifdef DEBUG_ENABLED
+			r->debug_name = Variant::get_type_name(type);
+#endif
+			return Variant::get_validated_constructor(type, index);
+		});
+#ifdef DEBUG_ENABLED
+		function->constructors_names = debug_names;
+#endif
+		read_table<Variant::ValidatedUtilityFunction>(function->utilities, function->_utilities_count, function->_utilities_ptr, "utility function", [](Reader *r) {
+			return Variant::get_validated_utility_function(r->read_debug_name());
+		});
+#ifdef DEBUG_ENABLED
+		function->utilities_names = debug_names;
+#endif
+		read_table<GDScriptUtilityFunctions::FunctionPtr>(function->gds_utilities, function->_gds_utilities_count, function->_gds_utilities_ptr, "GDScript utility function", [](Reader *r) {
+			return GDScriptUtilityFunctions::get_function(r->read_debug_name());
+		});
+#ifdef DEBUG_ENABLED
+		function->gds_utilities_names = debug_names;
+#endif
+
+		const int method_count = read_count();
+		function->methods.resize(method_count);
+		for (int i = 0; i < method_count; i++) {
+			const StringName class_name = read_string();
+			const StringName method_name = read_string();
+			MethodBind *method = ClassDB::get_method(class_name, method_name);
+			if (method == nullptr) {
+				set_error(vformat(R"(Unknown method "%s.%s".)", class_name, method_name));
+			}
+			function->methods.write[i] = method;
+		}
+		function->_methods_count = method_count;
+		function->_methods_ptr = method_count ? function->methods.ptrw() : nullptr;
+
+		const int lambda_count = read_count();
+		for (int i = 0; i < lambda_count && error.is_empty(); i++) {
+			GDScript::LambdaInfo info;
+			info.capture_count = buffer->get_32();
+			info.use_self = read_bool();
+			GDScriptFunction *lambda = read_function(p_script);
+			function->lambdas.push_back(lambda);
+			p_script->lambda_info.insert(lambda, info);
+		}
+		function->_lambdas_count = function->lambdas.size();
+		function->_lambdas_ptr = function->lambdas.is_empty() ? nullptr : function->lambdas.ptrw();
+
+		if (error.is_empty()) {
+			validate_function(function);
+		}
+		return function;
+	}
+
+	// Static variable indices can only be checked once every class of the script is read.
+	struct StaticVariableAccess {
+		GDScript *script = nullptr;
+		int index = 0;
+	};
+	Vector<StaticVariableAccess> static_variable_accesses;
+
+	void validate_static_variable_accesses() {
+		for (const StaticVariableAccess &E : static_variable_accesses) {
+			// Scripts still being compiled, e.g. in a dependency cycle, can't be checked yet.
+			if (E.script->valid && E.index >= E.script->static_variables.size()) {
+				set_error(vformat(R"(Corrupt static variable index %d.)", E.index));
+			}
+		}
+	}
+
+	bool is_valid_address(const GDScriptFunction *p_function, int p_address) const {
+		const int index = p_address & GDScriptFunction::ADDR_MASK;
+		switch ((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+			case GDScriptFunction::ADDR_TYPE_STACK:
+				return index < p_function->_stack_size;
+			case GDScriptFunction::ADDR_TYPE_CONSTANT:
+				return index < p_function->_constant_count;
+			case GDScriptFunction::ADDR_TYPE_MEMBER:
+				return index < (int)p_function->_script->member_indices.size();
+		}
+		return false;
+	}
+
+	// Instructions with a variable number of addresses are laid out as the opcode,
+	// the address count, the addresses, and then their other arguments.
+	// Returns the size of the instruction.
+	int validate_call(const GDScriptFunction *p_function, int p_ip, bool &r_valid) const {
+		const int *code = p_function->_code_ptr + p_ip;
+		const int remaining = p_function->_code_size - p_ip;
+
+		int argument_count = 2;
+		switch (code[0]) {
+			case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY:
+			case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+				argument_count = 1;
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY:
+			case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC: {
+				argument_count = 3;
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT:
+			case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+			case GDScriptFunction::OPCODE_CALL:
+			case GDScriptFunction::OPCODE_CALL_RETURN:
+			case GDScriptFunction::OPCODE_CALL_ASYNC:
+			case GDScriptFunction::OPCODE_CALL_UTILITY:
+			case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+			case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY:
+			case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+			case GDScriptFunction::OPCODE_CALL_SELF_BASE:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET:
+			case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC:
+			case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+			case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+			case GDScriptFunction::OPCODE_CREATE_LAMBDA:
+			case GDScriptFunction::OPCODE_CREATE_SELF_LAMBDA: {
+			} break;
+			default: {
+				r_valid = false;
+				return 0;
+			}
+		}
+
+		const int address_count = remaining >= 2 ? code[1] : -1;
+		if (address_count < 0 || address_count > p_function->_instruction_args_size || address_count > remaining - 2 - argument_count) {
+			r_valid = false;
+			return 0;
+		}
+		for (int i = 0; i < address_count; i++) {
+			if (!is_valid_address(p_function, code[2 + i])) {
+				r_valid = false;
+				return 0;
+			}
+		}
+
+		const int *arguments = code + 2 + address_count;
+		const int argc = code[0] == GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC ? arguments[2] : (code[0] == GDScriptFunction::OPCODE_CALL_NATIVE_STATIC ? arguments[1] : arguments[0]);
+		if (argc < 0 || argc > address_count) {
+			r_valid = false;
+			return 0;
+		}
+
+		// The number of addresses the VM reads, and the table indexed by the other argument.
+		int used_addresses = argc + 1;
+		int table_index = argument_count > 1 ? arguments[1] : 0;
+		int table_size = 0;
+		switch (code[0]) {
+			case GDScriptFunction::OPCODE_CONSTRUCT: {
+				table_size = Variant::VARIANT_MAX;
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+				table_size = p_function->_constructors_count;
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY: {
+				table_size = 1;
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY: {
+				used_addresses = argc + 2;
+				table_index = arguments[2];
+				table_size = arguments[1] >= 0 && arguments[1] < Variant::VARIANT_MAX ? p_function->_global_names_count : 0;
+			} break;
+			case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+				used_addresses = argc * 2 + 1;
+				table_size = 1;
+			} break;
+			case GDScriptFunction::OPCODE_CALL:
+			case GDScriptFunction::OPCODE_CALL_UTILITY:
+			case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+				table_size = p_function->_global_names_count;
+			} break;
+			case GDScriptFunction::OPCODE_CALL_RETURN:
+			case GDScriptFunction::OPCODE_CALL_ASYNC: {
+				used_addresses = argc + 2;
+				table_size = p_function->_global_names_count;
+			} break;
+			case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+				table_size = p_function->_utilities_count;
+			} break;
+			case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY: {
+				table_size = p_function->_gds_utilities_count;
+			} break;
+			case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+				used_addresses = argc + 2;
+				table_size = p_function->_builtin_methods_count;
+			} break;
+			case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC: {
+				table_size = arguments[0] >= 0 && arguments[0] < Variant::VARIANT_MAX ? p_function->_global_names_count : 0;
+			} break;
+			case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC: {
+				table_index = arguments[0];
+				table_size = p_function->_methods_count;
+			} break;
+			case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+			case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND: {
+				table_size = p_function->_methods_count;
+			} break;
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+			case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+				used_addresses = argc + 2;
+				table_size = p_function->_methods_count;
+			} break;
+			default: {
+				// Lambda creation.
+				table_size = p_function->_lambdas_count;
+			} break;
+		}
+		if (used_addresses > address_count || table_index < 0 || table_index >= table_size) {
+			r_valid = false;
+			return 0;
+		}
+
+		return 2 + address_count + argument_count;
+	}
+
+	// Release builds of the VM trust the bytecode, so everything it reads without
+	// checking is checked here: the layout of each instruction, addresses, table
+	// indices, and jump targets.
+	void validate_function(GDScriptFunction *p_function) {
+		if (p_function->_argument_count < 0 || p_function->argument_types.size() != p_function->_argument_count || p_function->_stack_size < GDScriptFunction::FIXED_ADDRESSES_MAX + p_function->_argument_count || p_function->_instruction_args_size < 0) {
+			set_error(vformat(R"(Corrupt stack layout in "%s".)", p_function->name));
+			return;
+		}
+		for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+			if (E.key < GDScriptFunction::FIXED_ADDRESSES_MAX || E.key >= p_function->_stack_size || E.value < 0 || E.value >= Variant::VARIANT_MAX) {
+				set_error(vformat(R"(Corrupt temporary slot in "%s".)", p_function->name));
+				return;
+			}
+		}
+
+		int *code = p_function->_code_ptr;
+		const int code_size = p_function->_code_size;
+		LocalVector<bool> is_instruction;
+		is_instruction.resize(code_size);
+		for (int i = 0; i < code_size; i++) {
+			is_instruction[i] = false;
+		}
+		LocalVector<int> jumps;
+
+		int ip = 0;
+		bool valid = true;
+		// Each check reads `code[ip + p_offset]`, callers make sure the instruction fits first.
+		auto address = [&](int p_offset) {
+			valid = valid && is_valid_address(p_function, code[ip + p_offset]);
+		};
+		auto index = [&](int p_offset, int p_count) {
+			valid = valid && code[ip + p_offset] >= 0 && code[ip + p_offset] < p_count;
+		};
+		auto jump = [&](int p_offset) {
+			jumps.push_back(code[ip + p_offset]);
+		};
+		auto fits = [&](int p_size) {
+			valid = valid && p_size > 0 && p_size <= code_size - ip;
+			return valid;
+		};
+
+		while (valid && ip < code_size) {
+			is_instruction[ip] = true;
+			int size = 0;
+
+			switch (code[ip]) {
+				case GDScriptFunction::OPCODE_OPERATOR: {
+					constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*code);
+					size = 7 + pointer_size;
+					if (fits(size)) {
+						address(1);
+						address(2);
+						address(3);
+						index(4, Variant::OP_MAX);
+						// The cached evaluator is a pointer into the process that wrote the entry.
+						for (int i = 5; i < size; i++) {
+							code[ip + i] = 0;
+						}
+					}
+				} break;
+				case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+				case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED:
+				case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED:
+				case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED:
+				case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+					size = 5;
+					if (fits(size)) {
+						address(1);
+						address(2);
+						address(3);
+						switch (code[ip]) {
+							case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+								index(4, p_function->_operator_funcs_count);
+								break;
+							case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED:
+								index(4, p_function->_keyed_setters_count);
+								break;
+							case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED:
+								index(4, p_function->_indexed_setters_count);
+								break;
+							case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED:
+								index(4, p_function->_keyed_getters_count);
+								break;
+							default:
+								index(4, p_function->_indexed_getters_count);
+								break;
+						}
+					}
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+				case GDScriptFunction::OPCODE_CAST_TO_BUILTIN: {
+					size = 4;
+					if (fits(size)) {
+						address(1);
+						address(2);
+						index(3, Variant::VARIANT_MAX);
+					}
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_ARRAY:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY: {
+					size = 6;
+					if (fits(size)) {
+						address(1);
+						address(2);
+						address(3);
+						index(4, Variant::VARIANT_MAX);
+						index(5, p_function->_global_names_count);
+					}
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_NATIVE:
+				case GDScriptFunction::OPCODE_SET_NAMED:
+				case GDScriptFunction::OPCODE_GET_NAMED: {
+					size = 4;
+					if (fits(size)) {
+						address(1);
+						address(2);
+						index(3, p_function->_global_names_count);
+					}
+				} break;
+				case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED:
+				case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+					size = 4;
+					if (fits(size)) {
+						address(1);
+						address(2);
+						index(3, code[ip] == GDScriptFunction::OPCODE_SET_NAMED_VALIDATED ? p_function->_setters_count : p_function->_getters_count);
+					}
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_SCRIPT:
+				case GDScriptFunction::OPCODE_SET_KEYED:
+				case GDScriptFunction::OPCODE_GET_KEYED:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+				case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+				case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+					size = 4;
+					if (fits(size)) {
+						address(1);
+						address(2);
+						address(3);
+					}
+				} break;
+				case GDScriptFunction::OPCODE_SET_MEMBER:
+				case GDScriptFunction::OPCODE_GET_MEMBER:
+				case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL: {
+					size = 3;
+					if (fits(size)) {
+						address(1);
+						index(2, p_function->_global_names_count);
+					}
+				} break;
+				case GDScriptFunction::OPCODE_SET_STATIC_VARIABLE:
+				case GDScriptFunction::OPCODE_GET_STATIC_VARIABLE: {
+					size = 4;
+					if (fits(size)) {
+						address(1);
+						address(2);
+						// The compiler always refers to the class with a constant.
+						const int class_address = code[ip + 2];
+						GDScript *script = nullptr;
+						if (valid && (class_address >> GDScriptFunction::ADDR_BITS) == GDScriptFunction::ADDR_TYPE_CONSTANT) {
+							script = Object::cast_to<GDScript>(p_function->constants[class_address & GDScriptFunction::ADDR_MASK]);
+						}
+						valid = valid && script != nullptr && code[ip + 3] >= 0;
+						if (valid) {
+							static_variable_accesses.push_back({ script, code[ip + 3] });
+						}
+					}
+				} break;
+				case GDScriptFunction::OPCODE_ASSIGN:
+				case GDScriptFunction::OPCODE_JUMP_IF:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+				case GDScriptFunction::OPCODE_JUMP_IF_SHARED: {
+					size = 3;
+					if (fits(size)) {
+						address(1);
+						if (code[ip] == GDScriptFunction::OPCODE_ASSIGN) {
+							address(2);
+						} else {
+							jump(2);
+						}
+					}
+				} break;
+				case GDScriptFunction::OPCODE_ASSIGN_NULL:
+				case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+				case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+				case GDScriptFunction::OPCODE_AWAIT_RESUME:
+				case GDScriptFunction::OPCODE_RETURN:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_INT:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_FLOAT:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_STRING:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR2I:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_RECT2:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_RECT2I:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR3I:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_TRANSFORM2D:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR4:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_VECTOR4I:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_PLANE:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_QUATERNION:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_AABB:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_BASIS:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_TRANSFORM3D:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_PROJECTION:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_COLOR:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_STRING_NAME:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_NODE_PATH:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_RID:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_OBJECT:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_CALLABLE:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_SIGNAL:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_DICTIONARY:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_ARRAY:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_BYTE_ARRAY:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_INT32_ARRAY:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_INT64_ARRAY:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_FLOAT32_ARRAY:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_FLOAT64_ARRAY:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_STRING_ARRAY:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR2_ARRAY:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY:
+				case GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY: {
+					size = 2;
+					if (fits(size)) {
+						address(1);
+					}
+				} break;
+				case GDScriptFunction::OPCODE_AWAIT: {
+					// Resuming right away skips the `OPCODE_AWAIT_RESUME` that always follows.
+					size = 2;
+					if (fits(size + 2)) {
+						address(1);
+						valid = valid && code[ip + 2] == GDScriptFunction::OPCODE_AWAIT_RESUME;
+					}
+				} break;
+				case GDScriptFunction::OPCODE_JUMP: {
+					size = 2;
+					if (fits(size)) {
+						jump(1);
+					}
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+					size = 3;
+					if (fits(size)) {
+						address(1);
+						index(2, Variant::VARIANT_MAX);
+					}
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY: {
+					size = 5;
+					if (fits(size)) {
+						address(1);
+						address(2);
+						index(3, Variant::VARIANT_MAX);
+						index(4, p_function->_global_names_count);
+					}
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+				case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT: {
+					size = 3;
+					if (fits(size)) {
+						address(1);
+						address(2);
+					}
+				} break;
+				case GDScriptFunction::OPCODE_STORE_GLOBAL: {
+					size = 3;
+					if (fits(size)) {
+						address(1);
+						index(2, GDScriptLanguage::get_singleton()->get_global_array_size());
+					}
+				} break;
+				case GDScriptFunction::OPCODE_ASSERT: {
+					size = 3;
+					if (fits(size)) {
+						address(1);
+						// Doubles as the message address when there's a message.
+						if (code[ip + 2] != 0) {
+							address(2);
+						}
+					}
+				} break;
+				case GDScriptFunction::OPCODE_LINE: {
+					size = 2;
+					fits(size);
+				} break;
+				case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+				case GDScriptFunction::OPCODE_BREAKPOINT:
+				case GDScriptFunction::OPCODE_END: {
+					size = 1;
+				} break;
+				default: {
+					if (code[ip] >= GDScriptFunction::OPCODE_ITERATE_BEGIN && code[ip] <= GDScriptFunction::OPCODE_ITERATE_OBJECT) {
+						size = 5;
+						if (fits(size)) {
+							address(1);
+							address(2);
+							address(3);
+							jump(4);
+						}
+					} else {
+						size = validate_call(p_function, ip, valid);
+					}
+				} break;
+			}
+
+			if (!valid) {
+				break;
+			}
+			ip += size;
+		}
+
+		for (int i = 0; valid && i < p_function->default_arguments.size(); i++) {
+			jumps.push_back(p_function->default_arguments[i]);
+		}
+		for (const int &E : jumps) {
+			valid = valid && E >= 0 && E < code_size && is_instruction[E];
+		}
+
+		if (!valid) {
+			set_error(vformat(R"(Corrupt bytecode in "%s" at address %d.)", p_function->name, MIN(ip, code_size)));
+		}
+	}
+
+	Variant::Type read_type() {
+		return (Variant::Type)buffer->get_u32();
+	}
+
+	// Reads a name, remembering it for the debug name tables used by the disassembler.
+	StringName read_debug_name() {
+		const StringName name = read_string();
+#ifdef DEBUG_ENABLED
+		debug_name = name;
+#endif
+		return name;
+	}
+
+#ifdef DEBUG_ENABLED
+	String debug_name;
+	Vector<String> debug_names;
+#endif
+
+	GDScriptFunction *read_optional_function(GDScript *p_script) {
+		return read_bool() ? read_function(p_script) : nullptr;
+	}
+
+	// Same as `GDScriptCompiler::make_scripts()`, inner classes are reused by name so
+	// references other scripts already hold stay valid.
+	void read_class_tree(GDScript *p_script) {
+		p_script->local_name = read_string();
+		p_script->global_name = read_string();
+		p_script->simplified_icon_path = read_string();
+
+		HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+		p_script->subclasses.clear();
+
+		const int subclass_count = read_count();
+		for (int i = 0; i < subclass_count && error.is_empty(); i++) {
+			const StringName name = read_string();
+			const String fully_qualified_name = read_string();
+
+			Ref<GDScript> subclass;
+			if (old_subclasses.has(name)) {
+				subclass = old_subclasses[name];
+			} else {
+				subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fully_qualified_name);
+			}
+			if (subclass.is_null()) {
+				subclass.instantiate();
+			}
+
+			subclass->_owner = p_script;
+			subclass->path = p_script->path;
+			subclass->fully_qualified_name = fully_qualified_name;
+			p_script->subclasses.insert(name, subclass);
+
+			read_class_tree(subclass.ptr());
+		}
+	}
+
+	void read_class(GDScript *p_script) {
+		GDScriptBytecodeCache::_clear_class(p_script);
+
+		p_script->tool = read_bool();
+
+		const StringName native_name = read_string();
+		const int *native_index = GDScriptLanguage::get_singleton()->get_global_map().getptr(native_name);
+		if (native_index) {
+			p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[*native_index];
+		}
+		if (p_script->native.is_null()) {
+			set_error(vformat(R"(Unknown native base class "%s".)", native_name));
+			return;
+		}
+
+		const Ref<Script> base = read_script();
+		if (base.is_valid()) {
+			p_script->base = base;
+			p_script->_base = p_script->base.ptr();
+			if (p_script->base.is_null()) {
+				set_error("The base class isn't a GDScript.");
+				return;
+			}
+		}
+
+		const int member_count = read_count();
+		for (int i = 0; i < member_count; i++) {
+			const StringName name = read_string();
+			p_script->member_indices[name] = read_member_info();
+		}
+		const int own_member_count = read_count();
+		for (int i = 0; i < own_member_count; i++) {
+			p_script->members.insert(read_string());
+		}
+		const int static_variable_count = read_count();
+		for (int i = 0; i < static_variable_count; i++) {
+			const StringName name = read_string();
+			p_script->static_variables_indices[name] = read_member_info();
+		}
+		p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+		const int constant_count = read_count();
+		for (int i = 0; i < constant_count; i++) {
+			const StringName name = read_string();
+			p_script->constants.insert(name, read_variant());
+		}
+		const int signal_count = read_count();
+		for (int i = 0; i < signal_count; i++) {
+			const StringName name = read_string();
+			p_script->_signals[name] = read_method_info();
+		}
+		p_script->rpc_config = read_variant();
+
+#ifdef TOOLS_ENABLED
+		const int default_value_count = read_count();
+		for (int i = 0; i < default_value_count; i++) {
+			const StringName name = read_string();
+			p_script->member_default_values[name] = read_variant();
+		}
+#endif
+
+		const int function_count = read_count();
+		for (int i = 0; i < function_count && error.is_empty(); i++) {
+			GDScriptFunction *function = read_function(p_script);
+			p_script->member_functions[function->name] = function;
+		}
+		if (!error.is_empty()) {
+			return;
+		}
+		GDScriptFunction **initializer = p_script->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init);
+		p_script->initializer = initializer ? *initializer : nullptr;
+		p_script->implicit_initializer = read_optional_function(p_script);
+		p_script->implicit_ready = read_optional_function(p_script);
+		p_script->static_initializer = read_optional_function(p_script);
+		if (!error.is_empty()) {
+			return;
+		}
+
+		for (KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+			read_class(E.value.ptr());
+			if (!error.is_empty()) {
+				return;
+			}
+		}
+
+		p_script->valid = true;
+	}
+};
+
+/* GDScriptBytecodeCache */
+
+void GDScriptBytecodeCache::_build_lookups() {
+	if (lookups_built) {
+		return;
+	}
+	lookups_built = true;
+
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		const Variant::Type type = (Variant::Type)i;
+
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+				Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, type, (Variant::Type)j);
+				if (evaluator && !operator_keys.has(evaluator)) {
+					operator_keys.insert(evaluator, { (Variant::Operator)op, type, (Variant::Type)j });
+				}
+			}
+		}
+
+		List<StringName> members;
+		Variant::get_member_list(type, &members);
+		for (const StringName &member : members) {
+			setter_keys.insert(Variant::get_member_validated_setter(type, member), { type, member });
+			getter_keys.insert(Variant::get_member_validated_getter(type, member), { type, member });
+		}
+
+		keyed_setter_keys.insert(Variant::get_member_validated_keyed_setter(type), type);
+		keyed_getter_keys.insert(Variant::get_member_validated_keyed_getter(type), type);
+		indexed_setter_keys.insert(Variant::get_member_validated_indexed_setter(type), type);
+		indexed_getter_keys.insert(Variant::get_member_validated_indexed_getter(type), type);
+
+		List<StringName> methods;
+		Variant::get_builtin_method_list(type, &methods);
+		for (const StringName &method : methods) {
+			builtin_method_keys.insert(Variant::get_validated_builtin_method(type, method), { type, method });
+		}
+
+		for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+			constructor_keys.insert(Variant::get_validated_constructor(type, j), { type, j });
+		}
+	}
+
+	List<StringName> utilities;
+	Variant::get_utility_function_list(&utilities);
+	for (const StringName &utility : utilities) {
+		utility_keys.insert(Variant::get_validated_utility_function(utility), utility);
+	}
+
+	List<StringName> gds_utilities;
+	GDScriptUtilityFunctions::get_function_list(&gds_utilities);
+	for (const StringName &utility : gds_utilities) {
+		gds_utility_keys.insert(GDScriptUtilityFunctions::get_function(utility), utility);
+	}
+}
+
+void GDScriptBytecodeCache::_clear_class(GDScript *p_script) {
+	// Same as `GDScriptCompiler::_prepare_compilation()`.
+	p_script->clearing = true;
+
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = nullptr;
+	p_script->members.clear();
+
+	// Copied first, since releasing constants and functions can access the maps being cleared.
+	HashMap<StringName, Variant> constants;
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		constants.insert(E.key, E.value);
+	}
+	p_script->constants.clear();
+	constants.clear();
+	HashMap<StringName, GDScriptFunction *> member_functions;
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		member_functions.insert(E.key, E.value);
+	}
+	p_script->member_functions.clear();
+	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+		memdelete(E.value);
+	}
+
+	if (p_script->implicit_initializer) {
+		memdelete(p_script->implicit_initializer);
+	}
+	if (p_script->implicit_ready) {
+		memdelete(p_script->implicit_ready);
+	}
+	if (p_script->static_initializer) {
+		memdelete(p_script->static_initializer);
+	}
+
+	p_script->member_functions.clear();
+	p_script->member_indices.clear();
+	p_script->static_variables_indices.clear();
+	p_script->static_variables.clear();
+	p_script->_signals.clear();
+	p_script->initializer = nullptr;
+	p_script->implicit_initializer = nullptr;
+	p_script->implicit_ready = nullptr;
+	p_script->static_initializer = nullptr;
+	p_script->rpc_config.clear();
+	p_script->lambda_info.clear();
+#ifdef TOOLS_ENABLED
+	p_script->member_default_values.clear();
+#endif
+
+	p_script->clearing = false;
+	p_script->valid = false;
+}
+
+String GDScriptBytecodeCache::_get_source_hash(const String &p_path) {
+	if (const String *hash = source_hashes.getptr(p_path)) {
+		return *hash;
+	}
+	const String hash = FileAccess::get_md5(ResourceLoader::path_remap(p_path));
+	source_hashes.insert(p_path, hash);
+	return hash;
+}
+
+String GDScriptBytecodeCache::_get_environment_hash() {
+	if (!environment_hash.is_empty()) {
+		return environment_hash;
+	}
+
+	// Compiled code depends on the engine build, and on the global names
+	// that identifiers resolved to when it was compiled.
+	String environment = VERSION_FULL_BUILD;
+	environment += VERSION_HASH;
+#ifdef DEBUG_ENABLED
+	environment += "|debug";
+#endif
+#ifdef TOOLS_ENABLED
+	environment += "|tools";
+#endif
+#ifdef REAL_T_IS_DOUBLE
+	environment += "|double";
+#endif
+
+	const TypedArray<Dictionary> global_classes = ProjectSettings::get_singleton()->get_global_class_list();
+	for (int i = 0; i < global_classes.size(); i++) {
+		const Dictionary global_class = global_classes[i];
+		environment += vformat("|%s:%s:%s", global_class.get("class", ""), global_class.get("base", ""), global_class.get("path", ""));
+	}
+	for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+		environment += vformat("|%s:%s:%d", E.key, E.value.path, E.value.is_singleton);
+	}
+
+	environment_hash = environment.md5_text();
+	return environment_hash;
+}
+
+String GDScriptBytecodeCache::_get_entry_path(const String &p_path) const {
+	const String directory = GLOBAL_GET("gdscript/bytecode_cache/path");
+	return directory.path_join(p_path.md5_text() + ".gdbc");
+}
+
+String GDScriptBytecodeCache::_get_body_hash(const Vector<uint8_t> &p_body) {
+	unsigned char hash[16];
+	CryptoCore::md5(p_body.ptr(), p_body.size(), hash);
+	return String::md5(hash);
+}
+
+Error GDScriptBytecodeCache::_read_header(const Ref<FileAccess> &p_file, Header &r_header) {
+	uint8_t magic[4] = {};
+	p_file->get_buffer(magic, 4);
+	if (memcmp(magic, ENTRY_MAGIC, 4) != 0 || p_file->get_32() != FORMAT_VERSION) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	if (p_file->get_pascal_string() != _get_environment_hash()) {
+		return ERR_INVALID_DATA;
+	}
+
+	r_header.source_hash = p_file->get_pascal_string();
+	const uint32_t dependency_count = p_file->get_32();
+	for (uint32_t i = 0; i < dependency_count && p_file->get_error() == OK; i++) {
+		const String path = p_file->get_pascal_string();
+		r_header.dependencies[path] = p_file->get_pascal_string();
+	}
+	r_header.has_body = p_file->get_8() != 0;
+	if (r_header.has_body) {
+		r_header.body_hash = p_file->get_pascal_string();
+	}
+
+	return p_file->get_error() == OK ? OK : ERR_FILE_CORRUPT;
+}
+
+bool GDScriptBytecodeCache::_is_same_header(const Header &p_a, const Header &p_b) {
+	if (p_a.source_hash != p_b.source_hash || p_a.has_body != p_b.has_body || p_a.body_hash != p_b.body_hash || p_a.dependencies.size() != p_b.dependencies.size()) {
+		return false;
+	}
+	for (const KeyValue<String, String> &E : p_a.dependencies) {
+		const String *hash = p_b.dependencies.getptr(E.key);
+		if (hash == nullptr || *hash != E.value) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_is_entry_valid(const String &p_path, HashSet<String> &r_visiting, HashSet<String> &r_checked) {
+	if (const bool *valid = valid_entries.getptr(p_path)) {
+		return *valid;
+	}
+	if (r_visiting.has(p_path)) {
+		// Dependency cycle, the result depends on the rest of the cycle.
+		return true;
+	}
+
+	bool valid = false;
+	Header header;
+	Ref<FileAccess> file = FileAccess::open(_get_entry_path(p_path), FileAccess::READ);
+	if (file.is_valid() && _read_header(file, header) == OK && header.source_hash == _get_source_hash(p_path)) {
+		r_visiting.insert(p_path);
+		valid = true;
+		for (const KeyValue<String, String> &E : header.dependencies) {
+			if (E.value != _get_source_hash(E.key) || !_is_entry_valid(E.key, r_visiting, r_checked)) {
+				valid = false;
+				break;
+			}
+		}
+		r_visiting.erase(p_path);
+	}
+
+	// Invalid results are final, valid ones might rely on a cycle that's still being checked.
+	if (valid) {
+		r_checked.insert(p_path);
+	} else {
+		valid_entries[p_path] = false;
+	}
+	return valid;
+}
+
+Error GDScriptBytecodeCache::_read_entry(const String &p_path, Vector<uint8_t> &r_body) {
+	MutexLock lock(mutex);
+
+	if (Vector<uint8_t> *pending = pending_entries.getptr(p_path)) {
+		r_body = *pending;
+		pending_entries.erase(p_path);
+		return OK;
+	}
+
+	HashSet<String> visiting;
+	HashSet<String> checked;
+	if (!_is_entry_valid(p_path, visiting, checked)) {
+		return ERR_FILE_NOT_FOUND;
+	}
+	for (const String &E : checked) {
+		valid_entries[E] = true;
+	}
+
+	Ref<FileAccess> file = FileAccess::open(_get_entry_path(p_path), FileAccess::READ);
+	ERR_FAIL_COND_V(file.is_null(), ERR_FILE_CANT_OPEN);
+	Header header;
+	Error err = _read_header(file, header);
+	if (err != OK) {
+		return err;
+	}
+	if (!header.has_body) {
+		return ERR_UNAVAILABLE;
+	}
+
+	const uint32_t size = file->get_32();
+	if (size > file->get_length() - file->get_position()) {
+		return ERR_FILE_CORRUPT;
+	}
+	r_body.resize(size);
+	file->get_buffer(r_body.ptrw(), size);
+	if (file->get_error() != OK || _get_body_hash(r_body) != header.body_hash) {
+		r_body.clear();
+		return ERR_FILE_CORRUPT;
+	}
+	return OK;
+}
+
+bool GDScriptBytecodeCache::is_enabled_for(const GDScript *p_script) {
+	if (singleton == nullptr || Engine::get_singleton()->is_editor_hint() || EngineDebugger::is_active()) {
+		// The editor needs the parse tree for documentation and exports,
+		// and the debugger needs stack information only emitted when compiling.
+		return false;
+	}
+	if (!GLOBAL_GET("gdscript/bytecode_cache/enabled")) {
+		return false;
+	}
+	return p_script->path.is_resource_file();
+}
+
+Error GDScriptBytecodeCache::serialize(GDScript *p_script, Vector<uint8_t> &r_data, HashSet<String> *r_dependencies) {
+	ERR_FAIL_NULL_V(singleton, ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V_MSG(p_script->_owner != nullptr, ERR_INVALID_PARAMETER, "Only root scripts can be serialized, inner classes are serialized with them.");
+
+	{
+		MutexLock lock(singleton->mutex);
+		singleton->_build_lookups();
+	}
+
+	Writer writer;
+	writer.cache = singleton;
+	writer.root = p_script;
+	writer.buffer.instantiate();
+
+	writer.write_string(p_script->fully_qualified_name);
+	writer.write_class_tree(p_script);
+	writer.write_class(p_script);
+	writer.buffer->put_u8(GDScriptCache::singleton->static_gdscript_cache.has(p_script->fully_qualified_name));
+
+	if (r_dependencies) {
+		*r_dependencies = writer.dependencies;
+	}
+	if (!writer.error.is_empty()) {
+		print_verbose(vformat(R"(GDScript: Bytecode of "%s" can't be cached: %s)", p_script->path, writer.error));
+		return ERR_UNAVAILABLE;
+	}
+
+	// The dependencies come first so they can be loaded before restoring the class.
+	Ref<StreamPeerBuffer> data;
+	data.instantiate();
+	data->put_32(writer.dependencies.size());
+	for (const String &E : writer.dependencies) {
+		data->put_utf8_string(E);
+	}
+	data->put_data(writer.buffer->get_data_array().ptr(), writer.buffer->get_size());
+	r_data = data->get_data_array();
+	return OK;
+}
+
+Error GDScriptBytecodeCache::deserialize(GDScript *p_script, const Vector<uint8_t> &p_data) {
+	ERR_FAIL_COND_V_MSG(p_script->_owner != nullptr, ERR_INVALID_PARAMETER, "Only root scripts can be deserialized, inner classes are deserialized with them.");
+
+	// Same as `GDScriptCompiler::compile()`, callables of lambdas from the
+	// previous compilation are moved to the matching restored lambdas.
+	GDScriptCompiler compiler;
+	const GDScriptCompiler::ScriptLambdaInfo old_lambda_info = compiler._get_script_lambda_replacement_info(p_script);
+
+	Reader reader;
+	reader.root = p_script;
+	reader.buffer.instantiate();
+	reader.buffer->set_data_array(p_data);
+
+	const int dependency_count = reader.read_count();
+	Vector<String> dependencies;
+	for (int i = 0; i < dependency_count; i++) {
+		dependencies.push_back(reader.read_string());
+	}
+
+	p_script->fully_qualified_name = reader.read_string();
+	p_script->_owner = nullptr;
+	reader.read_class_tree(p_script);
+
+	// Other scripts are loaded once the class tree exists, so they can refer to its inner classes.
+	for (const String &E : dependencies) {
+		Error err = OK;
+		GDScriptCache::get_full_script(E, err);
+		if (err != OK) {
+			reader.set_error(vformat(R"(Can't load the dependency "%s".)", E));
+		}
+	}
+
+	if (reader.error.is_empty()) {
+		reader.read_class(p_script);
+	}
+	if (reader.error.is_empty()) {
+		reader.validate_static_variable_accesses();
+	}
+	const bool is_static = reader.read_bool();
+	if (reader.error.is_empty() && reader.buffer->get_position() != reader.buffer->get_size()) {
+		reader.set_error("Unexpected data at the end of the entry.");
+	}
+
+	HashMap<GDScriptFunction *, GDScriptFunction *> func_ptr_replacements;
+	if (reader.error.is_empty()) {
+		const GDScriptCompiler::ScriptLambdaInfo new_lambda_info = compiler._get_script_lambda_replacement_info(p_script);
+		compiler._get_function_ptr_replacements(func_ptr_replacements, old_lambda_info, &new_lambda_info);
+	} else {
+		compiler._get_function_ptr_replacements(func_ptr_replacements, old_lambda_info, nullptr);
+	}
+	p_script->_recurse_replace_function_ptrs(func_ptr_replacements);
+
+	if (!reader.error.is_empty()) {
+		p_script->valid = false;
+		print_verbose(vformat(R"(GDScript: Cached bytecode of "%s" can't be restored: %s)", p_script->path, reader.error));
+		return ERR_FILE_CORRUPT;
+	}
+
+	if (is_static) {
+		GDScriptCache::add_static_script(p_script);
+	}
+	return OK;
+}
+
+bool GDScriptBytecodeCache::make_scripts(GDScript *p_script) {
+	if (!is_enabled_for(p_script)) {
+		return false;
+	}
+
+	Vector<uint8_t> body;
+	if (singleton->_read_entry(p_script->path, body) != OK) {
+		return false;
+	}
+
+	Reader reader;
+	reader.root = p_script;
+	reader.buffer.instantiate();
+	reader.buffer->set_data_array(body);
+
+	const int dependency_count = reader.read_count();
+	for (int i = 0; i < dependency_count; i++) {
+		reader.read_string();
+	}
+	p_script->fully_qualified_name = reader.read_string();
+	reader.read_class_tree(p_script);
+	if (!reader.error.is_empty()) {
+		return false;
+	}
+
+	MutexLock lock(singleton->mutex);
+	singleton->pending_entries[p_script->path] = body;
+	return true;
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script) {
+	if (!is_enabled_for(p_script)) {
+		return ERR_UNAVAILABLE;
+	}
+
+	Vector<uint8_t> body;
+	Error err = singleton->_read_entry(p_script->path, body);
+	if (err != OK) {
+		return err;
+	}
+
+	err = deserialize(p_script, body);
+	if (err != OK) {
+		return err;
+	}
+
+	err = GDScriptCache::finish_compiling(p_script->path);
+	if (err != OK) {
+		p_script->valid = false;
+	}
+	return err;
+}
+
+void GDScriptBytecodeCache::save(GDScript *p_script, GDScriptParser *p_parser) {
+	if (!is_enabled_for(p_script)) {
+		return;
+	}
+
+	Vector<uint8_t> body;
+	HashSet<String> dependencies;
+	const bool has_body = serialize(p_script, body, &dependencies) == OK;
+
+	// Scripts only used while analyzing, e.g. for folded constants and enums
+	// of other classes, leave no trace in the bytecode but still affect it.
+	if (p_parser) {
+		for (const KeyValue<String, Ref<GDScriptParserRef>> &E : p_parser->get_depended_parsers()) {
+			dependencies.insert(E.key);
+		}
+	}
+	{
+		MutexLock cache_lock(GDScriptCache::singleton->mutex);
+		if (const HashSet<String> *cache_dependencies = GDScriptCache::singleton->dependencies.getptr(p_script->path)) {
+			for (const String &E : *cache_dependencies) {
+				dependencies.insert(E);
+			}
+		}
+	}
+	dependencies.erase(p_script->path);
+
+	MutexLock lock(singleton->mutex);
+
+	Header header;
+	header.source_hash = singleton->_get_source_hash(p_script->path);
+	for (const String &E : dependencies) {
+		if (E.is_resource_file()) {
+			header.dependencies[E] = singleton->_get_source_hash(E);
+		}
+	}
+	header.has_body = has_body;
+	if (has_body) {
+		header.body_hash = _get_body_hash(body);
+	}
+
+	const String entry_path = singleton->_get_entry_path(p_script->path);
+	if (!has_body) {
+		// Scripts without a body are compiled on every run, only write their entry when it changes.
+		Ref<FileAccess> existing = FileAccess::open(entry_path, FileAccess::READ);
+		Header existing_header;
+		if (existing.is_valid() && singleton->_read_header(existing, existing_header) == OK && _is_same_header(existing_header, header)) {
+			return;
+		}
+	}
+
+	Error err = DirAccess::make_dir_recursive_absolute(entry_path.get_base_dir());
+	ERR_FAIL_COND_MSG(err != OK, vformat(R"(Can't create the GDScript bytecode cache directory "%s".)", entry_path.get_base_dir()));
+	Ref<FileAccess> file = FileAccess::open(entry_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_MSG(err != OK, vformat(R"(Can't write the GDScript bytecode cache entry "%s".)", entry_path));
+
+	// Entries without a body still record their dependencies, so scripts that
+	// depend on this one can be validated.
+	file->store_buffer(ENTRY_MAGIC, 4);
+	file->store_32(FORMAT_VERSION);
+	file->store_pascal_string(singleton->_get_environment_hash());
+	file->store_pascal_string(header.source_hash);
+	file->store_32(header.dependencies.size());
+	for (const KeyValue<String, String> &E : header.dependencies) {
+		file->store_pascal_string(E.key);
+		file->store_pascal_string(E.value);
+	}
+	file->store_8(has_body);
+	if (has_body) {
+		file->store_pascal_string(header.body_hash);
+		file->store_32(body.size());
+		file->store_buffer(body.ptr(), body.size());
+	}
+
+	singleton->valid_entries.erase(p_script->path);
+}
+
+bool GDScriptBytecodeCache::has_entry(const String &p_path, bool *r_has_body) {
+	if (singleton == nullptr) {
+		return false;
+	}
+
+	MutexLock lock(singleton->mutex);
+	HashSet<String> visiting;
+	HashSet<String> checked;
+	if (!singleton->_is_entry_valid(p_path, visiting, checked)) {
+		return false;
+	}
+	if (r_has_body) {
+		Ref<FileAccess> file = FileAccess::open(singleton->_get_entry_path(p_path), FileAccess::READ);
+		Header header;
+		*r_has_body = file.is_valid() && singleton->_read_header(file, header) == OK && header.has_body;
+	}
+	return true;
+}
+
+void GDScriptBytecodeCache::invalidate(const String &p_path) {
+	if (singleton == nullptr) {
+		return;
+	}
+
+	MutexLock lock(singleton->mutex);
+	singleton->source_hashes.erase(p_path);
+	singleton->pending_entries.erase(p_path);
+	// Other entries may depend on this script.
+	singleton->valid_entries.clear();
+}
+
+GDScriptBytecodeCache::GDScriptBytecodeCache() {
+	singleton = this;
+}
+
+GDScriptBytecodeCache::~GDScriptBytecodeCache() {
+	singleton = nullptr;
+}
@@ -0,0 +1,143 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "gdscript.h"
+#include "gdscript_parser.h"
+
+#include "core/io/file_access.h"
+#include "core/io/stream_peer.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/rb_map.h"
+
+// Stores compiled GDScript classes on disk so they can be restored on the next
+// run without parsing, analyzing, and compiling them again.
+//
+// A cache entry is only used if the engine build, the script source, and the
+// source of every script it references or was analyzed against (recursively)
+// are unchanged. Scripts
+// that hold constants which cannot be restored by path are never cached.
+// Entries are written in native byte order and are local to the machine that
+// wrote them.
+class GDScriptBytecodeCache {
+	static GDScriptBytecodeCache *singleton;
+
+	struct OperatorKey {
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type type_a = Variant::NIL;
+		Variant::Type type_b = Variant::NIL;
+	};
+
+	struct MemberKey {
+		Variant::Type type = Variant::NIL;
+		StringName name;
+	};
+
+	struct ConstructorKey {
+		Variant::Type type = Variant::NIL;
+		int index = 0;
+	};
+
+	// Reverse lookups from validated function pointers to the keys they are
+	// registered with, built the first time a script is saved.
+	bool lookups_built = false;
+	RBMap<Variant::ValidatedOperatorEvaluator, OperatorKey> operator_keys;
+	RBMap<Variant::ValidatedSetter, MemberKey> setter_keys;
+	RBMap<Variant::ValidatedGetter, MemberKey> getter_keys;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setter_keys;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getter_keys;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setter_keys;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getter_keys;
+	RBMap<Variant::ValidatedBuiltInMethod, MemberKey> builtin_method_keys;
+	RBMap<Variant::ValidatedConstructor, ConstructorKey> constructor_keys;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utility_keys;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utility_keys;
+
+	// Per-run memoization, reset when a script is reloaded while running.
+	HashMap<String, String> source_hashes;
+	HashMap<String, bool> valid_entries;
+	String environment_hash;
+
+	// Entries read by `make_scripts()` and not yet consumed by `load()`.
+	HashMap<String, Vector<uint8_t>> pending_entries;
+
+	Mutex mutex;
+
+	class Writer;
+	class Reader;
+
+	struct Header {
+		String source_hash;
+		HashMap<String, String> dependencies;
+		bool has_body = false;
+		String body_hash;
+	};
+
+	void _build_lookups();
+	String _get_source_hash(const String &p_path);
+	String _get_environment_hash();
+	String _get_entry_path(const String &p_path) const;
+	static String _get_body_hash(const Vector<uint8_t> &p_body);
+	Error _read_header(const Ref<FileAccess> &p_file, Header &r_header);
+	static bool _is_same_header(const Header &p_a, const Header &p_b);
+	bool _is_entry_valid(const String &p_path, HashSet<String> &r_visiting, HashSet<String> &r_checked);
+	Error _read_entry(const String &p_path, Vector<uint8_t> &r_body);
+
+	static void _clear_class(GDScript *p_script);
+
+public:
+	static GDScriptBytecodeCache *get_singleton() { return singleton; }
+
+	static bool is_enabled_for(const GDScript *p_script);
+
+	// Raw (de)serialization of a compiled script and its inner classes.
+	// `r_dependencies` receives the paths of other scripts referenced by it.
+	static Error serialize(GDScript *p_script, Vector<uint8_t> &r_data, HashSet<String> *r_dependencies = nullptr);
+	static Error deserialize(GDScript *p_script, const Vector<uint8_t> &p_data);
+
+	// Cache entries on disk. `make_scripts()` restores the inner class tree
+	// for `GDScriptCache::get_shallow_script()`, `load()` and `save()` are
+	// used by `GDScript::reload()`. `save()` records the scripts `p_parser`
+	// depended on, so entries are invalidated when any of them changes.
+	static bool make_scripts(GDScript *p_script);
+	static Error load(GDScript *p_script);
+	static void save(GDScript *p_script, GDScriptParser *p_parser);
+	// Whether an up-to-date entry exists, even if it holds no bytecode.
+	static bool has_entry(const String &p_path, bool *r_has_body = nullptr);
+	static void invalidate(const String &p_path);
+
+	GDScriptBytecodeCache();
+	~GDScriptBytecodeCache();
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
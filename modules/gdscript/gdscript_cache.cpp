@@ -32,10 +32,13 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -191,6 +194,7 @@ void GDScriptCache::remove_script(const String &p_path) {
 	singleton->dependencies.erase(p_path);
 	singleton->shallow_gdscript_cache.erase(p_path);
 	singleton->full_gdscript_cache.erase(p_path);
+	singleton->warmed_parsers.erase(p_path);
 }
 
 Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptParserRef::Status p_status, Error &r_error, const String &p_owner) {
@@ -295,9 +299,12 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	// A valid bytecode cache entry already has the inner classes, which saves parsing the script.
+	if (!GDScriptBytecodeCache::make_scripts(script.ptr())) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -405,6 +412,81 @@ void GDScriptCache::remove_static_script(const String &p_fqcn) {
 	singleton->static_gdscript_cache.erase(p_fqcn);
 }
 
+void GDScriptCache::_warm_up_parse(uint32_t p_index, WarmUpTask *p_tasks) {
+	WarmUpTask &task = p_tasks[p_index];
+	task.parser = memnew(GDScriptParser);
+
+	// Same as the `EMPTY` step of `GDScriptParserRef::raise_status()`, minus the cache lookups.
+	String remapped_path = ResourceLoader::path_remap(task.path);
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		Vector<uint8_t> tokens = get_binary_tokens(remapped_path);
+		task.source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+		task.result = task.parser->parse_binary(tokens, task.path);
+	} else {
+		String source = get_source_code(remapped_path);
+		task.source_hash = source.hash();
+		task.result = task.parser->parse(source, task.path, false);
+	}
+}
+
+void GDScriptCache::warm_up(const Vector<String> &p_paths) {
+	LocalVector<WarmUpTask> tasks;
+	{
+		MutexLock lock(singleton->mutex);
+		for (const String &E : p_paths) {
+			if (singleton->parser_map.has(E) || singleton->full_gdscript_cache.has(E) || !FileAccess::exists(ResourceLoader::path_remap(E))) {
+				continue;
+			}
+			WarmUpTask task;
+			task.path = E;
+			tasks.push_back(task);
+		}
+	}
+	if (tasks.is_empty()) {
+		return;
+	}
+
+	// The first parser registers the annotations, which isn't thread-safe.
+	{
+		GDScriptParser parser;
+	}
+
+	// Parsing doesn't depend on other scripts, so it can be done in parallel. Analysis and
+	// compilation still happen when the scripts are loaded, since they resolve dependencies
+	// through the cache.
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(singleton, &GDScriptCache::_warm_up_parse, tasks.ptr(), tasks.size(), -1, true, SNAME("GDScriptWarmUp"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	MutexLock lock(singleton->mutex);
+	for (WarmUpTask &task : tasks) {
+		if (singleton->parser_map.has(task.path)) {
+			memdelete(task.parser);
+			continue;
+		}
+
+		Ref<GDScriptParserRef> ref;
+		ref.instantiate();
+		ref->path = task.path;
+		ref->parser = task.parser;
+		ref->status = GDScriptParserRef::PARSED;
+		ref->result = task.result;
+		ref->source_hash = task.source_hash;
+		singleton->parser_map[task.path] = ref.ptr();
+		// Keep the parser alive until the script itself is compiled.
+		singleton->warmed_parsers[task.path] = ref;
+	}
+}
+
+Ref<GDScriptParserRef> GDScriptCache::take_warmed_parser(const String &p_path) {
+	MutexLock lock(singleton->mutex);
+	Ref<GDScriptParserRef> ref;
+	if (singleton->warmed_parsers.has(p_path)) {
+		ref = singleton->warmed_parsers[p_path];
+		singleton->warmed_parsers.erase(p_path);
+	}
+	return ref;
+}
+
 void GDScriptCache::clear() {
 	if (singleton == nullptr) {
 		return;
@@ -423,6 +505,7 @@ void GDScriptCache::clear() {
 	}
 
 	singleton->parser_map.clear();
+	singleton->warmed_parsers.clear();
 
 	for (Ref<GDScriptParserRef> &E : parser_map_refs) {
 		if (E.is_valid()) {
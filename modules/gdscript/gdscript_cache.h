@@ -83,8 +83,10 @@ class GDScriptCache {
 	HashMap<String, Ref<GDScript>> full_gdscript_cache;
 	HashMap<String, Ref<GDScript>> static_gdscript_cache;
 	HashMap<String, HashSet<String>> dependencies;
+	HashMap<String, Ref<GDScriptParserRef>> warmed_parsers;
 
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 
@@ -94,6 +96,15 @@ class GDScriptCache {
 
 	Mutex mutex;
 
+	struct WarmUpTask {
+		String path;
+		GDScriptParser *parser = nullptr;
+		uint32_t source_hash = 0;
+		Error result = OK;
+	};
+
+	void _warm_up_parse(uint32_t p_index, WarmUpTask *p_tasks);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
@@ -109,6 +120,9 @@ public:
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
 
+	static void warm_up(const Vector<String> &p_paths);
+	static Ref<GDScriptParserRef> take_warmed_parser(const String &p_path);
+
 	static void clear();
 
 	GDScriptCache();
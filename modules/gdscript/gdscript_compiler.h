@@ -39,6 +39,8 @@
 #include "core/templates/hash_set.h"
 
 class GDScriptCompiler {
+	friend class GDScriptBytecodeCache;
+
 	const GDScriptParser *parser = nullptr;
 	HashSet<GDScript *> parsed_classes;
 	HashSet<GDScript *> parsing_classes;
@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -74,6 +75,7 @@ GDScriptLanguage *script_language_gd = nullptr;
 Ref<ResourceFormatLoaderGDScript> resource_loader_gd;
 Ref<ResourceFormatSaverGDScript> resource_saver_gd;
 GDScriptCache *gdscript_cache = nullptr;
+GDScriptBytecodeCache *gdscript_bytecode_cache = nullptr;
 
 #ifdef TOOLS_ENABLED
 
@@ -155,6 +157,7 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 		ResourceSaver::add_resource_format_saver(resource_saver_gd);
 
 		gdscript_cache = memnew(GDScriptCache);
+		gdscript_bytecode_cache = memnew(GDScriptBytecodeCache);
 
 		GDScriptUtilityFunctions::register_functions();
 	}
@@ -173,6 +176,10 @@ void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
 		ScriptServer::unregister_language(script_language_gd);
 
+		if (gdscript_bytecode_cache) {
+			memdelete(gdscript_bytecode_cache);
+		}
+
 		if (gdscript_cache) {
 			memdelete(gdscript_cache);
 		}
@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  benchmark_gdscript.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_GDSCRIPT_H
+#define BENCHMARK_GDSCRIPT_H
+
+#include "../gdscript.h"
+#include "../gdscript_bytecode_cache.h"
+
+#include "tests/test_benchmark.h"
+
+namespace GDScriptTests {
+
+static const char *benchmark_source = R"(
+extends RefCounted
+
+func fibonacci(n: int) -> int:
+	return n if n < 2 else fibonacci(n - 1) + fibonacci(n - 2)
+
+func typed_loop(n: int) -> int:
+	var total := 0
+	for i in n:
+		total += i * 3 % 7
+	return total
+
+func untyped_loop(n):
+	var total = 0
+	for i in range(n):
+		total += i * 3 % 7
+	return total
+
+func vectors(n: int) -> Vector3:
+	var v := Vector3()
+	for i in n:
+		v += Vector3(i, 1, 2) * 0.5
+	return v
+
+func strings(n: int) -> int:
+	var parts := PackedStringArray()
+	for i in n:
+		parts.append("item %d" % i)
+	return ",".join(parts).length()
+
+func dictionaries(n: int) -> int:
+	var d := {}
+	for i in n:
+		d[i] = i
+	var total := 0
+	for key in d:
+		total += d[key]
+	return total
+
+func _add(a: int, b: int) -> int:
+	return a + b
+
+func method_calls(n: int) -> int:
+	var total := 0
+	for i in n:
+		total = _add(total, i)
+	return total
+)";
+
+// Same issue as in "Load source code dynamically and run it".
+#ifdef TOOLS_ENABLED
+BENCHMARK_CASE("[Benchmark][Modules][GDScript] VM") {
+	BENCHMARK_REPORT("Compile", TestBenchmark::measure_usec([&]() {
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(benchmark_source);
+		ERR_PRINT_OFF;
+		CHECK(gdscript->reload() == OK);
+		ERR_PRINT_ON;
+	}));
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(benchmark_source);
+	ERR_PRINT_OFF;
+	REQUIRE(gdscript->reload() == OK);
+	ERR_PRINT_ON;
+
+	Vector<uint8_t> bytecode;
+	REQUIRE(GDScriptBytecodeCache::serialize(gdscript.ptr(), bytecode) == OK);
+	BENCHMARK_REPORT("Load from bytecode cache", TestBenchmark::measure_usec([&]() {
+		Ref<GDScript> cached = memnew(GDScript);
+		CHECK(GDScriptBytecodeCache::deserialize(cached.ptr(), bytecode) == OK);
+	}));
+
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(gdscript);
+
+	const struct {
+		const char *method;
+		int argument;
+	} calls[] = {
+		{ "fibonacci", 25 },
+		{ "typed_loop", 1000000 },
+		{ "untyped_loop", 1000000 },
+		{ "vectors", 1000000 },
+		{ "strings", 100000 },
+		{ "dictionaries", 100000 },
+		{ "method_calls", 1000000 },
+	};
+	for (const auto &call : calls) {
+		BENCHMARK_REPORT(vformat("%s(%d)", call.method, call.argument), TestBenchmark::measure_usec([&]() {
+			const Variant result = instance->call(call.method, call.argument);
+			CHECK(result.get_type() != Variant::NIL);
+		}));
+	}
+}
+#endif // TOOLS_ENABLED
+
+} // namespace GDScriptTests
+
+#endif // BENCHMARK_GDSCRIPT_H
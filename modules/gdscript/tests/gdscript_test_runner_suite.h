@@ -33,6 +33,13 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -70,6 +77,269 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+
+TEST_CASE("[Modules][GDScript] Restore compiled script from cached bytecode") {
+	Ref<GDScript> source = memnew(GDScript);
+	source->set_source_code(R"(
+extends RefCounted
+
+const OFFSETS = [1, 2, 3]
+
+class Inner:
+	var value := 10
+
+	func get_value() -> int:
+		return value
+
+func _init():
+	var sum := func(a: int, b: int) -> int: return a + b
+	set_meta("result", sum.call(Inner.new().get_value(), OFFSETS[2]))
+)");
+	ERR_PRINT_OFF;
+	const Error error = source->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Vector<uint8_t> data;
+	REQUIRE_MESSAGE(GDScriptBytecodeCache::serialize(source.ptr(), data) == OK, "The compiled script should be serializable.");
+	CHECK(data.size() > 0);
+
+	Ref<GDScript> restored = memnew(GDScript);
+	REQUIRE_MESSAGE(GDScriptBytecodeCache::deserialize(restored.ptr(), data) == OK, "The cached bytecode should be restored.");
+	CHECK(restored->is_valid());
+	CHECK(restored->has_method("_init"));
+	CHECK(restored->get_constants().has("OFFSETS"));
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(restored);
+	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 13, "The restored script should behave like the compiled one.");
+
+	Vector<uint8_t> truncated = data;
+	truncated.resize(data.size() / 2);
+	Ref<GDScript> corrupt = memnew(GDScript);
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(GDScriptBytecodeCache::deserialize(corrupt.ptr(), truncated) != OK, "Truncated bytecode should be rejected.");
+	ERR_PRINT_ON;
+	CHECK_FALSE(corrupt->is_valid());
+}
+
+TEST_CASE("[Modules][GDScript] Reject cached bytecode that reads out of bounds") {
+	Ref<GDScript> source = memnew(GDScript);
+	source->set_source_code(R"(
+extends RefCounted
+
+func get_value():
+	return 7
+)");
+	ERR_PRINT_OFF;
+	const Error error = source->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	Vector<uint8_t> data;
+	REQUIRE(GDScriptBytecodeCache::serialize(source.ptr(), data) == OK);
+
+	// `return 7` reads the only constant of the function.
+	const int instruction[2] = { GDScriptFunction::OPCODE_RETURN, GDScriptFunction::ADDR_TYPE_CONSTANT << GDScriptFunction::ADDR_BITS };
+	int offset = -1;
+	for (int i = 0; i + (int)sizeof(instruction) <= data.size(); i++) {
+		if (memcmp(data.ptr() + i, instruction, sizeof(instruction)) == 0) {
+			offset = i;
+			break;
+		}
+	}
+	REQUIRE_MESSAGE(offset >= 0, "The return instruction should be in the bytecode.");
+
+	const int past_constants = instruction[1] + 1;
+	memcpy(data.ptrw() + offset + sizeof(int), &past_constants, sizeof(int));
+	Ref<GDScript> corrupt = memnew(GDScript);
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(GDScriptBytecodeCache::deserialize(corrupt.ptr(), data) != OK, "Bytecode reading past the constants should be rejected.");
+	ERR_PRINT_ON;
+	CHECK_FALSE(corrupt->is_valid());
+}
+
+static void write_test_script(const String &p_path, const String &p_source) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_source);
+}
+
+// Loads the script like a new run would, with nothing remembered from the previous one.
+static Variant run_cached_script(const String &p_path, const Vector<String> &p_edited_paths) {
+	for (const String &E : p_edited_paths) {
+		GDScriptBytecodeCache::invalidate(E);
+		GDScriptCache::remove_script(E);
+	}
+	Error error = OK;
+	ERR_PRINT_OFF;
+	Ref<GDScript> gdscript = GDScriptCache::get_full_script(p_path, error);
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should load.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	return ref_counted->call("get_value");
+}
+
+TEST_CASE("[Modules][GDScript] Invalidate bytecode cache entries on disk") {
+	const Variant was_enabled = GLOBAL_GET("gdscript/bytecode_cache/enabled");
+	const Variant old_cache_path = GLOBAL_GET("gdscript/bytecode_cache/path");
+	const String cache_path = OS::get_singleton()->get_cache_path().path_join("gdscript_bytecode_cache_test");
+	ProjectSettings::get_singleton()->set_setting("gdscript/bytecode_cache/enabled", true);
+	ProjectSettings::get_singleton()->set_setting("gdscript/bytecode_cache/path", cache_path);
+
+	// Scripts must have a resource path to be cached.
+	const String directory = "res://.gdscript_bytecode_cache_test";
+	REQUIRE(DirAccess::make_dir_recursive_absolute(directory) == OK);
+	const String dependency_path = directory.path_join("dependency.gd");
+	const String script_path = directory.path_join("script.gd");
+	const String header_only_path = directory.path_join("header_only.gd");
+	Vector<String> all_paths;
+	all_paths.push_back(dependency_path);
+	all_paths.push_back(script_path);
+	all_paths.push_back(header_only_path);
+
+	write_test_script(dependency_path, "const VALUE = 42\n");
+	// Only the folded value of the constant ends up in the bytecode.
+	const String source = vformat(R"(extends RefCounted
+
+const VALUE = preload("%s").VALUE * 2
+
+func get_value() -> int:
+	return VALUE
+)",
+			dependency_path);
+	write_test_script(script_path, source);
+
+	bool has_body = false;
+	SUBCASE("Entries are reused until a source changes") {
+		CHECK(run_cached_script(script_path, all_paths) == Variant(84));
+		CHECK(GDScriptBytecodeCache::has_entry(script_path, &has_body));
+		CHECK(has_body);
+		CHECK(run_cached_script(script_path, all_paths) == Variant(84));
+		CHECK(GDScriptBytecodeCache::has_entry(script_path));
+
+		write_test_script(script_path, source.replace("* 2", "* 3"));
+		GDScriptBytecodeCache::invalidate(script_path);
+		CHECK_FALSE_MESSAGE(GDScriptBytecodeCache::has_entry(script_path), "Editing the script should invalidate its entry.");
+		CHECK(run_cached_script(script_path, all_paths) == Variant(126));
+		CHECK(GDScriptBytecodeCache::has_entry(script_path));
+	}
+
+	SUBCASE("Entries are invalidated by scripts used for folded constants") {
+		CHECK(run_cached_script(script_path, all_paths) == Variant(84));
+		CHECK(GDScriptBytecodeCache::has_entry(script_path));
+
+		write_test_script(dependency_path, "const VALUE = 10\n");
+		GDScriptBytecodeCache::invalidate(dependency_path);
+		CHECK_FALSE_MESSAGE(GDScriptBytecodeCache::has_entry(script_path), "Editing a dependency should invalidate the entry.");
+		CHECK(run_cached_script(script_path, all_paths) == Variant(20));
+		CHECK(GDScriptBytecodeCache::has_entry(script_path));
+	}
+
+	SUBCASE("Damaged entries are compiled again") {
+		CHECK(run_cached_script(script_path, all_paths) == Variant(84));
+		CHECK(GDScriptBytecodeCache::has_entry(script_path));
+
+		const String entry_path = cache_path.path_join(script_path.md5_text() + ".gdbc");
+		{
+			Ref<FileAccess> f = FileAccess::open(entry_path, FileAccess::READ_WRITE);
+			REQUIRE(f.is_valid());
+			f->seek(f->get_length() - 1);
+			const uint8_t last = f->get_8();
+			f->seek(f->get_length() - 1);
+			f->store_8(~last);
+		}
+		CHECK_MESSAGE(run_cached_script(script_path, all_paths) == Variant(84), "A body that doesn't match its hash should be compiled again.");
+		CHECK(GDScriptBytecodeCache::has_entry(script_path, &has_body));
+		CHECK(has_body);
+	}
+
+	SUBCASE("Header-only entries are only written when they change") {
+		// Callables can't be cached, so the script is compiled on every run.
+		write_test_script(header_only_path, R"(extends RefCounted
+
+const NO_CALLBACK = Callable()
+
+func get_value() -> int:
+	return 1
+)");
+		CHECK(run_cached_script(header_only_path, all_paths) == Variant(1));
+		CHECK(GDScriptBytecodeCache::has_entry(header_only_path, &has_body));
+		CHECK_FALSE(has_body);
+
+		// Extra data after the header is ignored, but a rewritten entry wouldn't have it.
+		const String entry_path = cache_path.path_join(header_only_path.md5_text() + ".gdbc");
+		uint64_t length = 0;
+		{
+			Ref<FileAccess> f = FileAccess::open(entry_path, FileAccess::READ_WRITE);
+			REQUIRE(f.is_valid());
+			f->seek_end();
+			f->store_8(0);
+			length = f->get_length();
+		}
+		CHECK(run_cached_script(header_only_path, all_paths) == Variant(1));
+		CHECK_MESSAGE(FileAccess::open(entry_path, FileAccess::READ)->get_length() == length, "An unchanged header-only entry should not be rewritten.");
+
+		write_test_script(header_only_path, R"(extends RefCounted
+
+const NO_CALLBACK = Callable()
+
+func get_value() -> int:
+	return 2
+)");
+		CHECK(run_cached_script(header_only_path, all_paths) == Variant(2));
+		CHECK(GDScriptBytecodeCache::has_entry(header_only_path));
+		CHECK_MESSAGE(FileAccess::open(entry_path, FileAccess::READ)->get_length() != length, "A changed header-only entry should be rewritten.");
+	}
+
+	for (const String &E : all_paths) {
+		GDScriptBytecodeCache::invalidate(E);
+		GDScriptCache::remove_script(E);
+		DirAccess::remove_absolute(E);
+		DirAccess::remove_absolute(cache_path.path_join(E.md5_text() + ".gdbc"));
+	}
+	DirAccess::remove_absolute(directory);
+	DirAccess::remove_absolute(cache_path);
+	ProjectSettings::get_singleton()->set_setting("gdscript/bytecode_cache/enabled", was_enabled);
+	ProjectSettings::get_singleton()->set_setting("gdscript/bytecode_cache/path", old_cache_path);
+}
+
+TEST_CASE("[Modules][GDScript] Compile scripts from warmed up parsers") {
+	const String path = OS::get_singleton()->get_cache_path().path_join("gdscript_warm_up.gd");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(R"(
+extends RefCounted
+
+func _init():
+	set_meta("result", 42)
+)");
+	}
+
+	Vector<String> paths;
+	paths.push_back(path);
+	GDScriptCache::warm_up(paths);
+	CHECK_MESSAGE(GDScriptCache::has_parser(path), "The script should be parsed ahead of time.");
+
+	Error error = OK;
+	ERR_PRINT_OFF;
+	Ref<GDScript> gdscript = GDScriptCache::get_full_script(path, error);
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile from the warmed up parser.");
+	CHECK_MESSAGE(GDScriptCache::take_warmed_parser(path).is_null(), "Compiling the script should consume its warmed up parser.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	CHECK(int(ref_counted->get_meta("result")) == 42);
+
+	ref_counted.unref();
+	gdscript.unref();
+	GDScriptCache::remove_script(path);
+	DirAccess::remove_absolute(path);
+}
 #endif // TOOLS_ENABLED
 
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
@@ -292,6 +292,211 @@ int GridMap::get_octant_size() const {
 	return octant_size;
 }
 
+void GridMap::set_octant_updates_threaded(bool p_enabled) {
+	if (octant_updates_threaded == p_enabled) {
+		return;
+	}
+	octant_updates_threaded = p_enabled;
+
+	if (!octant_updates_threaded && octant_build_batch) {
+		// Commit what is still pending right away, then rebuild anything left dirty.
+		if (octant_build_batch->task != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(octant_build_batch->task);
+			octant_build_batch->task = WorkerThreadPool::INVALID_TASK_ID;
+		}
+		for (uint32_t i = octant_build_batch->committed; i < octant_build_batch->builds.size(); i++) {
+			if (_octant_commit(octant_build_batch->builds[i])) {
+				memdelete(octant_map[octant_build_batch->builds[i].key]);
+				octant_map.erase(octant_build_batch->builds[i].key);
+			}
+		}
+		_discard_octant_build_batch();
+		_update_visibility();
+		_queue_octants_dirty();
+	}
+}
+
+bool GridMap::is_octant_updates_threaded() const {
+	return octant_updates_threaded;
+}
+
+void GridMap::set_octant_updates_per_frame(int p_count) {
+	ERR_FAIL_COND(p_count < 1);
+	octant_updates_per_frame = p_count;
+}
+
+int GridMap::get_octant_updates_per_frame() const {
+	return octant_updates_per_frame;
+}
+
+void GridMap::set_hlod_enabled(bool p_enabled) {
+	if (hlod_enabled == p_enabled) {
+		return;
+	}
+	hlod_enabled = p_enabled;
+	_recreate_octant_data();
+}
+
+bool GridMap::is_hlod_enabled() const {
+	return hlod_enabled;
+}
+
+void GridMap::set_hlod_distance(real_t p_distance) {
+	ERR_FAIL_COND(p_distance < 0.0);
+	hlod_distance = p_distance;
+	if (hlod_enabled) {
+		_recreate_octant_data();
+	}
+}
+
+real_t GridMap::get_hlod_distance() const {
+	return hlod_distance;
+}
+
+void GridMap::set_hlod_detail(float p_detail) {
+	hlod_detail = CLAMP(p_detail, 0.0, 1.0);
+	if (hlod_enabled) {
+		_recreate_octant_data();
+	}
+}
+
+float GridMap::get_hlod_detail() const {
+	return hlod_detail;
+}
+
+void GridMap::_cache_hlod_item_surfaces(int p_item) {
+	Vector<HLODSurface> &surfaces = hlod_item_surfaces[p_item];
+	if (mesh_library.is_null() || !mesh_library->has_item(p_item)) {
+		return;
+	}
+
+	Ref<Mesh> mesh = mesh_library->get_item_mesh(p_item);
+	if (mesh.is_null()) {
+		return;
+	}
+
+	for (int i = 0; i < mesh->get_surface_count(); i++) {
+		if (mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
+			continue;
+		}
+
+		Array arrays = mesh->surface_get_arrays(i);
+		HLODSurface surface;
+		surface.material = mesh->surface_get_material(i);
+		surface.vertices = arrays[Mesh::ARRAY_VERTEX];
+		surface.normals = arrays[Mesh::ARRAY_NORMAL];
+		surface.uvs = arrays[Mesh::ARRAY_TEX_UV];
+		surface.indices = arrays[Mesh::ARRAY_INDEX];
+		if (surface.vertices.is_empty()) {
+			continue;
+		}
+		if (surface.normals.size() != surface.vertices.size()) {
+			surface.normals.resize(surface.vertices.size());
+			surface.normals.fill(Vector3(0, 1, 0));
+		}
+		if (surface.uvs.size() != surface.vertices.size()) {
+			surface.uvs.resize(surface.vertices.size());
+			surface.uvs.fill(Vector2());
+		}
+		if (surface.indices.is_empty()) {
+			surface.indices.resize(surface.vertices.size());
+			int *w = surface.indices.ptrw();
+			for (int j = 0; j < surface.indices.size(); j++) {
+				w[j] = j;
+			}
+		}
+		surfaces.push_back(surface);
+	}
+}
+
+void GridMap::_simplify_hlod_surface(HLODSurface &r_surface, float p_detail) {
+	if (!SurfaceTool::simplify_func || !SurfaceTool::generate_remap_func || !SurfaceTool::remap_vertex_func || !SurfaceTool::remap_index_func) {
+		// Without meshoptimizer, the merged octant is still a single instance, just not a simpler one.
+		return;
+	}
+
+	// Position first, so the same data can be given to the simplifier with the attributes following it.
+	struct HLODVertex {
+		float position[3];
+		float normal[3];
+		float uv[2];
+	};
+
+	const unsigned int index_count = r_surface.indices.size();
+	const unsigned int vertex_count = r_surface.vertices.size();
+	if (index_count == 0) {
+		return;
+	}
+
+	LocalVector<HLODVertex> vertices;
+	vertices.resize(vertex_count);
+	for (unsigned int i = 0; i < vertex_count; i++) {
+		HLODVertex &v = vertices[i];
+		v.position[0] = r_surface.vertices[i].x;
+		v.position[1] = r_surface.vertices[i].y;
+		v.position[2] = r_surface.vertices[i].z;
+		v.normal[0] = r_surface.normals[i].x;
+		v.normal[1] = r_surface.normals[i].y;
+		v.normal[2] = r_surface.normals[i].z;
+		v.uv[0] = r_surface.uvs[i].x;
+		v.uv[1] = r_surface.uvs[i].y;
+	}
+
+	// Cells don't share vertices, so weld the identical ones first, or the simplifier can't collapse across cell borders.
+	// Vertices that only share their position are kept apart: the simplifier treats them as a seam, and collapses
+	// along it without mixing the normals and UVs on either side.
+	LocalVector<unsigned int> remap;
+	remap.resize(vertex_count);
+	const unsigned int *indices = (const unsigned int *)r_surface.indices.ptr();
+	const size_t unique_count = SurfaceTool::generate_remap_func(remap.ptr(), indices, index_count, vertices.ptr(), vertex_count, sizeof(HLODVertex));
+
+	LocalVector<HLODVertex> welded_vertices;
+	welded_vertices.resize(unique_count);
+	SurfaceTool::remap_vertex_func(welded_vertices.ptr(), vertices.ptr(), vertex_count, sizeof(HLODVertex), remap.ptr());
+
+	LocalVector<unsigned int> welded_indices;
+	welded_indices.resize(index_count);
+	SurfaceTool::remap_index_func(welded_indices.ptr(), indices, index_count, remap.ptr());
+
+	size_t target_index_count = MAX(size_t(index_count * p_detail) / 3 * 3, (size_t)3);
+	LocalVector<unsigned int> simplified;
+	simplified.resize(index_count);
+	float error = 0.0;
+	// Stop before the shape drifts more than 5% of the octant's size, whatever the requested detail.
+	const float target_error = 0.05;
+	size_t simplified_count;
+	if (SurfaceTool::simplify_with_attrib_func) {
+		// Give some weight to the normals and UVs, so the simplifier also keeps the shading and texturing in mind.
+		const float attribute_weights[5] = { 1.0, 1.0, 1.0, 0.5, 0.5 };
+		simplified_count = SurfaceTool::simplify_with_attrib_func(simplified.ptr(), welded_indices.ptr(), index_count, welded_vertices[0].position, unique_count, sizeof(HLODVertex), welded_vertices[0].normal, sizeof(HLODVertex), attribute_weights, 5, target_index_count, target_error, 0, &error);
+	} else {
+		simplified_count = SurfaceTool::simplify_func(simplified.ptr(), welded_indices.ptr(), index_count, welded_vertices[0].position, unique_count, sizeof(HLODVertex), target_index_count, target_error, 0, &error);
+	}
+
+	// The simplifier only drops triangles, so keep the vertices still used with their original attributes.
+	LocalVector<int> used;
+	used.resize(unique_count);
+	for (size_t i = 0; i < unique_count; i++) {
+		used[i] = -1;
+	}
+	r_surface.vertices.clear();
+	r_surface.normals.clear();
+	r_surface.uvs.clear();
+	r_surface.indices.resize(simplified_count);
+	int *w = r_surface.indices.ptrw();
+	for (size_t i = 0; i < simplified_count; i++) {
+		const unsigned int vertex = simplified[i];
+		if (used[vertex] < 0) {
+			const HLODVertex &v = welded_vertices[vertex];
+			used[vertex] = r_surface.vertices.size();
+			r_surface.vertices.push_back(Vector3(v.position[0], v.position[1], v.position[2]));
+			r_surface.normals.push_back(Vector3(v.normal[0], v.normal[1], v.normal[2]));
+			r_surface.uvs.push_back(Vector2(v.uv[0], v.uv[1]));
+		}
+		w[i] = used[vertex];
+	}
+}
+
 void GridMap::set_center_x(bool p_enable) {
 	center_x = p_enable;
 	_recreate_octant_data();
@@ -538,14 +743,195 @@ void GridMap::_octant_transform(const OctantKey &p_key) {
 	for (int i = 0; i < g.multimesh_instances.size(); i++) {
 		RS::get_singleton()->instance_set_transform(g.multimesh_instances[i].instance, get_global_transform());
 	}
+
+	if (g.hlod_instance.is_valid()) {
+		RS::get_singleton()->instance_set_transform(g.hlod_instance, get_global_transform());
+	}
 }
 
-bool GridMap::_octant_update(const OctantKey &p_key) {
-	ERR_FAIL_COND_V(!octant_map.has(p_key), false);
-	Octant &g = *octant_map[p_key];
-	if (!g.dirty) {
+GridMap::OctantBuildBatch *GridMap::_create_octant_build_batch() {
+	OctantBuildBatch *batch = memnew(OctantBuildBatch);
+	batch->cell_size = cell_size;
+	batch->offset = _get_offset();
+	batch->cell_scale = cell_scale;
+	batch->build_multimeshes = baked_meshes.size() == 0;
+	batch->build_hlod = hlod_enabled && batch->build_multimeshes && mesh_library.is_valid();
+	batch->hlod_detail = hlod_detail;
+
+	for (KeyValue<OctantKey, Octant *> &E : octant_map) {
+		Octant &g = *E.value;
+		if (!g.dirty) {
+			continue;
+		}
+
+		batch->builds.push_back(OctantBuild());
+		OctantBuild &build = batch->builds[batch->builds.size() - 1];
+		build.key = E.key;
+		build.cells.reserve(g.cells.size());
+		for (const IndexKey &F : g.cells) {
+			const Cell *c = cell_map.getptr(F);
+			ERR_CONTINUE(!c);
+			build.cells.push_back(Pair<IndexKey, Cell>(F, *c));
+			if (mesh_library.is_valid() && !batch->items.has(c->item) && mesh_library->has_item(c->item)) {
+				OctantBuildBatch::ItemData &item = batch->items[c->item];
+				item.mesh = mesh_library->get_item_mesh(c->item);
+				item.mesh_transform = mesh_library->get_item_mesh_transform(c->item);
+				item.shapes = mesh_library->get_item_shapes(c->item);
+				item.navigation_mesh = mesh_library->get_item_navigation_mesh(c->item);
+				item.navigation_mesh_transform = mesh_library->get_item_navigation_mesh_transform(c->item);
+				item.navigation_layers = mesh_library->get_item_navigation_layers(c->item);
+			}
+			if (batch->build_hlod && !hlod_item_surfaces.has(c->item)) {
+				_cache_hlod_item_surfaces(c->item);
+			}
+		}
+		g.dirty = false;
+	}
+
+	if (batch->build_hlod) {
+		batch->hlod_item_surfaces = hlod_item_surfaces;
+	}
+
+	return batch;
+}
+
+void GridMap::_octant_build(uint32_t p_index, OctantBuildBatch *p_batch) {
+	OctantBuild &build = p_batch->builds[p_index];
+
+	/*
+	 * foreach item in this octant,
+	 * set item's multimesh's instance count to number of cells which have this item
+	 * and set said multimesh bounding box to one containing all cells which have this item
+	 */
+
+	HashMap<int, LocalVector<Pair<Transform3D, IndexKey>>> multimesh_items;
+
+	for (const Pair<IndexKey, Cell> &E : build.cells) {
+		const Cell &c = E.second;
+
+		const OctantBuildBatch::ItemData *item = p_batch->items.getptr(c.item);
+		if (!item) {
+			continue;
+		}
+
+		Vector3 cellpos = Vector3(E.first.x, E.first.y, E.first.z);
+
+		Transform3D xform;
+
+		xform.basis = _ortho_bases[c.rot];
+		xform.set_origin(cellpos * p_batch->cell_size + p_batch->offset);
+		xform.basis.scale(Vector3(p_batch->cell_scale, p_batch->cell_scale, p_batch->cell_scale));
+		if (p_batch->build_multimeshes && item->mesh.is_valid()) {
+			const Transform3D mesh_xform = xform * item->mesh_transform;
+			multimesh_items[c.item].push_back(Pair<Transform3D, IndexKey>(mesh_xform, E.first));
+
+			const Vector<HLODSurface> *item_surfaces = p_batch->build_hlod ? p_batch->hlod_item_surfaces.getptr(c.item) : nullptr;
+			if (item_surfaces) {
+				// Merge the item into the octant's surface using the same material.
+				for (const HLODSurface &F : *item_surfaces) {
+					HLODSurface *surface = nullptr;
+					for (HLODSurface &G : build.hlod_surfaces) {
+						if (G.material == F.material) {
+							surface = &G;
+							break;
+						}
+					}
+					if (!surface) {
+						build.hlod_surfaces.push_back(HLODSurface());
+						surface = &build.hlod_surfaces[build.hlod_surfaces.size() - 1];
+						surface->material = F.material;
+					}
+
+					const int base = surface->vertices.size();
+					surface->vertices.resize(base + F.vertices.size());
+					surface->normals.resize(base + F.vertices.size());
+					surface->uvs.resize(base + F.vertices.size());
+					Vector3 *vertices = surface->vertices.ptrw() + base;
+					Vector3 *normals = surface->normals.ptrw() + base;
+					Vector2 *uvs = surface->uvs.ptrw() + base;
+					for (int i = 0; i < F.vertices.size(); i++) {
+						vertices[i] = mesh_xform.xform(F.vertices[i]);
+						normals[i] = mesh_xform.basis.xform(F.normals[i]).normalized();
+						uvs[i] = F.uvs[i];
+					}
+
+					const int index_base = surface->indices.size();
+					surface->indices.resize(index_base + F.indices.size());
+					int *indices = surface->indices.ptrw() + index_base;
+					for (int i = 0; i < F.indices.size(); i++) {
+						indices[i] = base + F.indices[i];
+					}
+				}
+			}
+		}
+
+		for (const MeshLibrary::ShapeData &F : item->shapes) {
+			if (!F.shape.is_valid()) {
+				continue;
+			}
+			OctantBuild::ShapeData shape;
+			shape.shape = F.shape;
+			shape.xform = xform * F.local_transform;
+			build.shapes.push_back(shape);
+		}
+
+		if (item->navigation_mesh.is_valid()) {
+			OctantBuild::NavigationData nav;
+			nav.key = E.first;
+			nav.navigation_mesh = item->navigation_mesh;
+			nav.xform = xform * item->navigation_mesh_transform;
+			nav.navigation_layers = item->navigation_layers;
+			build.navigation_cells.push_back(nav);
+		}
+	}
+
+	// Fill the instance buffers here, so committing a multimesh is a single server call.
+	for (const KeyValue<int, LocalVector<Pair<Transform3D, IndexKey>>> &E : multimesh_items) {
+		OctantBuild::MultimeshData mm;
+		mm.mesh = p_batch->items.get(E.key).mesh;
+		mm.buffer.resize(E.value.size() * 12);
+		float *w = mm.buffer.ptrw();
+
+		for (uint32_t i = 0; i < E.value.size(); i++) {
+			const Transform3D &t = E.value[i].first;
+			float *ptr = w + i * 12;
+			ptr[0] = t.basis.rows[0][0];
+			ptr[1] = t.basis.rows[0][1];
+			ptr[2] = t.basis.rows[0][2];
+			ptr[3] = t.origin.x;
+			ptr[4] = t.basis.rows[1][0];
+			ptr[5] = t.basis.rows[1][1];
+			ptr[6] = t.basis.rows[1][2];
+			ptr[7] = t.origin.y;
+			ptr[8] = t.basis.rows[2][0];
+			ptr[9] = t.basis.rows[2][1];
+			ptr[10] = t.basis.rows[2][2];
+			ptr[11] = t.origin.z;
+#ifdef TOOLS_ENABLED
+
+			Octant::MultimeshInstance::Item it;
+			it.index = i;
+			it.transform = t;
+			it.key = E.value[i].second;
+			mm.items.push_back(it);
+#endif
+		}
+
+		build.multimeshes.push_back(mm);
+	}
+
+	for (HLODSurface &E : build.hlod_surfaces) {
+		_simplify_hlod_surface(E, p_batch->hlod_detail);
+	}
+}
+
+bool GridMap::_octant_commit(const OctantBuild &p_build) {
+	Octant **octant = octant_map.getptr(p_build.key);
+	if (!octant) {
+		// Removed since the build was made.
 		return false;
 	}
+	Octant &g = **octant;
 
 	//erase body shapes
 	PhysicsServer3D::get_singleton()->body_clear_shapes(g.static_body);
@@ -576,136 +962,88 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 	}
 	g.multimesh_instances.clear();
 
+	//erase merged far mesh
+	if (g.hlod_instance.is_valid()) {
+		RS::get_singleton()->free(g.hlod_instance);
+		RS::get_singleton()->free(g.hlod_mesh);
+		g.hlod_instance = RID();
+		g.hlod_mesh = RID();
+	}
+
 	if (g.cells.size() == 0) {
 		//octant no longer needed
-		_octant_clean_up(p_key);
+		_octant_clean_up(p_build.key);
 		return true;
 	}
 
+	// add the items' shapes to octant's static_body
 	Vector<Vector3> col_debug;
-
-	/*
-	 * foreach item in this octant,
-	 * set item's multimesh's instance count to number of cells which have this item
-	 * and set said multimesh bounding box to one containing all cells which have this item
-	 */
-
-	HashMap<int, List<Pair<Transform3D, IndexKey>>> multimesh_items;
-
-	for (const IndexKey &E : g.cells) {
-		ERR_CONTINUE(!cell_map.has(E));
-		const Cell &c = cell_map[E];
-
-		if (!mesh_library.is_valid() || !mesh_library->has_item(c.item)) {
-			continue;
+	for (const OctantBuild::ShapeData &E : p_build.shapes) {
+		PhysicsServer3D::get_singleton()->body_add_shape(g.static_body, E.shape->get_rid(), E.xform);
+		if (g.collision_debug.is_valid()) {
+			E.shape->add_vertices_to_array(col_debug, E.xform);
 		}
+	}
 
-		Vector3 cellpos = Vector3(E.x, E.y, E.z);
-		Vector3 ofs = _get_offset();
-
-		Transform3D xform;
+	// add the items' navigation_mesh to GridMap's Navigation ancestor
+	for (const OctantBuild::NavigationData &E : p_build.navigation_cells) {
+		Octant::NavigationCell nm;
+		nm.xform = E.xform;
+		nm.navigation_layers = E.navigation_layers;
 
-		xform.basis = _ortho_bases[c.rot];
-		xform.set_origin(cellpos * cell_size + ofs);
-		xform.basis.scale(Vector3(cell_scale, cell_scale, cell_scale));
-		if (baked_meshes.size() == 0) {
-			if (mesh_library->get_item_mesh(c.item).is_valid()) {
-				if (!multimesh_items.has(c.item)) {
-					multimesh_items[c.item] = List<Pair<Transform3D, IndexKey>>();
+		if (bake_navigation) {
+			RID region = NavigationServer3D::get_singleton()->region_create();
+			NavigationServer3D::get_singleton()->region_set_owner_id(region, get_instance_id());
+			NavigationServer3D::get_singleton()->region_set_navigation_layers(region, nm.navigation_layers);
+			NavigationServer3D::get_singleton()->region_set_navigation_mesh(region, E.navigation_mesh);
+			NavigationServer3D::get_singleton()->region_set_transform(region, get_global_transform() * nm.xform);
+			if (is_inside_tree()) {
+				if (map_override.is_valid()) {
+					NavigationServer3D::get_singleton()->region_set_map(region, map_override);
+				} else {
+					NavigationServer3D::get_singleton()->region_set_map(region, get_world_3d()->get_navigation_map());
 				}
-
-				Pair<Transform3D, IndexKey> p;
-				p.first = xform * mesh_library->get_item_mesh_transform(c.item);
-				p.second = E;
-				multimesh_items[c.item].push_back(p);
-			}
-		}
-
-		Vector<MeshLibrary::ShapeData> shapes = mesh_library->get_item_shapes(c.item);
-		// add the item's shape at given xform to octant's static_body
-		for (int i = 0; i < shapes.size(); i++) {
-			// add the item's shape
-			if (!shapes[i].shape.is_valid()) {
-				continue;
 			}
-			PhysicsServer3D::get_singleton()->body_add_shape(g.static_body, shapes[i].shape->get_rid(), xform * shapes[i].local_transform);
-			if (g.collision_debug.is_valid()) {
-				shapes.write[i].shape->add_vertices_to_array(col_debug, xform * shapes[i].local_transform);
-			}
-		}
-
-		// add the item's navigation_mesh at given xform to GridMap's Navigation ancestor
-		Ref<NavigationMesh> navigation_mesh = mesh_library->get_item_navigation_mesh(c.item);
-		if (navigation_mesh.is_valid()) {
-			Octant::NavigationCell nm;
-			nm.xform = xform * mesh_library->get_item_navigation_mesh_transform(c.item);
-			nm.navigation_layers = mesh_library->get_item_navigation_layers(c.item);
-
-			if (bake_navigation) {
-				RID region = NavigationServer3D::get_singleton()->region_create();
-				NavigationServer3D::get_singleton()->region_set_owner_id(region, get_instance_id());
-				NavigationServer3D::get_singleton()->region_set_navigation_layers(region, nm.navigation_layers);
-				NavigationServer3D::get_singleton()->region_set_navigation_mesh(region, navigation_mesh);
-				NavigationServer3D::get_singleton()->region_set_transform(region, get_global_transform() * nm.xform);
-				if (is_inside_tree()) {
-					if (map_override.is_valid()) {
-						NavigationServer3D::get_singleton()->region_set_map(region, map_override);
-					} else {
-						NavigationServer3D::get_singleton()->region_set_map(region, get_world_3d()->get_navigation_map());
-					}
-				}
-				nm.region = region;
+			nm.region = region;
 
 #ifdef DEBUG_ENABLED
-				// add navigation debugmesh visual instances if debug is enabled
-				SceneTree *st = SceneTree::get_singleton();
-				if (st && st->is_debugging_navigation_hint()) {
-					if (!nm.navigation_mesh_debug_instance.is_valid()) {
-						RID navigation_mesh_debug_rid = navigation_mesh->get_debug_mesh()->get_rid();
-						nm.navigation_mesh_debug_instance = RS::get_singleton()->instance_create();
-						RS::get_singleton()->instance_set_base(nm.navigation_mesh_debug_instance, navigation_mesh_debug_rid);
-					}
-					if (is_inside_tree()) {
-						RS::get_singleton()->instance_set_scenario(nm.navigation_mesh_debug_instance, get_world_3d()->get_scenario());
-						RS::get_singleton()->instance_set_transform(nm.navigation_mesh_debug_instance, get_global_transform() * nm.xform);
-					}
+			// add navigation debugmesh visual instances if debug is enabled
+			SceneTree *st = SceneTree::get_singleton();
+			if (st && st->is_debugging_navigation_hint()) {
+				if (!nm.navigation_mesh_debug_instance.is_valid()) {
+					RID navigation_mesh_debug_rid = E.navigation_mesh->get_debug_mesh()->get_rid();
+					nm.navigation_mesh_debug_instance = RS::get_singleton()->instance_create();
+					RS::get_singleton()->instance_set_base(nm.navigation_mesh_debug_instance, navigation_mesh_debug_rid);
+				}
+				if (is_inside_tree()) {
+					RS::get_singleton()->instance_set_scenario(nm.navigation_mesh_debug_instance, get_world_3d()->get_scenario());
+					RS::get_singleton()->instance_set_transform(nm.navigation_mesh_debug_instance, get_global_transform() * nm.xform);
 				}
-#endif // DEBUG_ENABLED
 			}
-			g.navigation_cell_ids[E] = nm;
+#endif // DEBUG_ENABLED
 		}
+		g.navigation_cell_ids[E.key] = nm;
 	}
 
 #ifdef DEBUG_ENABLED
 	if (bake_navigation) {
-		_update_octant_navigation_debug_edge_connections_mesh(p_key);
+		_update_octant_navigation_debug_edge_connections_mesh(p_build.key);
 	}
 #endif // DEBUG_ENABLED
 
 	//update multimeshes, only if not baked
 	if (baked_meshes.size() == 0) {
-		for (const KeyValue<int, List<Pair<Transform3D, IndexKey>>> &E : multimesh_items) {
+		for (const OctantBuild::MultimeshData &E : p_build.multimeshes) {
 			Octant::MultimeshInstance mmi;
 
 			RID mm = RS::get_singleton()->multimesh_create();
-			RS::get_singleton()->multimesh_allocate_data(mm, E.value.size(), RS::MULTIMESH_TRANSFORM_3D);
-			RS::get_singleton()->multimesh_set_mesh(mm, mesh_library->get_item_mesh(E.key)->get_rid());
-
-			int idx = 0;
-			for (const Pair<Transform3D, IndexKey> &F : E.value) {
-				RS::get_singleton()->multimesh_instance_set_transform(mm, idx, F.first);
+			RS::get_singleton()->multimesh_allocate_data(mm, E.buffer.size() / 12, RS::MULTIMESH_TRANSFORM_3D);
+			RS::get_singleton()->multimesh_set_mesh(mm, E.mesh->get_rid());
+			RS::get_singleton()->multimesh_set_buffer(mm, E.buffer);
 #ifdef TOOLS_ENABLED
-
-				Octant::MultimeshInstance::Item it;
-				it.index = idx;
-				it.transform = F.first;
-				it.key = F.second;
-				mmi.items.push_back(it);
+			mmi.items = E.items;
 #endif
 
-				idx++;
-			}
-
 			RID instance = RS::get_singleton()->instance_create();
 			RS::get_singleton()->instance_set_base(instance, mm);
 
@@ -713,12 +1051,45 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 				RS::get_singleton()->instance_set_scenario(instance, get_world_3d()->get_scenario());
 				RS::get_singleton()->instance_set_transform(instance, get_global_transform());
 			}
+			if (p_build.hlod_surfaces.size()) {
+				RS::get_singleton()->instance_geometry_set_visibility_range(instance, 0.0, hlod_distance, 0.0, 0.0, RS::VISIBILITY_RANGE_FADE_DISABLED);
+			}
 
 			mmi.multimesh = mm;
 			mmi.instance = instance;
 
 			g.multimesh_instances.push_back(mmi);
 		}
+
+		// Past the HLOD distance, the whole octant is drawn as one merged mesh instead of its multimeshes.
+		if (p_build.hlod_surfaces.size()) {
+			g.hlod_mesh = RS::get_singleton()->mesh_create();
+			int surface_index = 0;
+			for (const HLODSurface &E : p_build.hlod_surfaces) {
+				if (E.indices.is_empty()) {
+					continue;
+				}
+				Array arr;
+				arr.resize(RS::ARRAY_MAX);
+				arr[RS::ARRAY_VERTEX] = E.vertices;
+				arr[RS::ARRAY_NORMAL] = E.normals;
+				arr[RS::ARRAY_TEX_UV] = E.uvs;
+				arr[RS::ARRAY_INDEX] = E.indices;
+				RS::get_singleton()->mesh_add_surface_from_arrays(g.hlod_mesh, RS::PRIMITIVE_TRIANGLES, arr);
+				if (E.material.is_valid()) {
+					RS::get_singleton()->mesh_surface_set_material(g.hlod_mesh, surface_index, E.material->get_rid());
+				}
+				surface_index++;
+			}
+
+			g.hlod_instance = RS::get_singleton()->instance_create();
+			RS::get_singleton()->instance_set_base(g.hlod_instance, g.hlod_mesh);
+			RS::get_singleton()->instance_geometry_set_visibility_range(g.hlod_instance, hlod_distance, 0.0, 0.0, 0.0, RS::VISIBILITY_RANGE_FADE_DISABLED);
+			if (is_inside_tree()) {
+				RS::get_singleton()->instance_set_scenario(g.hlod_instance, get_world_3d()->get_scenario());
+				RS::get_singleton()->instance_set_transform(g.hlod_instance, get_global_transform());
+			}
+		}
 	}
 
 	if (col_debug.size()) {
@@ -733,8 +1104,6 @@ bool GridMap::_octant_update(const OctantKey &p_key) {
 		}
 	}
 
-	g.dirty = false;
-
 	return false;
 }
 
@@ -775,6 +1144,11 @@ void GridMap::_octant_enter_world(const OctantKey &p_key) {
 		RS::get_singleton()->instance_set_transform(g.multimesh_instances[i].instance, get_global_transform());
 	}
 
+	if (g.hlod_instance.is_valid()) {
+		RS::get_singleton()->instance_set_scenario(g.hlod_instance, get_world_3d()->get_scenario());
+		RS::get_singleton()->instance_set_transform(g.hlod_instance, get_global_transform());
+	}
+
 	if (bake_navigation && mesh_library.is_valid()) {
 		for (KeyValue<IndexKey, Octant::NavigationCell> &F : g.navigation_cell_ids) {
 			if (cell_map.has(F.key) && F.value.region.is_valid() == false) {
@@ -829,6 +1203,10 @@ void GridMap::_octant_exit_world(const OctantKey &p_key) {
 		RS::get_singleton()->instance_set_scenario(g.multimesh_instances[i].instance, RID());
 	}
 
+	if (g.hlod_instance.is_valid()) {
+		RS::get_singleton()->instance_set_scenario(g.hlod_instance, RID());
+	}
+
 	for (KeyValue<IndexKey, Octant::NavigationCell> &F : g.navigation_cell_ids) {
 		if (F.value.region.is_valid()) {
 			NavigationServer3D::get_singleton()->free(F.value.region);
@@ -900,6 +1278,13 @@ void GridMap::_octant_clean_up(const OctantKey &p_key) {
 		RS::get_singleton()->free(g.multimesh_instances[i].multimesh);
 	}
 	g.multimesh_instances.clear();
+
+	if (g.hlod_instance.is_valid()) {
+		RS::get_singleton()->free(g.hlod_instance);
+		RS::get_singleton()->free(g.hlod_mesh);
+		g.hlod_instance = RID();
+		g.hlod_mesh = RID();
+	}
 }
 
 void GridMap::_notification(int p_what) {
@@ -959,6 +1344,10 @@ void GridMap::_notification(int p_what) {
 		case NOTIFICATION_VISIBILITY_CHANGED: {
 			_update_visibility();
 		} break;
+
+		case NOTIFICATION_INTERNAL_PROCESS: {
+			_update_octants_threaded();
+		} break;
 	}
 }
 
@@ -973,6 +1362,9 @@ void GridMap::_update_visibility() {
 			const Octant::MultimeshInstance &mi = octant->multimesh_instances[i];
 			RS::get_singleton()->instance_set_visible(mi.instance, is_visible_in_tree());
 		}
+		if (octant->hlod_instance.is_valid()) {
+			RS::get_singleton()->instance_set_visible(octant->hlod_instance, is_visible_in_tree());
+		}
 	}
 
 	for (int i = 0; i < baked_meshes.size(); i++) {
@@ -1000,6 +1392,8 @@ void GridMap::_recreate_octant_data() {
 }
 
 void GridMap::_clear_internal() {
+	_discard_octant_build_batch();
+
 	for (const KeyValue<OctantKey, Octant *> &E : octant_map) {
 		if (is_inside_world()) {
 			_octant_exit_world(E.key);
@@ -1011,6 +1405,7 @@ void GridMap::_clear_internal() {
 
 	octant_map.clear();
 	cell_map.clear();
+	hlod_item_surfaces.clear();
 }
 
 void GridMap::clear() {
@@ -1028,23 +1423,82 @@ void GridMap::_update_octants_callback() {
 		return;
 	}
 
-	List<OctantKey> to_delete;
-	for (const KeyValue<OctantKey, Octant *> &E : octant_map) {
-		if (_octant_update(E.key)) {
-			to_delete.push_back(E.key);
-		}
+	if (octant_updates_threaded) {
+		_update_octants_threaded();
+		awaiting_update = false;
+		return;
 	}
 
-	while (to_delete.front()) {
-		memdelete(octant_map[to_delete.front()->get()]);
-		octant_map.erase(to_delete.front()->get());
-		to_delete.pop_front();
+	OctantBuildBatch *batch = _create_octant_build_batch();
+	for (uint32_t i = 0; i < batch->builds.size(); i++) {
+		_octant_build(i, batch);
+		if (_octant_commit(batch->builds[i])) {
+			memdelete(octant_map[batch->builds[i].key]);
+			octant_map.erase(batch->builds[i].key);
+		}
 	}
+	memdelete(batch);
 
 	_update_visibility();
 	awaiting_update = false;
 }
 
+void GridMap::_update_octants_threaded() {
+	if (octant_build_batch) {
+		if (octant_build_batch->task != WorkerThreadPool::INVALID_TASK_ID) {
+			if (!WorkerThreadPool::get_singleton()->is_group_task_completed(octant_build_batch->task)) {
+				return;
+			}
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(octant_build_batch->task);
+			octant_build_batch->task = WorkerThreadPool::INVALID_TASK_ID;
+		}
+
+		// Spread the server calls over several frames, so large edits don't stall a single one.
+		uint32_t to_commit = MIN(octant_build_batch->builds.size() - octant_build_batch->committed, (uint32_t)octant_updates_per_frame);
+		for (uint32_t i = 0; i < to_commit; i++) {
+			const OctantBuild &build = octant_build_batch->builds[octant_build_batch->committed++];
+			if (_octant_commit(build)) {
+				memdelete(octant_map[build.key]);
+				octant_map.erase(build.key);
+			}
+		}
+		if (to_commit > 0) {
+			_update_visibility();
+		}
+
+		if (octant_build_batch->committed < octant_build_batch->builds.size()) {
+			return;
+		}
+		memdelete(octant_build_batch);
+		octant_build_batch = nullptr;
+	}
+
+	// Octants made dirty while the previous batch was in flight are built in the next one.
+	OctantBuildBatch *batch = _create_octant_build_batch();
+	if (batch->builds.is_empty()) {
+		memdelete(batch);
+		set_process_internal(false);
+		return;
+	}
+
+	octant_build_batch = batch;
+	batch->task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GridMap::_octant_build, batch, batch->builds.size(), -1, false, SNAME("GridMapOctantBuild"));
+	set_process_internal(true);
+}
+
+void GridMap::_discard_octant_build_batch() {
+	if (!octant_build_batch) {
+		return;
+	}
+
+	if (octant_build_batch->task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(octant_build_batch->task);
+	}
+	memdelete(octant_build_batch);
+	octant_build_batch = nullptr;
+	set_process_internal(false);
+}
+
 void GridMap::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_collision_layer", "layer"), &GridMap::set_collision_layer);
 	ClassDB::bind_method(D_METHOD("get_collision_layer"), &GridMap::get_collision_layer);
@@ -1082,6 +1536,11 @@ void GridMap::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_octant_size", "size"), &GridMap::set_octant_size);
 	ClassDB::bind_method(D_METHOD("get_octant_size"), &GridMap::get_octant_size);
 
+	ClassDB::bind_method(D_METHOD("set_octant_updates_threaded", "enabled"), &GridMap::set_octant_updates_threaded);
+	ClassDB::bind_method(D_METHOD("is_octant_updates_threaded"), &GridMap::is_octant_updates_threaded);
+	ClassDB::bind_method(D_METHOD("set_octant_updates_per_frame", "count"), &GridMap::set_octant_updates_per_frame);
+	ClassDB::bind_method(D_METHOD("get_octant_updates_per_frame"), &GridMap::get_octant_updates_per_frame);
+
 	ClassDB::bind_method(D_METHOD("set_cell_item", "position", "item", "orientation"), &GridMap::set_cell_item, DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("get_cell_item", "position"), &GridMap::get_cell_item);
 	ClassDB::bind_method(D_METHOD("get_cell_item_orientation", "position"), &GridMap::get_cell_item_orientation);
@@ -1096,6 +1555,13 @@ void GridMap::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("resource_changed", "resource"), &GridMap::resource_changed);
 #endif
 
+	ClassDB::bind_method(D_METHOD("set_hlod_enabled", "enabled"), &GridMap::set_hlod_enabled);
+	ClassDB::bind_method(D_METHOD("is_hlod_enabled"), &GridMap::is_hlod_enabled);
+	ClassDB::bind_method(D_METHOD("set_hlod_distance", "distance"), &GridMap::set_hlod_distance);
+	ClassDB::bind_method(D_METHOD("get_hlod_distance"), &GridMap::get_hlod_distance);
+	ClassDB::bind_method(D_METHOD("set_hlod_detail", "detail"), &GridMap::set_hlod_detail);
+	ClassDB::bind_method(D_METHOD("get_hlod_detail"), &GridMap::get_hlod_detail);
+
 	ClassDB::bind_method(D_METHOD("set_center_x", "enable"), &GridMap::set_center_x);
 	ClassDB::bind_method(D_METHOD("get_center_x"), &GridMap::get_center_x);
 	ClassDB::bind_method(D_METHOD("set_center_y", "enable"), &GridMap::set_center_y);
@@ -1109,6 +1575,7 @@ void GridMap::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_used_cells_by_item", "item"), &GridMap::get_used_cells_by_item);
 
 	ClassDB::bind_method(D_METHOD("get_meshes"), &GridMap::get_meshes);
+	ClassDB::bind_method(D_METHOD("get_hlod_meshes"), &GridMap::get_hlod_meshes);
 	ClassDB::bind_method(D_METHOD("get_bake_meshes"), &GridMap::get_bake_meshes);
 	ClassDB::bind_method(D_METHOD("get_bake_mesh_instance", "idx"), &GridMap::get_bake_mesh_instance);
 
@@ -1124,6 +1591,13 @@ void GridMap::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "cell_center_y"), "set_center_y", "get_center_y");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "cell_center_z"), "set_center_z", "get_center_z");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_scale"), "set_cell_scale", "get_cell_scale");
+	ADD_GROUP("HLOD", "hlod_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "hlod_enabled"), "set_hlod_enabled", "is_hlod_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "hlod_distance", PROPERTY_HINT_RANGE, "0,4096,0.01,or_greater,suffix:m"), "set_hlod_distance", "get_hlod_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "hlod_detail", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_hlod_detail", "get_hlod_detail");
+	ADD_GROUP("Octant Updates", "octant_updates_");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "octant_updates_threaded"), "set_octant_updates_threaded", "is_octant_updates_threaded");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "octant_updates_per_frame", PROPERTY_HINT_RANGE, "1,1024,1,or_greater"), "set_octant_updates_per_frame", "get_octant_updates_per_frame");
 	ADD_GROUP("Collision", "collision_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_layer", PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_collision_layer", "get_collision_layer");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_mask", PROPERTY_HINT_LAYERS_3D_PHYSICS), "set_collision_mask", "get_collision_mask");
@@ -1206,6 +1680,16 @@ Array GridMap::get_meshes() const {
 	return meshes;
 }
 
+TypedArray<RID> GridMap::get_hlod_meshes() const {
+	TypedArray<RID> meshes;
+	for (const KeyValue<OctantKey, Octant *> &E : octant_map) {
+		if (E.value->hlod_mesh.is_valid()) {
+			meshes.push_back(E.value->hlod_mesh);
+		}
+	}
+	return meshes;
+}
+
 Vector3 GridMap::_get_offset() const {
 	return Vector3(
 			cell_size.x * 0.5 * int(center_x),
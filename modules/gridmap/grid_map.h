@@ -31,6 +31,7 @@
 #ifndef GRID_MAP_H
 #define GRID_MAP_H
 
+#include "core/object/worker_thread_pool.h"
 #include "scene/3d/node_3d.h"
 #include "scene/resources/3d/mesh_library.h"
 #include "scene/resources/multimesh.h"
@@ -123,6 +124,9 @@ class GridMap : public Node3D {
 		Ref<ArrayMesh> navigation_debug_edge_connections_mesh;
 #endif // DEBUG_ENABLED
 
+		RID hlod_mesh;
+		RID hlod_instance;
+
 		bool dirty = false;
 		RID static_body;
 		HashMap<IndexKey, NavigationCell> navigation_cell_ids;
@@ -149,6 +153,74 @@ class GridMap : public Node3D {
 		OctantKey() {}
 	};
 
+	/**
+	 * @brief An HLODSurface is triangle geometry sharing a single material, used to draw whole octants from far away.
+	 */
+	struct HLODSurface {
+		Ref<Material> material;
+		Vector<Vector3> vertices;
+		Vector<Vector3> normals;
+		Vector<Vector2> uvs;
+		Vector<int> indices;
+	};
+
+	/**
+	 * @brief An OctantBuild holds what an Octant needs from the servers, computed from a snapshot of its Cells.
+	 * It doesn't touch the GridMap or the servers, so it can be computed on a worker thread and committed later.
+	 */
+	struct OctantBuild {
+		struct MultimeshData {
+			Ref<Mesh> mesh;
+			Vector<float> buffer;
+			Vector<Octant::MultimeshInstance::Item> items;
+		};
+
+		struct ShapeData {
+			Ref<Shape3D> shape;
+			Transform3D xform;
+		};
+
+		struct NavigationData {
+			IndexKey key;
+			Ref<NavigationMesh> navigation_mesh;
+			Transform3D xform;
+			uint32_t navigation_layers = 1;
+		};
+
+		OctantKey key;
+		LocalVector<Pair<IndexKey, Cell>> cells;
+
+		LocalVector<MultimeshData> multimeshes;
+		LocalVector<ShapeData> shapes;
+		LocalVector<NavigationData> navigation_cells;
+		LocalVector<HLODSurface> hlod_surfaces;
+	};
+
+	struct OctantBuildBatch {
+		// Copied from the MeshLibrary on the main thread, since it can be edited while octants are built.
+		struct ItemData {
+			Ref<Mesh> mesh;
+			Transform3D mesh_transform;
+			Vector<MeshLibrary::ShapeData> shapes;
+			Ref<NavigationMesh> navigation_mesh;
+			Transform3D navigation_mesh_transform;
+			uint32_t navigation_layers = 1;
+		};
+
+		HashMap<int, ItemData> items;
+		Vector3 cell_size;
+		Vector3 offset;
+		float cell_scale = 1.0;
+		bool build_multimeshes = true;
+		bool build_hlod = false;
+		float hlod_detail = 0.25;
+		HashMap<int, Vector<HLODSurface>> hlod_item_surfaces;
+
+		LocalVector<OctantBuild> builds;
+		uint32_t committed = 0;
+		WorkerThreadPool::GroupID task = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
 	uint32_t collision_layer = 1;
 	uint32_t collision_mask = 1;
 	real_t collision_priority = 1.0;
@@ -168,6 +240,18 @@ class GridMap : public Node3D {
 
 	bool recreating_octants = false;
 
+	bool octant_updates_threaded = false;
+	int octant_updates_per_frame = 32;
+	OctantBuildBatch *octant_build_batch = nullptr;
+
+	bool hlod_enabled = false;
+	real_t hlod_distance = 100.0;
+	float hlod_detail = 0.25;
+	HashMap<int, Vector<HLODSurface>> hlod_item_surfaces;
+
+	void _cache_hlod_item_surfaces(int p_item);
+	static void _simplify_hlod_surface(HLODSurface &r_surface, float p_detail);
+
 	Ref<MeshLibrary> mesh_library;
 
 	HashMap<OctantKey, Octant *, OctantKey> octant_map;
@@ -190,7 +274,10 @@ class GridMap : public Node3D {
 	void _update_physics_bodies_characteristics();
 	void _octant_enter_world(const OctantKey &p_key);
 	void _octant_exit_world(const OctantKey &p_key);
-	bool _octant_update(const OctantKey &p_key);
+	OctantBuildBatch *_create_octant_build_batch();
+	void _octant_build(uint32_t p_index, OctantBuildBatch *p_batch);
+	bool _octant_commit(const OctantBuild &p_build);
+	void _discard_octant_build_batch();
 	void _octant_clean_up(const OctantKey &p_key);
 	void _octant_transform(const OctantKey &p_key);
 #ifdef DEBUG_ENABLED
@@ -202,6 +289,7 @@ class GridMap : public Node3D {
 
 	void _queue_octants_dirty();
 	void _update_octants_callback();
+	void _update_octants_threaded();
 
 #ifndef DISABLE_DEPRECATED
 	void resource_changed(const Ref<Resource> &p_res);
@@ -267,6 +355,21 @@ public:
 	void set_octant_size(int p_size);
 	int get_octant_size() const;
 
+	void set_octant_updates_threaded(bool p_enabled);
+	bool is_octant_updates_threaded() const;
+
+	void set_octant_updates_per_frame(int p_count);
+	int get_octant_updates_per_frame() const;
+
+	void set_hlod_enabled(bool p_enabled);
+	bool is_hlod_enabled() const;
+
+	void set_hlod_distance(real_t p_distance);
+	real_t get_hlod_distance() const;
+
+	void set_hlod_detail(float p_detail);
+	float get_hlod_detail() const;
+
 	void set_center_x(bool p_enable);
 	bool get_center_x() const;
 	void set_center_y(bool p_enable);
@@ -291,6 +394,7 @@ public:
 	TypedArray<Vector3i> get_used_cells_by_item(int p_item) const;
 
 	Array get_meshes() const;
+	TypedArray<RID> get_hlod_meshes() const;
 
 	void clear_baked_meshes();
 	void make_baked_meshes(bool p_gen_lightmap_uv = false, float p_lightmap_uv_texel_size = 0.1);
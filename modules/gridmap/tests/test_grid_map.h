@@ -0,0 +1,263 @@
+/**************************************************************************/
+/*  test_grid_map.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GRID_MAP_H
+#define TEST_GRID_MAP_H
+
+#include "../grid_map.h"
+
+#include "scene/main/window.h"
+#include "scene/resources/3d/box_shape_3d.h"
+#include "scene/resources/3d/mesh_library.h"
+#include "scene/resources/3d/primitive_meshes.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGridMap {
+
+static Vector<MeshLibrary::ShapeData> make_box_shapes(int p_count) {
+	Vector<MeshLibrary::ShapeData> shapes;
+	for (int i = 0; i < p_count; i++) {
+		MeshLibrary::ShapeData shape_data;
+		shape_data.shape = Ref<BoxShape3D>(memnew(BoxShape3D));
+		shapes.push_back(shape_data);
+	}
+	return shapes;
+}
+
+// Each committed cell adds its item's shapes to the body of its octant.
+static int get_committed_shape_count(GridMap *p_grid_map) {
+	return p_grid_map->get_collision_shapes().size() / 2;
+}
+
+// Processes frames until the shape count is reached, giving the worker threads time to build octants.
+static void process_until_shape_count(GridMap *p_grid_map, int p_count) {
+	for (int i = 0; i < 5000 && get_committed_shape_count(p_grid_map) != p_count; i++) {
+		SceneTree::get_singleton()->process(1.0 / 60.0);
+		OS::get_singleton()->delay_usec(1000);
+	}
+}
+
+TEST_CASE("[SceneTree][GridMap] Threaded octant updates") {
+	Ref<MeshLibrary> mesh_library;
+	mesh_library.instantiate();
+	mesh_library->create_item(0);
+	mesh_library->set_item_mesh(0, memnew(BoxMesh));
+	mesh_library->set_item_shapes(0, make_box_shapes(1));
+
+	GridMap *grid_map = memnew(GridMap);
+	grid_map->set_mesh_library(mesh_library);
+	grid_map->set_octant_size(1); // One octant per cell.
+	grid_map->set_octant_updates_threaded(true);
+	SceneTree::get_singleton()->get_root()->add_child(grid_map);
+
+	const int cell_count = 10;
+	for (int i = 0; i < cell_count; i++) {
+		grid_map->set_cell_item(Vector3i(i, 0, 0), 0);
+	}
+
+	SUBCASE("Commits are spread over frames") {
+		grid_map->set_octant_updates_per_frame(2);
+		int committed = 0;
+		int frames = 0;
+		while (committed < cell_count && frames < 5000) {
+			SceneTree::get_singleton()->process(1.0 / 60.0);
+			const int count = get_committed_shape_count(grid_map);
+			CHECK_MESSAGE(count - committed <= 2, "No more octants than the budget should be committed in a frame.");
+			if (count == committed) {
+				OS::get_singleton()->delay_usec(1000);
+			}
+			committed = count;
+			frames++;
+		}
+		CHECK(committed == cell_count);
+		CHECK(frames >= cell_count / 2);
+	}
+
+	SUBCASE("Octants removed while they are built") {
+		// The whole batch is committed at once, so the count is either 0, 10 if the batch
+		// was committed before the cells were erased, or 5 once everything is up to date.
+		grid_map->set_octant_updates_per_frame(100);
+		SceneTree::get_singleton()->process(1.0 / 60.0);
+		for (int i = 0; i < cell_count / 2; i++) {
+			grid_map->set_cell_item(Vector3i(i, 0, 0), GridMap::INVALID_CELL_ITEM);
+		}
+		process_until_shape_count(grid_map, cell_count / 2);
+		CHECK(get_committed_shape_count(grid_map) == cell_count / 2);
+
+		for (int i = 0; i < 10; i++) {
+			SceneTree::get_singleton()->process(1.0 / 60.0);
+		}
+		CHECK(get_committed_shape_count(grid_map) == cell_count / 2);
+		CHECK(grid_map->get_used_cells().size() == cell_count / 2);
+	}
+
+	SUBCASE("Turning threaded updates off commits pending builds") {
+		grid_map->set_octant_updates_per_frame(1);
+		SceneTree::get_singleton()->process(1.0 / 60.0);
+		CHECK(get_committed_shape_count(grid_map) <= 1);
+		grid_map->set_octant_updates_threaded(false);
+		CHECK(get_committed_shape_count(grid_map) == cell_count);
+	}
+
+	SUBCASE("Editing the MeshLibrary while octants are built") {
+		grid_map->set_octant_updates_per_frame(100);
+		SceneTree::get_singleton()->process(1.0 / 60.0);
+		// Rebuilds all octants, the pending ones can't be committed anymore.
+		mesh_library->set_item_shapes(0, make_box_shapes(2));
+		process_until_shape_count(grid_map, cell_count * 2);
+		CHECK(get_committed_shape_count(grid_map) == cell_count * 2);
+	}
+
+	memdelete(grid_map);
+}
+
+// A flat floor of unit cells with a plane mesh, so neighboring cells share vertex positions but not UVs.
+static GridMap *create_hlod_floor(int p_width, int p_depth, float p_detail) {
+	Ref<PlaneMesh> plane;
+	plane.instantiate();
+	plane->set_size(Vector2(1, 1));
+	Ref<MeshLibrary> mesh_library;
+	mesh_library.instantiate();
+	mesh_library->create_item(0);
+	mesh_library->set_item_mesh(0, plane);
+
+	GridMap *grid_map = memnew(GridMap);
+	grid_map->set_mesh_library(mesh_library);
+	grid_map->set_cell_size(Vector3(1, 1, 1));
+	grid_map->set_octant_size(4);
+	grid_map->set_hlod_enabled(true);
+	grid_map->set_hlod_detail(p_detail);
+	for (int x = 0; x < p_width; x++) {
+		for (int z = 0; z < p_depth; z++) {
+			grid_map->set_cell_item(Vector3i(x, 0, z), 0);
+		}
+	}
+	SceneTree::get_singleton()->get_root()->add_child(grid_map);
+	SceneTree::get_singleton()->process(1.0 / 60.0);
+	return grid_map;
+}
+
+TEST_CASE("[SceneTree][GridMap] HLOD meshes") {
+	SUBCASE("Merged surfaces keep every cell") {
+		// 16 cells with 4 vertices and 2 triangles each, in a single octant.
+		GridMap *grid_map = create_hlod_floor(4, 4, 1.0);
+		TypedArray<RID> hlod_meshes = grid_map->get_hlod_meshes();
+		REQUIRE(hlod_meshes.size() == 1);
+		REQUIRE(RS::get_singleton()->mesh_get_surface_count(hlod_meshes[0]) == 1);
+
+		Array arrays = RS::get_singleton()->mesh_surface_get_arrays(hlod_meshes[0], 0);
+		const Vector<Vector3> vertices = arrays[RS::ARRAY_VERTEX];
+		const Vector<Vector3> normals = arrays[RS::ARRAY_NORMAL];
+		const Vector<Vector2> uvs = arrays[RS::ARRAY_TEX_UV];
+		const Vector<int> indices = arrays[RS::ARRAY_INDEX];
+		CHECK(indices.size() == 16 * 6);
+		// No two vertices are identical, so none are welded.
+		CHECK(vertices.size() == 16 * 4);
+		REQUIRE(normals.size() == vertices.size());
+		REQUIRE(uvs.size() == vertices.size());
+
+		// The corners inside the floor are shared by four cells, each with its own UV there.
+		HashMap<Vector3, HashSet<Vector2>> uvs_by_position;
+		for (int i = 0; i < vertices.size(); i++) {
+			CHECK(normals[i].dot(Vector3(0, 1, 0)) > 0.99);
+			uvs_by_position[vertices[i]].insert(uvs[i]);
+		}
+		int inner_corners = 0;
+		for (const KeyValue<Vector3, HashSet<Vector2>> &E : uvs_by_position) {
+			if (E.value.size() == 4) {
+				inner_corners++;
+			}
+		}
+		CHECK(inner_corners == 3 * 3);
+
+		memdelete(grid_map);
+	}
+
+	SUBCASE("Normals and UVs survive simplification") {
+		GridMap *grid_map = create_hlod_floor(4, 4, 0.25);
+		TypedArray<RID> hlod_meshes = grid_map->get_hlod_meshes();
+		REQUIRE(hlod_meshes.size() == 1);
+
+		Array arrays = RS::get_singleton()->mesh_surface_get_arrays(hlod_meshes[0], 0);
+		const Vector<Vector3> vertices = arrays[RS::ARRAY_VERTEX];
+		const Vector<Vector3> normals = arrays[RS::ARRAY_NORMAL];
+		const Vector<Vector2> uvs = arrays[RS::ARRAY_TEX_UV];
+		const Vector<int> indices = arrays[RS::ARRAY_INDEX];
+		CHECK(indices.size() <= 16 * 6);
+		CHECK(indices.size() % 3 == 0);
+		REQUIRE(normals.size() == vertices.size());
+		REQUIRE(uvs.size() == vertices.size());
+
+		// Simplifying only drops triangles, the vertices left keep the attributes they had in their cell.
+		for (int i = 0; i < vertices.size(); i++) {
+			CHECK(normals[i].dot(Vector3(0, 1, 0)) > 0.99);
+			CHECK((uvs[i].x == 0 || uvs[i].x == 1));
+			CHECK((uvs[i].y == 0 || uvs[i].y == 1));
+		}
+		for (int i = 0; i < indices.size(); i++) {
+			CHECK((indices[i] >= 0 && indices[i] < vertices.size()));
+		}
+
+		memdelete(grid_map);
+	}
+
+	SUBCASE("One merged mesh per octant while enabled") {
+		// Two octants of 4x4 cells.
+		GridMap *grid_map = create_hlod_floor(8, 4, 0.25);
+		CHECK(grid_map->get_hlod_meshes().size() == 2);
+		// The per-cell meshes are still there to be drawn up close.
+		CHECK(grid_map->get_meshes().size() == 8 * 4 * 2);
+
+		grid_map->set_hlod_enabled(false);
+		SceneTree::get_singleton()->process(1.0 / 60.0);
+		CHECK(grid_map->get_hlod_meshes().is_empty());
+		CHECK(grid_map->get_meshes().size() == 8 * 4 * 2);
+
+		grid_map->set_hlod_enabled(true);
+		SceneTree::get_singleton()->process(1.0 / 60.0);
+		CHECK(grid_map->get_hlod_meshes().size() == 2);
+
+		// Erasing the cells of an octant removes its merged mesh.
+		for (int x = 4; x < 8; x++) {
+			for (int z = 0; z < 4; z++) {
+				grid_map->set_cell_item(Vector3i(x, 0, z), GridMap::INVALID_CELL_ITEM);
+			}
+		}
+		SceneTree::get_singleton()->process(1.0 / 60.0);
+		CHECK(grid_map->get_hlod_meshes().size() == 1);
+
+		memdelete(grid_map);
+	}
+}
+
+} // namespace TestGridMap
+
+#endif // TEST_GRID_MAP_H
@@ -153,7 +153,19 @@ PackedStringArray MultiplayerSynchronizer::get_configuration_warnings() const {
 	return warnings;
 }
 
-Error MultiplayerSynchronizer::get_state(const List<NodePath> &p_properties, Object *p_obj, Vector<Variant> &r_variant, Vector<const Variant *> &r_variant_ptrs) {
+static PropertyHandle &_get_property_handle(LocalVector<PropertyHandle> &r_handles, int p_index, const NodePath &p_prop) {
+	if (uint32_t(p_index) >= r_handles.size()) {
+		r_handles.resize(p_index + 1);
+	}
+	PropertyHandle &handle = r_handles[p_index];
+	const Vector<StringName> subnames = p_prop.get_subnames();
+	if (handle.get_path() != subnames) {
+		handle.set_path(subnames);
+	}
+	return handle;
+}
+
+Error MultiplayerSynchronizer::get_state(const List<NodePath> &p_properties, Object *p_obj, Vector<Variant> &r_variant, Vector<const Variant *> &r_variant_ptrs, LocalVector<PropertyHandle> *r_handles) {
 	ERR_FAIL_NULL_V(p_obj, ERR_INVALID_PARAMETER);
 	r_variant.resize(p_properties.size());
 	r_variant_ptrs.resize(r_variant.size());
@@ -162,7 +174,11 @@ Error MultiplayerSynchronizer::get_state(const List<NodePath> &p_properties, Obj
 		bool valid = false;
 		const Object *obj = _get_prop_target(p_obj, prop);
 		ERR_FAIL_NULL_V(obj, FAILED);
-		r_variant.write[i] = obj->get_indexed(prop.get_subnames(), &valid);
+		if (r_handles) {
+			r_variant.write[i] = _get_property_handle(*r_handles, i, prop).get(obj, &valid);
+		} else {
+			r_variant.write[i] = obj->get_indexed(prop.get_subnames(), &valid);
+		}
 		r_variant_ptrs.write[i] = &r_variant[i];
 		ERR_FAIL_COND_V_MSG(!valid, ERR_INVALID_DATA, vformat("Property '%s' not found.", prop));
 		i++;
@@ -170,13 +186,17 @@ Error MultiplayerSynchronizer::get_state(const List<NodePath> &p_properties, Obj
 	return OK;
 }
 
-Error MultiplayerSynchronizer::set_state(const List<NodePath> &p_properties, Object *p_obj, const Vector<Variant> &p_state) {
+Error MultiplayerSynchronizer::set_state(const List<NodePath> &p_properties, Object *p_obj, const Vector<Variant> &p_state, LocalVector<PropertyHandle> *r_handles) {
 	ERR_FAIL_NULL_V(p_obj, ERR_INVALID_PARAMETER);
 	int i = 0;
 	for (const NodePath &prop : p_properties) {
 		Object *obj = _get_prop_target(p_obj, prop);
 		ERR_FAIL_NULL_V(obj, FAILED);
-		obj->set_indexed(prop.get_subnames(), p_state[i]);
+		if (r_handles) {
+			_get_property_handle(*r_handles, i, prop).set(obj, p_state[i]);
+		} else {
+			obj->set_indexed(prop.get_subnames(), p_state[i]);
+		}
 		i += 1;
 	}
 	return OK;
@@ -388,10 +408,14 @@ Error MultiplayerSynchronizer::_watch_changes(uint64_t p_usec) {
 		bool valid = false;
 		const Object *obj = _get_prop_target(node, prop);
 		ERR_CONTINUE_MSG(!obj, vformat("Node not found for property '%s'.", prop));
-		Variant v = obj->get_indexed(prop.get_subnames(), &valid);
-		ERR_CONTINUE_MSG(!valid, vformat("Property '%s' not found.", prop));
 		Watcher &w = ptr[idx];
-		if (w.prop != prop) {
+		const bool changed_prop = w.prop != prop;
+		if (changed_prop) {
+			w.handle.set_path(prop.get_subnames());
+		}
+		Variant v = w.handle.get(obj, &valid);
+		ERR_CONTINUE_MSG(!valid, vformat("Property '%s' not found.", prop));
+		if (changed_prop) {
 			w.prop = prop;
 			w.value = v.duplicate(true);
 			w.last_change_usec = p_usec;
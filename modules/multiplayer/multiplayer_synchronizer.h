@@ -33,6 +33,8 @@
 
 #include "scene_replication_config.h"
 
+#include "core/object/property_handle.h"
+
 #include "scene/main/node.h"
 
 class MultiplayerSynchronizer : public Node {
@@ -48,6 +50,7 @@ public:
 private:
 	struct Watcher {
 		NodePath prop;
+		PropertyHandle handle;
 		uint64_t last_change_usec = 0;
 		Variant value;
 	};
@@ -60,6 +63,7 @@ private:
 	HashSet<Callable> visibility_filters;
 	HashSet<int> peer_visibility;
 	Vector<Watcher> watchers;
+	LocalVector<PropertyHandle> sync_handles; // For the sync properties, in the same order.
 	uint64_t last_watch_usec = 0;
 
 	ObjectID root_node_cache;
@@ -79,8 +83,11 @@ protected:
 	void _notification(int p_what);
 
 public:
-	static Error get_state(const List<NodePath> &p_properties, Object *p_obj, Vector<Variant> &r_variant, Vector<const Variant *> &r_variant_ptrs);
-	static Error set_state(const List<NodePath> &p_properties, Object *p_obj, const Vector<Variant> &p_state);
+	// When handles are given, they are kept resolved for each of the properties, for repeated calls.
+	static Error get_state(const List<NodePath> &p_properties, Object *p_obj, Vector<Variant> &r_variant, Vector<const Variant *> &r_variant_ptrs, LocalVector<PropertyHandle> *r_handles = nullptr);
+	static Error set_state(const List<NodePath> &p_properties, Object *p_obj, const Vector<Variant> &p_state, LocalVector<PropertyHandle> *r_handles = nullptr);
+
+	LocalVector<PropertyHandle> *get_sync_property_handles() { return &sync_handles; }
 
 	void reset();
 	Node *get_root_node();
@@ -34,6 +34,7 @@
 #include "nav_mesh_generator_2d.h"
 #endif // CLIPPER2_ENABLED
 
+#include "core/debugger/frame_timeline.h"
 #include "servers/navigation_server_3d.h"
 
 #define FORWARD_0(FUNC_NAME)                                     \
@@ -172,6 +173,7 @@ void GodotNavigationServer2D::init() {
 }
 
 void GodotNavigationServer2D::sync() {
+	FRAME_TIMELINE_ZONE("NavigationServer2D::sync");
 #ifdef CLIPPER2_ENABLED
 	if (navmesh_generator_2d) {
 		navmesh_generator_2d->sync();
@@ -30,6 +30,7 @@
 
 #include "godot_navigation_server_3d.h"
 
+#include "core/debugger/frame_timeline.h"
 #include "core/os/mutex.h"
 #include "scene/main/node.h"
 
@@ -1276,6 +1277,7 @@ uint32_t GodotNavigationServer3D::map_get_iteration_id(RID p_map) const {
 }
 
 void GodotNavigationServer3D::sync() {
+	FRAME_TIMELINE_ZONE("NavigationServer3D::sync");
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
 		navmesh_generator_3d->sync();
@@ -1284,6 +1286,7 @@ void GodotNavigationServer3D::sync() {
 }
 
 void GodotNavigationServer3D::process(real_t p_delta_time) {
+	FRAME_TIMELINE_ZONE("NavigationServer3D::process");
 	flush_queries();
 
 	if (!active) {
@@ -394,7 +394,7 @@ int64_t TextServerAdvanced::_get_features() const {
 }
 
 void TextServerAdvanced::_free_rid(const RID &p_rid) {
-	_THREAD_SAFE_METHOD_
+	// No global lock, system fallback fonts are freed with `system_fonts_mutex` held.
 	if (font_owner.owns(p_rid)) {
 		MutexLock ftlock(ft_mutex);
 
@@ -1870,8 +1870,7 @@ hb_font_t *TextServerAdvanced::_font_get_hb_handle(const RID &p_font_rid, int64_
 }
 
 RID TextServerAdvanced::_create_font() {
-	_THREAD_SAFE_METHOD_
-
+	// No global lock, system fallback fonts are created while shaping.
 	FontAdvanced *fd = memnew(FontAdvanced);
 
 	return font_owner.make_rid(fd);
@@ -3952,6 +3951,7 @@ double TextServerAdvanced::_font_get_global_oversampling() const {
 
 void TextServerAdvanced::_font_set_global_oversampling(double p_oversampling) {
 	_THREAD_SAFE_METHOD_
+	// The global lock is taken first here, and each buffer's lock after it, which keeps the lock order.
 	if (oversampling != p_oversampling) {
 		oversampling = p_oversampling;
 		List<RID> fonts;
@@ -3968,7 +3968,12 @@ void TextServerAdvanced::_font_set_global_oversampling(double p_oversampling) {
 			List<RID> text_bufs;
 			shaped_owner.get_owned_list(&text_bufs);
 			for (const RID &E : text_bufs) {
-				invalidate(shaped_owner.get_or_null(E), false);
+				ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(E);
+				if (!sd) {
+					continue;
+				}
+				MutexLock lock(sd->mutex);
+				invalidate(sd, false);
 			}
 		}
 	}
@@ -4074,7 +4079,6 @@ RID TextServerAdvanced::_create_shaped_text(TextServer::Direction p_direction, T
 	ERR_FAIL_COND_V_MSG(p_direction == DIRECTION_INHERITED, RID(), "Invalid text direction.");
 
 	ShapedTextDataAdvanced *sd = memnew(ShapedTextDataAdvanced);
-	sd->hb_buffer = hb_buffer_create();
 	sd->direction = p_direction;
 	sd->orientation = p_orientation;
 	return shaped_owner.make_rid(sd);
@@ -4127,10 +4131,10 @@ TextServer::Direction TextServerAdvanced::_shaped_text_get_inferred_direction(co
 }
 
 void TextServerAdvanced::_shaped_text_set_custom_punctuation(const RID &p_shaped, const String &p_punct) {
-	_THREAD_SAFE_METHOD_
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL(sd);
 
+	MutexLock lock(sd->mutex);
 	if (sd->custom_punct != p_punct) {
 		if (sd->parent != RID()) {
 			full_copy(sd);
@@ -4141,23 +4145,26 @@ void TextServerAdvanced::_shaped_text_set_custom_punctuation(const RID &p_shaped
 }
 
 String TextServerAdvanced::_shaped_text_get_custom_punctuation(const RID &p_shaped) const {
-	_THREAD_SAFE_METHOD_
 	const ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, String());
+
+	MutexLock lock(sd->mutex);
 	return sd->custom_punct;
 }
 
 void TextServerAdvanced::_shaped_text_set_custom_ellipsis(const RID &p_shaped, int64_t p_char) {
-	_THREAD_SAFE_METHOD_
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL(sd);
+
+	MutexLock lock(sd->mutex);
 	sd->el_char = p_char;
 }
 
 int64_t TextServerAdvanced::_shaped_text_get_custom_ellipsis(const RID &p_shaped) const {
-	_THREAD_SAFE_METHOD_
 	const ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, 0);
+
+	MutexLock lock(sd->mutex);
 	return sd->el_char;
 }
 
@@ -4274,12 +4281,16 @@ TextServer::Orientation TextServerAdvanced::_shaped_text_get_orientation(const R
 int64_t TextServerAdvanced::_shaped_get_span_count(const RID &p_shaped) const {
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, 0);
+
+	MutexLock lock(sd->mutex);
 	return sd->spans.size();
 }
 
 Variant TextServerAdvanced::_shaped_get_span_meta(const RID &p_shaped, int64_t p_index) const {
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, Variant());
+
+	MutexLock lock(sd->mutex);
 	ERR_FAIL_INDEX_V(p_index, sd->spans.size(), Variant());
 	return sd->spans[p_index].meta;
 }
@@ -4287,6 +4298,8 @@ Variant TextServerAdvanced::_shaped_get_span_meta(const RID &p_shaped, int64_t p
 void TextServerAdvanced::_shaped_set_span_update_font(const RID &p_shaped, int64_t p_index, const TypedArray<RID> &p_fonts, int64_t p_size, const Dictionary &p_opentype_features) {
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL(sd);
+
+	MutexLock lock(sd->mutex);
 	ERR_FAIL_INDEX(p_index, sd->spans.size());
 
 	ShapedTextDataAdvanced::Span &span = sd->spans.ptrw()[p_index];
@@ -4333,10 +4346,11 @@ bool TextServerAdvanced::_shaped_text_add_string(const RID &p_shaped, const Stri
 }
 
 bool TextServerAdvanced::_shaped_text_add_object(const RID &p_shaped, const Variant &p_key, const Size2 &p_size, InlineAlignment p_inline_align, int64_t p_length, double p_baseline) {
-	_THREAD_SAFE_METHOD_
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, false);
 	ERR_FAIL_COND_V(p_key == Variant(), false);
+
+	MutexLock lock(sd->mutex);
 	ERR_FAIL_COND_V(sd->objects.has(p_key), false);
 
 	if (sd->parent != RID()) {
@@ -4509,7 +4523,6 @@ void TextServerAdvanced::_realign(ShapedTextDataAdvanced *p_sd) const {
 }
 
 RID TextServerAdvanced::_shaped_text_substr(const RID &p_shaped, int64_t p_start, int64_t p_length) const {
-	_THREAD_SAFE_METHOD_
 	const ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, RID());
 
@@ -4549,8 +4562,6 @@ bool TextServerAdvanced::_shape_substr(ShapedTextDataAdvanced *p_new_sd, const S
 		return true;
 	}
 
-	p_new_sd->hb_buffer = hb_buffer_create();
-
 	p_new_sd->line_breaks_valid = p_sd->line_breaks_valid;
 	p_new_sd->justification_ops_valid = p_sd->justification_ops_valid;
 	p_new_sd->sort_valid = false;
@@ -4941,6 +4952,8 @@ RID TextServerAdvanced::_find_sys_font_for_text(const RID &p_fdef, const String
 		font_style.set_flag(TextServer::FONT_ITALIC);
 	}
 
+	MutexLock lock(system_fonts_mutex);
+
 	String locale = (p_language.is_empty()) ? TranslationServer::get_singleton()->get_tool_locale() : p_language;
 	PackedStringArray fallback_font_name = OS::get_singleton()->get_system_font_path_for_text(font_name, p_text, locale, p_script_code, font_weight, font_stretch, font_style & TextServer::FONT_ITALIC);
 #ifdef GDEXTENSION
@@ -5804,23 +5817,49 @@ bool TextServerAdvanced::_shaped_text_update_justification_ops(const RID &p_shap
 	return sd->justification_ops_valid;
 }
 
+// HarfBuzz buffers only live for the duration of a single shaping call, so each thread
+// reuses its own buffer instead of keeping one per shaped text.
+struct HBThreadBuffer {
+	hb_buffer_t *buffer = nullptr;
+
+	~HBThreadBuffer() {
+		if (buffer) {
+			hb_buffer_destroy(buffer);
+		}
+	}
+};
+
+static thread_local HBThreadBuffer hb_thread_buffer;
+
+static hb_buffer_t *_get_thread_hb_buffer() {
+	if (unlikely(!hb_thread_buffer.buffer)) {
+		hb_thread_buffer.buffer = hb_buffer_create();
+	}
+	return hb_thread_buffer.buffer;
+}
+
 Glyph TextServerAdvanced::_shape_single_glyph(ShapedTextDataAdvanced *p_sd, char32_t p_char, hb_script_t p_script, hb_direction_t p_direction, const RID &p_font, int64_t p_font_size) {
+	FontAdvanced *fd = _get_font_data(p_font);
+	ERR_FAIL_NULL_V(fd, Glyph());
+	MutexLock lock(fd->mutex);
+
 	hb_font_t *hb_font = _font_get_hb_handle(p_font, p_font_size);
 	double scale = _font_get_scale(p_font, p_font_size);
 	bool subpos = (scale != 1.0) || (_font_get_subpixel_positioning(p_font) == SUBPIXEL_POSITIONING_ONE_HALF) || (_font_get_subpixel_positioning(p_font) == SUBPIXEL_POSITIONING_ONE_QUARTER) || (_font_get_subpixel_positioning(p_font) == SUBPIXEL_POSITIONING_AUTO && p_font_size <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE);
 	ERR_FAIL_NULL_V(hb_font, Glyph());
 
-	hb_buffer_clear_contents(p_sd->hb_buffer);
-	hb_buffer_set_direction(p_sd->hb_buffer, p_direction);
-	hb_buffer_set_flags(p_sd->hb_buffer, (hb_buffer_flags_t)(HB_BUFFER_FLAG_DEFAULT));
-	hb_buffer_set_script(p_sd->hb_buffer, p_script);
-	hb_buffer_add_utf32(p_sd->hb_buffer, (const uint32_t *)&p_char, 1, 0, 1);
+	hb_buffer_t *hb_buffer = _get_thread_hb_buffer();
+	hb_buffer_clear_contents(hb_buffer);
+	hb_buffer_set_direction(hb_buffer, p_direction);
+	hb_buffer_set_flags(hb_buffer, (hb_buffer_flags_t)(HB_BUFFER_FLAG_DEFAULT));
+	hb_buffer_set_script(hb_buffer, p_script);
+	hb_buffer_add_utf32(hb_buffer, (const uint32_t *)&p_char, 1, 0, 1);
 
-	hb_shape(hb_font, p_sd->hb_buffer, nullptr, 0);
+	hb_shape(hb_font, hb_buffer, nullptr, 0);
 
 	unsigned int glyph_count = 0;
-	hb_glyph_info_t *glyph_info = hb_buffer_get_glyph_infos(p_sd->hb_buffer, &glyph_count);
-	hb_glyph_position_t *glyph_pos = hb_buffer_get_glyph_positions(p_sd->hb_buffer, &glyph_count);
+	hb_glyph_info_t *glyph_info = hb_buffer_get_glyph_infos(hb_buffer, &glyph_count);
+	hb_glyph_position_t *glyph_pos = hb_buffer_get_glyph_positions(hb_buffer, &glyph_count);
 
 	// Process glyphs.
 	Glyph gl;
@@ -5989,163 +6028,172 @@ void TextServerAdvanced::_shape_run(ShapedTextDataAdvanced *p_sd, int64_t p_star
 
 	FontAdvanced *fd = _get_font_data(f);
 	ERR_FAIL_NULL(fd);
-	MutexLock lock(fd->mutex);
 
-	Vector2i fss = _get_size(fd, fs);
-	hb_font_t *hb_font = _font_get_hb_handle(f, fs);
-	double scale = _font_get_scale(f, fs);
-	double sp_sp = p_sd->extra_spacing[SPACING_SPACE] + _font_get_spacing(f, SPACING_SPACE);
-	double sp_gl = p_sd->extra_spacing[SPACING_GLYPH] + _font_get_spacing(f, SPACING_GLYPH);
-	bool last_run = (p_sd->end == p_end);
-	double ea = _get_extra_advance(f, fs);
-	bool subpos = (scale != 1.0) || (_font_get_subpixel_positioning(f) == SUBPIXEL_POSITIONING_ONE_HALF) || (_font_get_subpixel_positioning(f) == SUBPIXEL_POSITIONING_ONE_QUARTER) || (_font_get_subpixel_positioning(f) == SUBPIXEL_POSITIONING_AUTO && fs <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE);
-	ERR_FAIL_NULL(hb_font);
-
-	hb_buffer_clear_contents(p_sd->hb_buffer);
-	hb_buffer_set_direction(p_sd->hb_buffer, p_direction);
-	int flags = (p_start == 0 ? HB_BUFFER_FLAG_BOT : 0) | (p_end == p_sd->text.length() ? HB_BUFFER_FLAG_EOT : 0);
-	if (p_sd->preserve_control) {
-		flags |= HB_BUFFER_FLAG_PRESERVE_DEFAULT_IGNORABLES;
-	} else {
-		flags |= HB_BUFFER_FLAG_DEFAULT;
-	}
+	Glyph *w = nullptr;
+	unsigned int glyph_count = 0;
+	{
+		// Only hold the font lock while HarfBuzz accesses the face and new glyphs are cached.
+		// Fallback runs below may lock other fonts, and must not nest with this lock.
+		MutexLock lock(fd->mutex);
+
+		Vector2i fss = _get_size(fd, fs);
+		hb_font_t *hb_font = _font_get_hb_handle(f, fs);
+		double scale = _font_get_scale(f, fs);
+		double sp_sp = p_sd->extra_spacing[SPACING_SPACE] + _font_get_spacing(f, SPACING_SPACE);
+		double sp_gl = p_sd->extra_spacing[SPACING_GLYPH] + _font_get_spacing(f, SPACING_GLYPH);
+		bool last_run = (p_sd->end == p_end);
+		double ea = _get_extra_advance(f, fs);
+		bool subpos = (scale != 1.0) || (_font_get_subpixel_positioning(f) == SUBPIXEL_POSITIONING_ONE_HALF) || (_font_get_subpixel_positioning(f) == SUBPIXEL_POSITIONING_ONE_QUARTER) || (_font_get_subpixel_positioning(f) == SUBPIXEL_POSITIONING_AUTO && fs <= SUBPIXEL_POSITIONING_ONE_HALF_MAX_SIZE);
+		ERR_FAIL_NULL(hb_font);
+
+		hb_buffer_t *hb_buffer = _get_thread_hb_buffer();
+		hb_buffer_clear_contents(hb_buffer);
+		hb_buffer_set_direction(hb_buffer, p_direction);
+		int flags = (p_start == 0 ? HB_BUFFER_FLAG_BOT : 0) | (p_end == p_sd->text.length() ? HB_BUFFER_FLAG_EOT : 0);
+		if (p_sd->preserve_control) {
+			flags |= HB_BUFFER_FLAG_PRESERVE_DEFAULT_IGNORABLES;
+		} else {
+			flags |= HB_BUFFER_FLAG_DEFAULT;
+		}
 #if HB_VERSION_ATLEAST(5, 1, 0)
-	flags |= HB_BUFFER_FLAG_PRODUCE_SAFE_TO_INSERT_TATWEEL;
+		flags |= HB_BUFFER_FLAG_PRODUCE_SAFE_TO_INSERT_TATWEEL;
 #endif
-	hb_buffer_set_flags(p_sd->hb_buffer, (hb_buffer_flags_t)flags);
-	hb_buffer_set_script(p_sd->hb_buffer, p_script);
+		hb_buffer_set_flags(hb_buffer, (hb_buffer_flags_t)flags);
+		hb_buffer_set_script(hb_buffer, p_script);
 
-	if (p_sd->spans[p_span].language.is_empty()) {
-		hb_language_t lang = hb_language_from_string(TranslationServer::get_singleton()->get_tool_locale().ascii().get_data(), -1);
-		hb_buffer_set_language(p_sd->hb_buffer, lang);
-	} else {
-		hb_language_t lang = hb_language_from_string(p_sd->spans[p_span].language.ascii().get_data(), -1);
-		hb_buffer_set_language(p_sd->hb_buffer, lang);
-	}
+		if (p_sd->spans[p_span].language.is_empty()) {
+			hb_language_t lang = hb_language_from_string(TranslationServer::get_singleton()->get_tool_locale().ascii().get_data(), -1);
+			hb_buffer_set_language(hb_buffer, lang);
+		} else {
+			hb_language_t lang = hb_language_from_string(p_sd->spans[p_span].language.ascii().get_data(), -1);
+			hb_buffer_set_language(hb_buffer, lang);
+		}
 
-	hb_buffer_add_utf32(p_sd->hb_buffer, (const uint32_t *)p_sd->text.ptr(), p_sd->text.length(), p_start, p_end - p_start);
+		hb_buffer_add_utf32(hb_buffer, (const uint32_t *)p_sd->text.ptr(), p_sd->text.length(), p_start, p_end - p_start);
 
-	Vector<hb_feature_t> ftrs;
-	_add_featuers(_font_get_opentype_feature_overrides(f), ftrs);
-	_add_featuers(p_sd->spans[p_span].features, ftrs);
+		Vector<hb_feature_t> ftrs;
+		_add_featuers(_font_get_opentype_feature_overrides(f), ftrs);
+		_add_featuers(p_sd->spans[p_span].features, ftrs);
 
-	hb_shape(hb_font, p_sd->hb_buffer, ftrs.is_empty() ? nullptr : &ftrs[0], ftrs.size());
+		hb_shape(hb_font, hb_buffer, ftrs.is_empty() ? nullptr : &ftrs[0], ftrs.size());
 
-	unsigned int glyph_count = 0;
-	hb_glyph_info_t *glyph_info = hb_buffer_get_glyph_infos(p_sd->hb_buffer, &glyph_count);
-	hb_glyph_position_t *glyph_pos = hb_buffer_get_glyph_positions(p_sd->hb_buffer, &glyph_count);
+		hb_glyph_info_t *glyph_info = hb_buffer_get_glyph_infos(hb_buffer, &glyph_count);
+		hb_glyph_position_t *glyph_pos = hb_buffer_get_glyph_positions(hb_buffer, &glyph_count);
 
-	int mod = 0;
-	if (fd->antialiasing == FONT_ANTIALIASING_LCD) {
-		TextServer::FontLCDSubpixelLayout layout = (TextServer::FontLCDSubpixelLayout)(int)GLOBAL_GET("gui/theme/lcd_subpixel_layout");
-		if (layout != FONT_LCD_SUBPIXEL_LAYOUT_NONE) {
-			mod = (layout << 24);
+		int mod = 0;
+		if (fd->antialiasing == FONT_ANTIALIASING_LCD) {
+			TextServer::FontLCDSubpixelLayout layout = (TextServer::FontLCDSubpixelLayout)(int)GLOBAL_GET("gui/theme/lcd_subpixel_layout");
+			if (layout != FONT_LCD_SUBPIXEL_LAYOUT_NONE) {
+				mod = (layout << 24);
+			}
 		}
-	}
 
-	// Process glyphs.
-	if (glyph_count > 0) {
-		Glyph *w = (Glyph *)memalloc(glyph_count * sizeof(Glyph));
+		// Process glyphs.
+		if (glyph_count > 0) {
+			w = (Glyph *)memalloc(glyph_count * sizeof(Glyph));
 
-		int end = (p_direction == HB_DIRECTION_RTL || p_direction == HB_DIRECTION_BTT) ? p_end : 0;
-		uint32_t last_cluster_id = UINT32_MAX;
-		unsigned int last_cluster_index = 0;
-		bool last_cluster_valid = true;
+			int end = (p_direction == HB_DIRECTION_RTL || p_direction == HB_DIRECTION_BTT) ? p_end : 0;
+			uint32_t last_cluster_id = UINT32_MAX;
+			unsigned int last_cluster_index = 0;
+			bool last_cluster_valid = true;
 
-		for (unsigned int i = 0; i < glyph_count; i++) {
-			if ((i > 0) && (last_cluster_id != glyph_info[i].cluster)) {
-				if (p_direction == HB_DIRECTION_RTL || p_direction == HB_DIRECTION_BTT) {
-					end = w[last_cluster_index].start;
-				} else {
-					for (unsigned int j = last_cluster_index; j < i; j++) {
-						w[j].end = glyph_info[i].cluster;
+			for (unsigned int i = 0; i < glyph_count; i++) {
+				if ((i > 0) && (last_cluster_id != glyph_info[i].cluster)) {
+					if (p_direction == HB_DIRECTION_RTL || p_direction == HB_DIRECTION_BTT) {
+						end = w[last_cluster_index].start;
+					} else {
+						for (unsigned int j = last_cluster_index; j < i; j++) {
+							w[j].end = glyph_info[i].cluster;
+						}
 					}
+					if (p_direction == HB_DIRECTION_RTL || p_direction == HB_DIRECTION_BTT) {
+						w[last_cluster_index].flags |= GRAPHEME_IS_RTL;
+					}
+					if (last_cluster_valid) {
+						w[last_cluster_index].flags |= GRAPHEME_IS_VALID;
+					}
+					w[last_cluster_index].count = i - last_cluster_index;
+					last_cluster_index = i;
+					last_cluster_valid = true;
 				}
-				if (p_direction == HB_DIRECTION_RTL || p_direction == HB_DIRECTION_BTT) {
-					w[last_cluster_index].flags |= GRAPHEME_IS_RTL;
-				}
-				if (last_cluster_valid) {
-					w[last_cluster_index].flags |= GRAPHEME_IS_VALID;
-				}
-				w[last_cluster_index].count = i - last_cluster_index;
-				last_cluster_index = i;
-				last_cluster_valid = true;
-			}
 
-			last_cluster_id = glyph_info[i].cluster;
+				last_cluster_id = glyph_info[i].cluster;
 
-			Glyph &gl = w[i];
-			gl = Glyph();
+				Glyph &gl = w[i];
+				gl = Glyph();
 
-			gl.start = glyph_info[i].cluster;
-			gl.end = end;
-			gl.count = 0;
+				gl.start = glyph_info[i].cluster;
+				gl.end = end;
+				gl.count = 0;
 
-			gl.font_rid = f;
-			gl.font_size = fs;
+				gl.font_rid = f;
+				gl.font_size = fs;
 
-			if (glyph_info[i].mask & HB_GLYPH_FLAG_UNSAFE_TO_BREAK) {
-				gl.flags |= GRAPHEME_IS_CONNECTED;
-			}
+				if (glyph_info[i].mask & HB_GLYPH_FLAG_UNSAFE_TO_BREAK) {
+					gl.flags |= GRAPHEME_IS_CONNECTED;
+				}
 
 #if HB_VERSION_ATLEAST(5, 1, 0)
-			if (glyph_info[i].mask & HB_GLYPH_FLAG_SAFE_TO_INSERT_TATWEEL) {
-				gl.flags |= GRAPHEME_IS_SAFE_TO_INSERT_TATWEEL;
-			}
+				if (glyph_info[i].mask & HB_GLYPH_FLAG_SAFE_TO_INSERT_TATWEEL) {
+					gl.flags |= GRAPHEME_IS_SAFE_TO_INSERT_TATWEEL;
+				}
 #endif
 
-			gl.index = glyph_info[i].codepoint;
-			if (gl.index != 0) {
-				_ensure_glyph(fd, fss, gl.index | mod);
-				if (p_sd->orientation == ORIENTATION_HORIZONTAL) {
+				gl.index = glyph_info[i].codepoint;
+				if (gl.index != 0) {
+					_ensure_glyph(fd, fss, gl.index | mod);
+					if (p_sd->orientation == ORIENTATION_HORIZONTAL) {
+						if (subpos) {
+							gl.advance = (double)glyph_pos[i].x_advance / (64.0 / scale) + ea;
+						} else {
+							gl.advance = Math::round((double)glyph_pos[i].x_advance / (64.0 / scale) + ea);
+						}
+					} else {
+						gl.advance = -Math::round((double)glyph_pos[i].y_advance / (64.0 / scale));
+					}
 					if (subpos) {
-						gl.advance = (double)glyph_pos[i].x_advance / (64.0 / scale) + ea;
+						gl.x_off = (double)glyph_pos[i].x_offset / (64.0 / scale);
 					} else {
-						gl.advance = Math::round((double)glyph_pos[i].x_advance / (64.0 / scale) + ea);
+						gl.x_off = Math::round((double)glyph_pos[i].x_offset / (64.0 / scale));
+					}
+					gl.y_off = -Math::round((double)glyph_pos[i].y_offset / (64.0 / scale));
+					if (p_sd->orientation == ORIENTATION_HORIZONTAL) {
+						gl.y_off += _font_get_baseline_offset(gl.font_rid) * (double)(_font_get_ascent(gl.font_rid, gl.font_size) + _font_get_descent(gl.font_rid, gl.font_size));
+					} else {
+						gl.x_off += _font_get_baseline_offset(gl.font_rid) * (double)(_font_get_ascent(gl.font_rid, gl.font_size) + _font_get_descent(gl.font_rid, gl.font_size));
 					}
-				} else {
-					gl.advance = -Math::round((double)glyph_pos[i].y_advance / (64.0 / scale));
 				}
-				if (subpos) {
-					gl.x_off = (double)glyph_pos[i].x_offset / (64.0 / scale);
-				} else {
-					gl.x_off = Math::round((double)glyph_pos[i].x_offset / (64.0 / scale));
+				if (!last_run || i < glyph_count - 1) {
+					// Do not add extra spacing to the last glyph of the string.
+					if (sp_sp && is_whitespace(p_sd->text[glyph_info[i].cluster])) {
+						gl.advance += sp_sp;
+					} else {
+						gl.advance += sp_gl;
+					}
 				}
-				gl.y_off = -Math::round((double)glyph_pos[i].y_offset / (64.0 / scale));
-				if (p_sd->orientation == ORIENTATION_HORIZONTAL) {
-					gl.y_off += _font_get_baseline_offset(gl.font_rid) * (double)(_font_get_ascent(gl.font_rid, gl.font_size) + _font_get_descent(gl.font_rid, gl.font_size));
+
+				if (p_sd->preserve_control) {
+					last_cluster_valid = last_cluster_valid && ((glyph_info[i].codepoint != 0) || (p_sd->text[glyph_info[i].cluster] == 0x0009) || (u_isblank(p_sd->text[glyph_info[i].cluster]) && (gl.advance != 0)) || (!u_isblank(p_sd->text[glyph_info[i].cluster]) && is_linebreak(p_sd->text[glyph_info[i].cluster])));
 				} else {
-					gl.x_off += _font_get_baseline_offset(gl.font_rid) * (double)(_font_get_ascent(gl.font_rid, gl.font_size) + _font_get_descent(gl.font_rid, gl.font_size));
+					last_cluster_valid = last_cluster_valid && ((glyph_info[i].codepoint != 0) || (p_sd->text[glyph_info[i].cluster] == 0x0009) || (u_isblank(p_sd->text[glyph_info[i].cluster]) && (gl.advance != 0)) || (!u_isblank(p_sd->text[glyph_info[i].cluster]) && !u_isgraph(p_sd->text[glyph_info[i].cluster])));
 				}
 			}
-			if (!last_run || i < glyph_count - 1) {
-				// Do not add extra spacing to the last glyph of the string.
-				if (sp_sp && is_whitespace(p_sd->text[glyph_info[i].cluster])) {
-					gl.advance += sp_sp;
-				} else {
-					gl.advance += sp_gl;
+			if (p_direction == HB_DIRECTION_LTR || p_direction == HB_DIRECTION_TTB) {
+				for (unsigned int j = last_cluster_index; j < glyph_count; j++) {
+					w[j].end = p_end;
 				}
 			}
-
-			if (p_sd->preserve_control) {
-				last_cluster_valid = last_cluster_valid && ((glyph_info[i].codepoint != 0) || (p_sd->text[glyph_info[i].cluster] == 0x0009) || (u_isblank(p_sd->text[glyph_info[i].cluster]) && (gl.advance != 0)) || (!u_isblank(p_sd->text[glyph_info[i].cluster]) && is_linebreak(p_sd->text[glyph_info[i].cluster])));
-			} else {
-				last_cluster_valid = last_cluster_valid && ((glyph_info[i].codepoint != 0) || (p_sd->text[glyph_info[i].cluster] == 0x0009) || (u_isblank(p_sd->text[glyph_info[i].cluster]) && (gl.advance != 0)) || (!u_isblank(p_sd->text[glyph_info[i].cluster]) && !u_isgraph(p_sd->text[glyph_info[i].cluster])));
+			w[last_cluster_index].count = glyph_count - last_cluster_index;
+			if (p_direction == HB_DIRECTION_RTL || p_direction == HB_DIRECTION_BTT) {
+				w[last_cluster_index].flags |= GRAPHEME_IS_RTL;
 			}
-		}
-		if (p_direction == HB_DIRECTION_LTR || p_direction == HB_DIRECTION_TTB) {
-			for (unsigned int j = last_cluster_index; j < glyph_count; j++) {
-				w[j].end = p_end;
+			if (last_cluster_valid) {
+				w[last_cluster_index].flags |= GRAPHEME_IS_VALID;
 			}
 		}
-		w[last_cluster_index].count = glyph_count - last_cluster_index;
-		if (p_direction == HB_DIRECTION_RTL || p_direction == HB_DIRECTION_BTT) {
-			w[last_cluster_index].flags |= GRAPHEME_IS_RTL;
-		}
-		if (last_cluster_valid) {
-			w[last_cluster_index].flags |= GRAPHEME_IS_VALID;
-		}
+	}
 
+	if (glyph_count > 0) {
 		// Fallback.
 		int failed_subrun_start = p_end + 1;
 		int failed_subrun_end = p_start;
@@ -6193,7 +6241,6 @@ void TextServerAdvanced::_shape_run(ShapedTextDataAdvanced *p_sd, int64_t p_star
 }
 
 bool TextServerAdvanced::_shaped_text_shape(const RID &p_shaped) {
-	_THREAD_SAFE_METHOD_
 	ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, false);
 
@@ -6409,6 +6456,46 @@ bool TextServerAdvanced::_shaped_text_shape(const RID &p_shaped) {
 	return sd->valid;
 }
 
+void TextServerAdvanced::_shape_batch_threaded(void *p_td, uint32_t p_index) {
+	ShapeBatchData *td = static_cast<ShapeBatchData *>(p_td);
+	td->results[p_index] = td->ts->_shaped_text_shape(td->rids[p_index]);
+}
+
+bool TextServerAdvanced::_shaped_text_shape_batch(const TypedArray<RID> &p_shaped) {
+	int count = p_shaped.size();
+	if (count == 0) {
+		return true;
+	}
+
+	Vector<RID> rids;
+	rids.resize(count);
+	for (int i = 0; i < count; i++) {
+		rids.write[i] = p_shaped[i];
+	}
+	if (count == 1) {
+		return _shaped_text_shape(rids[0]);
+	}
+
+	// Each buffer is guarded by its own mutex, and fonts are only locked while glyphs are shaped and cached,
+	// so independent paragraphs can be shaped concurrently.
+	Vector<uint8_t> results;
+	results.resize(count);
+
+	ShapeBatchData td;
+	td.ts = this;
+	td.rids = rids.ptr();
+	td.results = results.ptrw();
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&TextServerAdvanced::_shape_batch_threaded, &td, count, -1, true, String("TextServerShapeBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	bool ok = true;
+	for (int i = 0; i < count; i++) {
+		ok = ok && results[i];
+	}
+	return ok;
+}
+
 bool TextServerAdvanced::_shaped_text_is_ready(const RID &p_shaped) const {
 	const ShapedTextDataAdvanced *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, false);
@@ -7359,7 +7446,7 @@ TextServerAdvanced::TextServerAdvanced() {
 }
 
 void TextServerAdvanced::_cleanup() {
-	_THREAD_SAFE_METHOD_
+	MutexLock lock(system_fonts_mutex);
 	for (const KeyValue<SystemFontKey, SystemFontCache> &E : system_fonts) {
 		const Vector<SystemFontCacheRec> &sysf_cache = E.value.var;
 		for (const SystemFontCacheRec &F : sysf_cache) {
@@ -517,7 +517,6 @@ class TextServerAdvanced : public TextServerExtension {
 		Vector<UBiDi *> bidi_iter;
 		Vector<Vector3i> bidi_override;
 		ScriptIterator *script_iter = nullptr;
-		hb_buffer_t *hb_buffer = nullptr;
 
 		HashMap<int, bool> jstops;
 		HashMap<int, bool> breaks;
@@ -536,18 +535,19 @@ class TextServerAdvanced : public TextServerExtension {
 			if (script_iter) {
 				memdelete(script_iter);
 			}
-			if (hb_buffer) {
-				hb_buffer_destroy(hb_buffer);
-			}
 		}
 	};
 
 	// Common data.
 
 	double oversampling = 1.0;
-	mutable RID_PtrOwner<FontAdvancedLinkedVariation> font_var_owner;
-	mutable RID_PtrOwner<FontAdvanced> font_owner;
-	mutable RID_PtrOwner<ShapedTextDataAdvanced> shaped_owner;
+	// Owners are thread-safe, since shaping may run on worker threads (see `shaped_text_shape_batch`)
+	// and create system fallback fonts while other threads look up existing ones.
+	mutable RID_PtrOwner<FontAdvancedLinkedVariation, true> font_var_owner;
+	mutable RID_PtrOwner<FontAdvanced, true> font_owner;
+	mutable RID_PtrOwner<ShapedTextDataAdvanced, true> shaped_owner;
+	// Lock order is `sd->mutex`, then `system_fonts_mutex`, then the font locks.
+	// The global lock of `_THREAD_SAFE_CLASS_` can be taken before them, but never while holding any of them.
 
 	_FORCE_INLINE_ FontAdvanced *_get_font_data(const RID &p_font_rid) const {
 		RID rid = p_font_rid;
@@ -646,6 +646,7 @@ class TextServerAdvanced : public TextServerExtension {
 	};
 	mutable HashMap<SystemFontKey, SystemFontCache, SystemFontKeyHasher> system_fonts;
 	mutable HashMap<String, PackedByteArray> system_font_data;
+	Mutex system_fonts_mutex; // Guards `system_fonts` and `system_font_data`.
 
 	void _update_chars(ShapedTextDataAdvanced *p_sd) const;
 	void _realign(ShapedTextDataAdvanced *p_sd) const;
@@ -657,6 +658,13 @@ class TextServerAdvanced : public TextServerExtension {
 	Glyph _shape_single_glyph(ShapedTextDataAdvanced *p_sd, char32_t p_char, hb_script_t p_script, hb_direction_t p_direction, const RID &p_font, int64_t p_font_size);
 	_FORCE_INLINE_ RID _find_sys_font_for_text(const RID &p_fdef, const String &p_script_code, const String &p_language, const String &p_text);
 
+	struct ShapeBatchData {
+		TextServerAdvanced *ts = nullptr;
+		const RID *rids = nullptr;
+		uint8_t *results = nullptr;
+	};
+	static void _shape_batch_threaded(void *p_td, uint32_t p_index);
+
 	_FORCE_INLINE_ void _add_featuers(const Dictionary &p_source, Vector<hb_feature_t> &r_ftrs);
 
 	Mutex ft_mutex;
@@ -944,6 +952,7 @@ public:
 	MODBIND2R(double, shaped_text_tab_align, const RID &, const PackedFloat32Array &);
 
 	MODBIND1R(bool, shaped_text_shape, const RID &);
+	MODBIND1R(bool, shaped_text_shape_batch, const TypedArray<RID> &);
 	MODBIND1R(bool, shaped_text_update_breaks, const RID &);
 	MODBIND1R(bool, shaped_text_update_justification_ops, const RID &);
 
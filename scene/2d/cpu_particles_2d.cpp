@@ -30,12 +30,15 @@
 
 #include "cpu_particles_2d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "scene/2d/gpu_particles_2d.h"
 #include "scene/resources/atlas_texture.h"
 #include "scene/resources/curve_texture.h"
 #include "scene/resources/gradient_texture.h"
 #include "scene/resources/particle_process_material.h"
 
+int CPUParticles2D::threading_threshold = 4096;
+
 void CPUParticles2D::set_emitting(bool p_emitting) {
 	if (emitting == p_emitting) {
 		return;
@@ -64,6 +67,8 @@ void CPUParticles2D::set_amount(int p_amount) {
 	RS::get_singleton()->multimesh_allocate_data(multimesh, p_amount, RS::MULTIMESH_TRANSFORM_2D, true, true);
 
 	particle_order.resize(p_amount);
+	particle_process_states.resize(p_amount);
+	particle_process_deltas.resize(p_amount);
 }
 
 void CPUParticles2D::set_lifetime(double p_lifetime) {
@@ -650,6 +655,7 @@ void CPUParticles2D::_particles_process(double p_delta) {
 	for (int i = 0; i < pcount; i++) {
 		Particle &p = parray[i];
 
+		particle_process_states[i] = PARTICLE_PROCESS_SKIP;
 		if (!emitting && !p.active) {
 			continue;
 		}
@@ -808,12 +814,64 @@ void CPUParticles2D::_particles_process(double p_delta) {
 				p.transform = emission_xform * p.transform;
 			}
 
+			particle_process_states[i] = PARTICLE_PROCESS_RESTARTED;
 		} else if (!p.active) {
 			continue;
 		} else if (p.time > p.lifetime) {
 			p.active = false;
-			tv = 1.0;
+			particle_process_states[i] = PARTICLE_PROCESS_EXPIRED;
 		} else {
+			particle_process_states[i] = PARTICLE_PROCESS_INTEGRATE;
+		}
+
+		particle_process_deltas[i] = local_delta;
+		should_be_active = true;
+	}
+
+	if (should_be_active) {
+		if (color_ramp.is_valid()) {
+			// Sorts the gradient points now, so worker threads only read them.
+			color_ramp->get_color_at_offset(0.0);
+		}
+
+		ParticlesProcessData data;
+		data.particles = parray;
+		data.particle_count = pcount;
+		data.emission_origin = emission_xform[2];
+
+		const uint32_t chunk_count = Math::division_round_up((uint32_t)pcount, PARTICLES_CHUNK_SIZE);
+		if (pcount >= threading_threshold) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles2D::_particles_process_chunk, &data, chunk_count, -1, true, SNAME("CPUParticles2DProcess"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < chunk_count; i++) {
+				_particles_process_chunk(i, &data);
+			}
+		}
+	}
+	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
+		active = false;
+		emit_signal(SceneStringName(finished));
+	}
+}
+
+void CPUParticles2D::_particles_process_chunk(uint32_t p_chunk, ParticlesProcessData *p_data) {
+	const uint32_t from = p_chunk * PARTICLES_CHUNK_SIZE;
+	const uint32_t to = MIN(from + PARTICLES_CHUNK_SIZE, p_data->particle_count);
+
+	for (uint32_t i = from; i < to; i++) {
+		const uint8_t state = particle_process_states[i];
+		if (state == PARTICLE_PROCESS_SKIP) {
+			continue;
+		}
+
+		Particle &p = p_data->particles[i];
+		double local_delta = particle_process_deltas[i];
+		float tv = 0.0;
+
+		if (state == PARTICLE_PROCESS_EXPIRED) {
+			tv = 1.0;
+		} else if (state == PARTICLE_PROCESS_INTEGRATE) {
 			uint32_t alt_seed = p.seed;
 
 			p.time += local_delta;
@@ -875,7 +933,7 @@ void CPUParticles2D::_particles_process(double p_delta) {
 			//apply linear acceleration
 			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector2();
 			//apply radial acceleration
-			Vector2 org = emission_xform[2];
+			Vector2 org = p_data->emission_origin;
 			Vector2 diff = pos - org;
 			force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector2();
 			//apply tangential acceleration;
@@ -991,12 +1049,6 @@ void CPUParticles2D::_particles_process(double p_delta) {
 		p.transform.columns[1] *= base_scale.y;
 
 		p.transform[2] += p.velocity * local_delta;
-
-		should_be_active = true;
-	}
-	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
-		active = false;
-		emit_signal(SceneStringName(finished));
 	}
 }
 
@@ -1010,7 +1062,6 @@ void CPUParticles2D::_update_particle_data_buffer() {
 
 	float *w = particle_data.ptrw();
 	const Particle *r = particles.ptr();
-	float *ptr = w;
 
 	if (draw_order != DRAW_ORDER_INDEX) {
 		ow = particle_order.ptrw();
@@ -1026,16 +1077,39 @@ void CPUParticles2D::_update_particle_data_buffer() {
 		}
 	}
 
-	for (int i = 0; i < pc; i++) {
-		int idx = order ? order[i] : i;
+	ParticlesBufferData data;
+	data.particles = r;
+	data.order = order;
+	data.buffer = w;
+	data.particle_count = pc;
+
+	const uint32_t chunk_count = Math::division_round_up((uint32_t)pc, PARTICLES_CHUNK_SIZE);
+	if (pc >= threading_threshold) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles2D::_update_particle_data_chunk, &data, chunk_count, -1, true, SNAME("CPUParticles2DUpdateBuffer"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_update_particle_data_chunk(i, &data);
+		}
+	}
+}
+
+void CPUParticles2D::_update_particle_data_chunk(uint32_t p_chunk, ParticlesBufferData *p_data) {
+	const uint32_t from = p_chunk * PARTICLES_CHUNK_SIZE;
+	const uint32_t to = MIN(from + PARTICLES_CHUNK_SIZE, p_data->particle_count);
 
-		Transform2D t = r[idx].transform;
+	for (uint32_t i = from; i < to; i++) {
+		int idx = p_data->order ? p_data->order[i] : i;
+		const Particle &p = p_data->particles[idx];
+		float *ptr = p_data->buffer + i * 16;
+
+		Transform2D t = p.transform;
 
 		if (!local_coords) {
 			t = inv_emission_transform * t;
 		}
 
-		if (r[idx].active) {
+		if (p.active) {
 			ptr[0] = t.columns[0][0];
 			ptr[1] = t.columns[1][0];
 			ptr[2] = 0;
@@ -1049,19 +1123,17 @@ void CPUParticles2D::_update_particle_data_buffer() {
 			memset(ptr, 0, sizeof(float) * 8);
 		}
 
-		Color c = r[idx].color;
+		Color c = p.color;
 
 		ptr[8] = c.r;
 		ptr[9] = c.g;
 		ptr[10] = c.b;
 		ptr[11] = c.a;
 
-		ptr[12] = r[idx].custom[0];
-		ptr[13] = r[idx].custom[1];
-		ptr[14] = r[idx].custom[2];
-		ptr[15] = r[idx].custom[3];
-
-		ptr += 16;
+		ptr[12] = p.custom[0];
+		ptr[13] = p.custom[1];
+		ptr[14] = p.custom[2];
+		ptr[15] = p.custom[3];
 	}
 }
 
@@ -99,6 +99,29 @@ private:
 		uint32_t seed = 0;
 	};
 
+	// What the serial emission pass left for the integration pass to do with each particle.
+	enum ParticleProcessState : uint8_t {
+		PARTICLE_PROCESS_SKIP,
+		PARTICLE_PROCESS_RESTARTED,
+		PARTICLE_PROCESS_EXPIRED,
+		PARTICLE_PROCESS_INTEGRATE,
+	};
+
+	static constexpr uint32_t PARTICLES_CHUNK_SIZE = 512;
+
+	struct ParticlesProcessData {
+		Particle *particles = nullptr;
+		uint32_t particle_count = 0;
+		Vector2 emission_origin;
+	};
+
+	struct ParticlesBufferData {
+		const Particle *particles = nullptr;
+		const int *order = nullptr;
+		float *buffer = nullptr;
+		uint32_t particle_count = 0;
+	};
+
 	double time = 0.0;
 	double frame_remainder = 0.0;
 	int cycle = 0;
@@ -110,6 +133,8 @@ private:
 	Vector<Particle> particles;
 	Vector<float> particle_data;
 	Vector<int> particle_order;
+	LocalVector<uint8_t> particle_process_states;
+	LocalVector<double> particle_process_deltas;
 
 	struct SortLifetime {
 		const Particle *particles = nullptr;
@@ -178,7 +203,9 @@ private:
 
 	void _update_internal();
 	void _particles_process(double p_delta);
+	void _particles_process_chunk(uint32_t p_chunk, ParticlesProcessData *p_data);
 	void _update_particle_data_buffer();
+	void _update_particle_data_chunk(uint32_t p_chunk, ParticlesBufferData *p_data);
 
 	Mutex update_mutex;
 
@@ -196,6 +223,10 @@ protected:
 	void _validate_property(PropertyInfo &p_property) const;
 
 public:
+	// Emitters with at least this amount of particles are processed on worker threads.
+	// Only meant to be changed by benchmarks comparing both paths.
+	static int threading_threshold;
+
 	void set_emitting(bool p_emitting);
 	void set_amount(int p_amount);
 	void set_lifetime(double p_lifetime);
@@ -141,9 +141,9 @@ void Area2D::_body_enter_tree(ObjectID p_id) {
 	ERR_FAIL_COND(E->value.in_tree);
 
 	E->value.in_tree = true;
-	emit_signal(SceneStringName(body_entered), node);
+	emit_signal(body_entered_signal, node);
 	for (int i = 0; i < E->value.shapes.size(); i++) {
-		emit_signal(SceneStringName(body_shape_entered), E->value.rid, node, E->value.shapes[i].body_shape, E->value.shapes[i].area_shape);
+		emit_signal(body_shape_entered_signal, E->value.rid, node, E->value.shapes[i].body_shape, E->value.shapes[i].area_shape);
 	}
 }
 
@@ -155,9 +155,9 @@ void Area2D::_body_exit_tree(ObjectID p_id) {
 	ERR_FAIL_COND(!E);
 	ERR_FAIL_COND(!E->value.in_tree);
 	E->value.in_tree = false;
-	emit_signal(SceneStringName(body_exited), node);
+	emit_signal(body_exited_signal, node);
 	for (int i = 0; i < E->value.shapes.size(); i++) {
-		emit_signal(SceneStringName(body_shape_exited), E->value.rid, node, E->value.shapes[i].body_shape, E->value.shapes[i].area_shape);
+		emit_signal(body_shape_exited_signal, E->value.rid, node, E->value.shapes[i].body_shape, E->value.shapes[i].area_shape);
 	}
 }
 
@@ -171,9 +171,9 @@ void Area2D::_body_inout(int p_status, const RID &p_body, ObjectID p_instance, i
 		lock_callback();
 		locked = true;
 		if (body_in) {
-			emit_signal(SceneStringName(body_shape_entered), p_body, (Node *)nullptr, p_body_shape, p_area_shape);
+			emit_signal(body_shape_entered_signal, p_body, (Node *)nullptr, p_body_shape, p_area_shape);
 		} else {
-			emit_signal(SceneStringName(body_shape_exited), p_body, (Node *)nullptr, p_body_shape, p_area_shape);
+			emit_signal(body_shape_exited_signal, p_body, (Node *)nullptr, p_body_shape, p_area_shape);
 		}
 		locked = false;
 		unlock_callback();
@@ -202,7 +202,7 @@ void Area2D::_body_inout(int p_status, const RID &p_body, ObjectID p_instance, i
 				node->connect(SceneStringName(tree_entered), callable_mp(this, &Area2D::_body_enter_tree).bind(objid));
 				node->connect(SceneStringName(tree_exiting), callable_mp(this, &Area2D::_body_exit_tree).bind(objid));
 				if (E->value.in_tree) {
-					emit_signal(SceneStringName(body_entered), node);
+					emit_signal(body_entered_signal, node);
 				}
 			}
 		}
@@ -212,7 +212,7 @@ void Area2D::_body_inout(int p_status, const RID &p_body, ObjectID p_instance, i
 		}
 
 		if (!node || E->value.in_tree) {
-			emit_signal(SceneStringName(body_shape_entered), p_body, node, p_body_shape, p_area_shape);
+			emit_signal(body_shape_entered_signal, p_body, node, p_body_shape, p_area_shape);
 		}
 
 	} else {
@@ -229,12 +229,12 @@ void Area2D::_body_inout(int p_status, const RID &p_body, ObjectID p_instance, i
 				node->disconnect(SceneStringName(tree_entered), callable_mp(this, &Area2D::_body_enter_tree));
 				node->disconnect(SceneStringName(tree_exiting), callable_mp(this, &Area2D::_body_exit_tree));
 				if (in_tree) {
-					emit_signal(SceneStringName(body_exited), obj);
+					emit_signal(body_exited_signal, obj);
 				}
 			}
 		}
 		if (!node || in_tree) {
-			emit_signal(SceneStringName(body_shape_exited), p_body, obj, p_body_shape, p_area_shape);
+			emit_signal(body_shape_exited_signal, p_body, obj, p_body_shape, p_area_shape);
 		}
 	}
 
@@ -252,9 +252,9 @@ void Area2D::_area_enter_tree(ObjectID p_id) {
 	ERR_FAIL_COND(E->value.in_tree);
 
 	E->value.in_tree = true;
-	emit_signal(SceneStringName(area_entered), node);
+	emit_signal(area_entered_signal, node);
 	for (int i = 0; i < E->value.shapes.size(); i++) {
-		emit_signal(SceneStringName(area_shape_entered), E->value.rid, node, E->value.shapes[i].area_shape, E->value.shapes[i].self_shape);
+		emit_signal(area_shape_entered_signal, E->value.rid, node, E->value.shapes[i].area_shape, E->value.shapes[i].self_shape);
 	}
 }
 
@@ -266,9 +266,9 @@ void Area2D::_area_exit_tree(ObjectID p_id) {
 	ERR_FAIL_COND(!E);
 	ERR_FAIL_COND(!E->value.in_tree);
 	E->value.in_tree = false;
-	emit_signal(SceneStringName(area_exited), node);
+	emit_signal(area_exited_signal, node);
 	for (int i = 0; i < E->value.shapes.size(); i++) {
-		emit_signal(SceneStringName(area_shape_exited), E->value.rid, node, E->value.shapes[i].area_shape, E->value.shapes[i].self_shape);
+		emit_signal(area_shape_exited_signal, E->value.rid, node, E->value.shapes[i].area_shape, E->value.shapes[i].self_shape);
 	}
 }
 
@@ -282,9 +282,9 @@ void Area2D::_area_inout(int p_status, const RID &p_area, ObjectID p_instance, i
 		lock_callback();
 		locked = true;
 		if (area_in) {
-			emit_signal(SceneStringName(area_shape_entered), p_area, (Node *)nullptr, p_area_shape, p_self_shape);
+			emit_signal(area_shape_entered_signal, p_area, (Node *)nullptr, p_area_shape, p_self_shape);
 		} else {
-			emit_signal(SceneStringName(area_shape_exited), p_area, (Node *)nullptr, p_area_shape, p_self_shape);
+			emit_signal(area_shape_exited_signal, p_area, (Node *)nullptr, p_area_shape, p_self_shape);
 		}
 		locked = false;
 		unlock_callback();
@@ -313,7 +313,7 @@ void Area2D::_area_inout(int p_status, const RID &p_area, ObjectID p_instance, i
 				node->connect(SceneStringName(tree_entered), callable_mp(this, &Area2D::_area_enter_tree).bind(objid));
 				node->connect(SceneStringName(tree_exiting), callable_mp(this, &Area2D::_area_exit_tree).bind(objid));
 				if (E->value.in_tree) {
-					emit_signal(SceneStringName(area_entered), node);
+					emit_signal(area_entered_signal, node);
 				}
 			}
 		}
@@ -323,7 +323,7 @@ void Area2D::_area_inout(int p_status, const RID &p_area, ObjectID p_instance, i
 		}
 
 		if (!node || E->value.in_tree) {
-			emit_signal(SceneStringName(area_shape_entered), p_area, node, p_area_shape, p_self_shape);
+			emit_signal(area_shape_entered_signal, p_area, node, p_area_shape, p_self_shape);
 		}
 
 	} else {
@@ -340,12 +340,12 @@ void Area2D::_area_inout(int p_status, const RID &p_area, ObjectID p_instance, i
 				node->disconnect(SceneStringName(tree_entered), callable_mp(this, &Area2D::_area_enter_tree));
 				node->disconnect(SceneStringName(tree_exiting), callable_mp(this, &Area2D::_area_exit_tree));
 				if (in_tree) {
-					emit_signal(SceneStringName(area_exited), obj);
+					emit_signal(area_exited_signal, obj);
 				}
 			}
 		}
 		if (!node || in_tree) {
-			emit_signal(SceneStringName(area_shape_exited), p_area, obj, p_area_shape, p_self_shape);
+			emit_signal(area_shape_exited_signal, p_area, obj, p_area_shape, p_self_shape);
 		}
 	}
 
@@ -377,10 +377,10 @@ void Area2D::_clear_monitoring() {
 			}
 
 			for (int i = 0; i < E.value.shapes.size(); i++) {
-				emit_signal(SceneStringName(body_shape_exited), E.value.rid, node, E.value.shapes[i].body_shape, E.value.shapes[i].area_shape);
+				emit_signal(body_shape_exited_signal, E.value.rid, node, E.value.shapes[i].body_shape, E.value.shapes[i].area_shape);
 			}
 
-			emit_signal(SceneStringName(body_exited), obj);
+			emit_signal(body_exited_signal, obj);
 		}
 	}
 
@@ -405,10 +405,10 @@ void Area2D::_clear_monitoring() {
 			}
 
 			for (int i = 0; i < E.value.shapes.size(); i++) {
-				emit_signal(SceneStringName(area_shape_exited), E.value.rid, node, E.value.shapes[i].area_shape, E.value.shapes[i].self_shape);
+				emit_signal(area_shape_exited_signal, E.value.rid, node, E.value.shapes[i].area_shape, E.value.shapes[i].self_shape);
 			}
 
-			emit_signal(SceneStringName(area_exited), obj);
+			emit_signal(area_exited_signal, obj);
 		}
 	}
 }
@@ -674,7 +674,15 @@ void Area2D::_bind_methods() {
 }
 
 Area2D::Area2D() :
-		CollisionObject2D(PhysicsServer2D::get_singleton()->area_create(), true) {
+		CollisionObject2D(PhysicsServer2D::get_singleton()->area_create(), true),
+		body_entered_signal(SceneStringName(body_entered)),
+		body_exited_signal(SceneStringName(body_exited)),
+		body_shape_entered_signal(SceneStringName(body_shape_entered)),
+		body_shape_exited_signal(SceneStringName(body_shape_exited)),
+		area_entered_signal(SceneStringName(area_entered)),
+		area_exited_signal(SceneStringName(area_exited)),
+		area_shape_entered_signal(SceneStringName(area_shape_entered)),
+		area_shape_exited_signal(SceneStringName(area_shape_exited)) {
 	set_gravity(980);
 	set_gravity_direction(Vector2(0, 1));
 	set_monitoring(true);
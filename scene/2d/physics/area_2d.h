@@ -132,6 +132,16 @@ private:
 	bool audio_bus_override = false;
 	StringName audio_bus;
 
+	// Cached lookups for the signals emitted on every physics overlap change.
+	SignalHandle body_entered_signal;
+	SignalHandle body_exited_signal;
+	SignalHandle body_shape_entered_signal;
+	SignalHandle body_shape_exited_signal;
+	SignalHandle area_entered_signal;
+	SignalHandle area_exited_signal;
+	SignalHandle area_shape_entered_signal;
+	SignalHandle area_shape_exited_signal;
+
 protected:
 	static void _bind_methods();
 	void _validate_property(PropertyInfo &p_property) const;
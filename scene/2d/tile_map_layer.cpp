@@ -31,6 +31,8 @@
 #include "tile_map_layer.h"
 
 #include "core/io/marshalls.h"
+#include "core/math/geometry_2d.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/2d/tile_map.h"
 #include "scene/gui/control.h"
 #include "scene/resources/world_2d.h"
@@ -239,6 +241,9 @@ void TileMapLayer::_rendering_update(bool p_force_cleanup) {
 		}
 
 		// Update all dirty quadrants.
+		LocalVector<RenderingQuadrantRebuild> rebuilds;
+		const bool layer_y_sort_enabled = is_y_sort_enabled();
+		const Color layer_self_modulate = get_self_modulate();
 		for (SelfList<RenderingQuadrant> *quadrant_list_element = dirty_rendering_quadrant_list.first(); quadrant_list_element;) {
 			SelfList<RenderingQuadrant> *next_quadrant_list_element = quadrant_list_element->next(); // "Hack" to clear the list while iterating.
 
@@ -255,113 +260,97 @@ void TileMapLayer::_rendering_update(bool p_force_cleanup) {
 			}
 
 			if (has_a_tile) {
-				// Process the quadrant.
-
-				// First, clear the quadrant's canvas items.
-				for (RID &ci : rendering_quadrant->canvas_items) {
-					rs->free(ci);
-				}
-				rendering_quadrant->canvas_items.clear();
-
-				// Sort the quadrant cells.
-				if (is_y_sort_enabled()) {
-					// For compatibility reasons, we use another comparator for Y-sorted layers.
-					rendering_quadrant->cells.sort_custom<CellDataYSortedComparator>();
-				} else {
-					rendering_quadrant->cells.sort();
-				}
-
-				// Those allow to group cell per material or z-index.
-				Ref<Material> prev_material;
-				int prev_z_index = 0;
-				RID prev_ci;
-
-				for (SelfList<CellData> *cell_data_quadrant_list_element = rendering_quadrant->cells.first(); cell_data_quadrant_list_element; cell_data_quadrant_list_element = cell_data_quadrant_list_element->next()) {
-					CellData &cell_data = *cell_data_quadrant_list_element->self();
-
-					TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*tile_set->get_source(cell_data.cell.source_id));
-
-					// Get the tile data.
-					const TileData *tile_data;
-					if (cell_data.runtime_tile_data_cache) {
-						tile_data = cell_data.runtime_tile_data_cache;
-					} else {
-						tile_data = atlas_source->get_tile_data(cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile);
+				// Process the quadrant once all of them are known.
+				RenderingQuadrantRebuild rebuild;
+				rebuild.quadrant = rendering_quadrant.ptr();
+				rebuild.y_sort_enabled = layer_y_sort_enabled;
+				rebuild.self_modulate = layer_self_modulate;
+				rebuilds.push_back(rebuild);
+			} else {
+				// Free the quadrant.
+				for (const RID &ci : rendering_quadrant->canvas_items) {
+					if (ci.is_valid()) {
+						rs->free(ci);
 					}
+				}
+				rendering_quadrant->cells.clear();
+				rendering_quadrant_map.erase(rendering_quadrant->quadrant_coords);
+			}
 
-					Ref<Material> mat = tile_data->get_material();
-					int tile_z_index = tile_data->get_z_index();
+			quadrant_list_element = next_quadrant_list_element;
+		}
 
-					// Quandrant pos.
+		// Sort the cells and compute what to draw for each quadrant. Quadrants don't share any
+		// data, so large rebuilds are split across threads.
+		if (rebuilds.size() >= QUADRANT_THREADING_THRESHOLD) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &TileMapLayer::_rendering_quadrant_prepare_draws, rebuilds.ptr(), rebuilds.size(), -1, true, SNAME("TileMapLayerRenderingQuadrants"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < rebuilds.size(); i++) {
+				_rendering_quadrant_prepare_draws(i, rebuilds.ptr());
+			}
+		}
 
-					// --- CanvasItems ---
-					RID ci;
+		// Only the RenderingServer calls happen on the calling thread.
+		for (RenderingQuadrantRebuild &rebuild : rebuilds) {
+			Ref<RenderingQuadrant> rendering_quadrant = rebuild.quadrant;
 
-					// Check if the material or the z_index changed.
-					if (prev_ci == RID() || prev_material != mat || prev_z_index != tile_z_index) {
-						// If so, create a new CanvasItem.
-						ci = rs->canvas_item_create();
-						if (mat.is_valid()) {
-							rs->canvas_item_set_material(ci, mat->get_rid());
-						}
-						rs->canvas_item_set_parent(ci, get_canvas_item());
-						rs->canvas_item_set_use_parent_material(ci, !mat.is_valid());
+			// First, clear the quadrant's canvas items.
+			for (RID &ci : rendering_quadrant->canvas_items) {
+				rs->free(ci);
+			}
+			rendering_quadrant->canvas_items.clear();
 
-						Transform2D xform(0, rendering_quadrant->canvas_items_position);
-						rs->canvas_item_set_transform(ci, xform);
+			// Those allow to group cell per material or z-index.
+			Ref<Material> prev_material;
+			int prev_z_index = 0;
+			RID prev_ci;
 
-						rs->canvas_item_set_light_mask(ci, get_light_mask());
-						rs->canvas_item_set_z_as_relative_to_parent(ci, true);
-						rs->canvas_item_set_z_index(ci, tile_z_index);
+			for (const RenderingQuadrantRebuild::CellDraw &cell_draw : rebuild.cell_draws) {
+				// --- CanvasItems ---
+				RID ci;
 
-						rs->canvas_item_set_default_texture_filter(ci, RS::CanvasItemTextureFilter(get_texture_filter_in_tree()));
-						rs->canvas_item_set_default_texture_repeat(ci, RS::CanvasItemTextureRepeat(get_texture_repeat_in_tree()));
+				// Check if the material or the z_index changed.
+				if (prev_ci == RID() || prev_material != cell_draw.material || prev_z_index != cell_draw.z_index) {
+					// If so, create a new CanvasItem.
+					ci = rs->canvas_item_create();
+					if (cell_draw.material.is_valid()) {
+						rs->canvas_item_set_material(ci, cell_draw.material->get_rid());
+					}
+					rs->canvas_item_set_parent(ci, get_canvas_item());
+					rs->canvas_item_set_use_parent_material(ci, !cell_draw.material.is_valid());
 
-						rendering_quadrant->canvas_items.push_back(ci);
+					Transform2D xform(0, rendering_quadrant->canvas_items_position);
+					rs->canvas_item_set_transform(ci, xform);
 
-						prev_ci = ci;
-						prev_material = mat;
-						prev_z_index = tile_z_index;
+					rs->canvas_item_set_light_mask(ci, get_light_mask());
+					rs->canvas_item_set_z_as_relative_to_parent(ci, true);
+					rs->canvas_item_set_z_index(ci, cell_draw.z_index);
 
-					} else {
-						// Keep the same canvas_item to draw on.
-						ci = prev_ci;
-					}
+					rs->canvas_item_set_default_texture_filter(ci, RS::CanvasItemTextureFilter(get_texture_filter_in_tree()));
+					rs->canvas_item_set_default_texture_repeat(ci, RS::CanvasItemTextureRepeat(get_texture_repeat_in_tree()));
 
-					const Vector2 local_tile_pos = tile_set->map_to_local(cell_data.coords);
+					rendering_quadrant->canvas_items.push_back(ci);
 
-					// Random animation offset.
-					real_t random_animation_offset = 0.0;
-					if (atlas_source->get_tile_animation_mode(cell_data.cell.get_atlas_coords()) != TileSetAtlasSource::TILE_ANIMATION_MODE_DEFAULT) {
-						Array to_hash;
-						to_hash.push_back(local_tile_pos);
-						to_hash.push_back(get_instance_id()); // Use instance id as a random hash
-						random_animation_offset = RandomPCG(to_hash.hash()).randf();
-					}
+					prev_ci = ci;
+					prev_material = cell_draw.material;
+					prev_z_index = cell_draw.z_index;
 
-					// Drawing the tile in the canvas item.
-					draw_tile(ci, local_tile_pos - rendering_quadrant->canvas_items_position, tile_set, cell_data.cell.source_id, cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile, -1, get_self_modulate(), tile_data, random_animation_offset);
+				} else {
+					// Keep the same canvas_item to draw on.
+					ci = prev_ci;
 				}
 
-				// Reset physics interpolation for any recreated canvas items.
-				if (is_physics_interpolated_and_enabled() && is_visible_in_tree()) {
-					for (const RID &ci : rendering_quadrant->canvas_items) {
-						rs->canvas_item_reset_physics_interpolation(ci);
-					}
-				}
+				// Drawing the tile in the canvas item.
+				_submit_tile_draw(ci, cell_draw.draw);
+			}
 
-			} else {
-				// Free the quadrant.
+			// Reset physics interpolation for any recreated canvas items.
+			if (is_physics_interpolated_and_enabled() && is_visible_in_tree()) {
 				for (const RID &ci : rendering_quadrant->canvas_items) {
-					if (ci.is_valid()) {
-						rs->free(ci);
-					}
+					rs->canvas_item_reset_physics_interpolation(ci);
 				}
-				rendering_quadrant->cells.clear();
-				rendering_quadrant_map.erase(rendering_quadrant->quadrant_coords);
 			}
-
-			quadrant_list_element = next_quadrant_list_element;
 		}
 
 		dirty_rendering_quadrant_list.clear();
@@ -428,6 +417,52 @@ void TileMapLayer::_rendering_update(bool p_force_cleanup) {
 	_rendering_was_cleaned_up = forced_cleanup;
 }
 
+void TileMapLayer::_rendering_quadrant_prepare_draws(uint32_t p_index, RenderingQuadrantRebuild *p_rebuilds) {
+	RenderingQuadrantRebuild &rebuild = p_rebuilds[p_index];
+	RenderingQuadrant *rendering_quadrant = rebuild.quadrant;
+
+	// Sort the quadrant cells.
+	if (rebuild.y_sort_enabled) {
+		// For compatibility reasons, we use another comparator for Y-sorted layers.
+		rendering_quadrant->cells.sort_custom<CellDataYSortedComparator>();
+	} else {
+		rendering_quadrant->cells.sort();
+	}
+
+	for (SelfList<CellData> *cell_data_quadrant_list_element = rendering_quadrant->cells.first(); cell_data_quadrant_list_element; cell_data_quadrant_list_element = cell_data_quadrant_list_element->next()) {
+		const CellData &cell_data = *cell_data_quadrant_list_element->self();
+
+		TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(*tile_set->get_source(cell_data.cell.source_id));
+
+		// Get the tile data.
+		const TileData *tile_data;
+		if (cell_data.runtime_tile_data_cache) {
+			tile_data = cell_data.runtime_tile_data_cache;
+		} else {
+			tile_data = atlas_source->get_tile_data(cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile);
+		}
+
+		const Vector2 local_tile_pos = tile_set->map_to_local(cell_data.coords);
+
+		// Random animation offset.
+		real_t random_animation_offset = 0.0;
+		if (atlas_source->get_tile_animation_mode(cell_data.cell.get_atlas_coords()) != TileSetAtlasSource::TILE_ANIMATION_MODE_DEFAULT) {
+			Array to_hash;
+			to_hash.push_back(local_tile_pos);
+			to_hash.push_back(get_instance_id()); // Use instance id as a random hash
+			random_animation_offset = RandomPCG(to_hash.hash()).randf();
+		}
+
+		RenderingQuadrantRebuild::CellDraw cell_draw;
+		if (!_prepare_tile_draw(cell_draw.draw, local_tile_pos - rendering_quadrant->canvas_items_position, tile_set, cell_data.cell.source_id, cell_data.cell.get_atlas_coords(), cell_data.cell.alternative_tile, -1, rebuild.self_modulate, tile_data, random_animation_offset)) {
+			continue;
+		}
+		cell_draw.material = tile_data->get_material();
+		cell_draw.z_index = tile_data->get_z_index();
+		rebuild.cell_draws.push_back(cell_draw);
+	}
+}
+
 void TileMapLayer::_rendering_notification(int p_what) {
 	RenderingServer *rs = RenderingServer::get_singleton();
 	if (p_what == NOTIFICATION_TRANSFORM_CHANGED || p_what == NOTIFICATION_ENTER_CANVAS || p_what == NOTIFICATION_VISIBILITY_CHANGED) {
@@ -671,27 +706,66 @@ void TileMapLayer::_rendering_draw_cell_debug(const RID &p_canvas_item, const Ve
 
 /////////////////////////////// Physics //////////////////////////////////////
 
+const TileData *TileMapLayer::_get_cell_tile_data(const CellData &p_cell_data) const {
+	const TileMapCell &c = p_cell_data.cell;
+	if (!tile_set->has_source(c.source_id)) {
+		return nullptr;
+	}
+
+	TileSetSource *source = *tile_set->get_source(c.source_id);
+	if (!source->has_tile(c.get_atlas_coords()) || !source->has_alternative_tile(c.get_atlas_coords(), c.alternative_tile)) {
+		return nullptr;
+	}
+	TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(source);
+	if (!atlas_source) {
+		return nullptr;
+	}
+
+	if (p_cell_data.runtime_tile_data_cache) {
+		return p_cell_data.runtime_tile_data_cache;
+	}
+	return atlas_source->get_tile_data(c.get_atlas_coords(), c.alternative_tile);
+}
+
 void TileMapLayer::_physics_update(bool p_force_cleanup) {
 	// Check if we should cleanup everything.
 	bool forced_cleanup = p_force_cleanup || !enabled || !collision_enabled || !is_inside_tree() || tile_set.is_null();
+
+	// Merged shapes depend on how cells are split into quadrants, so recreate all of them if that changed.
+	bool quadrant_shape_changed = dirty.flags[DIRTY_FLAGS_LAYER_PHYSICS_QUADRANT_SIZE] || dirty.flags[DIRTY_FLAGS_LAYER_COLLISION_SHAPES_MERGED];
+	if (forced_cleanup || quadrant_shape_changed) {
+		for (KeyValue<Vector2i, Ref<PhysicsQuadrant>> &kv : physics_quadrant_map) {
+			_physics_clear_quadrant(**kv.value);
+			for (SelfList<CellData> *cell_data_list_element = kv.value->cells.first(); cell_data_list_element; cell_data_list_element = cell_data_list_element->next()) {
+				cell_data_list_element->self()->physics_quadrant = Ref<PhysicsQuadrant>();
+			}
+			kv.value->cells.clear();
+		}
+		physics_quadrant_map.clear();
+	}
+
 	if (forced_cleanup) {
 		// Clean everything.
 		for (KeyValue<Vector2i, CellData> &kv : tile_map_layer_data) {
 			_physics_clear_cell(kv.value);
 		}
 	} else {
-		if (_physics_was_cleaned_up || dirty.flags[DIRTY_FLAGS_TILE_SET] || dirty.flags[DIRTY_FLAGS_LAYER_USE_KINEMATIC_BODIES] || dirty.flags[DIRTY_FLAGS_LAYER_IN_TREE]) {
+		SelfList<PhysicsQuadrant>::List dirty_physics_quadrant_list;
+
+		if (_physics_was_cleaned_up || quadrant_shape_changed || dirty.flags[DIRTY_FLAGS_TILE_SET] || dirty.flags[DIRTY_FLAGS_LAYER_USE_KINEMATIC_BODIES] || dirty.flags[DIRTY_FLAGS_LAYER_IN_TREE]) {
 			// Update all cells.
 			for (KeyValue<Vector2i, CellData> &kv : tile_map_layer_data) {
-				_physics_update_cell(kv.value);
+				_physics_update_cell(kv.value, dirty_physics_quadrant_list);
 			}
 		} else {
 			// Update dirty cells.
 			for (SelfList<CellData> *cell_data_list_element = dirty.cell_list.first(); cell_data_list_element; cell_data_list_element = cell_data_list_element->next()) {
 				CellData &cell_data = *cell_data_list_element->self();
-				_physics_update_cell(cell_data);
+				_physics_update_cell(cell_data, dirty_physics_quadrant_list);
 			}
 		}
+
+		_physics_update_quadrants(dirty_physics_quadrant_list);
 	}
 
 	// -----------
@@ -699,6 +773,187 @@ void TileMapLayer::_physics_update(bool p_force_cleanup) {
 	_physics_was_cleaned_up = forced_cleanup;
 }
 
+void TileMapLayer::_physics_update_quadrants(SelfList<PhysicsQuadrant>::List &r_dirty_physics_quadrant_list) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+
+	LocalVector<PhysicsQuadrantRebuild> rebuilds;
+	for (SelfList<PhysicsQuadrant> *quadrant_list_element = r_dirty_physics_quadrant_list.first(); quadrant_list_element;) {
+		SelfList<PhysicsQuadrant> *next_quadrant_list_element = quadrant_list_element->next(); // "Hack" to clear the list while iterating.
+
+		const Ref<PhysicsQuadrant> &physics_quadrant = quadrant_list_element->self();
+		if (physics_quadrant->cells.first()) {
+			PhysicsQuadrantRebuild rebuild;
+			rebuild.quadrant = physics_quadrant.ptr();
+			rebuilds.push_back(rebuild);
+		} else {
+			// Free the quadrant.
+			_physics_clear_quadrant(**physics_quadrant);
+			physics_quadrant_map.erase(physics_quadrant->quadrant_coords);
+		}
+
+		quadrant_list_element = next_quadrant_list_element;
+	}
+	r_dirty_physics_quadrant_list.clear();
+
+	// Merging is done per quadrant, so large rebuilds are split across threads.
+	if (rebuilds.size() >= QUADRANT_THREADING_THRESHOLD) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &TileMapLayer::_physics_quadrant_merge_shapes, rebuilds.ptr(), rebuilds.size(), -1, true, SNAME("TileMapLayerPhysicsQuadrants"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < rebuilds.size(); i++) {
+			_physics_quadrant_merge_shapes(i, rebuilds.ptr());
+		}
+	}
+
+	// Only the PhysicsServer2D calls happen on the calling thread.
+	const uint32_t physics_layers_count = tile_set->get_physics_layers_count();
+	for (PhysicsQuadrantRebuild &rebuild : rebuilds) {
+		PhysicsQuadrant *physics_quadrant = rebuild.quadrant;
+
+		// Free bodies of physics layers that don't exist anymore.
+		for (uint32_t i = physics_layers_count; i < physics_quadrant->bodies.size(); i++) {
+			if (physics_quadrant->bodies[i].is_valid()) {
+				merged_bodies_coords.erase(physics_quadrant->bodies[i]);
+				ps->free(physics_quadrant->bodies[i]);
+				for (const RID &shape : physics_quadrant->shapes[i]) {
+					ps->free(shape);
+				}
+			}
+		}
+		physics_quadrant->bodies.resize(physics_layers_count);
+		physics_quadrant->shapes.resize(physics_layers_count);
+
+		for (uint32_t tile_set_physics_layer = 0; tile_set_physics_layer < physics_layers_count; tile_set_physics_layer++) {
+			RID &body = physics_quadrant->bodies[tile_set_physics_layer];
+			LocalVector<RID> &shapes = physics_quadrant->shapes[tile_set_physics_layer];
+			const LocalVector<PhysicsQuadrantRebuild::MergedShape> &merged_shapes = rebuild.shapes[tile_set_physics_layer];
+
+			if (merged_shapes.is_empty()) {
+				// No body needed, free it if it exists.
+				if (body.is_valid()) {
+					merged_bodies_coords.erase(body);
+					ps->free(body);
+					for (const RID &shape : shapes) {
+						ps->free(shape);
+					}
+				}
+				body = RID();
+				shapes.clear();
+				continue;
+			}
+
+			// Create or update the body, reusing its shapes.
+			if (!body.is_valid()) {
+				body = ps->body_create();
+			}
+			_physics_configure_body(body, tile_set_physics_layer, physics_quadrant->origin);
+			ps->body_clear_shapes(body);
+			while (shapes.size() > merged_shapes.size()) {
+				ps->free(shapes[shapes.size() - 1]);
+				shapes.resize(shapes.size() - 1);
+			}
+			while (shapes.size() < merged_shapes.size()) {
+				shapes.push_back(ps->concave_polygon_shape_create());
+			}
+
+			// Each tile with edges left on the outline gets its own shape, so the shape index of a collision gives the tile.
+			LocalVector<Vector2i> &shapes_coords = merged_bodies_coords[body];
+			shapes_coords.clear();
+			for (uint32_t i = 0; i < merged_shapes.size(); i++) {
+				ps->shape_set_data(shapes[i], merged_shapes[i].segments);
+				ps->body_add_shape(body, shapes[i]);
+				shapes_coords.push_back(merged_shapes[i].coords);
+			}
+		}
+	}
+}
+
+void TileMapLayer::_physics_quadrant_merge_shapes(uint32_t p_index, PhysicsQuadrantRebuild *p_rebuilds) {
+	PhysicsQuadrantRebuild &rebuild = p_rebuilds[p_index];
+	const PhysicsQuadrant *physics_quadrant = rebuild.quadrant;
+	const uint32_t physics_layers_count = tile_set->get_physics_layers_count();
+	rebuild.shapes.resize(physics_layers_count);
+
+	// Edges are compared on a 1/64 pixel grid, so that edges shared by two neighboring tiles cancel out
+	// even with floating point errors. What remains is the outline of the merged polygons.
+	const real_t snap = 64.0;
+	typedef Pair<Vector2i, Vector2i> Edge;
+	struct MergedEdge {
+		int count = 0;
+		Vector2i coords; // The tile that added the edge first.
+	};
+	HashMap<Edge, MergedEdge, PairHash<Vector2i, Vector2i>> edges;
+	HashMap<Vector2i, uint32_t> shape_indices;
+
+	for (uint32_t tile_set_physics_layer = 0; tile_set_physics_layer < physics_layers_count; tile_set_physics_layer++) {
+		edges.clear();
+
+		for (const SelfList<CellData> *cell_data_list_element = physics_quadrant->cells.first(); cell_data_list_element; cell_data_list_element = cell_data_list_element->next()) {
+			const CellData &cell_data = *cell_data_list_element->self();
+			const TileData *tile_data = _get_cell_tile_data(cell_data);
+			if (!tile_data) {
+				continue;
+			}
+
+			const TileMapCell &c = cell_data.cell;
+			bool flip_h = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_H);
+			bool flip_v = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_V);
+			bool transpose = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_TRANSPOSE);
+			const Vector2 offset = tile_set->map_to_local(cell_data.coords) - physics_quadrant->origin;
+
+			for (int polygon_index = 0; polygon_index < tile_data->get_collision_polygons_count(tile_set_physics_layer); polygon_index++) {
+				Vector<Vector2> polygon = TileData::get_transformed_vertices(tile_data->get_collision_polygon_points(tile_set_physics_layer, polygon_index), flip_h, flip_v, transpose);
+				if (polygon.size() < 3) {
+					continue;
+				}
+				// Use the same winding everywhere, so shared edges go in opposite directions.
+				if (Geometry2D::is_polygon_clockwise(polygon)) {
+					polygon.reverse();
+				}
+
+				for (int i = 0; i < polygon.size(); i++) {
+					const Vector2i from = ((polygon[i] + offset) * snap).round();
+					const Vector2i to = ((polygon[(i + 1) % polygon.size()] + offset) * snap).round();
+					if (from == to) {
+						continue;
+					}
+
+					HashMap<Edge, MergedEdge, PairHash<Vector2i, Vector2i>>::Iterator opposite = edges.find(Edge(to, from));
+					if (opposite) {
+						opposite->value.count--;
+						if (opposite->value.count == 0) {
+							edges.remove(opposite);
+						}
+					} else {
+						MergedEdge &edge = edges[Edge(from, to)];
+						if (edge.count == 0) {
+							edge.coords = cell_data.coords;
+						}
+						edge.count++;
+					}
+				}
+			}
+		}
+
+		// Group the remaining edges by the tile they come from.
+		LocalVector<PhysicsQuadrantRebuild::MergedShape> &shapes = rebuild.shapes[tile_set_physics_layer];
+		shape_indices.clear();
+		for (const KeyValue<Edge, MergedEdge> &E : edges) {
+			uint32_t *shape_index = shape_indices.getptr(E.value.coords);
+			if (!shape_index) {
+				shape_index = &shape_indices.insert(E.value.coords, shapes.size())->value;
+				shapes.push_back(PhysicsQuadrantRebuild::MergedShape());
+				shapes[*shape_index].coords = E.value.coords;
+			}
+			Vector<Vector2> &segments = shapes[*shape_index].segments;
+			for (int i = 0; i < E.value.count; i++) {
+				segments.push_back(Vector2(E.key.first) / snap);
+				segments.push_back(Vector2(E.key.second) / snap);
+			}
+		}
+	}
+}
+
 void TileMapLayer::_physics_notification(int p_what) {
 	Transform2D gl_transform = get_global_transform();
 	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
@@ -718,6 +973,15 @@ void TileMapLayer::_physics_notification(int p_what) {
 						}
 					}
 				}
+				for (const KeyValue<Vector2i, Ref<PhysicsQuadrant>> &kv : physics_quadrant_map) {
+					for (RID body : kv.value->bodies) {
+						if (body.is_valid()) {
+							Transform2D xform(0, kv.value->origin);
+							xform = gl_transform * xform;
+							ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
+						}
+					}
+				}
 			}
 			break;
 		case NOTIFICATION_ENTER_TREE:
@@ -734,6 +998,13 @@ void TileMapLayer::_physics_notification(int p_what) {
 						}
 					}
 				}
+				for (const KeyValue<Vector2i, Ref<PhysicsQuadrant>> &kv : physics_quadrant_map) {
+					for (RID body : kv.value->bodies) {
+						if (body.is_valid()) {
+							ps->body_set_space(body, space);
+						}
+					}
+				}
 			}
 	}
 }
@@ -751,118 +1022,188 @@ void TileMapLayer::_physics_clear_cell(CellData &r_cell_data) {
 	r_cell_data.bodies.clear();
 }
 
-void TileMapLayer::_physics_update_cell(CellData &r_cell_data) {
-	Transform2D gl_transform = get_global_transform();
-	RID space = get_world_2d()->get_space();
+void TileMapLayer::_physics_clear_quadrant(PhysicsQuadrant &r_physics_quadrant) {
 	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
 
-	// Recreate bodies and shapes.
-	TileMapCell &c = r_cell_data.cell;
+	for (uint32_t i = 0; i < r_physics_quadrant.bodies.size(); i++) {
+		if (r_physics_quadrant.bodies[i].is_valid()) {
+			merged_bodies_coords.erase(r_physics_quadrant.bodies[i]);
+			ps->free(r_physics_quadrant.bodies[i]);
+			for (const RID &shape : r_physics_quadrant.shapes[i]) {
+				ps->free(shape);
+			}
+		}
+	}
+	r_physics_quadrant.bodies.clear();
+	r_physics_quadrant.shapes.clear();
+}
 
-	TileSetSource *source;
-	if (tile_set->has_source(c.source_id)) {
-		source = *tile_set->get_source(c.source_id);
+void TileMapLayer::_physics_quadrants_update_cell(CellData &r_cell_data, SelfList<PhysicsQuadrant>::List &r_dirty_physics_quadrant_list, bool p_merged) {
+	// Mark the old quadrant as dirty (if it exists) and remove the cell from it.
+	if (r_cell_data.physics_quadrant.is_valid()) {
+		if (!r_cell_data.physics_quadrant->dirty_quadrant_list_element.in_list()) {
+			r_dirty_physics_quadrant_list.add(&r_cell_data.physics_quadrant->dirty_quadrant_list_element);
+		}
+		if (r_cell_data.physics_quadrant_list_element.in_list()) {
+			r_cell_data.physics_quadrant->cells.remove(&r_cell_data.physics_quadrant_list_element);
+		}
+		r_cell_data.physics_quadrant = Ref<PhysicsQuadrant>();
+	}
 
-		if (source->has_tile(c.get_atlas_coords()) && source->has_alternative_tile(c.get_atlas_coords(), c.alternative_tile)) {
-			TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(source);
-			if (atlas_source) {
-				const TileData *tile_data;
-				if (r_cell_data.runtime_tile_data_cache) {
-					tile_data = r_cell_data.runtime_tile_data_cache;
-				} else {
-					tile_data = atlas_source->get_tile_data(c.get_atlas_coords(), c.alternative_tile);
-				}
+	if (!p_merged) {
+		return;
+	}
 
-				// Transform flags.
-				bool flip_h = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_H);
-				bool flip_v = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_V);
-				bool transpose = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_TRANSPOSE);
+	// Rounding down, instead of simply rounding towards zero (truncating).
+	const Vector2i &coords = r_cell_data.coords;
+	Vector2i quadrant_coords = Vector2i(
+			coords.x > 0 ? coords.x / physics_quadrant_size : (coords.x - (physics_quadrant_size - 1)) / physics_quadrant_size,
+			coords.y > 0 ? coords.y / physics_quadrant_size : (coords.y - (physics_quadrant_size - 1)) / physics_quadrant_size);
 
-				// Free unused bodies then resize the bodies array.
-				for (uint32_t i = tile_set->get_physics_layers_count(); i < r_cell_data.bodies.size(); i++) {
-					RID &body = r_cell_data.bodies[i];
-					if (body.is_valid()) {
-						bodies_coords.erase(body);
-						ps->free(body);
-						body = RID();
-					}
-				}
-				r_cell_data.bodies.resize(tile_set->get_physics_layers_count());
+	Ref<PhysicsQuadrant> physics_quadrant;
+	if (physics_quadrant_map.has(quadrant_coords)) {
+		// Reuse existing physics quadrant.
+		physics_quadrant = physics_quadrant_map[quadrant_coords];
+	} else {
+		// Create a new physics quadrant.
+		physics_quadrant.instantiate();
+		physics_quadrant->quadrant_coords = quadrant_coords;
+		physics_quadrant->origin = tile_set->map_to_local(physics_quadrant_size * quadrant_coords);
+		physics_quadrant_map[quadrant_coords] = physics_quadrant;
+	}
 
-				for (uint32_t tile_set_physics_layer = 0; tile_set_physics_layer < (uint32_t)tile_set->get_physics_layers_count(); tile_set_physics_layer++) {
-					Ref<PhysicsMaterial> physics_material = tile_set->get_physics_layer_physics_material(tile_set_physics_layer);
-					uint32_t physics_layer = tile_set->get_physics_layer_collision_layer(tile_set_physics_layer);
-					uint32_t physics_mask = tile_set->get_physics_layer_collision_mask(tile_set_physics_layer);
+	// Add the cell to its new quadrant.
+	r_cell_data.physics_quadrant = physics_quadrant;
+	physics_quadrant->cells.add(&r_cell_data.physics_quadrant_list_element);
 
-					RID body = r_cell_data.bodies[tile_set_physics_layer];
-					if (tile_data->get_collision_polygons_count(tile_set_physics_layer) == 0) {
-						// No body needed, free it if it exists.
-						if (body.is_valid()) {
-							bodies_coords.erase(body);
-							ps->free(body);
-						}
-						body = RID();
-					} else {
-						// Create or update the body.
-						if (!body.is_valid()) {
-							body = ps->body_create();
-						}
-						bodies_coords[body] = r_cell_data.coords;
-						ps->body_set_mode(body, use_kinematic_bodies ? PhysicsServer2D::BODY_MODE_KINEMATIC : PhysicsServer2D::BODY_MODE_STATIC);
-						ps->body_set_space(body, space);
+	// Add the new quadrant to the dirty quadrant list.
+	if (!physics_quadrant->dirty_quadrant_list_element.in_list()) {
+		r_dirty_physics_quadrant_list.add(&physics_quadrant->dirty_quadrant_list_element);
+	}
+}
 
-						Transform2D xform;
-						xform.set_origin(tile_set->map_to_local(r_cell_data.coords));
-						xform = gl_transform * xform;
-						ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
-
-						ps->body_attach_object_instance_id(body, tile_map_node ? tile_map_node->get_instance_id() : get_instance_id());
-						ps->body_set_collision_layer(body, physics_layer);
-						ps->body_set_collision_mask(body, physics_mask);
-						ps->body_set_pickable(body, false);
-						ps->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, tile_data->get_constant_linear_velocity(tile_set_physics_layer));
-						ps->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, tile_data->get_constant_angular_velocity(tile_set_physics_layer));
-
-						if (!physics_material.is_valid()) {
-							ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, 0);
-							ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, 1);
-						} else {
-							ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_BOUNCE, physics_material->computed_bounce());
-							ps->body_set_param(body, PhysicsServer2D::BODY_PARAM_FRICTION, physics_material->computed_friction());
-						}
+bool TileMapLayer::_physics_can_merge_tile(const TileData *p_tile_data) const {
+	// Merged polygons share a body, so they need the same body state and no per-polygon collision settings.
+	for (int tile_set_physics_layer = 0; tile_set_physics_layer < tile_set->get_physics_layers_count(); tile_set_physics_layer++) {
+		if (p_tile_data->get_constant_linear_velocity(tile_set_physics_layer) != Vector2() || p_tile_data->get_constant_angular_velocity(tile_set_physics_layer) != 0.0) {
+			return false;
+		}
+		for (int polygon_index = 0; polygon_index < p_tile_data->get_collision_polygons_count(tile_set_physics_layer); polygon_index++) {
+			if (p_tile_data->is_collision_polygon_one_way(tile_set_physics_layer, polygon_index)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
 
-						// Clear body's shape if needed.
-						ps->body_clear_shapes(body);
-
-						// Add the shapes to the body.
-						int body_shape_index = 0;
-						for (int polygon_index = 0; polygon_index < tile_data->get_collision_polygons_count(tile_set_physics_layer); polygon_index++) {
-							// Iterate over the polygons.
-							bool one_way_collision = tile_data->is_collision_polygon_one_way(tile_set_physics_layer, polygon_index);
-							float one_way_collision_margin = tile_data->get_collision_polygon_one_way_margin(tile_set_physics_layer, polygon_index);
-							int shapes_count = tile_data->get_collision_polygon_shapes_count(tile_set_physics_layer, polygon_index);
-							for (int shape_index = 0; shape_index < shapes_count; shape_index++) {
-								// Add decomposed convex shapes.
-								Ref<ConvexPolygonShape2D> shape = tile_data->get_collision_polygon_shape(tile_set_physics_layer, polygon_index, shape_index, flip_h, flip_v, transpose);
-								ps->body_add_shape(body, shape->get_rid());
-								ps->body_set_shape_as_one_way_collision(body, body_shape_index, one_way_collision, one_way_collision_margin);
-
-								body_shape_index++;
-							}
-						}
-					}
+void TileMapLayer::_physics_configure_body(RID p_body, uint32_t p_tile_set_physics_layer, const Vector2 &p_position) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	Ref<PhysicsMaterial> physics_material = tile_set->get_physics_layer_physics_material(p_tile_set_physics_layer);
 
-					// Set the body again.
-					r_cell_data.bodies[tile_set_physics_layer] = body;
-				}
+	ps->body_set_mode(p_body, use_kinematic_bodies ? PhysicsServer2D::BODY_MODE_KINEMATIC : PhysicsServer2D::BODY_MODE_STATIC);
+	ps->body_set_space(p_body, get_world_2d()->get_space());
 
-				return;
+	Transform2D xform;
+	xform.set_origin(p_position);
+	xform = get_global_transform() * xform;
+	ps->body_set_state(p_body, PhysicsServer2D::BODY_STATE_TRANSFORM, xform);
+
+	ps->body_attach_object_instance_id(p_body, tile_map_node ? tile_map_node->get_instance_id() : get_instance_id());
+	ps->body_set_collision_layer(p_body, tile_set->get_physics_layer_collision_layer(p_tile_set_physics_layer));
+	ps->body_set_collision_mask(p_body, tile_set->get_physics_layer_collision_mask(p_tile_set_physics_layer));
+	ps->body_set_pickable(p_body, false);
+
+	if (!physics_material.is_valid()) {
+		ps->body_set_param(p_body, PhysicsServer2D::BODY_PARAM_BOUNCE, 0);
+		ps->body_set_param(p_body, PhysicsServer2D::BODY_PARAM_FRICTION, 1);
+	} else {
+		ps->body_set_param(p_body, PhysicsServer2D::BODY_PARAM_BOUNCE, physics_material->computed_bounce());
+		ps->body_set_param(p_body, PhysicsServer2D::BODY_PARAM_FRICTION, physics_material->computed_friction());
+	}
+}
+
+void TileMapLayer::_physics_update_cell(CellData &r_cell_data, SelfList<PhysicsQuadrant>::List &r_dirty_physics_quadrant_list) {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+
+	// Recreate bodies and shapes.
+	const TileData *tile_data = _get_cell_tile_data(r_cell_data);
+	if (tile_data) {
+		if (collision_shapes_merged && _physics_can_merge_tile(tile_data)) {
+			// The shapes are built by the quadrant.
+			_physics_clear_cell(r_cell_data);
+			_physics_quadrants_update_cell(r_cell_data, r_dirty_physics_quadrant_list, true);
+			return;
+		}
+		_physics_quadrants_update_cell(r_cell_data, r_dirty_physics_quadrant_list, false);
+
+		// Transform flags.
+		const TileMapCell &c = r_cell_data.cell;
+		bool flip_h = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_H);
+		bool flip_v = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_V);
+		bool transpose = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_TRANSPOSE);
+
+		// Free unused bodies then resize the bodies array.
+		for (uint32_t i = tile_set->get_physics_layers_count(); i < r_cell_data.bodies.size(); i++) {
+			RID &body = r_cell_data.bodies[i];
+			if (body.is_valid()) {
+				bodies_coords.erase(body);
+				ps->free(body);
+				body = RID();
+			}
+		}
+		r_cell_data.bodies.resize(tile_set->get_physics_layers_count());
+
+		for (uint32_t tile_set_physics_layer = 0; tile_set_physics_layer < (uint32_t)tile_set->get_physics_layers_count(); tile_set_physics_layer++) {
+			RID body = r_cell_data.bodies[tile_set_physics_layer];
+			if (tile_data->get_collision_polygons_count(tile_set_physics_layer) == 0) {
+				// No body needed, free it if it exists.
+				if (body.is_valid()) {
+					bodies_coords.erase(body);
+					ps->free(body);
+				}
+				body = RID();
+			} else {
+				// Create or update the body.
+				if (!body.is_valid()) {
+					body = ps->body_create();
+				}
+				bodies_coords[body] = r_cell_data.coords;
+				_physics_configure_body(body, tile_set_physics_layer, tile_set->map_to_local(r_cell_data.coords));
+				ps->body_set_state(body, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, tile_data->get_constant_linear_velocity(tile_set_physics_layer));
+				ps->body_set_state(body, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, tile_data->get_constant_angular_velocity(tile_set_physics_layer));
+
+				// Clear body's shape if needed.
+				ps->body_clear_shapes(body);
+
+				// Add the shapes to the body.
+				int body_shape_index = 0;
+				for (int polygon_index = 0; polygon_index < tile_data->get_collision_polygons_count(tile_set_physics_layer); polygon_index++) {
+					// Iterate over the polygons.
+					bool one_way_collision = tile_data->is_collision_polygon_one_way(tile_set_physics_layer, polygon_index);
+					float one_way_collision_margin = tile_data->get_collision_polygon_one_way_margin(tile_set_physics_layer, polygon_index);
+					int shapes_count = tile_data->get_collision_polygon_shapes_count(tile_set_physics_layer, polygon_index);
+					for (int shape_index = 0; shape_index < shapes_count; shape_index++) {
+						// Add decomposed convex shapes.
+						Ref<ConvexPolygonShape2D> shape = tile_data->get_collision_polygon_shape(tile_set_physics_layer, polygon_index, shape_index, flip_h, flip_v, transpose);
+						ps->body_add_shape(body, shape->get_rid());
+						ps->body_set_shape_as_one_way_collision(body, body_shape_index, one_way_collision, one_way_collision_margin);
+
+						body_shape_index++;
+					}
+				}
 			}
+
+			// Set the body again.
+			r_cell_data.bodies[tile_set_physics_layer] = body;
 		}
+
+		return;
 	}
 
 	// If we did not return earlier, clear the cell.
 	_physics_clear_cell(r_cell_data);
+	_physics_quadrants_update_cell(r_cell_data, r_dirty_physics_quadrant_list, false);
 }
 
 #ifdef DEBUG_ENABLED
@@ -916,6 +1257,28 @@ void TileMapLayer::_physics_draw_cell_debug(const RID &p_canvas_item, const Vect
 			rs->canvas_item_add_set_transform(p_canvas_item, Transform2D());
 		}
 	}
+
+	// Merged cells have no bodies of their own, draw their polygons instead.
+	if (r_cell_data.physics_quadrant.is_valid()) {
+		const TileData *tile_data = _get_cell_tile_data(r_cell_data);
+		if (tile_data) {
+			const TileMapCell &c = r_cell_data.cell;
+			bool flip_h = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_H);
+			bool flip_v = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_V);
+			bool transpose = (c.alternative_tile & TileSetAtlasSource::TRANSFORM_TRANSPOSE);
+
+			rs->canvas_item_add_set_transform(p_canvas_item, Transform2D(0, tile_set->map_to_local(r_cell_data.coords) - p_quadrant_pos));
+			for (int tile_set_physics_layer = 0; tile_set_physics_layer < tile_set->get_physics_layers_count(); tile_set_physics_layer++) {
+				for (int polygon_index = 0; polygon_index < tile_data->get_collision_polygons_count(tile_set_physics_layer); polygon_index++) {
+					Vector<Vector2> polygon = TileData::get_transformed_vertices(tile_data->get_collision_polygon_points(tile_set_physics_layer, polygon_index), flip_h, flip_v, transpose);
+					if (polygon.size() >= 3) {
+						rs->canvas_item_add_polygon(p_canvas_item, polygon, color);
+					}
+				}
+			}
+			rs->canvas_item_add_set_transform(p_canvas_item, Transform2D());
+		}
+	}
 };
 #endif // DEBUG_ENABLED
 
@@ -1745,7 +2108,7 @@ void TileMapLayer::_bind_methods() {
 
 	// --- Physics helpers ---
 	ClassDB::bind_method(D_METHOD("has_body_rid", "body"), &TileMapLayer::has_body_rid);
-	ClassDB::bind_method(D_METHOD("get_coords_for_body_rid", "body"), &TileMapLayer::get_coords_for_body_rid);
+	ClassDB::bind_method(D_METHOD("get_coords_for_body_rid", "body", "body_shape_index"), &TileMapLayer::get_coords_for_body_rid, DEFVAL(-1));
 
 	// --- Runtime ---
 	ClassDB::bind_method(D_METHOD("update_internals"), &TileMapLayer::update_internals);
@@ -1777,6 +2140,10 @@ void TileMapLayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_collision_enabled"), &TileMapLayer::is_collision_enabled);
 	ClassDB::bind_method(D_METHOD("set_use_kinematic_bodies", "use_kinematic_bodies"), &TileMapLayer::set_use_kinematic_bodies);
 	ClassDB::bind_method(D_METHOD("is_using_kinematic_bodies"), &TileMapLayer::is_using_kinematic_bodies);
+	ClassDB::bind_method(D_METHOD("set_collision_shapes_merged", "merged"), &TileMapLayer::set_collision_shapes_merged);
+	ClassDB::bind_method(D_METHOD("is_collision_shapes_merged"), &TileMapLayer::is_collision_shapes_merged);
+	ClassDB::bind_method(D_METHOD("set_physics_quadrant_size", "size"), &TileMapLayer::set_physics_quadrant_size);
+	ClassDB::bind_method(D_METHOD("get_physics_quadrant_size"), &TileMapLayer::get_physics_quadrant_size);
 	ClassDB::bind_method(D_METHOD("set_collision_visibility_mode", "visibility_mode"), &TileMapLayer::set_collision_visibility_mode);
 	ClassDB::bind_method(D_METHOD("get_collision_visibility_mode"), &TileMapLayer::get_collision_visibility_mode);
 
@@ -1800,6 +2167,8 @@ void TileMapLayer::_bind_methods() {
 	ADD_GROUP("Physics", "");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "collision_enabled"), "set_collision_enabled", "is_collision_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_kinematic_bodies"), "set_use_kinematic_bodies", "is_using_kinematic_bodies");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "collision_shapes_merged"), "set_collision_shapes_merged", "is_collision_shapes_merged");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "physics_quadrant_size"), "set_physics_quadrant_size", "get_physics_quadrant_size");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "collision_visibility_mode", PROPERTY_HINT_ENUM, "Default,Force Show,Force Hide"), "set_collision_visibility_mode", "get_collision_visibility_mode");
 	ADD_GROUP("Navigation", "");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "navigation_enabled"), "set_navigation_enabled", "is_navigation_enabled");
@@ -2162,88 +2531,109 @@ TileMapCell TileMapLayer::get_cell(const Vector2i &p_coords) const {
 	}
 }
 
-void TileMapLayer::draw_tile(RID p_canvas_item, const Vector2 &p_position, const Ref<TileSet> p_tile_set, int p_atlas_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile, int p_frame, Color p_modulation, const TileData *p_tile_data_override, real_t p_normalized_animation_offset) {
-	ERR_FAIL_COND(p_tile_set.is_null());
-	ERR_FAIL_COND(!p_tile_set->has_source(p_atlas_source_id));
-	ERR_FAIL_COND(!p_tile_set->get_source(p_atlas_source_id)->has_tile(p_atlas_coords));
-	ERR_FAIL_COND(!p_tile_set->get_source(p_atlas_source_id)->has_alternative_tile(p_atlas_coords, p_alternative_tile));
+bool TileMapLayer::_prepare_tile_draw(TileDrawData &r_draw, const Vector2 &p_position, const Ref<TileSet> &p_tile_set, int p_atlas_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile, int p_frame, Color p_modulation, const TileData *p_tile_data_override, real_t p_normalized_animation_offset) {
+	ERR_FAIL_COND_V(p_tile_set.is_null(), false);
+	ERR_FAIL_COND_V(!p_tile_set->has_source(p_atlas_source_id), false);
+	ERR_FAIL_COND_V(!p_tile_set->get_source(p_atlas_source_id)->has_tile(p_atlas_coords), false);
+	ERR_FAIL_COND_V(!p_tile_set->get_source(p_atlas_source_id)->has_alternative_tile(p_atlas_coords, p_alternative_tile), false);
 	TileSetSource *source = *p_tile_set->get_source(p_atlas_source_id);
 	TileSetAtlasSource *atlas_source = Object::cast_to<TileSetAtlasSource>(source);
-	if (atlas_source) {
-		// Check for the frame.
-		if (p_frame >= 0) {
-			ERR_FAIL_INDEX(p_frame, atlas_source->get_tile_animation_frames_count(p_atlas_coords));
-		}
+	if (!atlas_source) {
+		return false;
+	}
 
-		// Get the texture.
-		Ref<Texture2D> tex = atlas_source->get_runtime_texture();
-		if (tex.is_null()) {
-			return;
-		}
+	// Check for the frame.
+	if (p_frame >= 0) {
+		ERR_FAIL_INDEX_V(p_frame, atlas_source->get_tile_animation_frames_count(p_atlas_coords), false);
+	}
 
-		// Check if we are in the texture, return otherwise.
-		Vector2i grid_size = atlas_source->get_atlas_grid_size();
-		if (p_atlas_coords.x >= grid_size.x || p_atlas_coords.y >= grid_size.y) {
-			return;
-		}
+	// Get the texture.
+	r_draw.texture = atlas_source->get_runtime_texture();
+	if (r_draw.texture.is_null()) {
+		return false;
+	}
 
-		// Get tile data.
-		const TileData *tile_data = p_tile_data_override ? p_tile_data_override : atlas_source->get_tile_data(p_atlas_coords, p_alternative_tile);
+	// Check if we are in the texture, return otherwise.
+	Vector2i grid_size = atlas_source->get_atlas_grid_size();
+	if (p_atlas_coords.x >= grid_size.x || p_atlas_coords.y >= grid_size.y) {
+		return false;
+	}
 
-		// Get the tile modulation.
-		Color modulate = tile_data->get_modulate() * p_modulation;
+	// Get tile data.
+	const TileData *tile_data = p_tile_data_override ? p_tile_data_override : atlas_source->get_tile_data(p_atlas_coords, p_alternative_tile);
 
-		// Compute the offset.
-		Vector2 tile_offset = tile_data->get_texture_origin();
+	// Get the tile modulation.
+	r_draw.modulate = tile_data->get_modulate() * p_modulation;
 
-		// Get destination rect.
-		Rect2 dest_rect;
-		dest_rect.size = atlas_source->get_runtime_tile_texture_region(p_atlas_coords).size;
-		dest_rect.size.x += FP_ADJUST;
-		dest_rect.size.y += FP_ADJUST;
+	// Compute the offset.
+	Vector2 tile_offset = tile_data->get_texture_origin();
 
-		bool transpose = tile_data->get_transpose() ^ bool(p_alternative_tile & TileSetAtlasSource::TRANSFORM_TRANSPOSE);
-		if (transpose) {
-			dest_rect.position = (p_position - Vector2(dest_rect.size.y, dest_rect.size.x) / 2 - tile_offset);
-		} else {
-			dest_rect.position = (p_position - dest_rect.size / 2 - tile_offset);
-		}
+	// Get destination rect.
+	Rect2 &dest_rect = r_draw.dest_rect;
+	dest_rect.size = atlas_source->get_runtime_tile_texture_region(p_atlas_coords).size;
+	dest_rect.size.x += FP_ADJUST;
+	dest_rect.size.y += FP_ADJUST;
 
-		if (tile_data->get_flip_h() ^ bool(p_alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_H)) {
-			dest_rect.size.x = -dest_rect.size.x;
-		}
+	r_draw.transpose = tile_data->get_transpose() ^ bool(p_alternative_tile & TileSetAtlasSource::TRANSFORM_TRANSPOSE);
+	if (r_draw.transpose) {
+		dest_rect.position = (p_position - Vector2(dest_rect.size.y, dest_rect.size.x) / 2 - tile_offset);
+	} else {
+		dest_rect.position = (p_position - dest_rect.size / 2 - tile_offset);
+	}
 
-		if (tile_data->get_flip_v() ^ bool(p_alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_V)) {
-			dest_rect.size.y = -dest_rect.size.y;
-		}
+	if (tile_data->get_flip_h() ^ bool(p_alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_H)) {
+		dest_rect.size.x = -dest_rect.size.x;
+	}
 
-		// Draw the tile.
-		if (p_frame >= 0) {
-			Rect2i source_rect = atlas_source->get_runtime_tile_texture_region(p_atlas_coords, p_frame);
-			tex->draw_rect_region(p_canvas_item, dest_rect, source_rect, modulate, transpose, p_tile_set->is_uv_clipping());
-		} else if (atlas_source->get_tile_animation_frames_count(p_atlas_coords) == 1) {
-			Rect2i source_rect = atlas_source->get_runtime_tile_texture_region(p_atlas_coords, 0);
-			tex->draw_rect_region(p_canvas_item, dest_rect, source_rect, modulate, transpose, p_tile_set->is_uv_clipping());
-		} else {
-			real_t speed = atlas_source->get_tile_animation_speed(p_atlas_coords);
-			real_t animation_duration = atlas_source->get_tile_animation_total_duration(p_atlas_coords) / speed;
-			real_t animation_offset = p_normalized_animation_offset * animation_duration;
-			// Accumulate durations unaffected by the speed to avoid accumulating floating point division errors.
-			// Aka do `sum(duration[i]) / speed` instead of `sum(duration[i] / speed)`.
-			real_t time_unscaled = 0.0;
-			for (int frame = 0; frame < atlas_source->get_tile_animation_frames_count(p_atlas_coords); frame++) {
-				real_t frame_duration_unscaled = atlas_source->get_tile_animation_frame_duration(p_atlas_coords, frame);
-				real_t slice_start = time_unscaled / speed;
-				real_t slice_end = (time_unscaled + frame_duration_unscaled) / speed;
-				RenderingServer::get_singleton()->canvas_item_add_animation_slice(p_canvas_item, animation_duration, slice_start, slice_end, animation_offset);
+	if (tile_data->get_flip_v() ^ bool(p_alternative_tile & TileSetAtlasSource::TRANSFORM_FLIP_V)) {
+		dest_rect.size.y = -dest_rect.size.y;
+	}
 
-				Rect2i source_rect = atlas_source->get_runtime_tile_texture_region(p_atlas_coords, frame);
-				tex->draw_rect_region(p_canvas_item, dest_rect, source_rect, modulate, transpose, p_tile_set->is_uv_clipping());
+	r_draw.atlas_source = atlas_source;
+	r_draw.atlas_coords = p_atlas_coords;
+	r_draw.frame = p_frame;
+	if (p_frame < 0 && atlas_source->get_tile_animation_frames_count(p_atlas_coords) == 1) {
+		r_draw.frame = 0;
+	}
+	r_draw.normalized_animation_offset = p_normalized_animation_offset;
+	r_draw.clip_uv = p_tile_set->is_uv_clipping();
+	return true;
+}
 
-				time_unscaled += frame_duration_unscaled;
-			}
-			RenderingServer::get_singleton()->canvas_item_add_animation_slice(p_canvas_item, 1.0, 0.0, 1.0, 0.0);
+void TileMapLayer::_submit_tile_draw(RID p_canvas_item, const TileDrawData &p_draw) {
+	const TileSetAtlasSource *atlas_source = p_draw.atlas_source;
+	const Vector2i &atlas_coords = p_draw.atlas_coords;
+
+	// Draw the tile.
+	if (p_draw.frame >= 0) {
+		Rect2i source_rect = atlas_source->get_runtime_tile_texture_region(atlas_coords, p_draw.frame);
+		p_draw.texture->draw_rect_region(p_canvas_item, p_draw.dest_rect, source_rect, p_draw.modulate, p_draw.transpose, p_draw.clip_uv);
+	} else {
+		real_t speed = atlas_source->get_tile_animation_speed(atlas_coords);
+		real_t animation_duration = atlas_source->get_tile_animation_total_duration(atlas_coords) / speed;
+		real_t animation_offset = p_draw.normalized_animation_offset * animation_duration;
+		// Accumulate durations unaffected by the speed to avoid accumulating floating point division errors.
+		// Aka do `sum(duration[i]) / speed` instead of `sum(duration[i] / speed)`.
+		real_t time_unscaled = 0.0;
+		for (int frame = 0; frame < atlas_source->get_tile_animation_frames_count(atlas_coords); frame++) {
+			real_t frame_duration_unscaled = atlas_source->get_tile_animation_frame_duration(atlas_coords, frame);
+			real_t slice_start = time_unscaled / speed;
+			real_t slice_end = (time_unscaled + frame_duration_unscaled) / speed;
+			RenderingServer::get_singleton()->canvas_item_add_animation_slice(p_canvas_item, animation_duration, slice_start, slice_end, animation_offset);
+
+			Rect2i source_rect = atlas_source->get_runtime_tile_texture_region(atlas_coords, frame);
+			p_draw.texture->draw_rect_region(p_canvas_item, p_draw.dest_rect, source_rect, p_draw.modulate, p_draw.transpose, p_draw.clip_uv);
+
+			time_unscaled += frame_duration_unscaled;
 		}
+		RenderingServer::get_singleton()->canvas_item_add_animation_slice(p_canvas_item, 1.0, 0.0, 1.0, 0.0);
+	}
+}
+
+void TileMapLayer::draw_tile(RID p_canvas_item, const Vector2 &p_position, const Ref<TileSet> p_tile_set, int p_atlas_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile, int p_frame, Color p_modulation, const TileData *p_tile_data_override, real_t p_normalized_animation_offset) {
+	TileDrawData draw;
+	if (_prepare_tile_draw(draw, p_position, p_tile_set, p_atlas_source_id, p_atlas_coords, p_alternative_tile, p_frame, p_modulation, p_tile_data_override, p_normalized_animation_offset)) {
+		_submit_tile_draw(p_canvas_item, draw);
 	}
 }
 
@@ -2571,10 +2961,19 @@ void TileMapLayer::set_cells_terrain_path(TypedArray<Vector2i> p_path, int p_ter
 }
 
 bool TileMapLayer::has_body_rid(RID p_physics_body) const {
-	return bodies_coords.has(p_physics_body);
+	return bodies_coords.has(p_physics_body) || merged_bodies_coords.has(p_physics_body);
 }
 
-Vector2i TileMapLayer::get_coords_for_body_rid(RID p_physics_body) const {
+Vector2i TileMapLayer::get_coords_for_body_rid(RID p_physics_body, int p_body_shape_index) const {
+	const LocalVector<Vector2i> *shapes_coords = merged_bodies_coords.getptr(p_physics_body);
+	if (shapes_coords) {
+		// Merged bodies have one shape per tile, and at least one.
+		if (p_body_shape_index < 0) {
+			return (*shapes_coords)[0];
+		}
+		ERR_FAIL_INDEX_V(p_body_shape_index, (int)shapes_coords->size(), Vector2i());
+		return (*shapes_coords)[p_body_shape_index];
+	}
 	const Vector2i *found = bodies_coords.getptr(p_physics_body);
 	ERR_FAIL_NULL_V(found, Vector2i());
 	return *found;
@@ -2850,6 +3249,36 @@ bool TileMapLayer::is_using_kinematic_bodies() const {
 	return use_kinematic_bodies;
 }
 
+void TileMapLayer::set_collision_shapes_merged(bool p_merged) {
+	if (collision_shapes_merged == p_merged) {
+		return;
+	}
+	collision_shapes_merged = p_merged;
+	dirty.flags[DIRTY_FLAGS_LAYER_COLLISION_SHAPES_MERGED] = true;
+	_queue_internal_update();
+	emit_signal(CoreStringName(changed));
+}
+
+bool TileMapLayer::is_collision_shapes_merged() const {
+	return collision_shapes_merged;
+}
+
+void TileMapLayer::set_physics_quadrant_size(int p_size) {
+	if (physics_quadrant_size == p_size) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(p_size < 1, "Physics quadrant size cannot be smaller than 1.");
+
+	physics_quadrant_size = p_size;
+	dirty.flags[DIRTY_FLAGS_LAYER_PHYSICS_QUADRANT_SIZE] = true;
+	_queue_internal_update();
+	emit_signal(CoreStringName(changed));
+}
+
+int TileMapLayer::get_physics_quadrant_size() const {
+	return physics_quadrant_size;
+}
+
 void TileMapLayer::set_collision_visibility_mode(TileMapLayer::DebugVisibilityMode p_show_collision) {
 	if (collision_visibility_mode == p_show_collision) {
 		return;
@@ -97,6 +97,7 @@ public:
 class DebugQuadrant;
 #endif // DEBUG_ENABLED
 class RenderingQuadrant;
+class PhysicsQuadrant;
 
 struct CellData {
 	Vector2i coords;
@@ -112,6 +113,8 @@ struct CellData {
 
 	// Physics.
 	LocalVector<RID> bodies;
+	Ref<PhysicsQuadrant> physics_quadrant; // Only for cells with merged collision shapes.
+	SelfList<CellData> physics_quadrant_list_element;
 
 	// Navigation.
 	LocalVector<RID> navigation_regions;
@@ -143,6 +146,7 @@ struct CellData {
 	CellData(const CellData &p_other) :
 			debug_quadrant_list_element(this),
 			rendering_quadrant_list_element(this),
+			physics_quadrant_list_element(this),
 			dirty_list_element(this) {
 		coords = p_other.coords;
 		cell = p_other.cell;
@@ -156,6 +160,7 @@ struct CellData {
 	CellData() :
 			debug_quadrant_list_element(this),
 			rendering_quadrant_list_element(this),
+			physics_quadrant_list_element(this),
 			dirty_list_element(this) {
 	}
 };
@@ -219,6 +224,27 @@ public:
 	}
 };
 
+class PhysicsQuadrant : public RefCounted {
+	GDCLASS(PhysicsQuadrant, RefCounted);
+
+public:
+	Vector2i quadrant_coords;
+	SelfList<CellData>::List cells;
+	Vector2 origin; // Position of the bodies, in the layer's local coordinates.
+	LocalVector<RID> bodies; // One per TileSet physics layer.
+	LocalVector<LocalVector<RID>> shapes; // Per TileSet physics layer, one per tile with edges on the merged outline.
+
+	SelfList<PhysicsQuadrant> dirty_quadrant_list_element;
+
+	PhysicsQuadrant() :
+			dirty_quadrant_list_element(this) {
+	}
+
+	~PhysicsQuadrant() {
+		cells.clear();
+	}
+};
+
 class TileMapLayer : public Node2D {
 	GDCLASS(TileMapLayer, Node2D);
 
@@ -252,6 +278,8 @@ public:
 		DIRTY_FLAGS_LAYER_RENDERING_QUADRANT_SIZE,
 		DIRTY_FLAGS_LAYER_COLLISION_ENABLED,
 		DIRTY_FLAGS_LAYER_USE_KINEMATIC_BODIES,
+		DIRTY_FLAGS_LAYER_COLLISION_SHAPES_MERGED,
+		DIRTY_FLAGS_LAYER_PHYSICS_QUADRANT_SIZE,
 		DIRTY_FLAGS_LAYER_COLLISION_VISIBILITY_MODE,
 		DIRTY_FLAGS_LAYER_NAVIGATION_ENABLED,
 		DIRTY_FLAGS_LAYER_NAVIGATION_MAP,
@@ -271,6 +299,24 @@ public:
 private:
 	static constexpr float FP_ADJUST = 0.00001;
 
+	// Below this amount of dirty quadrants, rebuilding them on other threads isn't worth it.
+	static constexpr uint32_t QUADRANT_THREADING_THRESHOLD = 4;
+
+	// What draw_tile() needs to draw a tile, computed without calling the RenderingServer.
+	struct TileDrawData {
+		Ref<Texture2D> texture;
+		const TileSetAtlasSource *atlas_source = nullptr;
+		Vector2i atlas_coords;
+		Rect2 dest_rect;
+		Color modulate;
+		bool transpose = false;
+		bool clip_uv = false;
+		int frame = -1; // All frames are drawn as an animation if negative.
+		real_t normalized_animation_offset = 0.0;
+	};
+	static bool _prepare_tile_draw(TileDrawData &r_draw, const Vector2 &p_position, const Ref<TileSet> &p_tile_set, int p_atlas_source_id, const Vector2i &p_atlas_coords, int p_alternative_tile, int p_frame, Color p_modulation, const TileData *p_tile_data_override, real_t p_normalized_animation_offset);
+	static void _submit_tile_draw(RID p_canvas_item, const TileDrawData &p_draw);
+
 	// Properties.
 	HashMap<Vector2i, CellData> tile_map_layer_data;
 
@@ -284,6 +330,8 @@ private:
 
 	bool collision_enabled = true;
 	bool use_kinematic_bodies = false;
+	bool collision_shapes_merged = false;
+	int physics_quadrant_size = 16;
 	DebugVisibilityMode collision_visibility_mode = DEBUG_VISIBILITY_MODE_DEFAULT;
 
 	bool navigation_enabled = true;
@@ -331,6 +379,20 @@ private:
 	void _rendering_update(bool p_force_cleanup);
 	void _rendering_notification(int p_what);
 	void _rendering_quadrants_update_cell(CellData &r_cell_data, SelfList<RenderingQuadrant>::List &r_dirty_rendering_quadrant_list);
+	struct RenderingQuadrantRebuild {
+		struct CellDraw {
+			TileDrawData draw;
+			Ref<Material> material;
+			int z_index = 0;
+		};
+
+		RenderingQuadrant *quadrant = nullptr;
+		// Node properties can't be read from worker threads, so they are copied here.
+		bool y_sort_enabled = false;
+		Color self_modulate;
+		LocalVector<CellDraw> cell_draws;
+	};
+	void _rendering_quadrant_prepare_draws(uint32_t p_index, RenderingQuadrantRebuild *p_rebuilds);
 	void _rendering_occluders_clear_cell(CellData &r_cell_data);
 	void _rendering_occluders_update_cell(CellData &r_cell_data);
 #ifdef DEBUG_ENABLED
@@ -338,11 +400,29 @@ private:
 #endif // DEBUG_ENABLED
 
 	HashMap<RID, Vector2i> bodies_coords; // Mapping for RID to coords.
+	HashMap<RID, LocalVector<Vector2i>> merged_bodies_coords; // Mapping for physics quadrant bodies to the coords of each of their shapes.
+	HashMap<Vector2i, Ref<PhysicsQuadrant>> physics_quadrant_map;
 	bool _physics_was_cleaned_up = false;
+	const TileData *_get_cell_tile_data(const CellData &p_cell_data) const;
 	void _physics_update(bool p_force_cleanup);
 	void _physics_notification(int p_what);
 	void _physics_clear_cell(CellData &r_cell_data);
-	void _physics_update_cell(CellData &r_cell_data);
+	void _physics_clear_quadrant(PhysicsQuadrant &r_physics_quadrant);
+	void _physics_quadrants_update_cell(CellData &r_cell_data, SelfList<PhysicsQuadrant>::List &r_dirty_physics_quadrant_list, bool p_merged);
+	bool _physics_can_merge_tile(const TileData *p_tile_data) const;
+	void _physics_configure_body(RID p_body, uint32_t p_tile_set_physics_layer, const Vector2 &p_position);
+	void _physics_update_cell(CellData &r_cell_data, SelfList<PhysicsQuadrant>::List &r_dirty_physics_quadrant_list);
+	struct PhysicsQuadrantRebuild {
+		struct MergedShape {
+			Vector2i coords; // The tile the edges come from.
+			Vector<Vector2> segments;
+		};
+
+		PhysicsQuadrant *quadrant = nullptr;
+		LocalVector<LocalVector<MergedShape>> shapes; // One set of shapes per TileSet physics layer.
+	};
+	void _physics_update_quadrants(SelfList<PhysicsQuadrant>::List &r_dirty_physics_quadrant_list);
+	void _physics_quadrant_merge_shapes(uint32_t p_index, PhysicsQuadrantRebuild *p_rebuilds);
 #ifdef DEBUG_ENABLED
 	void _physics_draw_cell_debug(const RID &p_canvas_item, const Vector2 &p_quadrant_pos, const CellData &r_cell_data);
 #endif // DEBUG_ENABLED
@@ -439,7 +519,7 @@ public:
 
 	// --- Physics helpers ---
 	bool has_body_rid(RID p_physics_body) const;
-	Vector2i get_coords_for_body_rid(RID p_physics_body) const; // For finding tiles from collision.
+	Vector2i get_coords_for_body_rid(RID p_physics_body, int p_body_shape_index = -1) const; // For finding tiles from collision.
 
 	// --- Runtime ---
 	void update_internals();
@@ -479,6 +559,10 @@ public:
 	bool is_collision_enabled() const;
 	void set_use_kinematic_bodies(bool p_use_kinematic_bodies);
 	bool is_using_kinematic_bodies() const;
+	void set_collision_shapes_merged(bool p_merged);
+	bool is_collision_shapes_merged() const;
+	void set_physics_quadrant_size(int p_size);
+	int get_physics_quadrant_size() const;
 	void set_collision_visibility_mode(DebugVisibilityMode p_show_collision);
 	DebugVisibilityMode get_collision_visibility_mode() const;
 
@@ -30,6 +30,7 @@
 
 #include "cpu_particles_3d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "scene/3d/camera_3d.h"
 #include "scene/3d/gpu_particles_3d.h"
 #include "scene/main/viewport.h"
@@ -38,6 +39,8 @@
 #include "scene/resources/image_texture.h"
 #include "scene/resources/particle_process_material.h"
 
+int CPUParticles3D::threading_threshold = 4096;
+
 AABB CPUParticles3D::get_aabb() const {
 	return AABB();
 }
@@ -77,6 +80,8 @@ void CPUParticles3D::set_amount(int p_amount) {
 	RS::get_singleton()->multimesh_allocate_data(multimesh, p_amount, RS::MULTIMESH_TRANSFORM_3D, true, true);
 
 	particle_order.resize(p_amount);
+	particle_process_states.resize(p_amount);
+	particle_process_deltas.resize(p_amount);
 }
 
 void CPUParticles3D::set_lifetime(double p_lifetime) {
@@ -686,6 +691,7 @@ void CPUParticles3D::_particles_process(double p_delta) {
 	for (int i = 0; i < pcount; i++) {
 		Particle &p = parray[i];
 
+		particle_process_states[i] = PARTICLE_PROCESS_SKIP;
 		if (!emitting && !p.active) {
 			continue;
 		}
@@ -907,12 +913,64 @@ void CPUParticles3D::_particles_process(double p_delta) {
 				p.transform.origin.z = 0.0;
 			}
 
+			particle_process_states[i] = PARTICLE_PROCESS_RESTARTED;
 		} else if (!p.active) {
 			continue;
 		} else if (p.time > p.lifetime) {
 			p.active = false;
-			tv = 1.0;
+			particle_process_states[i] = PARTICLE_PROCESS_EXPIRED;
+		} else {
+			particle_process_states[i] = PARTICLE_PROCESS_INTEGRATE;
+		}
+
+		particle_process_deltas[i] = local_delta;
+		should_be_active = true;
+	}
+
+	if (should_be_active) {
+		if (color_ramp.is_valid()) {
+			// Sorts the gradient points now, so worker threads only read them.
+			color_ramp->get_color_at_offset(0.0);
+		}
+
+		ParticlesProcessData data;
+		data.particles = parray;
+		data.particle_count = pcount;
+		data.emission_origin = emission_xform.origin;
+
+		const uint32_t chunk_count = Math::division_round_up((uint32_t)pcount, PARTICLES_CHUNK_SIZE);
+		if (pcount >= threading_threshold) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles3D::_particles_process_chunk, &data, chunk_count, -1, true, SNAME("CPUParticles3DProcess"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
+			for (uint32_t i = 0; i < chunk_count; i++) {
+				_particles_process_chunk(i, &data);
+			}
+		}
+	}
+	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
+		active = false;
+		emit_signal(SceneStringName(finished));
+	}
+}
+
+void CPUParticles3D::_particles_process_chunk(uint32_t p_chunk, ParticlesProcessData *p_data) {
+	const uint32_t from = p_chunk * PARTICLES_CHUNK_SIZE;
+	const uint32_t to = MIN(from + PARTICLES_CHUNK_SIZE, p_data->particle_count);
+
+	for (uint32_t i = from; i < to; i++) {
+		const uint8_t state = particle_process_states[i];
+		if (state == PARTICLE_PROCESS_SKIP) {
+			continue;
+		}
+
+		Particle &p = p_data->particles[i];
+		double local_delta = particle_process_deltas[i];
+		float tv = 0.0;
+
+		if (state == PARTICLE_PROCESS_EXPIRED) {
+			tv = 1.0;
+		} else if (state == PARTICLE_PROCESS_INTEGRATE) {
 			uint32_t alt_seed = p.seed;
 
 			p.time += local_delta;
@@ -978,7 +1036,7 @@ void CPUParticles3D::_particles_process(double p_delta) {
 			//apply linear acceleration
 			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector3();
 			//apply radial acceleration
-			Vector3 org = emission_xform.origin;
+			Vector3 org = p_data->emission_origin;
 			Vector3 diff = position - org;
 			force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector3();
 			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
@@ -1150,12 +1208,6 @@ void CPUParticles3D::_particles_process(double p_delta) {
 		}
 
 		p.transform.origin += p.velocity * local_delta;
-
-		should_be_active = true;
-	}
-	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
-		active = false;
-		emit_signal(SceneStringName(finished));
 	}
 }
 
@@ -1169,7 +1221,6 @@ void CPUParticles3D::_update_particle_data_buffer() {
 
 	float *w = particle_data.ptrw();
 	const Particle *r = particles.ptr();
-	float *ptr = w;
 
 	if (draw_order != DRAW_ORDER_INDEX) {
 		ow = particle_order.ptrw();
@@ -1204,16 +1255,42 @@ void CPUParticles3D::_update_particle_data_buffer() {
 		}
 	}
 
-	for (int i = 0; i < pc; i++) {
-		int idx = order ? order[i] : i;
+	ParticlesBufferData data;
+	data.particles = r;
+	data.order = order;
+	data.buffer = w;
+	data.particle_count = pc;
 
-		Transform3D t = r[idx].transform;
+	const uint32_t chunk_count = Math::division_round_up((uint32_t)pc, PARTICLES_CHUNK_SIZE);
+	if (pc >= threading_threshold) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles3D::_update_particle_data_chunk, &data, chunk_count, -1, true, SNAME("CPUParticles3DUpdateBuffer"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_update_particle_data_chunk(i, &data);
+		}
+	}
+
+	can_update.set();
+}
+
+void CPUParticles3D::_update_particle_data_chunk(uint32_t p_chunk, ParticlesBufferData *p_data) {
+	const uint32_t from = p_chunk * PARTICLES_CHUNK_SIZE;
+	const uint32_t to = MIN(from + PARTICLES_CHUNK_SIZE, p_data->particle_count);
+
+	for (uint32_t i = from; i < to; i++) {
+		int idx = p_data->order ? p_data->order[i] : i;
+
+		const Particle &p = p_data->particles[idx];
+		float *ptr = p_data->buffer + i * 20;
+
+		Transform3D t = p.transform;
 
 		if (!local_coords) {
 			t = inv_emission_transform * t;
 		}
 
-		if (r[idx].active) {
+		if (p.active) {
 			ptr[0] = t.basis.rows[0][0];
 			ptr[1] = t.basis.rows[0][1];
 			ptr[2] = t.basis.rows[0][2];
@@ -1230,22 +1307,18 @@ void CPUParticles3D::_update_particle_data_buffer() {
 			memset(ptr, 0, sizeof(float) * 12);
 		}
 
-		Color c = r[idx].color;
+		Color c = p.color;
 
 		ptr[12] = c.r;
 		ptr[13] = c.g;
 		ptr[14] = c.b;
 		ptr[15] = c.a;
 
-		ptr[16] = r[idx].custom[0];
-		ptr[17] = r[idx].custom[1];
-		ptr[18] = r[idx].custom[2];
-		ptr[19] = r[idx].custom[3];
-
-		ptr += 20;
+		ptr[16] = p.custom[0];
+		ptr[17] = p.custom[1];
+		ptr[18] = p.custom[2];
+		ptr[19] = p.custom[3];
 	}
-
-	can_update.set();
 }
 
 void CPUParticles3D::_set_redraw(bool p_redraw) {
@@ -143,6 +143,16 @@ private:
 
 	void _initialize_wind();
 
+	// Cached lookups for the signals emitted on every physics overlap change.
+	SignalHandle body_entered_signal;
+	SignalHandle body_exited_signal;
+	SignalHandle body_shape_entered_signal;
+	SignalHandle body_shape_exited_signal;
+	SignalHandle area_entered_signal;
+	SignalHandle area_exited_signal;
+	SignalHandle area_shape_entered_signal;
+	SignalHandle area_shape_exited_signal;
+
 protected:
 	void _notification(int p_what);
 	static void _bind_methods();
@@ -681,7 +681,7 @@ bool AnimationMixer::_update_caches() {
 
 						track_value->is_using_angle = anim->track_get_interpolation_type(i) == Animation::INTERPOLATION_LINEAR_ANGLE || anim->track_get_interpolation_type(i) == Animation::INTERPOLATION_CUBIC_ANGLE;
 
-						track_value->subpath = leftover_path;
+						track_value->property.set_path(leftover_path);
 
 						track = track_value;
 
@@ -1472,7 +1472,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 							value = post_process_key_value(a, i, value, t->object_id);
 							Object *t_obj = ObjectDB::get_instance(t->object_id);
 							if (t_obj) {
-								t_obj->set_indexed(t->subpath, value);
+								t->property.set(t_obj, value);
 							}
 						} else {
 							List<int> indices;
@@ -1482,7 +1482,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 								value = post_process_key_value(a, i, value, t->object_id);
 								Object *t_obj = ObjectDB::get_instance(t->object_id);
 								if (t_obj) {
-									t_obj->set_indexed(t->subpath, value);
+									t->property.set(t_obj, value);
 								}
 							}
 						}
@@ -1761,7 +1761,7 @@ void AnimationMixer::_blend_apply() {
 
 				Object *t_obj = ObjectDB::get_instance(t->object_id);
 				if (t_obj) {
-					t_obj->set_indexed(t->subpath, Animation::cast_from_blendwise(t->value, t->init_value.get_type()));
+					t->property.set(t_obj, Animation::cast_from_blendwise(t->value, t->init_value.get_type()));
 				}
 
 			} break;
@@ -1982,7 +1982,7 @@ void AnimationMixer::_build_backup_track_cache() {
 				TrackCacheValue *t = static_cast<TrackCacheValue *>(track);
 				Object *t_obj = ObjectDB::get_instance(t->object_id);
 				if (t_obj) {
-					t->value = Animation::cast_to_blendwise(t_obj->get_indexed(t->subpath));
+					t->value = Animation::cast_to_blendwise(t->property.get(t_obj));
 				}
 				t->use_continuous = true;
 				t->use_discrete = false;
@@ -2114,7 +2114,7 @@ void AnimationMixer::capture(const StringName &p_name, double p_duration, Tween:
 			TrackCacheValue *t = static_cast<TrackCacheValue *>(track_cache[reference_animation->track_get_type_hash(i)]);
 			Object *t_obj = ObjectDB::get_instance(t->object_id);
 			if (t_obj) {
-				Variant value = t_obj->get_indexed(t->subpath);
+				Variant value = t->property.get(t_obj);
 				int inserted_idx = capture_cache.animation->add_track(Animation::TYPE_VALUE);
 				capture_cache.animation->track_set_path(inserted_idx, reference_animation->track_get_path(i));
 				capture_cache.animation->track_insert_key(inserted_idx, 0, value);
@@ -31,6 +31,7 @@
 #ifndef ANIMATION_MIXER_H
 #define ANIMATION_MIXER_H
 
+#include "core/object/property_handle.h"
 #include "scene/animation/tween.h"
 #include "scene/main/node.h"
 #include "scene/resources/animation.h"
@@ -221,7 +222,7 @@ protected:
 	struct TrackCacheValue : public TrackCache {
 		Variant init_value;
 		Variant value;
-		Vector<StringName> subpath;
+		PropertyHandle property; // The subpath of the track.
 
 		// TODO: There are many boolean, can be packed into one integer.
 		bool init_use_continuous = false;
@@ -236,7 +237,7 @@ protected:
 				TrackCache(p_other),
 				init_value(p_other.init_value),
 				value(p_other.value),
-				subpath(p_other.subpath),
+				property(p_other.property),
 				init_use_continuous(p_other.init_use_continuous),
 				use_continuous(p_other.use_continuous),
 				use_discrete(p_other.use_discrete),
@@ -553,7 +553,7 @@ void PropertyTweener::start() {
 
 	if (do_continue) {
 		if (Math::is_zero_approx(delay)) {
-			initial_val = target_instance->get_indexed(property);
+			initial_val = property.get(target_instance);
 		} else {
 			do_continue_delayed = true;
 		}
@@ -582,7 +582,7 @@ bool PropertyTweener::step(double &r_delta) {
 		r_delta = 0;
 		return true;
 	} else if (do_continue_delayed && !Math::is_zero_approx(delay)) {
-		initial_val = target_instance->get_indexed(property);
+		initial_val = property.get(target_instance);
 		delta_val = Animation::subtract_variant(final_val, initial_val);
 		do_continue_delayed = false;
 	}
@@ -604,14 +604,14 @@ bool PropertyTweener::step(double &r_delta) {
 				ERR_FAIL_V_MSG(false, vformat("Wrong return type in PropertyTweener custom method. Expected float, got %s.", Variant::get_type_name(result.get_type())));
 			}
 
-			target_instance->set_indexed(property, Animation::interpolate_variant(initial_val, final_val, result));
+			property.set(target_instance, Animation::interpolate_variant(initial_val, final_val, result));
 		} else {
-			target_instance->set_indexed(property, tween->interpolate_variant(initial_val, delta_val, time, duration, trans_type, ease_type));
+			property.set(target_instance, tween->interpolate_variant(initial_val, delta_val, time, duration, trans_type, ease_type));
 		}
 		r_delta = 0;
 		return true;
 	} else {
-		target_instance->set_indexed(property, final_val);
+		property.set(target_instance, final_val);
 		finished = true;
 		r_delta = elapsed_time - delay - duration;
 		emit_signal(SceneStringName(finished));
@@ -641,8 +641,8 @@ void PropertyTweener::_bind_methods() {
 
 PropertyTweener::PropertyTweener(const Object *p_target, const Vector<StringName> &p_property, const Variant &p_to, double p_duration) {
 	target = p_target->get_instance_id();
-	property = p_property;
-	initial_val = p_target->get_indexed(property);
+	property.set_path(p_property);
+	initial_val = p_target->get_indexed(p_property);
 	base_final_val = p_to;
 	final_val = base_final_val;
 	duration = p_duration;
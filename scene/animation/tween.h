@@ -31,6 +31,7 @@
 #ifndef TWEEN_H
 #define TWEEN_H
 
+#include "core/object/property_handle.h"
 #include "core/object/ref_counted.h"
 
 class Tween;
@@ -214,7 +215,7 @@ protected:
 
 private:
 	ObjectID target;
-	Vector<StringName> property;
+	PropertyHandle property;
 	Variant initial_val;
 	Variant base_final_val;
 	Variant final_val;
@@ -45,7 +45,7 @@ void Range::_value_changed(double p_value) {
 }
 void Range::_value_changed_notify() {
 	_value_changed(shared->val);
-	emit_signal(SNAME("value_changed"), shared->val);
+	emit_signal(value_changed_signal, shared->val);
 	queue_redraw();
 }
 
@@ -373,7 +373,8 @@ bool Range::is_lesser_allowed() const {
 	return shared->allow_lesser;
 }
 
-Range::Range() {
+Range::Range() :
+		value_changed_signal(SNAME("value_changed")) {
 	shared = memnew(Shared);
 	shared->owners.insert(this);
 }
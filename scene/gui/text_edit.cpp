@@ -187,13 +187,7 @@ void TextEdit::Text::_calculate_max_line_width() {
 	max_width = line_width;
 }
 
-void TextEdit::Text::invalidate_cache(int p_line, int p_column, bool p_text_changed, const String &p_ime_text, const Array &p_bidi_override) {
-	ERR_FAIL_INDEX(p_line, text.size());
-
-	if (font.is_null()) {
-		return; // Not in tree?
-	}
-
+void TextEdit::Text::_update_line_buffer(int p_line, bool p_text_changed, const String &p_ime_text, const Array &p_bidi_override) {
 	if (p_text_changed) {
 		text.write[p_line].data_buf->clear();
 	}
@@ -230,7 +224,9 @@ void TextEdit::Text::invalidate_cache(int p_line, int p_column, bool p_text_chan
 			TS->shaped_set_span_update_font(r, i, font->get_rids(), font_size, font->get_opentype_features());
 		}
 	}
+}
 
+void TextEdit::Text::_update_line_size(int p_line) {
 	// Apply tab align.
 	if (tab_size > 0) {
 		Vector<float> tabs;
@@ -267,6 +263,32 @@ void TextEdit::Text::invalidate_cache(int p_line, int p_column, bool p_text_chan
 	}
 }
 
+void TextEdit::Text::_invalidate_lines(int p_from_line, int p_to_line, bool p_text_changed) {
+	// Set up all buffers first, so they can be shaped in a single batch instead of one line at a time.
+	TypedArray<RID> rids;
+	rids.resize(p_to_line - p_from_line);
+	for (int i = p_from_line; i < p_to_line; i++) {
+		_update_line_buffer(i, p_text_changed, String(), Array());
+		rids[i - p_from_line] = text[i].data_buf->get_rid();
+	}
+	TS->shaped_text_shape_batch(rids);
+
+	for (int i = p_from_line; i < p_to_line; i++) {
+		_update_line_size(i);
+	}
+}
+
+void TextEdit::Text::invalidate_cache(int p_line, int p_column, bool p_text_changed, const String &p_ime_text, const Array &p_bidi_override) {
+	ERR_FAIL_INDEX(p_line, text.size());
+
+	if (font.is_null()) {
+		return; // Not in tree?
+	}
+
+	_update_line_buffer(p_line, p_text_changed, p_ime_text, p_bidi_override);
+	_update_line_size(p_line);
+}
+
 void TextEdit::Text::invalidate_all_lines() {
 	for (int i = 0; i < text.size(); i++) {
 		BitField<TextServer::LineBreakFlag> flags = brk_flags;
@@ -301,8 +323,8 @@ void TextEdit::Text::invalidate_font() {
 		font_height = font->get_height(font_size);
 	}
 
-	for (int i = 0; i < text.size(); i++) {
-		invalidate_cache(i, -1, false);
+	if (font.is_valid()) {
+		_invalidate_lines(0, text.size(), false);
 	}
 	is_dirty = false;
 }
@@ -319,8 +341,8 @@ void TextEdit::Text::invalidate_all() {
 		font_height = font->get_height(font_size);
 	}
 
-	for (int i = 0; i < text.size(); i++) {
-		invalidate_cache(i, -1, true);
+	if (font.is_valid()) {
+		_invalidate_lines(0, text.size(), true);
 	}
 	is_dirty = false;
 }
@@ -372,7 +394,9 @@ void TextEdit::Text::insert(int p_at, const Vector<String> &p_text, const Vector
 		line.data = p_text[i];
 		line.bidi_override = p_bidi_override[i];
 		text.write[p_at + i] = line;
-		invalidate_cache(p_at + i, -1, true);
+	}
+	if (p_text.size() > 1 && font.is_valid()) {
+		_invalidate_lines(p_at + 1, p_at + p_text.size(), true);
 	}
 }
 
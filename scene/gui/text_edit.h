@@ -186,6 +186,10 @@ private:
 		void _calculate_line_height();
 		void _calculate_max_line_width();
 
+		void _update_line_buffer(int p_line, bool p_text_changed, const String &p_ime_text, const Array &p_bidi_override);
+		void _update_line_size(int p_line);
+		void _invalidate_lines(int p_from_line, int p_to_line, bool p_text_changed);
+
 	public:
 		void set_tab_size(int p_tab_size);
 		int get_tab_size() const;
@@ -1511,7 +1511,7 @@ Node::InternalMode Node::get_internal_mode() const {
 	return data.internal_mode;
 }
 
-void Node::_add_child_nocheck(Node *p_child, const StringName &p_name, InternalMode p_internal_mode) {
+void Node::_add_child_nocheck(Node *p_child, const StringName &p_name, InternalMode p_internal_mode, bool p_notify_order_changed) {
 	//add a child node quickly, without name validation
 
 	p_child->data.name = p_name;
@@ -1549,8 +1549,23 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name, InternalM
 	//recognize children created in this node constructor
 	p_child->data.parent_owned = data.in_constructor;
 	add_child_notify(p_child);
-	notification(NOTIFICATION_CHILD_ORDER_CHANGED);
-	emit_signal(SNAME("child_order_changed"));
+	if (p_notify_order_changed) {
+		notification(NOTIFICATION_CHILD_ORDER_CHANGED);
+		emit_signal(SNAME("child_order_changed"));
+	}
+}
+
+void Node::_reserve_children(int p_count) {
+	data.children.reserve((data.children.size() + p_count) * 4 / 3 + 1);
+	if (data.children.is_empty()) {
+		// Nothing to sort, so the cache can be filled as children are added.
+		data.children_cache.clear();
+		data.children_cache.reserve(p_count);
+		data.children_cache_dirty = false;
+		data.external_children_count_cache = 0;
+		data.internal_children_front_count_cache = 0;
+		data.internal_children_back_count_cache = 0;
+	}
 }
 
 void Node::add_child(Node *p_child, bool p_force_readable_name, InternalMode p_internal) {
@@ -2254,17 +2269,19 @@ NodePath Node::get_path() const {
 		return *data.path_cache;
 	}
 
-	const Node *n = this;
+	int depth = 0;
+	for (const Node *n = this; n; n = n->data.parent) {
+		depth++;
+	}
 
+	// Fill from the end, so the path is built with a single allocation.
 	Vector<StringName> path;
-
-	while (n) {
-		path.push_back(n->get_name());
-		n = n->data.parent;
+	path.resize(depth);
+	StringName *path_ptrw = path.ptrw();
+	for (const Node *n = this; n; n = n->data.parent) {
+		path_ptrw[--depth] = n->data.name;
 	}
 
-	path.reverse();
-
 	data.path_cache = memnew(NodePath(path, true));
 
 	return *data.path_cache;
@@ -3884,6 +3901,11 @@ Error Node::emit_signalp(const StringName &p_name, const Variant **p_args, int p
 	return Object::emit_signalp(p_name, p_args, p_argcount);
 }
 
+Error Node::emit_signalp(SignalHandle &r_handle, const Variant **p_args, int p_argcount) {
+	ERR_THREAD_GUARD_V(ERR_INVALID_PARAMETER);
+	return Object::emit_signalp(r_handle, p_args, p_argcount);
+}
+
 bool Node::has_signal(const StringName &p_name) const {
 	ERR_THREAD_GUARD_V(false);
 	return Object::has_signal(p_name);
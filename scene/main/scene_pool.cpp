@@ -0,0 +1,271 @@
+/**************************************************************************/
+/*  scene_pool.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_pool.h"
+
+int ScenePool::_count_nodes(const Node *p_node) {
+	int count = 1;
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		count += _count_nodes(p_node->get_child(i));
+	}
+	return count;
+}
+
+bool ScenePool::_is_restorable(const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			// Nodes belong to the instance they were captured from, and resources local to scene
+			// are duplicated for each instance.
+			Ref<Resource> res = p_value;
+			if (res.is_valid()) {
+				return !res->is_local_to_scene();
+			}
+			return p_value.get_validated_object() == nullptr;
+		}
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				if (!_is_restorable(array[i])) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			return _is_restorable(dictionary.keys()) && _is_restorable(dictionary.values());
+		}
+		default: {
+			return true;
+		}
+	}
+}
+
+void ScenePool::_capture_state(Node *p_root, Node *p_node, LocalVector<NodeState> &r_state) {
+	NodeState node_state;
+	node_state.path = p_root->get_path_to(p_node);
+
+	List<PropertyInfo> plist;
+	p_node->get_property_list(&plist);
+	for (const PropertyInfo &E : plist) {
+		if (!(E.usage & PROPERTY_USAGE_STORAGE) || E.name == CoreStringName(script)) {
+			continue;
+		}
+		const Variant value = p_node->get(E.name);
+		if (_is_restorable(value)) {
+			node_state.properties.push_back(Pair<StringName, Variant>(E.name, value.duplicate(true)));
+		}
+	}
+	r_state.push_back(node_state);
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_capture_state(p_root, p_node->get_child(i), r_state);
+	}
+}
+
+bool ScenePool::_reset_instance(const Pool &p_pool, Node *p_instance) const {
+	// Nodes added or removed since the instance was acquired can't be restored.
+	if (_count_nodes(p_instance) != p_pool.node_count) {
+		return false;
+	}
+
+	for (const NodeState &node_state : p_pool.instantiated_state) {
+		Node *node = p_instance->get_node_or_null(node_state.path);
+		if (!node) {
+			return false;
+		}
+		for (const Pair<StringName, Variant> &E : node_state.properties) {
+			if (node->get(E.first) != E.second) {
+				// Keep the captured arrays and dictionaries from being shared with the instance.
+				node->set(E.first, E.second.duplicate(true));
+			}
+		}
+	}
+	return true;
+}
+
+void ScenePool::_prune_acquired() {
+	// Instances may be freed instead of released, forget about them from time to time.
+	LocalVector<ObjectID> freed;
+	for (const KeyValue<ObjectID, Ref<PackedScene>> &E : acquired) {
+		if (!ObjectDB::get_instance(E.key)) {
+			freed.push_back(E.key);
+		}
+	}
+	for (const ObjectID &id : freed) {
+		acquired.erase(id);
+	}
+	acquired_prune_size = MAX(64u, acquired.size() * 2);
+}
+
+Node *ScenePool::acquire(const Ref<PackedScene> &p_scene) {
+	ERR_FAIL_COND_V(p_scene.is_null(), nullptr);
+
+	Pool &pool = pools[p_scene];
+	Node *instance = nullptr;
+	if (!pool.available.is_empty()) {
+		instance = pool.available[pool.available.size() - 1];
+		pool.available.resize(pool.available.size() - 1);
+		hits++;
+	} else {
+		instance = p_scene->instantiate();
+		ERR_FAIL_NULL_V_MSG(instance, nullptr, vformat("Failed to instantiate scene \"%s\".", p_scene->get_path()));
+		if (!pool.state_captured) {
+			_capture_state(instance, instance, pool.instantiated_state);
+			pool.node_count = _count_nodes(instance);
+			pool.state_captured = true;
+		}
+		misses++;
+	}
+
+	if (acquired.size() >= acquired_prune_size) {
+		_prune_acquired();
+	}
+	acquired.insert(instance->get_instance_id(), p_scene);
+
+	return instance;
+}
+
+void ScenePool::release(Node *p_instance) {
+	ERR_FAIL_NULL(p_instance);
+	HashMap<ObjectID, Ref<PackedScene>>::Iterator E = acquired.find(p_instance->get_instance_id());
+	ERR_FAIL_COND_MSG(!E, vformat("Node \"%s\" was not acquired from this pool, or was already released.", p_instance->get_name()));
+	const Ref<PackedScene> scene = E->value;
+	acquired.remove(E);
+
+	Node *parent = p_instance->get_parent();
+	if (parent) {
+		parent->remove_child(p_instance);
+	}
+
+	Pool *pool = pools.getptr(scene);
+	if (!pool || (int)pool->available.size() >= max_size || !_reset_instance(*pool, p_instance)) {
+		memdelete(p_instance);
+		discards++;
+		return;
+	}
+
+	// Let scripts reset the state the scene doesn't store.
+	p_instance->propagate_call(SNAME("_pool_reset"));
+
+	pool->available.push_back(p_instance);
+	releases++;
+}
+
+void ScenePool::prewarm(const Ref<PackedScene> &p_scene, int p_count) {
+	ERR_FAIL_COND(p_scene.is_null());
+
+	Pool &pool = pools[p_scene];
+	const int count = MIN(p_count, max_size);
+	while ((int)pool.available.size() < count) {
+		Node *instance = p_scene->instantiate();
+		ERR_FAIL_NULL_MSG(instance, vformat("Failed to instantiate scene \"%s\".", p_scene->get_path()));
+		if (!pool.state_captured) {
+			_capture_state(instance, instance, pool.instantiated_state);
+			pool.node_count = _count_nodes(instance);
+			pool.state_captured = true;
+		}
+		pool.available.push_back(instance);
+	}
+}
+
+void ScenePool::clear() {
+	for (KeyValue<Ref<PackedScene>, Pool> &E : pools) {
+		for (Node *instance : E.value.available) {
+			memdelete(instance);
+		}
+	}
+	pools.clear();
+}
+
+int ScenePool::get_available_count(const Ref<PackedScene> &p_scene) const {
+	const Pool *pool = pools.getptr(p_scene);
+	return pool ? pool->available.size() : 0;
+}
+
+void ScenePool::set_max_size(int p_max_size) {
+	ERR_FAIL_COND(p_max_size < 0);
+	max_size = p_max_size;
+
+	// Free the instances over the new limit.
+	for (KeyValue<Ref<PackedScene>, Pool> &E : pools) {
+		while ((int)E.value.available.size() > max_size) {
+			memdelete(E.value.available[E.value.available.size() - 1]);
+			E.value.available.resize(E.value.available.size() - 1);
+		}
+	}
+}
+
+int ScenePool::get_max_size() const {
+	return max_size;
+}
+
+Dictionary ScenePool::get_stats() const {
+	int available = 0;
+	for (const KeyValue<Ref<PackedScene>, Pool> &E : pools) {
+		available += E.value.available.size();
+	}
+
+	Dictionary stats;
+	stats["hits"] = hits;
+	stats["misses"] = misses;
+	stats["hit_rate"] = hits + misses > 0 ? double(hits) / double(hits + misses) : 0.0;
+	stats["releases"] = releases;
+	stats["discards"] = discards;
+	stats["available"] = available;
+	return stats;
+}
+
+void ScenePool::reset_stats() {
+	hits = 0;
+	misses = 0;
+	releases = 0;
+	discards = 0;
+}
+
+void ScenePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("acquire", "scene"), &ScenePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "instance"), &ScenePool::release);
+	ClassDB::bind_method(D_METHOD("prewarm", "scene", "count"), &ScenePool::prewarm);
+	ClassDB::bind_method(D_METHOD("clear"), &ScenePool::clear);
+	ClassDB::bind_method(D_METHOD("get_available_count", "scene"), &ScenePool::get_available_count);
+
+	ClassDB::bind_method(D_METHOD("set_max_size", "max_size"), &ScenePool::set_max_size);
+	ClassDB::bind_method(D_METHOD("get_max_size"), &ScenePool::get_max_size);
+
+	ClassDB::bind_method(D_METHOD("get_stats"), &ScenePool::get_stats);
+	ClassDB::bind_method(D_METHOD("reset_stats"), &ScenePool::reset_stats);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_size", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), "set_max_size", "get_max_size");
+}
+
+ScenePool::~ScenePool() {
+	clear();
+}
@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  scene_pool.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SCENE_POOL_H
+#define SCENE_POOL_H
+
+#include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "scene/resources/packed_scene.h"
+
+// Keeps released scene instances around so they can be handed out again instead of instantiating
+// the scene. Instances are reset to the state they were instantiated with when released.
+class ScenePool : public RefCounted {
+	GDCLASS(ScenePool, RefCounted);
+
+	struct NodeState {
+		NodePath path;
+		LocalVector<Pair<StringName, Variant>> properties;
+	};
+
+	struct Pool {
+		LocalVector<Node *> available;
+		// Storable properties of every node of a freshly instantiated scene, captured once.
+		LocalVector<NodeState> instantiated_state;
+		int node_count = 0;
+		bool state_captured = false;
+	};
+
+	HashMap<Ref<PackedScene>, Pool> pools;
+	// Instances handed out, to find their pool when released.
+	HashMap<ObjectID, Ref<PackedScene>> acquired;
+	uint32_t acquired_prune_size = 64;
+
+	int max_size = 32;
+
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	uint64_t releases = 0;
+	uint64_t discards = 0;
+
+	static int _count_nodes(const Node *p_node);
+	static bool _is_restorable(const Variant &p_value);
+	static void _capture_state(Node *p_root, Node *p_node, LocalVector<NodeState> &r_state);
+	bool _reset_instance(const Pool &p_pool, Node *p_instance) const;
+	void _prune_acquired();
+
+protected:
+	static void _bind_methods();
+
+public:
+	Node *acquire(const Ref<PackedScene> &p_scene);
+	void release(Node *p_instance);
+	void prewarm(const Ref<PackedScene> &p_scene, int p_count);
+	void clear();
+
+	int get_available_count(const Ref<PackedScene> &p_scene) const;
+
+	void set_max_size(int p_max_size);
+	int get_max_size() const;
+
+	Dictionary get_stats() const;
+	void reset_stats();
+
+	~ScenePool();
+};
+
+#endif // SCENE_POOL_H
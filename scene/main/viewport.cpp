@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
 #include "core/string/translation.h"
+#include "core/templates/frame_arena.h"
 #include "core/templates/pair.h"
 #include "core/templates/sort_array.h"
 #include "scene/2d/audio_listener_2d.h"
@@ -2422,9 +2423,10 @@ void Viewport::_gui_update_mouse_over() {
 	}
 
 	// Rebuild the mouse over hierarchy.
-	LocalVector<Control *> new_mouse_over_hierarchy;
-	LocalVector<Control *> needs_enter;
-	LocalVector<int> needs_exit;
+	FrameArena::Scope arena_scope;
+	FrameLocalVector<Control *> new_mouse_over_hierarchy;
+	FrameLocalVector<Control *> needs_enter;
+	FrameLocalVector<int> needs_exit;
 
 	CanvasItem *ancestor = gui.mouse_over;
 	bool removing = false;
@@ -3994,8 +3996,9 @@ void Viewport::_camera_2d_set(Camera2D *p_camera_2d) {
 }
 
 void Viewport::_cleanup_mouseover_colliders(bool p_clean_all_frames, bool p_paused_only, uint64_t p_frame_reference) {
-	List<ObjectID> to_erase;
-	List<ObjectID> to_mouse_exit;
+	FrameArena::Scope arena_scope;
+	List<ObjectID, FrameArenaAllocator> to_erase;
+	List<ObjectID, FrameArenaAllocator> to_mouse_exit;
 
 	for (const KeyValue<ObjectID, uint64_t> &E : physics_2d_mouseover) {
 		if (!p_clean_all_frames && E.value == p_frame_reference) {
@@ -4021,8 +4024,8 @@ void Viewport::_cleanup_mouseover_colliders(bool p_clean_all_frames, bool p_paus
 	}
 
 	// Per-shape.
-	List<Pair<ObjectID, int>> shapes_to_erase;
-	List<Pair<ObjectID, int>> shapes_to_mouse_exit;
+	List<Pair<ObjectID, int>, FrameArenaAllocator> shapes_to_erase;
+	List<Pair<ObjectID, int>, FrameArenaAllocator> shapes_to_mouse_exit;
 
 	for (KeyValue<Pair<ObjectID, int>, uint64_t> &E : physics_2d_shape_mouseover) {
 		if (!p_clean_all_frames && E.value == p_frame_reference) {
@@ -125,6 +125,13 @@ Ref<Resource> SceneState::get_remap_resource(const Ref<Resource> &p_resource, Ha
 }
 
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint()) {
+		const InstantiationPlan *instantiation_plan = _get_instantiation_plan();
+		if (instantiation_plan) {
+			return _instantiate_from_plan(*instantiation_plan);
+		}
+	}
+
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
 
@@ -514,25 +521,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		}
 	}
 
-	for (const DeferredNodePathProperties &dnp : deferred_node_paths) {
-		// Replace properties stored as NodePaths with actual Nodes.
-		if (dnp.value.get_type() == Variant::ARRAY) {
-			Array paths = dnp.value;
-
-			bool valid;
-			Array array = dnp.base->get(dnp.property, &valid);
-			ERR_CONTINUE(!valid);
-			array = array.duplicate();
-
-			array.resize(paths.size());
-			for (int i = 0; i < array.size(); i++) {
-				array.set(i, dnp.base->get_node_or_null(paths[i]));
-			}
-			dnp.base->set(dnp.property, array);
-		} else {
-			dnp.base->set(dnp.property, dnp.base->get_node_or_null(dnp.value));
-		}
-	}
+	_assign_deferred_node_paths(deferred_node_paths);
 
 	for (KeyValue<Ref<Resource>, Ref<Resource>> &E : resources_local_to_scene) {
 		if (E.value->get_local_scene() == ret_nodes[0]) {
@@ -597,6 +586,416 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+void SceneState::_assign_deferred_node_paths(const LocalVector<DeferredNodePathProperties> &p_deferred_node_paths) {
+	for (const DeferredNodePathProperties &dnp : p_deferred_node_paths) {
+		// Replace properties stored as NodePaths with actual Nodes.
+		if (dnp.value.get_type() == Variant::ARRAY) {
+			Array paths = dnp.value;
+
+			bool valid;
+			Array array = dnp.base->get(dnp.property, &valid);
+			ERR_CONTINUE(!valid);
+			array = array.duplicate();
+
+			array.resize(paths.size());
+			for (int i = 0; i < array.size(); i++) {
+				array.set(i, dnp.base->get_node_or_null(paths[i]));
+			}
+			dnp.base->set(dnp.property, array);
+		} else {
+			dnp.base->set(dnp.property, dnp.base->get_node_or_null(dnp.value));
+		}
+	}
+}
+
+// Collects the resources a property value assigns, the same way instantiate() looks for resources local to scene.
+// Returns false if the value can't be assigned as is.
+static bool _collect_plan_resources(const Variant &p_value, LocalVector<Ref<Resource>> &r_resources) {
+	if (p_value.get_type() == Variant::OBJECT) {
+		Ref<Resource> res = p_value;
+		if (res.is_valid()) {
+			if (Object::cast_to<MissingResource>(res.ptr())) {
+				return false;
+			}
+			r_resources.push_back(res);
+		}
+	} else if (p_value.get_type() == Variant::ARRAY) {
+		const Array array = p_value;
+		for (int i = 0; i < array.size(); i++) {
+			if (array[i].get_type() == Variant::OBJECT && !_collect_plan_resources(array[i], r_resources)) {
+				return false;
+			}
+		}
+	} else if (p_value.get_type() == Variant::DICTIONARY) {
+		const Dictionary dictionary = p_value;
+		if (!_collect_plan_resources(dictionary.keys(), r_resources) || !_collect_plan_resources(dictionary.values(), r_resources)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Text scenes refer to parents, owners and connected nodes by path. Those paths are relative
+// to the root, so they can be matched against the paths of the nodes created before.
+static String _plan_node_path_key(const NodePath &p_path) {
+	if (p_path.is_absolute() || p_path.get_subname_count() > 0) {
+		return String();
+	}
+
+	String key = ".";
+	for (int i = 0; i < p_path.get_name_count(); i++) {
+		const String name = p_path.get_name(i);
+		if (name == ".") {
+			continue;
+		}
+		if (name == ".." || name.begins_with("%")) {
+			return String();
+		}
+		key += "/" + name;
+	}
+	return key;
+}
+
+SceneState::InstantiationPlan *SceneState::_compile_instantiation_plan() const {
+	// Inherited scenes, editable children and nodes modified inside instances need the generic path.
+	if (nodes.is_empty() || base_scene_idx >= 0 || !editable_instances.is_empty()) {
+		return nullptr;
+	}
+
+	const int nc = nodes.size();
+	const int sname_count = names.size();
+	const int prop_count = variants.size();
+
+	InstantiationPlan *new_plan = memnew(InstantiationPlan);
+	new_plan->nodes.resize(nc);
+
+	LocalVector<String> node_keys;
+	node_keys.resize(nc);
+	HashMap<String, int> node_indices; // By path key.
+	// Returns the index of the node a scene node ID refers to, or -1 if it isn't created by this plan.
+	auto resolve_node_id = [&](int p_id) -> int {
+		if (!(p_id & FLAG_ID_IS_PATH)) {
+			return p_id;
+		}
+		int path_idx = p_id & FLAG_MASK;
+		if (path_idx >= node_paths.size()) {
+			return -1;
+		}
+		HashMap<String, int>::ConstIterator E = node_indices.find(_plan_node_path_key(node_paths[path_idx]));
+		return E ? E->value : -1;
+	};
+
+	bool compiled = true;
+	for (int i = 0; i < nc && compiled; i++) {
+		const NodeData &n = nodes[i];
+		InstantiationPlan::PlanNode &pn = new_plan->nodes[i];
+
+		// Nodes modified inside sub-scenes need to be looked up.
+		if ((n.type == TYPE_INSTANTIATED && n.instance < 0) || n.name < 0 || n.name >= sname_count) {
+			compiled = false;
+			break;
+		}
+
+		// Parents and owners must be nodes of this scene created before this one.
+		const int parent = i == 0 ? -1 : resolve_node_id(n.parent);
+		const int owner = n.owner == -1 ? -1 : resolve_node_id(n.owner);
+		if (i == 0) {
+			compiled = n.parent == -1 && n.owner == -1;
+		} else {
+			compiled = parent >= 0 && parent < i && (n.owner == -1 || (owner >= 0 && owner < i));
+		}
+		if (!compiled) {
+			break;
+		}
+
+		pn.name = names[n.name];
+		pn.parent = parent;
+		pn.owner = owner;
+		pn.index = n.index;
+		if (i > 0) {
+			new_plan->nodes[parent].child_count++;
+		}
+		node_keys[i] = i == 0 ? String(".") : node_keys[parent] + "/" + String(pn.name);
+		node_indices[node_keys[i]] = i;
+
+		if (n.instance >= 0) {
+			if (n.instance & FLAG_INSTANCE_IS_PLACEHOLDER || (n.instance & FLAG_MASK) >= prop_count) {
+				compiled = false;
+				break;
+			}
+			pn.scene = variants[n.instance & FLAG_MASK];
+			compiled = pn.scene.is_valid();
+		} else {
+			if (n.type < 0 || n.type >= sname_count) {
+				compiled = false;
+				break;
+			}
+			pn.type = names[n.type];
+			pn.creation_func = ClassDB::get_native_creation_func(pn.type);
+			compiled = pn.creation_func && ClassDB::is_parent_class(pn.type, SNAME("Node"));
+		}
+		if (!compiled) {
+			break;
+		}
+
+		for (const NodeData::Property &prop : n.properties) {
+			if (prop.value < 0 || prop.value >= prop_count) {
+				compiled = false;
+				break;
+			}
+
+			InstantiationPlan::Property plan_prop;
+			plan_prop.value = prop.value;
+
+			if (prop.name & FLAG_PATH_PROPERTY_IS_NODE) {
+				int name_idx = prop.name & (FLAG_PATH_PROPERTY_IS_NODE - 1);
+				if (name_idx >= sname_count) {
+					compiled = false;
+					break;
+				}
+				plan_prop.name = names[name_idx];
+				pn.node_path_properties.push_back(plan_prop);
+				continue;
+			}
+
+			if (prop.name < 0 || prop.name >= sname_count || !_collect_plan_resources(variants[prop.value], new_plan->resources)) {
+				compiled = false;
+				break;
+			}
+
+			plan_prop.name = names[prop.name];
+			if (pn.creation_func && plan_prop.name != CoreStringName(script)) {
+				ClassDB::PropertySetGet psg;
+				if (ClassDB::get_property_setget(pn.type, plan_prop.name, &psg) && psg._setptr) {
+					plan_prop.setter = psg._setptr;
+					plan_prop.index = psg.index;
+				}
+			}
+			pn.properties.push_back(plan_prop);
+		}
+		if (!compiled) {
+			break;
+		}
+
+		for (int j = 0; j < n.groups.size(); j++) {
+			if (n.groups[j] < 0 || n.groups[j] >= sname_count) {
+				compiled = false;
+				break;
+			}
+			pn.groups.push_back(names[n.groups[j]]);
+		}
+	}
+
+	for (int i = 0; i < connections.size() && compiled; i++) {
+		const ConnectionData &c = connections[i];
+		const int from = resolve_node_id(c.from);
+		const int to = resolve_node_id(c.to);
+		if (from < 0 || from >= nc || to < 0 || to >= nc || c.signal < 0 || c.signal >= sname_count || c.method < 0 || c.method >= sname_count) {
+			compiled = false;
+			break;
+		}
+
+		InstantiationPlan::Connection plan_connection;
+		plan_connection.from = from;
+		plan_connection.to = to;
+		plan_connection.signal = names[c.signal];
+		plan_connection.method = names[c.method];
+		plan_connection.flags = CONNECT_PERSIST | c.flags | CONNECT_INHERITED;
+		plan_connection.unbinds = c.unbinds;
+		for (int j = 0; j < c.binds.size(); j++) {
+			if (c.binds[j] < 0 || c.binds[j] >= prop_count) {
+				compiled = false;
+				break;
+			}
+			plan_connection.binds.push_back(variants[c.binds[j]]);
+		}
+		new_plan->connections.push_back(plan_connection);
+	}
+
+	if (!compiled) {
+		memdelete(new_plan);
+		return nullptr;
+	}
+
+	return new_plan;
+}
+
+const SceneState::InstantiationPlan *SceneState::_get_instantiation_plan() const {
+	if (!plan_compiled.is_set()) {
+		MutexLock lock(plan_mutex);
+		if (!plan_compiled.is_set()) {
+			plan = _compile_instantiation_plan();
+			plan_compiled.set();
+		}
+	}
+
+	if (!plan) {
+		return nullptr;
+	}
+
+	// Resources can be made local to scene after loading, so check every time.
+	for (const Ref<Resource> &res : plan->resources) {
+		if (res->is_local_to_scene()) {
+			return nullptr;
+		}
+	}
+
+	return plan;
+}
+
+Node *SceneState::_instantiate_from_plan(const InstantiationPlan &p_plan) const {
+	const Variant *props = variants.ptr();
+	const uint32_t nc = p_plan.nodes.size();
+
+	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
+
+	LocalVector<DeferredNodePathProperties> deferred_node_paths;
+
+	for (uint32_t i = 0; i < nc; i++) {
+		const InstantiationPlan::PlanNode &pn = p_plan.nodes[i];
+
+		Node *node = nullptr;
+		if (pn.creation_func) {
+			node = static_cast<Node *>(pn.creation_func());
+		} else {
+			node = pn.scene->instantiate(PackedScene::GEN_EDIT_STATE_DISABLED);
+			if (!node) {
+				if (i > 0) {
+					memdelete(ret_nodes[0]);
+				}
+				ERR_FAIL_V_MSG(nullptr, vformat("Failed to load scene dependency: \"%s\". Make sure the required scene is valid.", pn.scene->get_path()));
+			}
+		}
+
+		if (pn.child_count > 0) {
+			node->_reserve_children(pn.child_count);
+		}
+
+		for (const InstantiationPlan::Property &prop : pn.properties) {
+			if (prop.name == CoreStringName(script)) {
+				// Same workaround as instantiate(), to avoid old script variables from disappearing.
+				List<Pair<StringName, Variant>> old_state;
+				if (node->get_script_instance()) {
+					node->get_script_instance()->get_property_state(old_state);
+				}
+
+				node->set(prop.name, props[prop.value]);
+
+				for (const Pair<StringName, Variant> &E : old_state) {
+					node->set(E.first, E.second);
+				}
+				continue;
+			}
+
+			Variant value = props[prop.value];
+			if (value.get_type() == Variant::ARRAY) {
+				Array set_array = value;
+
+				bool is_get_valid = false;
+				Variant get_value = node->get(prop.name, &is_get_valid);
+
+				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+					Array get_array = get_value;
+					if (!set_array.is_same_typed(get_array)) {
+						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+					}
+				}
+			}
+
+			if (prop.setter && !node->get_script_instance()) {
+				// Same as what Object::set() ends up doing through ClassDB::set_property(), minus the lookups.
+				Callable::CallError ce;
+				if (prop.index >= 0) {
+					Variant index = prop.index;
+					const Variant *args[2] = { &index, &value };
+					prop.setter->call(node, args, 2, ce);
+				} else {
+					const Variant *args[1] = { &value };
+					prop.setter->call(node, args, 1, ce);
+				}
+#ifdef TOOLS_ENABLED
+				node->set_edited(true);
+#endif
+			} else {
+				node->set(prop.name, value);
+			}
+		}
+
+		for (const StringName &group : pn.groups) {
+			node->add_to_group(group, true);
+		}
+
+		if (i > 0) {
+			Node *parent = ret_nodes[pn.parent];
+			// The order change is notified once per parent below.
+			parent->_add_child_nocheck(node, pn.name, Node::INTERNAL_MODE_DISABLED, false);
+			if (pn.index >= 0 && pn.index < parent->get_child_count() - 1) {
+				parent->move_child(node, pn.index);
+			}
+		} else {
+			node->_set_name_nocheck(pn.name);
+		}
+
+		if (pn.owner >= 0) {
+			node->_set_owner_nocheck(ret_nodes[pn.owner]);
+			if (node->data.unique_name_in_owner) {
+				node->_acquire_unique_name_in_owner();
+			}
+		}
+
+		node->remove_meta("_edit_pinned_properties_");
+
+		for (const InstantiationPlan::Property &prop : pn.node_path_properties) {
+			DeferredNodePathProperties dnp;
+			dnp.value = props[prop.value];
+			dnp.base = node;
+			dnp.property = prop.name;
+			deferred_node_paths.push_back(dnp);
+		}
+
+		ret_nodes[i] = node;
+	}
+
+	for (uint32_t i = 0; i < nc; i++) {
+		if (p_plan.nodes[i].child_count > 0) {
+			ret_nodes[i]->notification(Node::NOTIFICATION_CHILD_ORDER_CHANGED);
+			ret_nodes[i]->emit_signal(SNAME("child_order_changed"));
+		}
+	}
+
+	_assign_deferred_node_paths(deferred_node_paths);
+
+	for (const InstantiationPlan::Connection &c : p_plan.connections) {
+		Callable callable(ret_nodes[c.to], c.method);
+		if (c.unbinds > 0) {
+			callable = callable.unbind(c.unbinds);
+		} else if (!c.binds.is_empty()) {
+			const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * c.binds.size());
+			for (int j = 0; j < c.binds.size(); j++) {
+				argptrs[j] = &c.binds[j];
+			}
+			callable = callable.bindp(argptrs, c.binds.size());
+		}
+
+		ret_nodes[c.from]->connect(c.signal, callable, c.flags);
+	}
+
+	return ret_nodes[0];
+}
+
+void SceneState::_clear_instantiation_plan() {
+	if (!plan_compiled.is_set()) {
+		return;
+	}
+
+	MutexLock lock(plan_mutex);
+	if (plan) {
+		memdelete(plan);
+		plan = nullptr;
+	}
+	plan_compiled.clear();
+}
+
 Variant SceneState::make_local_resource(Variant &p_value, const SceneState::NodeData &p_node_data, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const {
 	Ref<Resource> res = p_value;
 	if (res.is_null() || !res->is_local_to_scene()) {
@@ -1205,6 +1604,8 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
+
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1258,6 +1659,8 @@ Ref<SceneState> SceneState::get_base_scene_state() const {
 }
 
 void SceneState::update_instance_resource(String p_path, Ref<PackedScene> p_packed_scene) {
+	_clear_instantiation_plan();
+
 	ERR_FAIL_COND(p_packed_scene.is_null());
 
 	for (const NodeData &nd : nodes) {
@@ -1407,6 +1810,8 @@ bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_
 }
 
 void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
+	_clear_instantiation_plan();
+
 	ERR_FAIL_COND(!p_dictionary.has("names"));
 	ERR_FAIL_COND(!p_dictionary.has("variants"));
 	ERR_FAIL_COND(!p_dictionary.has("node_count"));
@@ -1873,21 +2278,29 @@ Vector<NodePath> SceneState::get_editable_instances() const {
 //add
 
 int SceneState::add_name(const StringName &p_name) {
+	_clear_instantiation_plan();
+
 	names.push_back(p_name);
 	return names.size() - 1;
 }
 
 int SceneState::add_value(const Variant &p_value) {
+	_clear_instantiation_plan();
+
 	variants.push_back(p_value);
 	return variants.size() - 1;
 }
 
 int SceneState::add_node_path(const NodePath &p_path) {
+	_clear_instantiation_plan();
+
 	node_paths.push_back(p_path);
 	return (node_paths.size() - 1) | FLAG_ID_IS_PATH;
 }
 
 int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int p_instance, int p_index) {
+	_clear_instantiation_plan();
+
 	NodeData nd;
 	nd.parent = p_parent;
 	nd.owner = p_owner;
@@ -1902,6 +2315,8 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 }
 
 void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_deferred_node_path) {
+	_clear_instantiation_plan();
+
 	ERR_FAIL_INDEX(p_node, nodes.size());
 	ERR_FAIL_INDEX(p_name, names.size());
 	ERR_FAIL_INDEX(p_value, variants.size());
@@ -1916,17 +2331,23 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 }
 
 void SceneState::add_node_group(int p_node, int p_group) {
+	_clear_instantiation_plan();
+
 	ERR_FAIL_INDEX(p_node, nodes.size());
 	ERR_FAIL_INDEX(p_group, names.size());
 	nodes.write[p_node].groups.push_back(p_group);
 }
 
 void SceneState::set_base_scene(int p_idx) {
+	_clear_instantiation_plan();
+
 	ERR_FAIL_INDEX(p_idx, variants.size());
 	base_scene_idx = p_idx;
 }
 
 void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method, int p_flags, int p_unbinds, const Vector<int> &p_binds) {
+	_clear_instantiation_plan();
+
 	ERR_FAIL_INDEX(p_signal, names.size());
 	ERR_FAIL_INDEX(p_method, names.size());
 
@@ -1945,10 +2366,14 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 }
 
 void SceneState::add_editable_instance(const NodePath &p_path) {
+	_clear_instantiation_plan();
+
 	editable_instances.push_back(p_path);
 }
 
 bool SceneState::remove_group_references(const StringName &p_name) {
+	_clear_instantiation_plan();
+
 	bool edited = false;
 	for (NodeData &node : nodes) {
 		for (const int &group : node.groups) {
@@ -1963,6 +2388,8 @@ bool SceneState::remove_group_references(const StringName &p_name) {
 }
 
 bool SceneState::rename_group_references(const StringName &p_old_name, const StringName &p_new_name) {
+	_clear_instantiation_plan();
+
 	bool edited = false;
 	for (const NodeData &node : nodes) {
 		for (const int &group : node.groups) {
@@ -2031,6 +2458,12 @@ void SceneState::_bind_methods() {
 SceneState::SceneState() {
 }
 
+SceneState::~SceneState() {
+	if (plan) {
+		memdelete(plan);
+	}
+}
+
 ////////////////
 
 void PackedScene::_set_bundled_scene(const Dictionary &p_scene) {
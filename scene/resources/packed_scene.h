@@ -32,8 +32,14 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/main/node.h"
 
+class MethodBind;
+class PackedScene;
+
 class SceneState : public RefCounted {
 	GDCLASS(SceneState, RefCounted);
 
@@ -89,6 +95,58 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Instantiating without edit state replays the nodes, properties and connections above.
+	// For scenes that only contain native nodes and sub-scenes, the class constructors, property
+	// setters and connection data are resolved once into a plan, built on the first instantiation.
+	struct InstantiationPlan {
+		struct Property {
+			StringName name;
+			MethodBind *setter = nullptr; // Called directly while the node has no script.
+			int index = -1;
+			int value = 0;
+		};
+
+		struct PlanNode {
+			Object *(*creation_func)() = nullptr;
+			StringName type;
+			Ref<PackedScene> scene; // For sub-scenes.
+			StringName name;
+			int parent = -1;
+			int owner = -1;
+			int index = -1;
+			int child_count = 0;
+			LocalVector<Property> properties;
+			LocalVector<Property> node_path_properties;
+			LocalVector<StringName> groups;
+		};
+
+		struct Connection {
+			int from = 0;
+			int to = 0;
+			StringName signal;
+			StringName method;
+			uint32_t flags = 0;
+			int unbinds = 0;
+			Vector<Variant> binds;
+		};
+
+		LocalVector<PlanNode> nodes;
+		LocalVector<Connection> connections;
+		// The plan doesn't duplicate resources local to the scene, so it can't be used once one of these is.
+		LocalVector<Ref<Resource>> resources;
+	};
+
+	mutable BinaryMutex plan_mutex;
+	mutable SafeFlag plan_compiled;
+	mutable InstantiationPlan *plan = nullptr;
+
+	InstantiationPlan *_compile_instantiation_plan() const;
+	const InstantiationPlan *_get_instantiation_plan() const;
+	Node *_instantiate_from_plan(const InstantiationPlan &p_plan) const;
+	void _clear_instantiation_plan();
+
+	static void _assign_deferred_node_paths(const LocalVector<DeferredNodePathProperties> &p_deferred_node_paths);
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -223,6 +281,7 @@ public:
 #endif
 
 	SceneState();
+	~SceneState();
 };
 
 VARIANT_ENUM_CAST(SceneState::GenEditState)
@@ -36,6 +36,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/frame_timeline.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1288,6 +1289,7 @@ void GodotPhysicsServer2D::init() {
 }
 
 void GodotPhysicsServer2D::step(real_t p_step) {
+	FRAME_TIMELINE_ZONE("PhysicsServer2D::step");
 	if (!active) {
 		return;
 	}
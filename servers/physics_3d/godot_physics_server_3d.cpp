@@ -39,6 +39,7 @@
 #include "joints/godot_slider_joint_3d.h"
 
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/frame_timeline.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1629,6 +1630,7 @@ void GodotPhysicsServer3D::init() {
 }
 
 void GodotPhysicsServer3D::step(real_t p_step) {
+	FRAME_TIMELINE_ZONE("PhysicsServer3D::step");
 #ifndef _3D_DISABLED
 
 	if (!active) {
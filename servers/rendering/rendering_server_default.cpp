@@ -31,6 +31,7 @@
 #include "rendering_server_default.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/frame_timeline.h"
 #include "core/io/marshalls.h"
 #include "core/os/os.h"
 #include "core/templates/sort_array.h"
@@ -69,6 +70,7 @@ void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_call
 }
 
 void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+	FRAME_TIMELINE_ZONE("RenderingServer::draw");
 	RSG::rasterizer->begin_frame(frame_step);
 
 	TIMESTAMP_BEGIN()
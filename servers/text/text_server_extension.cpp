@@ -272,6 +272,7 @@ void TextServerExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_shaped_text_tab_align, "shaped", "tab_stops");
 
 	GDVIRTUAL_BIND(_shaped_text_shape, "shaped");
+	GDVIRTUAL_BIND(_shaped_text_shape_batch, "shaped");
 	GDVIRTUAL_BIND(_shaped_text_update_breaks, "shaped");
 	GDVIRTUAL_BIND(_shaped_text_update_justification_ops, "shaped");
 
@@ -1199,6 +1200,14 @@ bool TextServerExtension::shaped_text_shape(const RID &p_shaped) {
 	return ret;
 }
 
+bool TextServerExtension::shaped_text_shape_batch(const TypedArray<RID> &p_shaped) {
+	bool ret = false;
+	if (GDVIRTUAL_CALL(_shaped_text_shape_batch, p_shaped, ret)) {
+		return ret;
+	}
+	return TextServer::shaped_text_shape_batch(p_shaped);
+}
+
 bool TextServerExtension::shaped_text_update_breaks(const RID &p_shaped) {
 	bool ret = false;
 	GDVIRTUAL_CALL(_shaped_text_update_breaks, p_shaped, ret);
@@ -427,6 +427,7 @@ void TextServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("shaped_text_tab_align", "shaped", "tab_stops"), &TextServer::shaped_text_tab_align);
 
 	ClassDB::bind_method(D_METHOD("shaped_text_shape", "shaped"), &TextServer::shaped_text_shape);
+	ClassDB::bind_method(D_METHOD("shaped_text_shape_batch", "shaped"), &TextServer::shaped_text_shape_batch);
 	ClassDB::bind_method(D_METHOD("shaped_text_is_ready", "shaped"), &TextServer::shaped_text_is_ready);
 	ClassDB::bind_method(D_METHOD("shaped_text_has_visible_chars", "shaped"), &TextServer::shaped_text_has_visible_chars);
 
@@ -766,6 +767,14 @@ void TextServer::draw_hex_code_box(const RID &p_canvas, int64_t p_size, const Ve
 	}
 }
 
+bool TextServer::shaped_text_shape_batch(const TypedArray<RID> &p_shaped) {
+	bool ok = true;
+	for (int i = 0; i < p_shaped.size(); i++) {
+		ok = shaped_text_shape(p_shaped[i]) && ok;
+	}
+	return ok;
+}
+
 bool TextServer::shaped_text_has_visible_chars(const RID &p_shaped) const {
 	int v_size = shaped_text_get_glyph_count(p_shaped);
 	if (v_size == 0) {
@@ -472,6 +472,7 @@ public:
 	virtual double shaped_text_tab_align(const RID &p_shaped, const PackedFloat32Array &p_tab_stops) = 0;
 
 	virtual bool shaped_text_shape(const RID &p_shaped) = 0;
+	virtual bool shaped_text_shape_batch(const TypedArray<RID> &p_shaped);
 	virtual bool shaped_text_update_breaks(const RID &p_shaped) = 0;
 	virtual bool shaped_text_update_justification_ops(const RID &p_shaped) = 0;
 
@@ -0,0 +1,240 @@
+/**************************************************************************/
+/*  benchmark_core.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_CORE_H
+#define BENCHMARK_CORE_H
+
+#include "core/debugger/frame_timeline.h"
+#include "core/io/image.h"
+#include "core/io/json.h"
+#include "core/math/random_number_generator.h"
+#include "core/string/string_builder.h"
+#include "core/templates/frame_arena.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_benchmark.h"
+
+namespace BenchmarkCore {
+
+BENCHMARK_CASE("[Benchmark][Core] Containers") {
+	const int count = 1000000;
+
+	BENCHMARK_REPORT("Vector push_back", TestBenchmark::measure_usec([&]() {
+		Vector<int> vector;
+		for (int i = 0; i < count; i++) {
+			vector.push_back(i);
+		}
+		CHECK(vector.size() == count);
+	}));
+
+	BENCHMARK_REPORT("LocalVector push_back", TestBenchmark::measure_usec([&]() {
+		LocalVector<int> vector;
+		for (int i = 0; i < count; i++) {
+			vector.push_back(i);
+		}
+		CHECK(vector.size() == count);
+	}));
+
+	BENCHMARK_REPORT("List push_back and iterate", TestBenchmark::measure_usec([&]() {
+		List<int> list;
+		for (int i = 0; i < count; i++) {
+			list.push_back(i);
+		}
+		int64_t sum = 0;
+		for (const int &value : list) {
+			sum += value;
+		}
+		CHECK(sum == int64_t(count) * (count - 1) / 2);
+	}));
+
+	BENCHMARK_REPORT("HashMap insert and lookup", TestBenchmark::measure_usec([&]() {
+		HashMap<int, int> map;
+		for (int i = 0; i < count; i++) {
+			map.insert(i * 7, i);
+		}
+		int64_t sum = 0;
+		for (int i = 0; i < count; i++) {
+			sum += *map.getptr(i * 7);
+		}
+		CHECK(sum == int64_t(count) * (count - 1) / 2);
+	}));
+
+	LocalVector<int> unsorted;
+	Ref<RandomNumberGenerator> rng = memnew(RandomNumberGenerator);
+	rng->set_seed(1);
+	for (int i = 0; i < count; i++) {
+		unsorted.push_back(rng->randi());
+	}
+	BENCHMARK_REPORT("LocalVector sort", TestBenchmark::measure_usec([&]() {
+		LocalVector<int> vector = unsorted;
+		vector.sort();
+	}));
+
+	BENCHMARK_REPORT("FrameLocalVector push_back", TestBenchmark::measure_usec([&]() {
+		FrameArena::Scope scope;
+		FrameLocalVector<int> vector;
+		for (int i = 0; i < count; i++) {
+			vector.push_back(i);
+		}
+		CHECK(vector.size() == count);
+	}));
+}
+
+static String repeat_text(const String &p_text, int p_length) {
+	StringBuilder builder;
+	for (int i = 0; i < p_length / p_text.length(); i++) {
+		builder.append(p_text);
+	}
+	return builder.as_string();
+}
+
+BENCHMARK_CASE("[Benchmark][Core] Strings") {
+	const int length = 4 * 1024 * 1024;
+	const String texts[][2] = {
+		{ "ASCII", repeat_text("The quick brown fox jumps over the lazy dog. ", length) },
+		{ "Latin", repeat_text(U"Le cœur déçu mais l'âme plutôt naïve, Louÿs rêva de crapaüter. ", length) },
+		{ "CJK", repeat_text(U"我能吞下玻璃而不伤身体。私はガラスを食べられます。", length) },
+		{ "Emoji", repeat_text(U"😀🚀🌍🎉👍", length) },
+	};
+
+	for (const String(&text)[2] : texts) {
+		const CharString utf8 = text[1].utf8();
+		String decoded;
+		const uint64_t decode_time = TestBenchmark::measure_usec([&]() {
+			decoded.parse_utf8(utf8.get_data(), utf8.length());
+		});
+		CHECK(decoded == text[1]);
+		const uint64_t encode_time = TestBenchmark::measure_usec([&]() {
+			CHECK(text[1].utf8().length() == utf8.length());
+		});
+		BENCHMARK_REPORT(text[0] + " UTF-8 decode", decode_time);
+		BENCHMARK_REPORT(text[0] + " UTF-8 encode", encode_time);
+		MESSAGE(vformat("%s UTF-8: decode %.2f GB/s, encode %.2f GB/s.", text[0], utf8.length() / (decode_time * 1000.0), utf8.length() / (encode_time * 1000.0)));
+	}
+
+	BENCHMARK_REPORT("StringBuilder append", TestBenchmark::measure_usec([&]() {
+		StringBuilder builder;
+		for (int i = 0; i < 100000; i++) {
+			builder.append("item ");
+			builder.append(itos(i));
+			builder.append('\n');
+		}
+		CHECK(builder.as_string().length() > 0);
+	}));
+
+	BENCHMARK_REPORT("vformat", TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < 100000; i++) {
+			vformat("Node %d at (%.2f, %.2f): %s", i, i * 0.5, i * 0.25, "visible");
+		}
+	}));
+}
+
+BENCHMARK_CASE("[Benchmark][Core] JSON") {
+	StringBuilder builder;
+	builder.append("[");
+	for (int i = 0; i < 50000; i++) {
+		builder.append(vformat("%s{\"id\": %d, \"name\": \"Item \\\"%d\\\"\", \"position\": [%f, %f, %f], \"tags\": [\"a\", \"b\"], \"visible\": true}", i ? "," : "", i, i, i * 0.5, i * 0.25, i * 0.125));
+	}
+	builder.append("]");
+	const String text = builder.as_string();
+	const CharString utf8 = text.utf8();
+	PackedByteArray bytes;
+	bytes.resize(utf8.length());
+	memcpy(bytes.ptrw(), utf8.get_data(), utf8.length());
+
+	JSON json;
+	BENCHMARK_REPORT("parse String", TestBenchmark::measure_usec([&]() {
+		CHECK(json.parse(text) == OK);
+	}));
+	BENCHMARK_REPORT("parse_utf8", TestBenchmark::measure_usec([&]() {
+		CHECK(json.parse_utf8(bytes) == OK);
+	}));
+	BENCHMARK_REPORT("parse_utf8 with packed arrays", TestBenchmark::measure_usec([&]() {
+		CHECK(json.parse_utf8(bytes, true) == OK);
+	}));
+	BENCHMARK_REPORT("stringify", TestBenchmark::measure_usec([&]() {
+		CHECK(!JSON::stringify(json.get_data()).is_empty());
+	}));
+}
+
+BENCHMARK_CASE("[Benchmark][Core] Image") {
+	Ref<Image> source = Image::create_empty(2048, 2048, false, Image::FORMAT_RGBA8);
+	uint8_t *w = source->ptrw();
+	for (int64_t i = 0; i < source->data_size(); i++) {
+		w[i] = uint8_t(i * 31 + (i >> 13));
+	}
+
+	const Image::Interpolation interpolations[] = { Image::INTERPOLATE_NEAREST, Image::INTERPOLATE_BILINEAR, Image::INTERPOLATE_CUBIC, Image::INTERPOLATE_LANCZOS };
+	const char *interpolation_names[] = { "nearest", "bilinear", "cubic", "lanczos" };
+	for (int i = 0; i < 4; i++) {
+		BENCHMARK_REPORT(vformat("resize %s", interpolation_names[i]), TestBenchmark::measure_usec([&]() {
+			Ref<Image> image = source->duplicate();
+			image->resize(1500, 1500, interpolations[i]);
+		}));
+	}
+
+	BENCHMARK_REPORT("convert RGBA8 to RGB8", TestBenchmark::measure_usec([&]() {
+		Ref<Image> image = source->duplicate();
+		image->convert(Image::FORMAT_RGB8);
+	}));
+	BENCHMARK_REPORT("convert RGBA8 to RGBAF", TestBenchmark::measure_usec([&]() {
+		Ref<Image> image = source->duplicate();
+		image->convert(Image::FORMAT_RGBAF);
+	}));
+	BENCHMARK_REPORT("generate_mipmaps", TestBenchmark::measure_usec([&]() {
+		Ref<Image> image = source->duplicate();
+		image->generate_mipmaps();
+	}));
+}
+
+BENCHMARK_CASE("[Benchmark][Core] Frame timeline zones") {
+	const int count = 1000000;
+	const uint64_t disabled_time = TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < count; i++) {
+			FRAME_TIMELINE_ZONE("Benchmark zone");
+		}
+	});
+	BENCHMARK_REPORT("1M disabled zones", disabled_time);
+
+	FrameTimeline::start();
+	const uint64_t enabled_time = TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < count; i++) {
+			FRAME_TIMELINE_ZONE("Benchmark zone");
+		}
+	});
+	FrameTimeline::finish();
+	BENCHMARK_REPORT("1M enabled zones", enabled_time);
+}
+
+} // namespace BenchmarkCore
+
+#endif // BENCHMARK_CORE_H
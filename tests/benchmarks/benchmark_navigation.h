@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*  benchmark_navigation.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_NAVIGATION_H
+#define BENCHMARK_NAVIGATION_H
+
+#include "scene/resources/navigation_mesh.h"
+#include "servers/navigation_server_3d.h"
+
+#include "tests/test_benchmark.h"
+
+namespace BenchmarkNavigation {
+
+TEST_SUITE("[Navigation]") {
+	// A 100x100 grid of quads, with every fourth column of cells left out in the middle rows
+	// so that paths have to go around walls.
+	static Ref<NavigationMesh> create_grid_navigation_mesh() {
+		const int size = 100;
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= size; z++) {
+			for (int x = 0; x <= size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		Ref<NavigationMesh> navigation_mesh;
+		navigation_mesh.instantiate();
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < size; z++) {
+			for (int x = 0; x < size; x++) {
+				if (x % 4 == 2 && z > 5 && z < size - 5) {
+					continue;
+				}
+				const int i = z * (size + 1) + x;
+				navigation_mesh->add_polygon({ i, i + 1, i + size + 2, i + size + 1 });
+			}
+		}
+		return navigation_mesh;
+	}
+
+	BENCHMARK_CASE("[Benchmark][NavigationServer3D] Map queries") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh();
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+
+		BENCHMARK_REPORT("Map synchronization with 10000 polygons", TestBenchmark::measure_usec([&]() {
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->map_force_update(map);
+		}));
+
+		BENCHMARK_REPORT("1000 paths", TestBenchmark::measure_usec([&]() {
+			int64_t points = 0;
+			for (int i = 0; i < 1000; i++) {
+				const Vector3 from = Vector3((i * 7) % 100 + 0.5, 0, 0.5);
+				const Vector3 to = Vector3((i * 13) % 100 + 0.5, 0, 99.5);
+				points += navigation_server->map_get_path(map, from, to, true).size();
+			}
+			CHECK(points > 0);
+		}));
+
+		BENCHMARK_REPORT("10000 closest points", TestBenchmark::measure_usec([&]() {
+			real_t distance = 0;
+			for (int i = 0; i < 10000; i++) {
+				const Vector3 point = Vector3(i % 100 + 0.3, 1, (i / 100) + 0.7);
+				distance += navigation_server->map_get_closest_point(map, point).distance_to(point);
+			}
+			CHECK(distance > 0);
+		}));
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	BENCHMARK_CASE("[Benchmark][NavigationServer3D] Agent avoidance") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		LocalVector<RID> agents;
+		for (int i = 0; i < 500; i++) {
+			RID agent = navigation_server->agent_create();
+			navigation_server->agent_set_map(agent, map);
+			navigation_server->agent_set_avoidance_enabled(agent, true);
+			navigation_server->agent_set_radius(agent, 0.5);
+			navigation_server->agent_set_max_speed(agent, 5);
+			navigation_server->agent_set_position(agent, Vector3((i % 25) * 1.5, 0, (i / 25) * 1.5));
+			navigation_server->agent_set_velocity(agent, Vector3(i % 2 ? 1 : -1, 0, i % 3 ? 1 : -1));
+			agents.push_back(agent);
+		}
+
+		BENCHMARK_REPORT("60 steps with 500 agents", TestBenchmark::measure_usec([&]() {
+			for (int i = 0; i < 60; i++) {
+				navigation_server->process(1.0 / 60.0);
+			}
+		}));
+
+		for (const RID &agent : agents) {
+			navigation_server->free(agent);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+}
+
+} // namespace BenchmarkNavigation
+
+#endif // BENCHMARK_NAVIGATION_H
@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*  benchmark_physics.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_PHYSICS_H
+#define BENCHMARK_PHYSICS_H
+
+#include "servers/physics_server_2d.h"
+#ifndef _3D_DISABLED
+#include "servers/physics_server_3d.h"
+#endif // _3D_DISABLED
+
+#include "tests/test_benchmark.h"
+
+namespace BenchmarkPhysics {
+
+// Boxes falling on a floor in a grid, so they settle in piles with many contacts.
+BENCHMARK_CASE("[Benchmark][SceneTree] Physics 2D stepping") {
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID floor_shape = ps->rectangle_shape_create();
+	ps->shape_set_data(floor_shape, Vector2(10000, 10));
+	RID floor = ps->body_create();
+	ps->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	ps->body_add_shape(floor, floor_shape);
+	ps->body_set_space(floor, space);
+
+	RID box_shape = ps->rectangle_shape_create();
+	ps->shape_set_data(box_shape, Vector2(5, 5));
+	LocalVector<RID> bodies;
+	for (int i = 0; i < 1000; i++) {
+		RID body = ps->body_create();
+		ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+		ps->body_add_shape(body, box_shape);
+		ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2((i % 50) * 12 - 300, -20 - (i / 50) * 12)));
+		ps->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 300; i++) {
+		ps->step(1.0 / 60.0);
+	}
+	BENCHMARK_REPORT("300 steps with 1000 boxes", OS::get_singleton()->get_ticks_usec() - begin);
+
+	PhysicsDirectSpaceState2D *state = ps->space_get_direct_state(space);
+	BENCHMARK_REPORT("10000 ray casts", TestBenchmark::measure_usec([&]() {
+		int hits = 0;
+		for (int i = 0; i < 10000; i++) {
+			PhysicsDirectSpaceState2D::RayParameters parameters;
+			parameters.from = Vector2((i % 600) - 300, -1000);
+			parameters.to = Vector2((i % 600) - 300, 1000);
+			PhysicsDirectSpaceState2D::RayResult result;
+			hits += state->intersect_ray(parameters, result);
+		}
+		CHECK(hits > 0);
+	}));
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(floor);
+	ps->free(box_shape);
+	ps->free(floor_shape);
+	ps->free(space);
+}
+
+#ifndef _3D_DISABLED
+BENCHMARK_CASE("[Benchmark][SceneTree] Physics 3D stepping") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID floor_shape = ps->box_shape_create();
+	ps->shape_set_data(floor_shape, Vector3(1000, 1, 1000));
+	RID floor = ps->body_create();
+	ps->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	ps->body_add_shape(floor, floor_shape);
+	ps->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+	ps->body_set_space(floor, space);
+
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> bodies;
+	for (int i = 0; i < 1000; i++) {
+		RID body = ps->body_create();
+		ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+		ps->body_add_shape(body, box_shape);
+		ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3((i % 10) * 1.2, 1 + (i / 100) * 1.2, ((i / 10) % 10) * 1.2)));
+		ps->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 300; i++) {
+		ps->step(1.0 / 60.0);
+	}
+	BENCHMARK_REPORT("300 steps with 1000 boxes", OS::get_singleton()->get_ticks_usec() - begin);
+
+	PhysicsDirectSpaceState3D *state = ps->space_get_direct_state(space);
+	BENCHMARK_REPORT("10000 ray casts", TestBenchmark::measure_usec([&]() {
+		int hits = 0;
+		for (int i = 0; i < 10000; i++) {
+			PhysicsDirectSpaceState3D::RayParameters parameters;
+			parameters.from = Vector3((i % 100) * 0.12, 100, (i / 100) * 0.12);
+			parameters.to = Vector3((i % 100) * 0.12, -100, (i / 100) * 0.12);
+			PhysicsDirectSpaceState3D::RayResult result;
+			hits += state->intersect_ray(parameters, result);
+		}
+		CHECK(hits > 0);
+	}));
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(floor);
+	ps->free(box_shape);
+	ps->free(floor_shape);
+	ps->free(space);
+}
+#endif // _3D_DISABLED
+
+} // namespace BenchmarkPhysics
+
+#endif // BENCHMARK_PHYSICS_H
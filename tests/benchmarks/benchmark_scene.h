@@ -0,0 +1,326 @@
+/**************************************************************************/
+/*  benchmark_scene.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_SCENE_H
+#define BENCHMARK_SCENE_H
+
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "scene/2d/cpu_particles_2d.h"
+#include "scene/2d/line_2d.h"
+#include "scene/2d/tile_map_layer.h"
+#include "scene/main/window.h"
+#include "scene/resources/gradient.h"
+#include "scene/resources/image_texture.h"
+#include "scene/resources/packed_scene.h"
+#include "scene/resources/world_2d.h"
+#include "servers/physics_server_2d.h"
+#ifndef _3D_DISABLED
+#include "scene/3d/cpu_particles_3d.h"
+#endif // _3D_DISABLED
+
+#include "tests/test_benchmark.h"
+
+namespace BenchmarkScene {
+
+// A scene of 1000 nodes, half of them with points and a gradient sub-resource.
+static Ref<PackedScene> create_benchmark_scene() {
+	Node2D *root = memnew(Node2D);
+	root->set_name("Root");
+	for (int i = 0; i < 500; i++) {
+		Node2D *group = memnew(Node2D);
+		group->set_name(vformat("Group%d", i));
+		group->set_position(Vector2(i, i * 2));
+		group->set_rotation(i * 0.01);
+		root->add_child(group);
+		group->set_owner(root);
+
+		Line2D *line = memnew(Line2D);
+		line->set_name("Line");
+		Vector<Vector2> points;
+		for (int j = 0; j < 16; j++) {
+			points.push_back(Vector2(j, i + j));
+		}
+		line->set_points(points);
+		Ref<Gradient> gradient;
+		gradient.instantiate();
+		gradient->set_colors({ Color(1, 0, 0), Color(0, 0, i / 500.0) });
+		line->set_gradient(gradient);
+		group->add_child(line);
+		line->set_owner(root);
+	}
+
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	CHECK(scene->pack(root) == OK);
+	memdelete(root);
+	return scene;
+}
+
+BENCHMARK_CASE("[Benchmark][SceneTree] Scene instantiation") {
+	const Ref<PackedScene> scene = create_benchmark_scene();
+
+	BENCHMARK_REPORT("10 instantiations of 1000 nodes", TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < 10; i++) {
+			Node *instance = scene->instantiate();
+			CHECK(instance->get_child_count() == 500);
+			memdelete(instance);
+		}
+	}));
+
+	BENCHMARK_REPORT("10 instantiations of 1000 nodes added to the tree", TestBenchmark::measure_usec([&]() {
+		Window *root = SceneTree::get_singleton()->get_root();
+		for (int i = 0; i < 10; i++) {
+			Node *instance = scene->instantiate();
+			root->add_child(instance);
+			root->remove_child(instance);
+			memdelete(instance);
+		}
+	}));
+
+	BENCHMARK_REPORT("Packing 1000 nodes", TestBenchmark::measure_usec([&]() {
+		Node *instance = scene->instantiate();
+		Ref<PackedScene> packed;
+		packed.instantiate();
+		CHECK(packed->pack(instance) == OK);
+		memdelete(instance);
+	}));
+}
+
+BENCHMARK_CASE("[Benchmark][SceneTree] Resource loading") {
+	const Ref<PackedScene> scene = create_benchmark_scene();
+	const String text_path = OS::get_singleton()->get_cache_path().path_join("benchmark_scene.tscn");
+	const String binary_path = OS::get_singleton()->get_cache_path().path_join("benchmark_scene.scn");
+	REQUIRE(ResourceSaver::save(scene, text_path) == OK);
+	REQUIRE(ResourceSaver::save(scene, binary_path) == OK);
+
+	BENCHMARK_REPORT("Load text scene", TestBenchmark::measure_usec([&]() {
+		Ref<PackedScene> loaded = ResourceLoader::load(text_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		CHECK(loaded.is_valid());
+	}));
+	BENCHMARK_REPORT("Load binary scene", TestBenchmark::measure_usec([&]() {
+		Ref<PackedScene> loaded = ResourceLoader::load(binary_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		CHECK(loaded.is_valid());
+	}));
+	BENCHMARK_REPORT("Load binary scene with sub-threads", TestBenchmark::measure_usec([&]() {
+		CHECK(ResourceLoader::load_threaded_request(binary_path, "", true, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+		Ref<PackedScene> loaded = ResourceLoader::load_threaded_get(binary_path);
+		CHECK(loaded.is_valid());
+	}));
+	BENCHMARK_REPORT("Save text scene", TestBenchmark::measure_usec([&]() {
+		CHECK(ResourceSaver::save(scene, text_path) == OK);
+	}));
+	BENCHMARK_REPORT("Save binary scene", TestBenchmark::measure_usec([&]() {
+		CHECK(ResourceSaver::save(scene, binary_path) == OK);
+	}));
+}
+
+// A tile set with a 4x4 atlas of 16x16 tiles, optionally all fully solid.
+static Ref<TileSet> create_benchmark_tile_set(bool p_with_collision = false) {
+	Ref<TileSet> tile_set;
+	tile_set.instantiate();
+	tile_set->set_tile_size(Vector2i(16, 16));
+	if (p_with_collision) {
+		tile_set->add_physics_layer();
+	}
+
+	Ref<TileSetAtlasSource> atlas_source;
+	atlas_source.instantiate();
+	atlas_source->set_texture(ImageTexture::create_from_image(Image::create_empty(64, 64, false, Image::FORMAT_RGBA8)));
+	atlas_source->set_texture_region_size(Vector2i(16, 16));
+	tile_set->add_source(atlas_source, 0);
+	for (int y = 0; y < 4; y++) {
+		for (int x = 0; x < 4; x++) {
+			atlas_source->create_tile(Vector2i(x, y));
+			if (p_with_collision) {
+				TileData *tile_data = atlas_source->get_tile_data(Vector2i(x, y), 0);
+				tile_data->add_collision_polygon(0);
+				tile_data->set_collision_polygon_points(0, 0, { Vector2(-8, -8), Vector2(8, -8), Vector2(8, 8), Vector2(-8, 8) });
+			}
+		}
+	}
+	return tile_set;
+}
+
+BENCHMARK_CASE("[Benchmark][SceneTree][TileMapLayer] Large generated map") {
+	const int map_size = 512;
+	Window *root = SceneTree::get_singleton()->get_root();
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_tile_set(create_benchmark_tile_set());
+	root->add_child(layer);
+
+	// Each run changes every cell, so the whole map is rebuilt.
+	int run = 0;
+	BENCHMARK_REPORT(vformat("Fill %dx%d cells", map_size, map_size), TestBenchmark::measure_usec([&]() {
+		for (int y = 0; y < map_size; y++) {
+			for (int x = 0; x < map_size; x++) {
+				layer->set_cell(Vector2i(x, y), 0, Vector2i((x * 7 + y + run) % 4, (x + y * 3) % 4));
+			}
+		}
+		layer->update_internals();
+		run++;
+	}));
+
+	RandomPCG rng(42);
+	BENCHMARK_REPORT("Change 1000 scattered cells", TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < 1000; i++) {
+			layer->set_cell(Vector2i(rng.rand() % map_size, rng.rand() % map_size), 0, Vector2i(rng.rand() % 4, rng.rand() % 4));
+		}
+		layer->update_internals();
+	}));
+
+	BENCHMARK_REPORT("Rebuild after changing the rendering quadrant size", TestBenchmark::measure_usec([&]() {
+		layer->set_rendering_quadrant_size(layer->get_rendering_quadrant_size() == 16 ? 32 : 16);
+		layer->update_internals();
+	}));
+
+	root->remove_child(layer);
+	memdelete(layer);
+}
+
+BENCHMARK_CASE("[Benchmark][SceneTree][TileMapLayer] Solid terrain collision") {
+	const int map_size = 256;
+	const Ref<TileSet> tile_set = create_benchmark_tile_set(true);
+	PhysicsServer2D *ps = PhysicsServer2D::get_singleton();
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	for (const bool merged : { false, true }) {
+		const String mode = merged ? "merged shapes" : "one body per tile";
+		TileMapLayer *layer = memnew(TileMapLayer);
+		layer->set_tile_set(tile_set);
+		layer->set_collision_shapes_merged(merged);
+		root->add_child(layer);
+
+		// Each run changes every cell, so all the collision is rebuilt.
+		int run = 0;
+		BENCHMARK_REPORT(vformat("Fill %dx%d solid cells (%s)", map_size, map_size, mode), TestBenchmark::measure_usec([&]() {
+			for (int y = 0; y < map_size; y++) {
+				for (int x = 0; x < map_size; x++) {
+					layer->set_cell(Vector2i(x, y), 0, Vector2i(run % 4, 0));
+				}
+			}
+			layer->update_internals();
+			run++;
+		}));
+
+		// Boxes falling on the terrain, most of them resting on it by the end.
+		RID box_shape = ps->rectangle_shape_create();
+		ps->shape_set_data(box_shape, Vector2(5, 5));
+		LocalVector<RID> bodies;
+		for (int i = 0; i < 500; i++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+			ps->body_add_shape(body, box_shape);
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2((i % 100) * 40 + 20, -20 - (i / 100) * 12)));
+			ps->body_set_space(body, layer->get_world_2d()->get_space());
+			bodies.push_back(body);
+		}
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < 120; i++) {
+			ps->step(1.0 / 60.0);
+		}
+		BENCHMARK_REPORT(vformat("120 physics steps with 500 boxes (%s)", mode), OS::get_singleton()->get_ticks_usec() - begin);
+
+		for (const RID &body : bodies) {
+			ps->free(body);
+		}
+		ps->free(box_shape);
+		root->remove_child(layer);
+		memdelete(layer);
+	}
+}
+
+// Particles with every lifetime curve set, so each of them samples a lot per frame.
+template <typename T>
+static void setup_benchmark_particles(T *p_particles, int p_amount) {
+	Ref<Curve> curve;
+	curve.instantiate();
+	curve->add_point(Vector2(0, 0.5));
+	curve->add_point(Vector2(0.5, 1));
+	curve->add_point(Vector2(1, 0));
+	for (int i = 0; i < T::PARAM_MAX; i++) {
+		p_particles->set_param_curve(typename T::Parameter(i), curve);
+		p_particles->set_param_max(typename T::Parameter(i), 1.0);
+	}
+
+	Ref<Gradient> gradient;
+	gradient.instantiate();
+	gradient->add_point(0.5, Color(1, 0, 0));
+	p_particles->set_color_ramp(gradient);
+
+	p_particles->set_amount(p_amount);
+	p_particles->set_lifetime(2.0);
+	p_particles->set_emitting(true);
+}
+
+// Runs the emitter for 60 frames with processing forced on one thread, then on worker
+// threads, and prints the throughput of both to check the threading threshold against.
+template <typename T>
+static void benchmark_particles_threading(const String &p_class, int p_amount) {
+	Window *root = SceneTree::get_singleton()->get_root();
+	const int default_threshold = T::threading_threshold;
+	double particles_per_msec[2] = {};
+
+	for (const bool threaded : { false, true }) {
+		T::threading_threshold = threaded ? 0 : INT_MAX;
+		T *particles = memnew(T);
+		setup_benchmark_particles(particles, p_amount);
+		root->add_child(particles);
+		const uint64_t usec = TestBenchmark::measure_usec([&]() {
+			for (int i = 0; i < 60; i++) {
+				SceneTree::get_singleton()->process(1.0 / 60.0);
+			}
+		});
+		BENCHMARK_REPORT(vformat("%s 60 frames with %d particles (%s)", p_class, p_amount, threaded ? "threaded" : "single-threaded"), usec);
+		particles_per_msec[threaded] = p_amount * 60 * 1000.0 / MAX(usec, uint64_t(1));
+		root->remove_child(particles);
+		memdelete(particles);
+	}
+	T::threading_threshold = default_threshold;
+
+	// The threshold is worth lowering if threading wins below it, or raising if it loses above it.
+	print_line(vformat("%s with %d particles: %d particles/ms single-threaded, %d particles/ms threaded (%.2fx, threshold is %d).",
+			p_class, p_amount, int64_t(particles_per_msec[0]), int64_t(particles_per_msec[1]), particles_per_msec[1] / MAX(particles_per_msec[0], 1.0), default_threshold));
+}
+
+BENCHMARK_CASE("[Benchmark][SceneTree][CPUParticles] Simulation") {
+	// Amounts around the threading threshold, and a large emitter.
+	for (const int amount : { 1024, 2048, 4096, 8192, 100000 }) {
+		benchmark_particles_threading<CPUParticles2D>("CPUParticles2D", amount);
+#ifndef _3D_DISABLED
+		benchmark_particles_threading<CPUParticles3D>("CPUParticles3D", amount);
+#endif // _3D_DISABLED
+	}
+}
+
+} // namespace BenchmarkScene
+
+#endif // BENCHMARK_SCENE_H
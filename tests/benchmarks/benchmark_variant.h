@@ -0,0 +1,173 @@
+/**************************************************************************/
+/*  benchmark_variant.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_VARIANT_H
+#define BENCHMARK_VARIANT_H
+
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_benchmark.h"
+
+namespace BenchmarkVariant {
+
+BENCHMARK_CASE("[Benchmark][Variant] Operators") {
+	const int count = 1000000;
+	const Variant values[][2] = {
+		{ 3, 4 },
+		{ 3.5, 4.25 },
+		{ Vector3(1, 2, 3), Vector3(4, 5, 6) },
+		{ String("abc"), String("def") },
+	};
+	const char *type_names[] = { "int", "float", "Vector3", "String" };
+
+	for (int i = 0; i < 4; i++) {
+		const Variant &a = values[i][0];
+		const Variant &b = values[i][1];
+		BENCHMARK_REPORT(vformat("1M %s additions", type_names[i]), TestBenchmark::measure_usec([&]() {
+			Variant ret;
+			bool valid = false;
+			for (int j = 0; j < count; j++) {
+				Variant::evaluate(Variant::OP_ADD, a, b, ret, valid);
+			}
+			CHECK(valid);
+		}));
+
+		const Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::OP_ADD, a.get_type(), b.get_type());
+		BENCHMARK_REPORT(vformat("1M validated %s additions", type_names[i]), TestBenchmark::measure_usec([&]() {
+			Variant ret;
+			for (int j = 0; j < count; j++) {
+				evaluator(&a, &b, &ret);
+			}
+			CHECK(ret.get_type() == a.get_type());
+		}));
+	}
+
+	BENCHMARK_REPORT("1M int comparisons", TestBenchmark::measure_usec([&]() {
+		Variant ret;
+		bool valid = false;
+		const Variant limit = count / 2;
+		int64_t less = 0;
+		for (int j = 0; j < count; j++) {
+			Variant::evaluate(Variant::OP_LESS, j, limit, ret, valid);
+			less += ret.operator bool();
+		}
+		CHECK(less == count / 2);
+	}));
+}
+
+BENCHMARK_CASE("[Benchmark][Variant] Calls and conversions") {
+	const int count = 1000000;
+
+	const Variant string = "The quick brown fox";
+	const StringName length_method = "length";
+	BENCHMARK_REPORT("1M String.length() calls", TestBenchmark::measure_usec([&]() {
+		Variant base = string;
+		Variant ret;
+		Callable::CallError error;
+		for (int j = 0; j < count; j++) {
+			base.callp(length_method, nullptr, 0, ret, error);
+		}
+		CHECK(error.error == Callable::CallError::CALL_OK);
+	}));
+
+	BENCHMARK_REPORT("1M Vector2 constructions", TestBenchmark::measure_usec([&]() {
+		const Variant x = 1.5;
+		const Variant y = 2.5;
+		const Variant *args[2] = { &x, &y };
+		Variant ret;
+		Callable::CallError error;
+		for (int j = 0; j < count; j++) {
+			Variant::construct(Variant::VECTOR2, ret, args, 2, error);
+		}
+		CHECK(error.error == Callable::CallError::CALL_OK);
+	}));
+
+	BENCHMARK_REPORT("1M int to String conversions", TestBenchmark::measure_usec([&]() {
+		int64_t length = 0;
+		for (int j = 0; j < count; j++) {
+			length += Variant(j).operator String().length();
+		}
+		CHECK(length > 0);
+	}));
+
+	BENCHMARK_REPORT("1M Variant copies of a Dictionary", TestBenchmark::measure_usec([&]() {
+		const Variant dictionary = Dictionary();
+		for (int j = 0; j < count; j++) {
+			Variant copy = dictionary;
+		}
+	}));
+}
+
+BENCHMARK_CASE("[Benchmark][Variant] Array and Dictionary") {
+	const int count = 100000;
+
+	BENCHMARK_REPORT("Array append and index", TestBenchmark::measure_usec([&]() {
+		Array array;
+		for (int j = 0; j < count; j++) {
+			array.push_back(j);
+		}
+		int64_t sum = 0;
+		for (int j = 0; j < count; j++) {
+			sum += int64_t(array[j]);
+		}
+		CHECK(sum == int64_t(count) * (count - 1) / 2);
+	}));
+
+	BENCHMARK_REPORT("Array sort", TestBenchmark::measure_usec([&]() {
+		Array array;
+		for (int j = 0; j < count; j++) {
+			array.push_back((j * 7919) % count);
+		}
+		array.sort();
+		CHECK(int(array[0]) == 0);
+	}));
+
+	LocalVector<Variant> keys;
+	for (int j = 0; j < count; j++) {
+		keys.push_back(vformat("key_%d", j));
+	}
+	BENCHMARK_REPORT("Dictionary set and get with String keys", TestBenchmark::measure_usec([&]() {
+		Dictionary dictionary;
+		for (int j = 0; j < count; j++) {
+			dictionary[keys[j]] = j;
+		}
+		int64_t sum = 0;
+		for (int j = 0; j < count; j++) {
+			sum += int64_t(dictionary[keys[j]]);
+		}
+		CHECK(sum == int64_t(count) * (count - 1) / 2);
+	}));
+}
+
+} // namespace BenchmarkVariant
+
+#endif // BENCHMARK_VARIANT_H
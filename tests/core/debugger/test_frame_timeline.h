@@ -0,0 +1,113 @@
+/**************************************************************************/
+/*  test_frame_timeline.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FRAME_TIMELINE_H
+#define TEST_FRAME_TIMELINE_H
+
+#include "core/debugger/frame_timeline.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameTimeline {
+
+#ifdef THREADS_ENABLED
+static void record_thread_zones(void *p_userdata) {
+	FrameTimeline::set_thread_name("Timeline test thread");
+	for (int i = 0; i < 3; i++) {
+		FRAME_TIMELINE_ZONE("Timeline test thread zone");
+	}
+}
+#endif
+
+static Dictionary count_zones(const Array &p_events, const String &p_thread_name = String()) {
+	int64_t thread_id = -1;
+	for (int i = 0; i < p_events.size(); i++) {
+		const Dictionary event = p_events[i];
+		if (event["ph"] == "M" && Dictionary(event["args"])["name"] == p_thread_name) {
+			thread_id = event["tid"];
+		}
+	}
+	Dictionary counts;
+	for (int i = 0; i < p_events.size(); i++) {
+		const Dictionary event = p_events[i];
+		if (event["ph"] != "X" || (!p_thread_name.is_empty() && int64_t(event["tid"]) != thread_id)) {
+			continue;
+		}
+		CHECK(int64_t(event["dur"]) >= 0);
+		counts[event["name"]] = int(counts.get(event["name"], 0)) + 1;
+	}
+	return counts;
+}
+
+TEST_CASE("[FrameTimeline] Zones are only recorded while enabled") {
+	{
+		FRAME_TIMELINE_ZONE("Timeline test disabled zone");
+	}
+
+	FrameTimeline::start();
+	CHECK(FrameTimeline::is_enabled());
+	{
+		FRAME_TIMELINE_ZONE("Timeline test outer zone");
+		FRAME_TIMELINE_ZONE_NAMED(inner, "Timeline test inner zone");
+	}
+#ifdef THREADS_ENABLED
+	Thread thread;
+	thread.start(record_thread_zones, nullptr);
+	thread.wait_to_finish();
+#endif
+
+	const String path = OS::get_singleton()->get_cache_path().path_join("frame_timeline_test.json");
+	REQUIRE(FrameTimeline::save_trace(path) == OK);
+	FrameTimeline::finish();
+	CHECK_FALSE(FrameTimeline::is_enabled());
+
+	JSON json;
+	REQUIRE(json.parse(FileAccess::get_file_as_string(path)) == OK);
+	const Array events = Dictionary(json.get_data())["traceEvents"];
+
+	const Dictionary counts = count_zones(events);
+	CHECK_FALSE(counts.has("Timeline test disabled zone"));
+	CHECK(int(counts.get("Timeline test outer zone", 0)) >= 1);
+	CHECK(int(counts.get("Timeline test inner zone", 0)) >= 1);
+
+#ifdef THREADS_ENABLED
+	const Dictionary thread_counts = count_zones(events, "Timeline test thread");
+	CHECK(int(thread_counts.get("Timeline test thread zone", 0)) == 3);
+	CHECK_FALSE(thread_counts.has("Timeline test outer zone"));
+#endif
+}
+
+} // namespace TestFrameTimeline
+
+#endif // TEST_FRAME_TIMELINE_H
@@ -432,6 +432,78 @@ TEST_CASE("[Image] Convert image") {
 	CHECK_MESSAGE(image2->get_data() == image_data, "Image conversion to invalid type (Image::FORMAT_MAX + 1) should not alter image.");
 }
 
+TEST_CASE("[Image] Processing large images") {
+	// Large enough to be split in row blocks across worker threads.
+	const int size = 512;
+	Ref<Image> image = memnew(Image(size, size, false, Image::FORMAT_RGBA8));
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			// 2x2 blocks of the same color, so that mipmaps and nearest downscaling are exact.
+			image->set_pixel(x, y, Color(((x / 2) % 256) / 255.0f, ((y / 2) % 256) / 255.0f, (((x / 2) + (y / 2)) % 256) / 255.0f));
+		}
+	}
+
+	SUBCASE("Converting keeps every row") {
+		Ref<Image> converted = image->duplicate();
+		converted->convert(Image::FORMAT_RGB8);
+		converted->convert(Image::FORMAT_RGBA8);
+		CHECK_MESSAGE(converted->get_data() == image->get_data(), "RGBA8 to RGB8 and back should preserve opaque images.");
+	}
+
+	SUBCASE("Mipmaps are computed for every row") {
+		Ref<Image> mipmapped = image->duplicate();
+		mipmapped->generate_mipmaps();
+		Ref<Image> level = Image::create_from_data(size / 2, size / 2, false, Image::FORMAT_RGBA8, mipmapped->get_data().slice(mipmapped->get_mipmap_offset(1), mipmapped->get_mipmap_offset(2)));
+		bool all_equal = true;
+		for (int y = 0; y < size / 2 && all_equal; y++) {
+			for (int x = 0; x < size / 2; x++) {
+				if (level->get_pixel(x, y) != image->get_pixel(x * 2, y * 2)) {
+					all_equal = false;
+					break;
+				}
+			}
+		}
+		CHECK_MESSAGE(all_equal, "The first mipmap should average each 2x2 block of the source image.");
+	}
+
+	SUBCASE("Resizing processes every row") {
+		Ref<Image> nearest = image->duplicate();
+		nearest->resize(size / 2, size / 2, Image::INTERPOLATE_NEAREST);
+		bool all_equal = true;
+		for (int y = 0; y < size / 2 && all_equal; y++) {
+			for (int x = 0; x < size / 2; x++) {
+				if (nearest->get_pixel(x, y) != image->get_pixel(x * 2, y * 2)) {
+					all_equal = false;
+					break;
+				}
+			}
+		}
+		CHECK_MESSAGE(all_equal, "Nearest downscaling should pick the matching source pixel.");
+
+		Ref<Image> solid = memnew(Image(size, size, false, Image::FORMAT_RGBA8));
+		const Color solid_color = Color(40 / 255.0f, 80 / 255.0f, 120 / 255.0f);
+		solid->fill(solid_color);
+		for (int interpolation = Image::INTERPOLATE_BILINEAR; interpolation <= Image::INTERPOLATE_LANCZOS; interpolation++) {
+			Ref<Image> resized = solid->duplicate();
+			resized->resize(size + 100, size - 100, (Image::Interpolation)interpolation);
+			CHECK(resized->get_width() == size + 100);
+			CHECK(resized->get_height() == size - 100);
+			bool uniform = true;
+			for (int y = 0; y < resized->get_height() && uniform; y++) {
+				for (int x = 0; x < resized->get_width(); x++) {
+					const Color diff = resized->get_pixel(x, y) - solid_color;
+					// Allow one step of rounding error from the filter weights.
+					if (MAX(MAX(Math::abs(diff.r), Math::abs(diff.g)), MAX(Math::abs(diff.b), Math::abs(diff.a))) > 1.5f / 255.0f) {
+						uniform = false;
+						break;
+					}
+				}
+			}
+			CHECK_MESSAGE(uniform, vformat("Resizing a solid image with interpolation %d should keep it solid.", interpolation));
+		}
+	}
+}
+
 } // namespace TestImage
 
 #endif // TEST_IMAGE_H
@@ -31,7 +31,10 @@
 #ifndef TEST_JSON_H
 #define TEST_JSON_H
 
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "core/io/json.h"
+#include "core/os/os.h"
 
 #include "thirdparty/doctest/doctest.h"
 
@@ -232,6 +235,92 @@ TEST_CASE("[JSON] Parsing escape sequences") {
 		ERR_PRINT_ON
 	}
 }
+
+TEST_CASE("[JSON] Parsing UTF-8 buffers") {
+	const String source = String::utf8(R"({"name": "Godot \u00c9ngine ✓", "is_free": true, "bugs": null, "apples": {"red": 500, "green": 0, "blue": -20.5e1},
+"list": [1, "two", [3.5, 4], {}, [], [false]], "emoji": "\ud83d\ude00"})");
+
+	JSON json;
+	CHECK(json.parse(source) == OK);
+	const Variant expected = json.get_data();
+
+	JSON json_utf8;
+	CHECK_MESSAGE(
+			json_utf8.parse_utf8(source.to_utf8_buffer()) == OK,
+			"Parsing a UTF-8 buffer should parse successfully.");
+	CHECK_MESSAGE(
+			json_utf8.get_data() == expected,
+			"Parsing a UTF-8 buffer should return the same data as parsing a String.");
+	CHECK(String(Dictionary(json_utf8.get_data())["emoji"]) == String::chr(0x1f600));
+
+	// Byte order mark.
+	PackedByteArray with_bom = source.to_utf8_buffer();
+	with_bom.insert(0, 0xbf);
+	with_bom.insert(0, 0xbb);
+	with_bom.insert(0, 0xef);
+	CHECK(json_utf8.parse_utf8(with_bom) == OK);
+	CHECK(json_utf8.get_data() == expected);
+
+	CHECK_MESSAGE(
+			json_utf8.parse_utf8(String("[1, 2,\n 3").to_utf8_buffer()) == ERR_PARSE_ERROR,
+			"Parsing an unterminated array should fail.");
+	CHECK(json_utf8.get_error_line() == 1);
+	CHECK(json_utf8.get_data() == Variant());
+	CHECK(json_utf8.parse_utf8(String("{\"a\" 1}").to_utf8_buffer()) == ERR_PARSE_ERROR);
+	CHECK(json_utf8.parse_utf8(String("[nope]").to_utf8_buffer()) == ERR_PARSE_ERROR);
+	CHECK(json_utf8.parse_utf8(String("\"unterminated").to_utf8_buffer()) == ERR_PARSE_ERROR);
+	CHECK(json_utf8.parse_utf8(String("1 2").to_utf8_buffer()) == ERR_PARSE_ERROR);
+	CHECK(json_utf8.parse_utf8(PackedByteArray()) == ERR_PARSE_ERROR);
+
+	// Same leniency as `parse()`.
+	CHECK(json_utf8.parse_utf8(String("[1, 2,]").to_utf8_buffer()) == OK);
+	CHECK(Array(json_utf8.get_data()).size() == 2);
+}
+
+TEST_CASE("[JSON] Parsing UTF-8 buffers into packed arrays") {
+	JSON json;
+	CHECK(json.parse_utf8(String(R"({"numbers": [1, 2.5, -3], "names": ["a", "b"], "mixed": [1, "a"], "empty": []})").to_utf8_buffer(), true) == OK);
+	const Dictionary data = json.get_data();
+
+	CHECK(data["numbers"].get_type() == Variant::PACKED_FLOAT64_ARRAY);
+	CHECK(PackedFloat64Array(data["numbers"]) == PackedFloat64Array({ 1, 2.5, -3 }));
+	CHECK(data["names"].get_type() == Variant::PACKED_STRING_ARRAY);
+	CHECK(PackedStringArray(data["names"]) == PackedStringArray({ "a", "b" }));
+	CHECK_MESSAGE(
+			data["mixed"].get_type() == Variant::ARRAY,
+			"Arrays with mixed types should stay generic arrays.");
+	CHECK(Array(data["mixed"]) == Array(json.parse_string(R"([1, "a"])")));
+	CHECK(data["empty"].get_type() == Variant::ARRAY);
+}
+
+TEST_CASE("[JSON] Parsing files") {
+	// Larger than the read chunk size, so strings and numbers span chunk boundaries.
+	String source = "[";
+	for (int i = 0; i < 20000; i++) {
+		source += vformat(R"({"id": %d, "name": "item \u00e9 %d", "value": %f},)", i, i, i * 0.25);
+	}
+	source += "0]";
+
+	const String path = OS::get_singleton()->get_cache_path().path_join("test_json_parse_file.json");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(source);
+	}
+
+	JSON json;
+	CHECK(json.parse(source) == OK);
+	JSON json_file;
+	CHECK_MESSAGE(
+			json_file.parse_file(path) == OK,
+			"Parsing a JSON file should parse successfully.");
+	CHECK_MESSAGE(
+			json_file.get_data() == json.get_data(),
+			"Parsing a JSON file should return the same data as parsing its text.");
+
+	DirAccess::remove_absolute(path);
+}
+
 } // namespace TestJSON
 
 #endif // TEST_JSON_H
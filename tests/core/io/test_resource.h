@@ -166,6 +166,53 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+TEST_CASE("[Resource] Loading binary resources with sub-threads") {
+	// Enough sub-resources to be decoded by several threads, referring to each other.
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Root");
+	Array children;
+	Ref<Resource> previous;
+	for (int i = 0; i < 32; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		PackedVector3Array points;
+		for (int j = 0; j < 256; j++) {
+			points.push_back(Vector3(i, j, i * j));
+		}
+		child->set_meta("points", points);
+		if (previous.is_valid()) {
+			child->set_meta("previous", previous);
+		}
+		children.push_back(child);
+		previous = child;
+	}
+	resource->set_meta("children", children);
+
+	const String save_path = OS::get_singleton()->get_cache_path().path_join("resource_sub_threads.res");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+
+	REQUIRE(ResourceLoader::load_threaded_request(save_path, "", true, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+	Error err = OK;
+	const Ref<Resource> loaded_resource = ResourceLoader::load_threaded_get(save_path, &err);
+	REQUIRE(err == OK);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(loaded_resource->get_name() == "Root");
+
+	const Array loaded_children = loaded_resource->get_meta("children");
+	REQUIRE(loaded_children.size() == 32);
+	for (int i = 0; i < 32; i++) {
+		const Ref<Resource> child = loaded_children[i];
+		REQUIRE(child.is_valid());
+		CHECK(child->get_name() == vformat("Child %d", i));
+		const PackedVector3Array points = child->get_meta("points");
+		CHECK(points.size() == 256);
+		CHECK(points[255] == Vector3(i, 255, i * 255));
+		if (i > 0) {
+			CHECK(Ref<Resource>(child->get_meta("previous")) == Ref<Resource>(loaded_children[i - 1]));
+		}
+	}
+}
+
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
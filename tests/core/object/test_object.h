@@ -34,7 +34,11 @@
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 
 // Declared in global namespace because of GDCLASS macro warning (Windows):
@@ -189,6 +193,111 @@ TEST_CASE("[Object] Construction") {
 			"The database pointer returned by the object id should reference same object.");
 }
 
+TEST_CASE("[Object] ObjectDB stale IDs") {
+	Object *object = memnew(Object);
+	const ObjectID id = object->get_instance_id();
+	memdelete(object);
+	CHECK_MESSAGE(
+			ObjectDB::get_instance(id) == nullptr,
+			"The ID of a freed object should not resolve.");
+
+	// The freed slot is reused, but with a different validator.
+	object = memnew(Object);
+	CHECK(object->get_instance_id() != id);
+	CHECK(ObjectDB::get_instance(id) == nullptr);
+	CHECK(ObjectDB::get_instance(object->get_instance_id()) == object);
+	memdelete(object);
+}
+
+#ifdef THREADS_ENABLED
+struct ObjectDBLookupData {
+	LocalVector<ObjectID> ids;
+	LocalVector<Object *> objects;
+	SafeFlag done;
+	uint64_t lookups = 0;
+	bool valid = true;
+	uint64_t time = 0;
+};
+
+static void lookup_objects(void *p_data) {
+	ObjectDBLookupData &data = *static_cast<ObjectDBLookupData *>(p_data);
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	while (!data.done.is_set()) {
+		for (uint32_t i = 0; i < data.ids.size(); i++) {
+			Object *object = ObjectDB::get_instance(data.ids[i]);
+			data.valid = data.valid && (object == nullptr || object == data.objects[i]);
+		}
+		data.lookups += data.ids.size();
+	}
+	data.time = OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+TEST_CASE("[Object] ObjectDB lookups while objects are freed on another thread") {
+	ObjectDBLookupData data;
+	for (int i = 0; i < 1000; i++) {
+		Object *object = memnew(Object);
+		data.ids.push_back(object->get_instance_id());
+		data.objects.push_back(object);
+	}
+
+	Thread thread;
+	thread.start(lookup_objects, &data);
+	// Freed slots are reused right away, so stale IDs point to live objects.
+	LocalVector<Object *> others;
+	for (uint32_t i = 0; i < data.objects.size(); i++) {
+		memdelete(data.objects[i]);
+		others.push_back(memnew(Object));
+	}
+	data.done.set();
+	thread.wait_to_finish();
+
+	CHECK(data.valid);
+	for (uint32_t i = 0; i < data.ids.size(); i++) {
+		CHECK(ObjectDB::get_instance(data.ids[i]) == nullptr);
+	}
+	for (Object *object : others) {
+		memdelete(object);
+	}
+}
+
+// Lookups from several threads while objects are being created and freed. Run with `--test --benchmark`.
+BENCHMARK_CASE("[Benchmark][Object] ObjectDB lookup contention") {
+	LocalVector<Object *> objects;
+	LocalVector<ObjectID> ids;
+	for (int i = 0; i < 10000; i++) {
+		objects.push_back(memnew(Object));
+		ids.push_back(objects[i]->get_instance_id());
+	}
+
+	const int max_threads = 8;
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		ObjectDBLookupData data[max_threads];
+		Thread threads[max_threads];
+		for (int i = 0; i < thread_count; i++) {
+			data[i].ids = ids;
+			data[i].objects = objects;
+			threads[i].start(lookup_objects, &data[i]);
+		}
+		for (int i = 0; i < 100000; i++) {
+			memdelete(memnew(Object));
+		}
+		uint64_t lookups = 0;
+		uint64_t time = 0;
+		for (int i = 0; i < thread_count; i++) {
+			data[i].done.set();
+			threads[i].wait_to_finish();
+			lookups += data[i].lookups;
+			time = MAX(time, data[i].time);
+		}
+		BENCHMARK_REPORT(vformat("1M lookups with %d threads", thread_count), uint64_t(time * 1000000.0 / MAX(lookups, 1u)));
+	}
+
+	for (Object *object : objects) {
+		memdelete(object);
+	}
+}
+#endif // THREADS_ENABLED
+
 TEST_CASE("[Object] Script instance property setter") {
 	Object object;
 	_MockScriptInstance *script_instance = memnew(_MockScriptInstance);
@@ -431,6 +540,139 @@ TEST_CASE("[Object] Signals") {
 	}
 }
 
+class _SignalListener : public Object {
+public:
+	int calls = 0;
+	Object *emitter = nullptr;
+	_SignalListener *other = nullptr;
+
+	void count() {
+		calls++;
+	}
+	void disconnect_other() {
+		calls++;
+		emitter->disconnect("counted", callable_mp(other, &_SignalListener::count));
+	}
+	void connect_other() {
+		calls++;
+		if (!emitter->is_connected("counted", callable_mp(other, &_SignalListener::count))) {
+			emitter->connect("counted", callable_mp(other, &_SignalListener::count));
+		}
+	}
+};
+
+TEST_CASE("[Object] Changing connections while emitting") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("counted"));
+	_SignalListener first;
+	_SignalListener second;
+	first.emitter = &emitter;
+	first.other = &second;
+
+	SUBCASE("Disconnected listeners are still called by the current emission") {
+		emitter.connect("counted", callable_mp(&first, &_SignalListener::disconnect_other));
+		emitter.connect("counted", callable_mp(&second, &_SignalListener::count));
+		emitter.emit_signal("counted");
+		CHECK(first.calls == 1);
+		CHECK(second.calls == 1);
+		emitter.emit_signal("counted");
+		CHECK(first.calls == 2);
+		CHECK(second.calls == 1);
+	}
+
+	SUBCASE("Connected listeners are called by the next emission") {
+		emitter.connect("counted", callable_mp(&first, &_SignalListener::connect_other));
+		emitter.emit_signal("counted");
+		CHECK(first.calls == 1);
+		CHECK(second.calls == 0);
+		emitter.emit_signal("counted");
+		CHECK(first.calls == 2);
+		CHECK(second.calls == 1);
+	}
+
+	SUBCASE("One-shot connections") {
+		emitter.connect("counted", callable_mp(&first, &_SignalListener::count), Object::CONNECT_ONE_SHOT);
+		emitter.connect("counted", callable_mp(&second, &_SignalListener::count));
+		emitter.emit_signal("counted");
+		emitter.emit_signal("counted");
+		CHECK(first.calls == 1);
+		CHECK(second.calls == 2);
+		CHECK_FALSE(emitter.is_connected("counted", callable_mp(&first, &_SignalListener::count)));
+	}
+}
+
+TEST_CASE("[Object] Emitting with a signal handle") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("counted"));
+	Object::SignalHandle handle("counted");
+	_SignalListener listener;
+
+	CHECK(emitter.emit_signal(handle) == OK);
+
+	emitter.connect("counted", callable_mp(&listener, &_SignalListener::count));
+	emitter.emit_signal(handle);
+	emitter.emit_signal(handle);
+	CHECK(listener.calls == 2);
+
+	// Adding signals may move the connections of the others.
+	for (int i = 0; i < 20; i++) {
+		emitter.add_user_signal(MethodInfo(vformat("other_%d", i)));
+	}
+	emitter.emit_signal(handle);
+	CHECK(listener.calls == 3);
+
+	emitter.disconnect("counted", callable_mp(&listener, &_SignalListener::count));
+	emitter.emit_signal(handle);
+	CHECK(listener.calls == 3);
+
+	// The handle can be used with other objects too.
+	Object other_emitter;
+	other_emitter.add_user_signal(MethodInfo("counted"));
+	other_emitter.connect("counted", callable_mp(&listener, &_SignalListener::count));
+	other_emitter.emit_signal(handle);
+	CHECK(listener.calls == 4);
+
+	Object::SignalHandle nonexistent("nonexistent");
+	ERR_PRINT_OFF;
+	CHECK(emitter.emit_signal(nonexistent) == ERR_UNAVAILABLE);
+	ERR_PRINT_ON;
+}
+
+// Emissions with different amounts of listeners. Run with `--test --benchmark`.
+BENCHMARK_CASE("[Benchmark][Object] Signal emission") {
+	const int emissions = 1000000;
+	const int listener_counts[] = { 0, 1, 16 };
+	for (int listener_count : listener_counts) {
+		Object emitter;
+		emitter.add_user_signal(MethodInfo("counted"));
+		LocalVector<_SignalListener *> listeners;
+		for (int i = 0; i < listener_count; i++) {
+			listeners.push_back(memnew(_SignalListener));
+			emitter.connect("counted", callable_mp(listeners[i], &_SignalListener::count));
+		}
+
+		const StringName name = "counted";
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < emissions; i++) {
+			emitter.emit_signal(name, i);
+		}
+		const uint64_t by_name = OS::get_singleton()->get_ticks_usec() - begin;
+
+		Object::SignalHandle handle(name);
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < emissions; i++) {
+			emitter.emit_signal(handle, i);
+		}
+		const uint64_t by_handle = OS::get_singleton()->get_ticks_usec() - begin;
+
+		BENCHMARK_REPORT(vformat("1M emissions by name with %d listeners", listener_count), by_name);
+		BENCHMARK_REPORT(vformat("1M emissions with a handle with %d listeners", listener_count), by_handle);
+		for (_SignalListener *listener : listeners) {
+			memdelete(listener);
+		}
+	}
+}
+
 class NotificationObject1 : public Object {
 	GDCLASS(NotificationObject1, Object);
 
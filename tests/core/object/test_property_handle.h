@@ -0,0 +1,173 @@
+/**************************************************************************/
+/*  test_property_handle.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PROPERTY_HANDLE_H
+#define TEST_PROPERTY_HANDLE_H
+
+#include "core/object/class_db.h"
+#include "core/object/property_handle.h"
+#include "core/os/os.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+// Declared in global namespace because of GDCLASS macro warning (Windows):
+// "Unqualified friend declaration referring to type outside of the nearest enclosing namespace
+// is a Microsoft extension; add a nested name specifier".
+class _TestPropertyHandleObject : public Object {
+	GDCLASS(_TestPropertyHandleObject, Object);
+	int value = 0;
+	Vector2 offset;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_value", "value"), &_TestPropertyHandleObject::set_value);
+		ClassDB::bind_method(D_METHOD("get_value"), &_TestPropertyHandleObject::get_value);
+		ClassDB::bind_method(D_METHOD("set_offset", "offset"), &_TestPropertyHandleObject::set_offset);
+		ClassDB::bind_method(D_METHOD("get_offset"), &_TestPropertyHandleObject::get_offset);
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "value"), "set_value", "get_value");
+		ADD_PROPERTY(PropertyInfo(Variant::VECTOR2, "offset"), "set_offset", "get_offset");
+	}
+
+public:
+	void set_value(int p_value) { value = p_value; }
+	int get_value() const { return value; }
+	void set_offset(const Vector2 &p_offset) { offset = p_offset; }
+	Vector2 get_offset() const { return offset; }
+};
+
+namespace TestPropertyHandle {
+
+TEST_CASE("[PropertyHandle] Native properties are accessed directly") {
+	GDREGISTER_CLASS(_TestPropertyHandleObject);
+	_TestPropertyHandleObject object;
+	PropertyHandle handle("value");
+
+	bool valid = false;
+	handle.set(&object, 42, &valid);
+	CHECK(valid);
+	CHECK(handle.is_direct());
+	CHECK(object.get_value() == 42);
+	CHECK(int(handle.get(&object, &valid)) == 42);
+	CHECK(valid);
+}
+
+TEST_CASE("[PropertyHandle] Subnames") {
+	GDREGISTER_CLASS(_TestPropertyHandleObject);
+	_TestPropertyHandleObject object;
+	object.set_offset(Vector2(1, 2));
+
+	Vector<StringName> path;
+	path.push_back("offset");
+	path.push_back("y");
+	PropertyHandle handle(path);
+
+	bool valid = false;
+	handle.set(&object, 5.0, &valid);
+	CHECK(valid);
+	CHECK(object.get_offset() == Vector2(1, 5));
+	CHECK(double(handle.get(&object)) == doctest::Approx(5.0));
+
+	path.write[1] = "nonexistent";
+	handle.set_path(path);
+	handle.set(&object, 5.0, &valid);
+	CHECK_FALSE(valid);
+	handle.get(&object, &valid);
+	CHECK_FALSE(valid);
+}
+
+TEST_CASE("[PropertyHandle] Falls back to access by name") {
+	GDREGISTER_CLASS(_TestPropertyHandleObject);
+	_TestPropertyHandleObject object;
+	object.set_meta("extra", 1);
+	PropertyHandle handle("metadata/extra");
+
+	bool valid = false;
+	handle.set(&object, 2, &valid);
+	CHECK(valid);
+	CHECK_FALSE(handle.is_direct());
+	CHECK(int(object.get_meta("extra")) == 2);
+	CHECK(int(handle.get(&object)) == 2);
+
+	PropertyHandle nonexistent("nonexistent");
+	nonexistent.get(&object, &valid);
+	CHECK_FALSE(valid);
+}
+
+TEST_CASE("[PropertyHandle] Resolved again for other objects") {
+	GDREGISTER_CLASS(_TestPropertyHandleObject);
+	_TestPropertyHandleObject first;
+	PropertyHandle handle("value");
+	handle.set(&first, 1);
+	CHECK(handle.is_direct());
+
+	// Doesn't have the property, so the setter of the first object must not be called.
+	Object other;
+	bool valid = true;
+	handle.set(&other, 2, &valid);
+	CHECK_FALSE(valid);
+	CHECK_FALSE(handle.is_direct());
+
+	_TestPropertyHandleObject second;
+	handle.set(&second, 3);
+	CHECK(handle.is_direct());
+	CHECK(first.get_value() == 1);
+	CHECK(second.get_value() == 3);
+}
+
+// Writes through a handle against Object::set_indexed(). Run with `--test --benchmark`.
+BENCHMARK_CASE("[Benchmark][PropertyHandle] Against access by name") {
+	GDREGISTER_CLASS(_TestPropertyHandleObject);
+	_TestPropertyHandleObject object;
+	Vector<StringName> path;
+	path.push_back("offset");
+	path.push_back("x");
+	const int writes = 1000000;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < writes; i++) {
+		object.set_indexed(path, i);
+	}
+	const uint64_t by_name = OS::get_singleton()->get_ticks_usec() - begin;
+
+	PropertyHandle handle(path);
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < writes; i++) {
+		handle.set(&object, i);
+	}
+	const uint64_t by_handle = OS::get_singleton()->get_ticks_usec() - begin;
+
+	BENCHMARK_REPORT("1M writes of offset:x by name", by_name);
+	BENCHMARK_REPORT("1M writes of offset:x with a handle", by_handle);
+}
+
+} // namespace TestPropertyHandle
+
+#endif // TEST_PROPERTY_HANDLE_H
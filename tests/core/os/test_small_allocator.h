@@ -0,0 +1,181 @@
+/**************************************************************************/
+/*  test_small_allocator.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SMALL_ALLOCATOR_H
+#define TEST_SMALL_ALLOCATOR_H
+
+#include "core/os/os.h"
+#include "core/os/small_allocator.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace TestSmallAllocator {
+
+TEST_CASE("[SmallAllocator] Allocate and free") {
+	LocalVector<uint8_t *> blocks;
+	bool all_valid = true;
+	for (size_t size = 1; size <= SmallAllocator::MAX_SIZE; size++) {
+		uint8_t *block = static_cast<uint8_t *>(SmallAllocator::alloc(size));
+		all_valid &= block != nullptr && SmallAllocator::owns(block) && SmallAllocator::get_block_size(block) >= size;
+		all_valid &= (uintptr_t(block) % alignof(max_align_t)) == 0;
+		memset(block, uint8_t(size), size);
+		blocks.push_back(block);
+	}
+	CHECK(all_valid);
+	CHECK(SmallAllocator::get_reserved_bytes() > 0);
+
+	bool all_intact = true;
+	for (uint32_t i = 0; i < blocks.size(); i++) {
+		const size_t size = i + 1;
+		for (size_t j = 0; j < size; j++) {
+			all_intact &= blocks[i][j] == uint8_t(size);
+		}
+		SmallAllocator::free(blocks[i]);
+	}
+	CHECK(all_intact);
+
+	CHECK(SmallAllocator::alloc(SmallAllocator::MAX_SIZE + 1) == nullptr);
+
+	int on_stack = 0;
+	void *from_system = malloc(16);
+	CHECK_FALSE(SmallAllocator::owns(&on_stack));
+	CHECK_FALSE(SmallAllocator::owns(from_system));
+	free(from_system);
+}
+
+#ifdef THREADS_ENABLED
+static void allocate_blocks(void *p_blocks) {
+	LocalVector<void *> &blocks = *static_cast<LocalVector<void *> *>(p_blocks);
+	for (uint32_t i = 0; i < blocks.size(); i++) {
+		blocks[i] = SmallAllocator::alloc(48);
+	}
+}
+
+TEST_CASE("[SmallAllocator] Free blocks allocated by another thread") {
+	LocalVector<void *> blocks;
+	blocks.resize(10000);
+
+	// The thread exits with its blocks still allocated, so its chunks are handed over.
+	Thread thread;
+	thread.start(allocate_blocks, &blocks);
+	thread.wait_to_finish();
+
+	bool all_allocated = true;
+	for (void *block : blocks) {
+		all_allocated &= block != nullptr && SmallAllocator::owns(block);
+	}
+	CHECK(all_allocated);
+
+	for (void *block : blocks) {
+		SmallAllocator::free(block);
+	}
+
+	// Blocks freed from here can be allocated again.
+	const uint64_t reserved = SmallAllocator::get_reserved_bytes();
+	for (uint32_t i = 0; i < blocks.size(); i++) {
+		blocks[i] = SmallAllocator::alloc(48);
+	}
+	for (void *block : blocks) {
+		SmallAllocator::free(block);
+	}
+#ifdef SMALL_ALLOCATOR_ENABLED
+	// Other threads may reserve chunks meanwhile.
+	CHECK(SmallAllocator::get_reserved_bytes() >= reserved);
+#else
+	CHECK(SmallAllocator::get_reserved_bytes() == reserved);
+#endif
+}
+
+template <bool UseSmallAllocator>
+static void churn(void *p_time) {
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	LocalVector<void *> blocks;
+	blocks.resize(1024);
+	for (void *&block : blocks) {
+		block = nullptr;
+	}
+	uint32_t seed = 1;
+	for (int i = 0; i < 2000000; i++) {
+		seed = seed * 1103515245 + 12345;
+		void *&block = blocks[(seed >> 8) % blocks.size()];
+		const size_t size = 16 + (seed >> 20) % 200;
+		if (UseSmallAllocator) {
+			if (block) {
+				SmallAllocator::free(block);
+			}
+			block = SmallAllocator::alloc(size);
+		} else {
+			if (block) {
+				free(block);
+			}
+			block = malloc(size);
+		}
+	}
+	for (void *block : blocks) {
+		if (UseSmallAllocator) {
+			SmallAllocator::free(block);
+		} else {
+			free(block);
+		}
+	}
+	*static_cast<uint64_t *>(p_time) = OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+// Allocation churn from several threads. Run with `--test --benchmark`.
+BENCHMARK_CASE("[Benchmark][SmallAllocator] Against the system allocator") {
+	const int thread_count = 4;
+	uint64_t times[2][thread_count] = {};
+	for (int mode = 0; mode < 2; mode++) {
+		Thread threads[thread_count];
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].start(mode ? churn<true> : churn<false>, &times[mode][i]);
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+	}
+	uint64_t system_time = 0;
+	uint64_t small_time = 0;
+	for (int i = 0; i < thread_count; i++) {
+		system_time += times[0][i];
+		small_time += times[1][i];
+	}
+	// Total time of all threads.
+	BENCHMARK_REPORT("System allocator", system_time);
+	BENCHMARK_REPORT("SmallAllocator", small_time);
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestSmallAllocator
+
+#endif // TEST_SMALL_ALLOCATOR_H
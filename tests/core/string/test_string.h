@@ -166,6 +166,33 @@ TEST_CASE("[String] UTF8 with CR") {
 	CHECK(no_cr == base.replace("\r", ""));
 }
 
+TEST_CASE("[String] UTF8 long mixed text") {
+	// Long enough ASCII runs go through the block fast paths, check every alignment of non-ASCII characters.
+	static const char32_t extra[] = { 0xE9, 0x304A, 0x1F3A4, '\r', 0 };
+	for (int offset = 0; offset < 24; offset++) {
+		for (int e = 0; extra[e]; e++) {
+			String base = "The quick brown fox jumps over the lazy dog, again and again.";
+			base = base.insert(offset, String::chr(extra[e])) + String::chr(extra[e]) + "0123456789";
+
+			CharString utf8 = base.utf8();
+			String decoded;
+			CHECK(decoded.parse_utf8(utf8.get_data()) == OK);
+			CHECK(decoded == base);
+			CHECK(decoded.parse_utf8(utf8.get_data(), utf8.length()) == OK);
+			CHECK(decoded == base);
+
+			CHECK(decoded.parse_utf8(utf8.get_data(), -1, true) == OK);
+			CHECK(decoded == base.replace("\r", ""));
+		}
+	}
+
+	// Decoding stops at the first NUL byte, even with an explicit length.
+	static const char with_nul[] = "0123456789abcdef\0ghijklmnopqrstuv";
+	String s;
+	CHECK(s.parse_utf8(with_nul, sizeof(with_nul) - 1) == OK);
+	CHECK(s == "0123456789abcdef");
+}
+
 TEST_CASE("[String] Invalid UTF8 (non-standard)") {
 	ERR_PRINT_OFF
 	static const uint8_t u8str[] = { 0x45, 0xE3, 0x81, 0x8A, 0xE3, 0x82, 0x88, 0xE3, 0x81, 0x86, 0xF0, 0x9F, 0x8E, 0xA4, 0xF0, 0x82, 0x82, 0xAC, 0xED, 0xA0, 0x81, 0 };
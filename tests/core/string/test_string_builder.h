@@ -0,0 +1,95 @@
+/**************************************************************************/
+/*  test_string_builder.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_BUILDER_H
+#define TEST_STRING_BUILDER_H
+
+#include "core/string/string_builder.h"
+#include "core/string/text_builder.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringBuilder {
+
+TEST_CASE("[StringBuilder] Appending") {
+	StringBuilder builder;
+	CHECK(builder.as_string().is_empty());
+
+	String expected;
+	const String long_string = String("0123456789").repeat(40);
+	for (int i = 0; i < 500; i++) {
+		builder.append("abc");
+		builder.append(itos(i));
+		builder += U'é';
+		expected += "abc" + itos(i) + U"é";
+		if (i % 100 == 0) {
+			// Long strings are referenced instead of copied.
+			builder.append(long_string);
+			expected += long_string;
+		}
+	}
+
+	CHECK(builder.get_string_length() == (uint32_t)expected.length());
+	CHECK(builder.as_string() == expected);
+	// Converting doesn't consume the contents.
+	CHECK(String(builder) == expected);
+
+	builder.clear();
+	CHECK(builder.get_string_length() == 0);
+	CHECK(builder.num_strings_appended() == 0);
+	CHECK(builder.as_string().is_empty());
+
+	builder.append(long_string);
+	CHECK(builder.as_string() == long_string);
+}
+
+TEST_CASE("[TextBuilder] Building text") {
+	Ref<TextBuilder> builder;
+	builder.instantiate();
+	CHECK(builder->is_empty());
+
+	builder->append("Hello");
+	builder->append_line(", world");
+	builder->append_line();
+	builder->append("Bye");
+
+	CHECK_FALSE(builder->is_empty());
+	CHECK(builder->get_length() == 17);
+	CHECK(builder->get_text() == "Hello, world\n\nBye");
+	CHECK(builder->to_string() == builder->get_text());
+
+	builder->clear();
+	CHECK(builder->is_empty());
+	CHECK(builder->get_text().is_empty());
+}
+
+} // namespace TestStringBuilder
+
+#endif // TEST_STRING_BUILDER_H
@@ -0,0 +1,266 @@
+/**************************************************************************/
+/*  test_flat_hash_map.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FLAT_HASH_MAP_H
+#define TEST_FLAT_HASH_MAP_H
+
+#include "core/os/os.h"
+#include "core/templates/flat_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/oa_hash_map.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace TestFlatHashMap {
+
+TEST_CASE("[FlatHashMap] Insert element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Overwrite element") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[FlatHashMap] Erase via element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[FlatHashMap] Erase via key") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	CHECK(map.erase(42));
+	CHECK(!map.erase(42));
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Iteration keeps insertion order") {
+	FlatHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i * 7, i);
+	}
+	// Leave holes in the middle and at the end.
+	for (int i = 0; i < 100; i += 3) {
+		map.erase(i * 7);
+	}
+	map.erase(98 * 7);
+
+	int previous = -1;
+	int count = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.key == E.value * 7);
+		CHECK(E.value > previous);
+		CHECK(E.value % 3 != 0);
+		previous = E.value;
+		count++;
+	}
+	CHECK(count == (int)map.size());
+	CHECK(count == 65);
+
+	// New elements go after the existing ones.
+	map.insert(-1, 1000);
+	CHECK(previous < 1000);
+	FlatHashMap<int, int>::Iterator last;
+	for (FlatHashMap<int, int>::Iterator it = map.begin(); it; ++it) {
+		last = it;
+	}
+	CHECK(last->key == -1);
+}
+
+TEST_CASE("[FlatHashMap] Many elements") {
+	FlatHashMap<int, int> map;
+	const int count = 10000;
+	for (int i = 0; i < count; i++) {
+		map[i] = i * 2;
+	}
+	CHECK(map.size() == count);
+	for (int i = 0; i < count; i += 2) {
+		map.erase(i);
+	}
+	CHECK(map.size() == count / 2);
+
+	bool all_found = true;
+	for (int i = 0; i < count; i++) {
+		const int *value = map.getptr(i);
+		if ((i % 2 == 0) != (value == nullptr) || (value && *value != i * 2)) {
+			all_found = false;
+		}
+	}
+	CHECK(all_found);
+
+	// Reinserting after erasing must reuse the index instead of growing forever.
+	const uint32_t capacity = map.get_capacity();
+	for (int round = 0; round < 10; round++) {
+		for (int i = 0; i < count; i += 2) {
+			map.insert(i, i);
+		}
+		for (int i = 0; i < count; i += 2) {
+			map.erase(i);
+		}
+	}
+	CHECK(map.size() == count / 2);
+	CHECK(map.get_capacity() == capacity);
+}
+
+TEST_CASE("[FlatHashMap] String keys") {
+	FlatHashMap<String, String> map;
+	map.insert("apple", "red");
+	map.insert("banana", "yellow");
+	map["cherry"] = "dark red";
+
+	CHECK(map.size() == 3);
+	CHECK(map["banana"] == "yellow");
+	CHECK(map.get("cherry") == "dark red");
+	CHECK(map.erase("apple"));
+	CHECK(!map.has("apple"));
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(!map.has("banana"));
+}
+
+TEST_CASE("[FlatHashMap] Copy and reserve") {
+	FlatHashMap<int, int> map;
+	map.reserve(1000);
+	const uint32_t capacity = map.get_capacity();
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i);
+	}
+	CHECK(map.get_capacity() == capacity);
+
+	FlatHashMap<int, int> copy = map;
+	map.erase(10);
+	CHECK(copy.size() == 1000);
+	CHECK(copy.has(10));
+	CHECK(!map.has(10));
+
+	copy = map;
+	CHECK(copy.size() == 999);
+	CHECK(!copy.has(10));
+	CHECK(copy[500] == 500);
+}
+
+TEST_CASE("[FlatHashMap] Insert a key and value stored in the map") {
+	// Growing the map moves the entries the arguments refer to.
+	FlatHashMap<String, String> map;
+	map.insert("0", "1");
+	for (int i = 1; i < 1000; i++) {
+		map.insert(map.get(itos(i - 1)), itos(i + 1));
+	}
+	CHECK(map.size() == 1000);
+	for (int i = 0; i < 1000; i++) {
+		CHECK(map[itos(i)] == itos(i + 1));
+	}
+
+	FlatHashMap<int, String> values;
+	values.insert(0, "first value");
+	for (int i = 1; i < 1000; i++) {
+		values.insert(i, values.get(0));
+	}
+	for (int i = 0; i < 1000; i++) {
+		CHECK(values[i] == "first value");
+	}
+}
+
+// Compares lookup heavy use against the other engine maps. Run with `--test --benchmark`.
+BENCHMARK_CASE("[Benchmark][FlatHashMap] Against HashMap and OAHashMap") {
+	const uint32_t count = 100000;
+	const uint32_t lookups = 1000000;
+
+	uint64_t sums[3] = {};
+	uint64_t times[3] = {};
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	{
+		HashMap<uint32_t, uint32_t> map;
+		for (uint32_t i = 0; i < count; i++) {
+			map.insert(hash_murmur3_one_32(i), i);
+		}
+		for (uint32_t i = 0; i < lookups; i++) {
+			const uint32_t *value = map.getptr(hash_murmur3_one_32(i % (count * 2)));
+			sums[0] += value ? *value : 0;
+		}
+	}
+	times[0] = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	{
+		OAHashMap<uint32_t, uint32_t> map;
+		for (uint32_t i = 0; i < count; i++) {
+			map.insert(hash_murmur3_one_32(i), i);
+		}
+		for (uint32_t i = 0; i < lookups; i++) {
+			const uint32_t *value = map.lookup_ptr(hash_murmur3_one_32(i % (count * 2)));
+			sums[1] += value ? *value : 0;
+		}
+	}
+	times[1] = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	{
+		FlatHashMap<uint32_t, uint32_t> map;
+		for (uint32_t i = 0; i < count; i++) {
+			map.insert(hash_murmur3_one_32(i), i);
+		}
+		for (uint32_t i = 0; i < lookups; i++) {
+			const uint32_t *value = map.getptr(hash_murmur3_one_32(i % (count * 2)));
+			sums[2] += value ? *value : 0;
+		}
+	}
+	times[2] = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(sums[0] == sums[1]);
+	CHECK(sums[0] == sums[2]);
+	BENCHMARK_REPORT("HashMap", times[0]);
+	BENCHMARK_REPORT("OAHashMap", times[1]);
+	BENCHMARK_REPORT("FlatHashMap", times[2]);
+}
+
+} // namespace TestFlatHashMap
+
+#endif // TEST_FLAT_HASH_MAP_H
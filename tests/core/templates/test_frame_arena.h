@@ -0,0 +1,108 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FRAME_ARENA_H
+#define TEST_FRAME_ARENA_H
+
+#include "core/templates/frame_arena.h"
+#include "core/templates/list.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Alignment") {
+	FrameArena::Scope scope;
+	FrameArena::alloc(1);
+	void *p = FrameArena::alloc(8, 64);
+	CHECK((uintptr_t)p % 64 == 0);
+	p = FrameArena::alloc(3);
+	CHECK((uintptr_t)p % alignof(max_align_t) == 0);
+}
+
+TEST_CASE("[FrameArena] Scope rewinds the arena") {
+	FrameArena::Scope scope;
+	void *first = nullptr;
+	{
+		FrameArena::Scope inner;
+		first = FrameArena::alloc(32);
+	}
+	{
+		FrameArena::Scope inner;
+		CHECK(FrameArena::alloc(32) == first);
+	}
+}
+
+TEST_CASE("[FrameArena] Allocations larger than a page") {
+	FrameArena::Scope scope;
+	uint8_t *small = (uint8_t *)FrameArena::alloc(16);
+	uint8_t *big = (uint8_t *)FrameArena::alloc(FrameArena::PAGE_SIZE * 3);
+	memset(big, 0xAB, FrameArena::PAGE_SIZE * 3);
+	small[0] = 1;
+	CHECK(big[FrameArena::PAGE_SIZE * 3 - 1] == 0xAB);
+	CHECK(small[0] == 1);
+}
+
+TEST_CASE("[FrameArena] FrameLocalVector") {
+	FrameArena::Scope scope;
+	FrameLocalVector<int> vector;
+	for (int i = 0; i < 10000; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == 10000);
+	bool all_match = true;
+	for (int i = 0; i < 10000; i++) {
+		all_match = all_match && vector[i] == i;
+	}
+	CHECK(all_match);
+
+	FrameLocalVector<String> strings;
+	strings.push_back("a");
+	strings.push_back("b");
+	strings.remove_at(0);
+	CHECK(strings.size() == 1);
+	CHECK(strings[0] == "b");
+}
+
+TEST_CASE("[FrameArena] List with FrameArenaAllocator") {
+	FrameArena::Scope scope;
+	List<int, FrameArenaAllocator> list;
+	for (int i = 0; i < 100; i++) {
+		list.push_back(i);
+	}
+	list.erase(50);
+	CHECK(list.size() == 99);
+	CHECK(list.front()->get() == 0);
+	CHECK(list.back()->get() == 99);
+}
+
+} // namespace TestFrameArena
+
+#endif // TEST_FRAME_ARENA_H
@@ -31,8 +31,12 @@
 #ifndef TEST_RID_H
 #define TEST_RID_H
 
+#include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/templates/rid.h"
+#include "core/templates/rid_owner.h"
 
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 
 namespace TestRID {
@@ -96,6 +100,156 @@ TEST_CASE("[RID] 'get_local_index'") {
 	CHECK(RID::from_uint64(4'294'967'295).get_local_index() == 4'294'967'295);
 	CHECK(RID::from_uint64(4'294'967'297).get_local_index() == 1);
 }
+
+TEST_CASE("[RID_Owner] Allocate, look up and free") {
+	RID_Owner<int> owner;
+	LocalVector<RID> rids;
+	// Enough to need several chunks.
+	for (int i = 0; i < 10000; i++) {
+		rids.push_back(owner.make_rid(i));
+	}
+	CHECK(owner.get_rid_count() == 10000);
+
+	bool all_match = true;
+	for (uint32_t i = 0; i < rids.size(); i++) {
+		int *value = owner.get_or_null(rids[i]);
+		all_match = all_match && value && *value == int(i) && owner.owns(rids[i]);
+	}
+	CHECK(all_match);
+
+	const RID freed = rids[5];
+	owner.free(freed);
+	CHECK(owner.get_or_null(freed) == nullptr);
+	CHECK_FALSE(owner.owns(freed));
+
+	// The slot is reused with a different validator.
+	const RID reused = owner.make_rid(42);
+	CHECK(reused.get_local_index() == freed.get_local_index());
+	CHECK(owner.get_or_null(freed) == nullptr);
+	CHECK(*owner.get_or_null(reused) == 42);
+
+	CHECK(owner.get_or_null(RID()) == nullptr);
+	owner.free(reused);
+	for (uint32_t i = 0; i < rids.size(); i++) {
+		if (i != 5) {
+			owner.free(rids[i]);
+		}
+	}
+	CHECK(owner.get_rid_count() == 0);
+}
+
+TEST_CASE("[RID_Owner] Allocated but uninitialized RIDs") {
+	RID_Owner<int> owner;
+	const RID rid = owner.allocate_rid();
+	CHECK(owner.owns(rid));
+	ERR_PRINT_OFF;
+	CHECK(owner.get_or_null(rid) == nullptr);
+	ERR_PRINT_ON;
+	owner.initialize_rid(rid, 7);
+	CHECK(*owner.get_or_null(rid) == 7);
+	owner.free(rid);
+}
+
+#ifdef THREADS_ENABLED
+struct RIDLookupData {
+	RID_Owner<uint64_t, true> *owner = nullptr;
+	LocalVector<RID> rids;
+	SafeFlag done;
+	uint64_t lookups = 0;
+	uint64_t time = 0;
+	bool valid = true;
+};
+
+static void lookup_rids(void *p_data) {
+	RIDLookupData &data = *static_cast<RIDLookupData *>(p_data);
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	while (!data.done.is_set()) {
+		for (const RID &rid : data.rids) {
+			// Values hold their own ID, so a lookup can't return another element.
+			uint64_t *value = data.owner->get_or_null(rid);
+			data.valid = data.valid && (!value || *value == rid.get_id());
+		}
+		data.lookups += data.rids.size();
+	}
+	data.time = OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+static RID make_self_rid(RID_Owner<uint64_t, true> &p_owner) {
+	const RID rid = p_owner.allocate_rid();
+	p_owner.initialize_rid(rid, rid.get_id());
+	return rid;
+}
+
+TEST_CASE("[RID_Owner] Thread safe lookups while allocating and freeing") {
+	RID_Owner<uint64_t, true> owner(256);
+	RIDLookupData data;
+	data.owner = &owner;
+	for (int i = 0; i < 1000; i++) {
+		data.rids.push_back(make_self_rid(owner));
+	}
+
+	Thread thread;
+	thread.start(lookup_rids, &data);
+	// Growing replaces the chunk array while the other thread reads it.
+	LocalVector<RID> others;
+	for (int i = 0; i < 1000; i++) {
+		for (int j = 0; j < 10; j++) {
+			others.push_back(make_self_rid(owner));
+		}
+		owner.free(others[i]);
+	}
+	data.done.set();
+	thread.wait_to_finish();
+
+	CHECK(data.valid);
+	for (uint32_t i = 0; i < others.size(); i++) {
+		if (i < 1000) {
+			CHECK(owner.get_or_null(others[i]) == nullptr);
+		} else {
+			owner.free(others[i]);
+		}
+	}
+	for (const RID &rid : data.rids) {
+		owner.free(rid);
+	}
+}
+
+// get_or_null() throughput from several threads while another allocates and frees. Run with `--test --benchmark`.
+BENCHMARK_CASE("[Benchmark][RID_Owner] Thread safe lookups") {
+	RID_Owner<uint64_t, true> owner;
+	LocalVector<RID> rids;
+	for (int i = 0; i < 10000; i++) {
+		rids.push_back(make_self_rid(owner));
+	}
+
+	const int max_threads = 8;
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		RIDLookupData data[max_threads];
+		Thread threads[max_threads];
+		for (int i = 0; i < thread_count; i++) {
+			data[i].owner = &owner;
+			data[i].rids = rids;
+			threads[i].start(lookup_rids, &data[i]);
+		}
+		for (int i = 0; i < 100000; i++) {
+			owner.free(make_self_rid(owner));
+		}
+		uint64_t lookups = 0;
+		uint64_t time = 0;
+		for (int i = 0; i < thread_count; i++) {
+			data[i].done.set();
+			threads[i].wait_to_finish();
+			lookups += data[i].lookups;
+			time = MAX(time, data[i].time);
+		}
+		BENCHMARK_REPORT(vformat("1M lookups with %d threads", thread_count), uint64_t(time * 1000000.0 / MAX(lookups, 1u)));
+	}
+
+	for (const RID &rid : rids) {
+		owner.free(rid);
+	}
+}
+#endif // THREADS_ENABLED
 } // namespace TestRID
 
 #endif // TEST_RID_H
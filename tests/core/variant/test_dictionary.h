@@ -31,7 +31,9 @@
 #ifndef TEST_DICTIONARY_H
 #define TEST_DICTIONARY_H
 
+#include "core/os/os.h"
 #include "core/variant/dictionary.h"
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 
 namespace TestDictionary {
@@ -537,6 +539,168 @@ TEST_CASE("[Dictionary] Order and find") {
 	CHECK_EQ(d.find_key("does not exist"), Variant());
 }
 
+TEST_CASE("[Dictionary] Order after erasing and inserting") {
+	Dictionary d;
+	for (int i = 0; i < 100; i++) {
+		d[i] = i * 2;
+	}
+	// Erase enough entries for the storage to be compacted by the next inserts.
+	for (int i = 0; i < 100; i++) {
+		if (i % 4 != 0) {
+			d.erase(i);
+		}
+	}
+	d[1000] = 0;
+	d[0] = 1;
+
+	CHECK(d.size() == 26);
+	CHECK(d.get_key_at_index(0) == Variant(0));
+	CHECK(d.get_key_at_index(1) == Variant(4));
+	CHECK(d.get_key_at_index(25) == Variant(1000));
+	CHECK(d.get_value_at_index(0) == Variant(1));
+	CHECK(d.get_value_at_index(24) == Variant(192));
+
+	int expected = 0;
+	const Variant *key = d.next(nullptr);
+	for (int i = 0; i < 25; i++) {
+		CHECK(*key == Variant(expected));
+		expected += 4;
+		key = d.next(key);
+	}
+	CHECK(*key == Variant(1000));
+	CHECK(d.next(key) == nullptr);
+}
+
+TEST_CASE("[Dictionary] Values keep their address when inserting") {
+	Dictionary d;
+	Variant &value = d["first"];
+	value = 1;
+	for (int i = 0; i < 1000; i++) {
+		d[i] = i;
+	}
+	CHECK(&value == d.getptr("first"));
+	CHECK(d["first"] == Variant(1));
+}
+
+TEST_CASE("[Dictionary] Values keep their address when erasing other keys") {
+	Dictionary d;
+	for (int i = 0; i < 100; i++) {
+		d[i] = i;
+	}
+	Variant *value = d.getptr(99);
+	REQUIRE(value != nullptr);
+	for (int i = 0; i < 99; i++) {
+		d.erase(i);
+	}
+	CHECK(value == d.getptr(99));
+	CHECK(*value == Variant(99));
+	*value = "changed";
+	CHECK(d[99] == Variant("changed"));
+}
+
+TEST_CASE("[Dictionary] Values keep their address when inserting after erasing") {
+	Dictionary d;
+	for (int i = 0; i < 100; i++) {
+		d[i] = i;
+	}
+	for (int i = 0; i < 99; i++) {
+		d.erase(i);
+	}
+	Variant *value = d.getptr(99);
+	REQUIRE(value != nullptr);
+	// New keys reuse the erased entries, without moving the remaining one.
+	for (int i = 100; i < 1000; i++) {
+		d[i] = d[99];
+	}
+	CHECK(value == d.getptr(99));
+	CHECK(*value == Variant(99));
+	CHECK(d[999] == Variant(99));
+	CHECK(d.get_key_at_index(0) == Variant(99));
+	CHECK(d.get_key_at_index(1) == Variant(100));
+	CHECK(d.get_key_at_index(900) == Variant(999));
+}
+
+TEST_CASE("[Dictionary] Inserting reuses erased entries") {
+	Dictionary d;
+	// Used like a queue, the storage must not keep growing.
+	for (int i = 0; i < 10000; i++) {
+		d[i] = i;
+		if (i >= 8) {
+			d.erase(i - 8);
+		}
+	}
+	CHECK(d.size() == 8);
+	CHECK(d.get_key_at_index(0) == Variant(9992));
+	CHECK(d.get_key_at_index(7) == Variant(9999));
+	CHECK(d[9995] == Variant(9995));
+}
+
+TEST_CASE("[Dictionary] StringName keys") {
+	Dictionary d;
+	d[StringName("name")] = "value";
+	d["other"] = 1;
+
+	// StringName keys are stored as String.
+	CHECK(d.keys()[0].get_type() == Variant::STRING);
+	CHECK(d.has("name"));
+	CHECK(d.has(StringName("name")));
+	CHECK(d.has(StringName("other")));
+	CHECK(d[StringName("other")] == Variant(1));
+	CHECK_FALSE(d.has(StringName("missing")));
+	CHECK(d.size() == 2);
+
+	CHECK(d.erase(StringName("other")));
+	CHECK_FALSE(d.has("other"));
+	CHECK(d.erase("name"));
+	CHECK(d.is_empty());
+}
+
+// Measures common operations. Run with `--test --benchmark`.
+BENCHMARK_CASE("[Benchmark][Dictionary] Common operations") {
+	const int count = 100000;
+	LocalVector<StringName> names;
+	for (int i = 0; i < count; i++) {
+		names.push_back(StringName(itos(i)));
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Dictionary d;
+	for (int i = 0; i < count; i++) {
+		d[names[i]] = i;
+	}
+	const uint64_t insert_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int64_t sum = 0;
+	for (int round = 0; round < 10; round++) {
+		for (int i = 0; i < count; i++) {
+			sum += int64_t(*d.getptr(names[i]));
+		}
+	}
+	const uint64_t lookup_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	int64_t iteration_sum = 0;
+	for (int round = 0; round < 10; round++) {
+		for (const Variant *key = d.next(nullptr); key; key = d.next(key)) {
+			iteration_sum += key->operator String().length();
+		}
+	}
+	const uint64_t iteration_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	Dictionary copy = d.duplicate();
+	const uint64_t duplicate_time = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(sum == int64_t(count) * (count - 1) / 2 * 10);
+	CHECK(iteration_sum > 0);
+	CHECK(copy.size() == count);
+	BENCHMARK_REPORT("Insert", insert_time);
+	BENCHMARK_REPORT("Lookup", lookup_time);
+	BENCHMARK_REPORT("Iteration", iteration_time);
+	BENCHMARK_REPORT("Duplicate", duplicate_time);
+}
+
 } // namespace TestDictionary
 
 #endif // TEST_DICTIONARY_H
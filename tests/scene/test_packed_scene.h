@@ -31,8 +31,11 @@
 #ifndef TEST_PACKED_SCENE_H
 #define TEST_PACKED_SCENE_H
 
+#include "scene/2d/line_2d.h"
+#include "scene/resources/gradient.h"
 #include "scene/resources/packed_scene.h"
 
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 
 namespace TestPackedScene {
@@ -215,6 +218,157 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+TEST_CASE("[PackedScene] Instantiate Packed Scene Without Edit State") {
+	// Create a sub-scene to instantiate inside the scene.
+	Node2D *sub_scene_root = memnew(Node2D);
+	sub_scene_root->set_name("SubScene");
+	Node2D *sub_scene_child = memnew(Node2D);
+	sub_scene_child->set_name("SubChild");
+	sub_scene_root->add_child(sub_scene_child);
+	sub_scene_child->set_owner(sub_scene_root);
+
+	Ref<PackedScene> sub_scene;
+	sub_scene.instantiate();
+	CHECK(sub_scene->pack(sub_scene_root) == OK);
+
+	// Build a scene state by hand, the same way the scene loaders do.
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	Ref<SceneState> state = packed_scene->get_state();
+	const int node_2d_type = state->add_name("Node2D");
+	const int line_type = state->add_name("Line2D");
+
+	const int root = state->add_node(-1, -1, node_2d_type, state->add_name("Root"), -1, -1);
+	state->add_node_property(root, state->add_name("position"), state->add_value(Vector2(1, 2)));
+	state->add_node_group(root, state->add_name("roots"));
+
+	const int line = state->add_node(root, root, line_type, state->add_name("Line"), -1, -1);
+	state->add_node_property(line, state->add_name("points"), state->add_value(PackedVector2Array({ Vector2(0, 0), Vector2(3, 4) })));
+	state->add_node_property(line, state->add_name("width"), state->add_value(5.0));
+
+	// Refer to the parent by path, as text scenes do.
+	const int sub = state->add_node(state->add_node_path(NodePath(".")), root, SceneState::TYPE_INSTANTIATED, state->add_name("Sub"), state->add_value(sub_scene), -1);
+	state->add_node_property(sub, state->add_name("rotation"), state->add_value(0.5));
+
+	state->add_node(sub, root, node_2d_type, state->add_name("Target"), -1, -1);
+	state->add_node_property(line, state->add_name("metadata/target"), state->add_value(NodePath("../Sub/Target")), true);
+
+	Vector<int> binds;
+	binds.push_back(state->add_value(42));
+	state->add_connection(line, state->add_node_path(NodePath("Sub/Target")), state->add_name("renamed"), state->add_name("queue_free"), 0, 0, binds);
+
+	Node *instance = packed_scene->instantiate();
+	REQUIRE(instance != nullptr);
+
+	Node2D *root_node = Object::cast_to<Node2D>(instance);
+	REQUIRE(root_node != nullptr);
+	CHECK(root_node->get_name() == "Root");
+	CHECK(root_node->get_position() == Vector2(1, 2));
+	CHECK(root_node->is_in_group("roots"));
+	CHECK(root_node->get_child_count() == 2);
+
+	Line2D *line_node = Object::cast_to<Line2D>(root_node->get_child(0));
+	REQUIRE(line_node != nullptr);
+	CHECK(line_node->get_name() == "Line");
+	CHECK(line_node->get_owner() == root_node);
+	CHECK(line_node->get_point_count() == 2);
+	CHECK(line_node->get_width() == doctest::Approx(5.0));
+
+	Node2D *sub_node = Object::cast_to<Node2D>(root_node->get_child(1));
+	REQUIRE(sub_node != nullptr);
+	CHECK(sub_node->get_name() == "Sub");
+	CHECK(sub_node->get_rotation() == doctest::Approx(0.5));
+	CHECK(sub_node->get_owner() == root_node);
+	CHECK(sub_node->get_child_count() == 2);
+	CHECK(sub_node->get_child(0)->get_name() == "SubChild");
+	CHECK(sub_node->get_child(0)->get_owner() == sub_node);
+
+	Node *target_node = sub_node->get_child(1);
+	CHECK(target_node->get_name() == "Target");
+	CHECK(target_node->get_owner() == root_node);
+	CHECK(Object::cast_to<Node>(line_node->get_meta("target")) == target_node);
+	CHECK(line_node->is_connected("renamed", Callable(target_node, "queue_free")));
+
+	memdelete(instance);
+
+	// Changing the state afterwards is reflected by the next instance.
+	state->add_node(root, root, node_2d_type, state->add_name("Added"), -1, -1);
+	instance = packed_scene->instantiate();
+	REQUIRE(instance != nullptr);
+	CHECK(instance->get_child_count() == 3);
+	CHECK(instance->get_child(2)->get_name() == "Added");
+	memdelete(instance);
+
+	memdelete(sub_scene_root);
+}
+
+TEST_CASE("[PackedScene] Instantiate Packed Scene With Resources Local To Scene") {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("TestScene");
+	Line2D *line = memnew(Line2D);
+	line->set_name("Line");
+	Ref<Gradient> gradient;
+	gradient.instantiate();
+	line->set_gradient(gradient);
+	scene->add_child(line);
+	line->set_owner(scene);
+
+	PackedScene packed_scene;
+	CHECK(packed_scene.pack(scene) == OK);
+
+	// Shared resources are assigned as is.
+	Node *instance1 = packed_scene.instantiate();
+	Node *instance2 = packed_scene.instantiate();
+	CHECK(Object::cast_to<Line2D>(instance1->get_child(0))->get_gradient() == gradient);
+	CHECK(Object::cast_to<Line2D>(instance2->get_child(0))->get_gradient() == gradient);
+	memdelete(instance1);
+	memdelete(instance2);
+
+	// Resources made local to scene afterwards are still duplicated for each instance.
+	gradient->set_local_to_scene(true);
+	instance1 = packed_scene.instantiate();
+	instance2 = packed_scene.instantiate();
+	Ref<Gradient> gradient1 = Object::cast_to<Line2D>(instance1->get_child(0))->get_gradient();
+	Ref<Gradient> gradient2 = Object::cast_to<Line2D>(instance2->get_child(0))->get_gradient();
+	CHECK(gradient1.is_valid());
+	CHECK(gradient1 != gradient);
+	CHECK(gradient1 != gradient2);
+	memdelete(instance1);
+	memdelete(instance2);
+
+	memdelete(scene);
+}
+
+BENCHMARK_CASE("[Benchmark][PackedScene] Instances per second") {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("TestScene");
+	for (int i = 0; i < 100; i++) {
+		Node2D *child = memnew(Node2D);
+		child->set_name(vformat("Child%d", i));
+		child->set_position(Vector2(i, i));
+		child->set_rotation(i * 0.1);
+		child->add_to_group("children", true);
+		scene->add_child(child);
+		child->set_owner(scene);
+		scene->connect("ready", Callable(child, "queue_free"), Object::CONNECT_PERSIST);
+	}
+
+	PackedScene packed_scene;
+	CHECK(packed_scene.pack(scene) == OK);
+	memdelete(scene);
+
+	BENCHMARK_REPORT("1000 instances of 101 nodes", TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < 1000; i++) {
+			memdelete(packed_scene.instantiate());
+		}
+	}));
+	BENCHMARK_REPORT("1000 instances of 101 nodes with edit state", TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < 1000; i++) {
+			memdelete(packed_scene.instantiate(PackedScene::GEN_EDIT_STATE_INSTANCE));
+		}
+	}));
+}
+
 } // namespace TestPackedScene
 
 #endif // TEST_PACKED_SCENE_H
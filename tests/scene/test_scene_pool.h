@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*  test_scene_pool.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_POOL_H
+#define TEST_SCENE_POOL_H
+
+#include "scene/2d/node_2d.h"
+#include "scene/main/scene_pool.h"
+#include "scene/main/window.h"
+
+#include "tests/test_benchmark.h"
+#include "tests/test_macros.h"
+
+namespace TestScenePool {
+
+static Ref<PackedScene> create_test_scene(int p_child_count = 2) {
+	Node2D *root = memnew(Node2D);
+	root->set_name("Root");
+	root->set_position(Vector2(10, 20));
+	for (int i = 0; i < p_child_count; i++) {
+		Node2D *child = memnew(Node2D);
+		child->set_name(vformat("Child%d", i));
+		child->set_rotation(0.5);
+		child->set_meta("values", Array());
+		root->add_child(child);
+		child->set_owner(root);
+	}
+
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	CHECK(scene->pack(root) == OK);
+	memdelete(root);
+	return scene;
+}
+
+TEST_CASE("[SceneTree][ScenePool] Acquire and release") {
+	Ref<PackedScene> scene = create_test_scene();
+	Ref<ScenePool> pool;
+	pool.instantiate();
+
+	Node *instance = pool->acquire(scene);
+	REQUIRE(instance != nullptr);
+	CHECK(instance->get_child_count() == 2);
+	CHECK(pool->get_available_count(scene) == 0);
+
+	pool->release(instance);
+	CHECK(pool->get_available_count(scene) == 1);
+
+	SUBCASE("Released instances are handed out again") {
+		CHECK(pool->acquire(scene) == instance);
+		CHECK(pool->get_available_count(scene) == 0);
+
+		Dictionary stats = pool->get_stats();
+		CHECK(int(stats["hits"]) == 1);
+		CHECK(int(stats["misses"]) == 1);
+		CHECK(double(stats["hit_rate"]) == doctest::Approx(0.5));
+		CHECK(int(stats["releases"]) == 1);
+
+		pool->release(instance);
+	}
+
+	SUBCASE("Releasing twice fails") {
+		ERR_PRINT_OFF;
+		pool->release(instance);
+		ERR_PRINT_ON;
+		CHECK(pool->get_available_count(scene) == 1);
+	}
+}
+
+TEST_CASE("[SceneTree][ScenePool] Released instances are reset") {
+	Ref<PackedScene> scene = create_test_scene();
+	Ref<ScenePool> pool;
+	pool.instantiate();
+
+	Node2D *instance = Object::cast_to<Node2D>(pool->acquire(scene));
+	REQUIRE(instance != nullptr);
+	Node2D *child = Object::cast_to<Node2D>(instance->get_child(0));
+
+	SceneTree::get_singleton()->get_root()->add_child(instance);
+	instance->set_position(Vector2(-1, -1));
+	instance->set_visible(false);
+	child->set_rotation(2.0);
+	Array values = child->get_meta("values");
+	values.push_back(1);
+
+	pool->release(instance);
+	CHECK(instance->get_parent() == nullptr);
+
+	CHECK(pool->acquire(scene) == instance);
+	CHECK(instance->get_position() == Vector2(10, 20));
+	CHECK(instance->is_visible());
+	CHECK(child->get_rotation() == doctest::Approx(0.5));
+	CHECK(Array(child->get_meta("values")).is_empty());
+
+	pool->release(instance);
+}
+
+TEST_CASE("[SceneTree][ScenePool] Instances that can't be reset are freed") {
+	Ref<PackedScene> scene = create_test_scene();
+	Ref<ScenePool> pool;
+	pool.instantiate();
+
+	Node *instance = pool->acquire(scene);
+	Node *extra = memnew(Node);
+	instance->add_child(extra);
+	ObjectID instance_id = instance->get_instance_id();
+
+	pool->release(instance);
+	CHECK(ObjectDB::get_instance(instance_id) == nullptr);
+	CHECK(pool->get_available_count(scene) == 0);
+	CHECK(int(pool->get_stats()["discards"]) == 1);
+}
+
+TEST_CASE("[SceneTree][ScenePool] Size limit and prewarming") {
+	Ref<PackedScene> scene = create_test_scene();
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_max_size(4);
+
+	pool->prewarm(scene, 10);
+	CHECK(pool->get_available_count(scene) == 4);
+
+	Node *instances[5];
+	for (int i = 0; i < 5; i++) {
+		instances[i] = pool->acquire(scene);
+	}
+	CHECK(int(pool->get_stats()["hits"]) == 4);
+	CHECK(int(pool->get_stats()["misses"]) == 1);
+
+	for (int i = 0; i < 5; i++) {
+		pool->release(instances[i]);
+	}
+	CHECK(pool->get_available_count(scene) == 4);
+	CHECK(int(pool->get_stats()["discards"]) == 1);
+
+	pool->set_max_size(2);
+	CHECK(pool->get_available_count(scene) == 2);
+
+	pool->clear();
+	CHECK(pool->get_available_count(scene) == 0);
+
+	pool->reset_stats();
+	CHECK(int(pool->get_stats()["hits"]) == 0);
+}
+
+BENCHMARK_CASE("[Benchmark][SceneTree][ScenePool] Recycling instances") {
+	Ref<PackedScene> scene = create_test_scene(50);
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_max_size(100);
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	BENCHMARK_REPORT("100 scenes of 51 nodes, instantiated and freed", TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < 100; i++) {
+			Node *instance = scene->instantiate();
+			root->add_child(instance);
+			memdelete(instance);
+		}
+	}));
+	BENCHMARK_REPORT("100 scenes of 51 nodes, acquired and released", TestBenchmark::measure_usec([&]() {
+		for (int i = 0; i < 100; i++) {
+			Node *instance = pool->acquire(scene);
+			root->add_child(instance);
+			pool->release(instance);
+		}
+	}));
+}
+
+} // namespace TestScenePool
+
+#endif // TEST_SCENE_POOL_H
@@ -0,0 +1,237 @@
+/**************************************************************************/
+/*  test_tile_map_layer.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef TEST_TILE_MAP_LAYER_H
+#define TEST_TILE_MAP_LAYER_H
+
+#include "scene/2d/tile_map_layer.h"
+#include "scene/main/window.h"
+#include "scene/resources/image_texture.h"
+#include "scene/resources/world_2d.h"
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_tools.h"
+
+namespace TestTileMapLayer {
+
+// Atlas coordinates of the test tiles, all with a 16x16 square collision polygon.
+static const Vector2i SOLID_TILE = Vector2i(0, 0);
+static const Vector2i ONE_WAY_TILE = Vector2i(1, 0);
+static const Vector2i MOVING_TILE = Vector2i(2, 0);
+
+static Ref<TileSet> create_collision_tile_set() {
+	Ref<TileSet> tile_set;
+	tile_set.instantiate();
+	tile_set->set_tile_size(Vector2i(16, 16));
+	tile_set->add_physics_layer();
+
+	Ref<TileSetAtlasSource> atlas_source;
+	atlas_source.instantiate();
+	atlas_source->set_texture(ImageTexture::create_from_image(Image::create_empty(48, 16, false, Image::FORMAT_RGBA8)));
+	atlas_source->set_texture_region_size(Vector2i(16, 16));
+	tile_set->add_source(atlas_source, 0);
+	for (int x = 0; x < 3; x++) {
+		atlas_source->create_tile(Vector2i(x, 0));
+		TileData *tile_data = atlas_source->get_tile_data(Vector2i(x, 0), 0);
+		tile_data->add_collision_polygon(0);
+		tile_data->set_collision_polygon_points(0, 0, { Vector2(-8, -8), Vector2(8, -8), Vector2(8, 8), Vector2(-8, 8) });
+	}
+	atlas_source->get_tile_data(ONE_WAY_TILE, 0)->set_collision_polygon_one_way(0, 0, true);
+	atlas_source->get_tile_data(MOVING_TILE, 0)->set_constant_linear_velocity(0, Vector2(10, 0));
+	return tile_set;
+}
+
+static PhysicsDirectSpaceState2D::RayResult cast_ray(TileMapLayer *p_layer, const Vector2 &p_from, const Vector2 &p_to) {
+	PhysicsDirectSpaceState2D::RayParameters parameters;
+	parameters.from = p_from;
+	parameters.to = p_to;
+	PhysicsDirectSpaceState2D::RayResult result;
+	p_layer->get_world_2d()->get_direct_space_state()->intersect_ray(parameters, result);
+	return result;
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Merged collision shapes") {
+	TileMapLayer *layer = memnew(TileMapLayer);
+	layer->set_tile_set(create_collision_tile_set());
+	SceneTree::get_singleton()->get_root()->add_child(layer);
+
+	// A 2x2 block of solid tiles, then a one-way tile and a moving tile.
+	for (int y = 0; y < 2; y++) {
+		for (int x = 0; x < 2; x++) {
+			layer->set_cell(Vector2i(x, y), 0, SOLID_TILE);
+		}
+	}
+	layer->set_cell(Vector2i(3, 0), 0, ONE_WAY_TILE);
+	layer->set_cell(Vector2i(5, 0), 0, MOVING_TILE);
+
+	SUBCASE("One body per tile") {
+		layer->update_internals();
+		PhysicsServer2D::get_singleton()->step(1.0 / 60.0);
+
+		const PhysicsDirectSpaceState2D::RayResult first = cast_ray(layer, Vector2(8, -8), Vector2(8, 8));
+		const PhysicsDirectSpaceState2D::RayResult second = cast_ray(layer, Vector2(24, -8), Vector2(24, 8));
+		REQUIRE(first.rid.is_valid());
+		REQUIRE(second.rid.is_valid());
+		CHECK(first.rid != second.rid);
+		CHECK(layer->get_coords_for_body_rid(first.rid) == Vector2i(0, 0));
+		CHECK(layer->get_coords_for_body_rid(second.rid) == Vector2i(1, 0));
+
+		// The edge between the two tiles is hit from inside the block.
+		const PhysicsDirectSpaceState2D::RayResult inside = cast_ray(layer, Vector2(4, 8), Vector2(28, 8));
+		CHECK(inside.rid == second.rid);
+		CHECK(inside.position.is_equal_approx(Vector2(16, 8)));
+	}
+
+	SUBCASE("Merged shapes") {
+		layer->set_collision_shapes_merged(true);
+		layer->update_internals();
+		PhysicsServer2D::get_singleton()->step(1.0 / 60.0);
+
+		const PhysicsDirectSpaceState2D::RayResult first = cast_ray(layer, Vector2(8, -8), Vector2(8, 8));
+		const PhysicsDirectSpaceState2D::RayResult second = cast_ray(layer, Vector2(24, -8), Vector2(24, 8));
+		REQUIRE(first.rid.is_valid());
+		CHECK(first.rid == second.rid);
+		CHECK(first.position.is_equal_approx(Vector2(8, 0)));
+		CHECK(layer->has_body_rid(first.rid));
+
+		// Each tile on the outline has its own shape in the merged body.
+		CHECK(first.shape != second.shape);
+		CHECK(layer->get_coords_for_body_rid(first.rid, first.shape) == Vector2i(0, 0));
+		CHECK(layer->get_coords_for_body_rid(second.rid, second.shape) == Vector2i(1, 0));
+		const PhysicsDirectSpaceState2D::RayResult bottom = cast_ray(layer, Vector2(8, 40), Vector2(8, 24));
+		REQUIRE(bottom.rid == first.rid);
+		CHECK(layer->get_coords_for_body_rid(bottom.rid, bottom.shape) == Vector2i(0, 1));
+		const Vector2i any_coords = layer->get_coords_for_body_rid(first.rid);
+		CHECK((any_coords.x >= 0 && any_coords.x < 2 && any_coords.y >= 0 && any_coords.y < 2));
+		ERR_PRINT_OFF;
+		CHECK(layer->get_coords_for_body_rid(first.rid, 4) == Vector2i());
+		ERR_PRINT_ON;
+
+		// Only the outline of the block is left, so nothing is hit from inside it.
+		CHECK_FALSE(cast_ray(layer, Vector2(4, 8), Vector2(28, 8)).rid.is_valid());
+		CHECK_FALSE(cast_ray(layer, Vector2(8, 4), Vector2(8, 28)).rid.is_valid());
+		const PhysicsDirectSpaceState2D::RayResult outline = cast_ray(layer, Vector2(40, 8), Vector2(4, 8));
+		CHECK(outline.rid == first.rid);
+		CHECK(outline.position.is_equal_approx(Vector2(32, 8)));
+		CHECK(layer->get_coords_for_body_rid(outline.rid, outline.shape) == Vector2i(1, 0));
+
+		// One-way and moving tiles keep their own bodies.
+		const PhysicsDirectSpaceState2D::RayResult one_way = cast_ray(layer, Vector2(56, -8), Vector2(56, 8));
+		REQUIRE(one_way.rid.is_valid());
+		CHECK(one_way.rid != first.rid);
+		CHECK(layer->get_coords_for_body_rid(one_way.rid) == Vector2i(3, 0));
+		const PhysicsDirectSpaceState2D::RayResult moving = cast_ray(layer, Vector2(88, -8), Vector2(88, 8));
+		REQUIRE(moving.rid.is_valid());
+		CHECK(moving.rid != first.rid);
+		CHECK(layer->get_coords_for_body_rid(moving.rid) == Vector2i(5, 0));
+
+		// Erasing a tile of the block brings its inner edges back on the outline.
+		layer->erase_cell(Vector2i(1, 0));
+		layer->update_internals();
+		PhysicsServer2D::get_singleton()->step(1.0 / 60.0);
+		CHECK_FALSE(cast_ray(layer, Vector2(24, -8), Vector2(24, 4)).rid.is_valid());
+		CHECK(cast_ray(layer, Vector2(4, 8), Vector2(28, 8)).position.is_equal_approx(Vector2(16, 8)));
+		const PhysicsDirectSpaceState2D::RayResult inner = cast_ray(layer, Vector2(24, 4), Vector2(24, 28));
+		CHECK(inner.position.is_equal_approx(Vector2(24, 16)));
+		CHECK(layer->get_coords_for_body_rid(inner.rid, inner.shape) == Vector2i(1, 1));
+	}
+
+	SUBCASE("Merged shapes across physics quadrants") {
+		// The block is split between two quadrants, so each quadrant has its own body.
+		layer->set_physics_quadrant_size(1);
+		layer->set_collision_shapes_merged(true);
+		layer->update_internals();
+		PhysicsServer2D::get_singleton()->step(1.0 / 60.0);
+
+		const PhysicsDirectSpaceState2D::RayResult first = cast_ray(layer, Vector2(8, -8), Vector2(8, 8));
+		const PhysicsDirectSpaceState2D::RayResult second = cast_ray(layer, Vector2(24, -8), Vector2(24, 8));
+		REQUIRE(first.rid.is_valid());
+		REQUIRE(second.rid.is_valid());
+		CHECK(first.rid != second.rid);
+		CHECK(layer->get_coords_for_body_rid(first.rid, first.shape) == Vector2i(0, 0));
+		CHECK(layer->get_coords_for_body_rid(second.rid, second.shape) == Vector2i(1, 0));
+
+		// Edges are only removed within a quadrant, so the border between two quadrants stays.
+		const PhysicsDirectSpaceState2D::RayResult seam = cast_ray(layer, Vector2(4, 8), Vector2(28, 8));
+		CHECK((seam.rid == first.rid || seam.rid == second.rid));
+		CHECK(seam.position.is_equal_approx(Vector2(16, 8)));
+	}
+
+	memdelete(layer);
+}
+
+TEST_CASE("[SceneTree][TileMapLayer] Threaded rendering quadrant updates") {
+	TileMapLayer *threaded_layer = memnew(TileMapLayer);
+	TileMapLayer *single_threaded_layer = memnew(TileMapLayer);
+	const Ref<TileSet> tile_set = create_collision_tile_set();
+	for (TileMapLayer *layer : { threaded_layer, single_threaded_layer }) {
+		layer->set_tile_set(tile_set);
+		layer->set_y_sort_enabled(true);
+		layer->set_self_modulate(Color(1, 0, 0, 0.5));
+		SceneTree::get_singleton()->get_root()->add_child(layer);
+	}
+
+	// Each row is a quadrant of its own, both with and without Y-sorting. This is well above
+	// the amount of dirty quadrants from which they are rebuilt on worker threads.
+	const int quadrant_count = 16;
+
+	ErrorDetector ed;
+	// All the quadrants are dirtied at once, so their draws are prepared on worker threads.
+	for (int i = 0; i < quadrant_count; i++) {
+		threaded_layer->set_cell(Vector2i(0, i * 16), 0, SOLID_TILE);
+	}
+	threaded_layer->update_internals();
+	CHECK_FALSE_MESSAGE(ed.has_error, "Worker threads must not read the layer's node properties.");
+
+	// One quadrant is dirtied at a time, so their draws are prepared on the calling thread.
+	for (int i = 0; i < quadrant_count; i++) {
+		single_threaded_layer->set_cell(Vector2i(0, i * 16), 0, SOLID_TILE);
+		single_threaded_layer->update_internals();
+	}
+	CHECK_FALSE(ed.has_error);
+	CHECK(threaded_layer->get_used_cells() == single_threaded_layer->get_used_cells());
+	CHECK(threaded_layer->get_used_rect() == single_threaded_layer->get_used_rect());
+
+	// Changing the properties read for the draws rebuilds all the quadrants again.
+	threaded_layer->set_y_sort_enabled(false);
+	threaded_layer->update_internals();
+	threaded_layer->set_self_modulate(Color(0, 1, 0));
+	threaded_layer->update_internals();
+	CHECK_FALSE(ed.has_error);
+
+	memdelete(threaded_layer);
+	memdelete(single_threaded_layer);
+}
+
+} // namespace TestTileMapLayer
+
+#endif // TEST_TILE_MAP_LAYER_H
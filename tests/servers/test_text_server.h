@@ -33,12 +33,36 @@
 
 #ifdef TOOLS_ENABLED
 
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
 #include "editor/themes/builtin_fonts.gen.h"
 #include "servers/text_server.h"
 #include "tests/test_macros.h"
 
 namespace TestTextServer {
 
+struct ConcurrentShapingData {
+	TextServer *ts = nullptr;
+	Array font;
+	String text;
+	SafeFlag done;
+	SafeNumeric<int> shaped;
+	SafeFlag failed;
+};
+
+static void shape_texts(void *p_data) {
+	ConcurrentShapingData &data = *static_cast<ConcurrentShapingData *>(p_data);
+	while (!data.done.is_set()) {
+		RID ctx = data.ts->create_shaped_text();
+		data.ts->shaped_text_add_string(ctx, data.text, data.font, 16);
+		if (!data.ts->shaped_text_shape(ctx) || data.ts->shaped_text_get_glyph_count(ctx) <= 0) {
+			data.failed.set();
+		}
+		data.ts->free_rid(ctx);
+		data.shaped.increment();
+	}
+}
+
 TEST_SUITE("[TextServer]") {
 	TEST_CASE("[TextServer] Init, font loading and shaping") {
 		SUBCASE("[TextServer] Loading fonts") {
@@ -112,6 +136,111 @@ TEST_SUITE("[TextServer]") {
 			}
 		}
 
+		SUBCASE("[TextServer] Text layout: Batch shaping") {
+			for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
+				Ref<TextServer> ts = TextServerManager::get_singleton()->get_interface(i);
+				CHECK_FALSE_MESSAGE(ts.is_null(), "Invalid TS interface.");
+
+				if (!ts->has_feature(TextServer::FEATURE_FONT_DYNAMIC) || !ts->has_feature(TextServer::FEATURE_SIMPLE_LAYOUT)) {
+					continue;
+				}
+
+				RID font1 = ts->create_font();
+				ts->font_set_data_ptr(font1, _font_NotoSans_Regular, _font_NotoSans_Regular_size);
+				ts->font_set_allow_system_fallback(font1, false);
+				RID font2 = ts->create_font();
+				ts->font_set_data_ptr(font2, _font_NotoSansThai_Regular, _font_NotoSansThai_Regular_size);
+				ts->font_set_allow_system_fallback(font2, false);
+
+				Array font;
+				font.push_back(font1);
+				font.push_back(font2);
+
+				const int count = 64;
+				TypedArray<RID> batch;
+				Vector<RID> single;
+				for (int j = 0; j < count; j++) {
+					String test = vformat(U"%d: คนอ้วน khon uan %d", j, j * 7);
+
+					RID ctx = ts->create_shaped_text();
+					ts->shaped_text_add_string(ctx, test, font, 16);
+					batch.push_back(ctx);
+
+					RID ref = ts->create_shaped_text();
+					ts->shaped_text_add_string(ref, test, font, 16);
+					single.push_back(ref);
+				}
+
+				CHECK_MESSAGE(ts->shaped_text_shape_batch(batch), "Batch shaping failed.");
+				for (int j = 0; j < count; j++) {
+					CHECK_MESSAGE(ts->shaped_text_is_ready(batch[j]), "Buffer was not shaped.");
+					ts->shaped_text_shape(single[j]);
+
+					int gl_size = ts->shaped_text_get_glyph_count(batch[j]);
+					CHECK_FALSE_MESSAGE(gl_size == 0, "Shaping failed.");
+					CHECK_MESSAGE(gl_size == ts->shaped_text_get_glyph_count(single[j]), "Batch and single shaping results differ.");
+					const Glyph *glyphs = ts->shaped_text_get_glyphs(batch[j]);
+					const Glyph *ref_glyphs = ts->shaped_text_get_glyphs(single[j]);
+					for (int k = 0; k < gl_size; k++) {
+						CHECK_FALSE_MESSAGE((glyphs[k].index != ref_glyphs[k].index || glyphs[k].font_rid != ref_glyphs[k].font_rid || glyphs[k].advance != ref_glyphs[k].advance), "Batch and single shaping results differ.");
+					}
+
+					ts->free_rid(batch[j]);
+					ts->free_rid(single[j]);
+				}
+
+				for (int j = 0; j < font.size(); j++) {
+					ts->free_rid(font[j]);
+				}
+				font.clear();
+			}
+		}
+
+		SUBCASE("[TextServer] Text layout: Concurrent shaping and substrings") {
+			for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
+				Ref<TextServer> ts = TextServerManager::get_singleton()->get_interface(i);
+				CHECK_FALSE_MESSAGE(ts.is_null(), "Invalid TS interface.");
+
+				if (!ts->has_feature(TextServer::FEATURE_FONT_DYNAMIC) || !ts->has_feature(TextServer::FEATURE_SIMPLE_LAYOUT)) {
+					continue;
+				}
+
+				// System fallback is allowed, so shaping the Hebrew part looks up (and may create)
+				// system fonts while substrings of other buffers are shaped on this thread.
+				RID font1 = ts->create_font();
+				ts->font_set_data_ptr(font1, _font_NotoSans_Regular, _font_NotoSans_Regular_size);
+				RID font2 = ts->create_font();
+				ts->font_set_data_ptr(font2, _font_NotoSansThai_Regular, _font_NotoSansThai_Regular_size);
+
+				ConcurrentShapingData data;
+				data.ts = ts.ptr();
+				data.font.push_back(font1);
+				data.font.push_back(font2);
+				data.text = U"คนอ้วน khon uan ראה";
+
+				Thread thread;
+				thread.start(shape_texts, &data);
+				bool valid = true;
+				for (int j = 0; j < 200 || data.shaped.get() == 0; j++) {
+					RID ctx = ts->create_shaped_text();
+					ts->shaped_text_add_string(ctx, data.text, data.font, 16);
+					// Not shaped yet, so the substring shapes its parent.
+					RID sub = ts->shaped_text_substr(ctx, 7, 8);
+					valid = valid && sub.is_valid() && ts->shaped_text_get_glyph_count(sub) > 0;
+					ts->free_rid(sub);
+					ts->free_rid(ctx);
+				}
+				data.done.set();
+				thread.wait_to_finish();
+
+				CHECK_MESSAGE(valid, "Shaping substrings failed.");
+				CHECK_FALSE_MESSAGE(data.failed.is_set(), "Concurrent shaping failed.");
+
+				ts->free_rid(font1);
+				ts->free_rid(font2);
+			}
+		}
+
 		SUBCASE("[TextServer] Text layout: BiDi") {
 			for (int i = 0; i < TextServerManager::get_singleton()->get_interface_count(); i++) {
 				Ref<TextServer> ts = TextServerManager::get_singleton()->get_interface(i);
@@ -0,0 +1,99 @@
+/**************************************************************************/
+/*  test_benchmark.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_benchmark.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/version.h"
+
+static Dictionary *benchmark_results = nullptr;
+
+void TestBenchmark::report(const char *p_test_case, const String &p_name, uint64_t p_usec) {
+	if (!benchmark_results) {
+		benchmark_results = memnew(Dictionary);
+	}
+	const String key = vformat("%s: %s", String::utf8(p_test_case), p_name);
+	(*benchmark_results)[key] = p_usec;
+	MESSAGE(vformat("%s: %d usec.", p_name, p_usec));
+}
+
+Dictionary TestBenchmark::get_results() {
+	return benchmark_results ? *benchmark_results : Dictionary();
+}
+
+void TestBenchmark::clear_results() {
+	if (benchmark_results) {
+		memdelete(benchmark_results);
+		benchmark_results = nullptr;
+	}
+}
+
+void TestBenchmark::print_results(const Dictionary &p_compare_with) {
+	const Dictionary results = get_results();
+	Array keys = results.keys();
+	keys.sort();
+
+	print_line("BENCHMARK:");
+	for (int i = 0; i < keys.size(); i++) {
+		const uint64_t usec = results[keys[i]];
+		if (p_compare_with.has(keys[i]) && uint64_t(p_compare_with[keys[i]]) > 0) {
+			const double ratio = double(usec) / double(uint64_t(p_compare_with[keys[i]]));
+			print_line(vformat("\t- %s: %d usec (%s%.1f%%).", keys[i], usec, ratio >= 1.0 ? "+" : "", (ratio - 1.0) * 100.0));
+		} else {
+			print_line(vformat("\t- %s: %d usec.", keys[i], usec));
+		}
+	}
+}
+
+Error TestBenchmark::save_results(const String &p_path) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_CREATE, vformat("Can't save benchmark results to \"%s\".", p_path));
+
+	Dictionary engine;
+	engine["version"] = VERSION_FULL_BUILD;
+	engine["hash"] = VERSION_HASH;
+#ifdef DEBUG_ENABLED
+	engine["debug"] = true;
+#else
+	engine["debug"] = false;
+#endif
+	engine["platform"] = OS::get_singleton()->get_name();
+	engine["processor_name"] = OS::get_singleton()->get_processor_name();
+	engine["processor_count"] = OS::get_singleton()->get_processor_count();
+
+	Dictionary data;
+	data["engine"] = engine;
+	data["results_usec"] = get_results();
+
+	// Keys are sorted, so files from different runs can be diffed.
+	f->store_string(JSON::stringify(data, "\t", true) + "\n");
+	return OK;
+}
@@ -0,0 +1,77 @@
+/**************************************************************************/
+/*  test_benchmark.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BENCHMARK_H
+#define TEST_BENCHMARK_H
+
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+// Benchmarks are test cases skipped by default, with "[Benchmark]" in their name.
+// Run them with `godot --test --benchmark`, which prints the results, or use
+// `--benchmark-file <path>` to save them as JSON. Passing `--benchmark-compare <path>`
+// with an earlier file prints how much each result changed, e.g. between engine versions.
+// Options such as `--test-case=<filter>` can be combined with these to pick benchmarks.
+
+#define BENCHMARK_CASE(m_name) TEST_CASE(m_name *doctest::skip())
+
+// Records a time (in microseconds) measured by the running benchmark.
+#define BENCHMARK_REPORT(m_measurement, m_usec) TestBenchmark::report(doctest::getContextOptions()->currentTest->m_name, m_measurement, m_usec)
+
+namespace TestBenchmark {
+
+void report(const char *p_test_case, const String &p_name, uint64_t p_usec);
+
+Dictionary get_results();
+void clear_results();
+void print_results(const Dictionary &p_compare_with = Dictionary());
+Error save_results(const String &p_path);
+
+// Runs the function once to warm up caches, then `p_runs` times, and returns the median time
+// in microseconds. The median is steadier than the mean when the machine is busy.
+template <typename F>
+uint64_t measure_usec(F p_function, int p_runs = 5) {
+	p_function();
+	LocalVector<uint64_t> times;
+	for (int i = 0; i < p_runs; i++) {
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		p_function();
+		times.push_back(OS::get_singleton()->get_ticks_usec() - begin);
+	}
+	times.sort();
+	return times[times.size() / 2];
+}
+
+} // namespace TestBenchmark
+
+#endif // TEST_BENCHMARK_H
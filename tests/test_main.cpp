@@ -35,7 +35,12 @@
 #include "editor/editor_settings.h"
 #endif // TOOLS_ENABLED
 
+#include "tests/benchmarks/benchmark_core.h"
+#include "tests/benchmarks/benchmark_physics.h"
+#include "tests/benchmarks/benchmark_scene.h"
+#include "tests/benchmarks/benchmark_variant.h"
 #include "tests/core/config/test_project_settings.h"
+#include "tests/core/debugger/test_frame_timeline.h"
 #include "tests/core/input/test_input_event.h"
 #include "tests/core/input/test_input_event_key.h"
 #include "tests/core/input/test_input_event_mouse.h"
@@ -74,13 +79,18 @@
 #include "tests/core/object/test_class_db.h"
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
+#include "tests/core/object/test_property_handle.h"
 #include "tests/core/object/test_undo_redo.h"
 #include "tests/core/os/test_os.h"
+#include "tests/core/os/test_small_allocator.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
+#include "tests/core/string/test_string_builder.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/string/test_translation_server.h"
 #include "tests/core/templates/test_command_queue.h"
+#include "tests/core/templates/test_flat_hash_map.h"
+#include "tests/core/templates/test_frame_arena.h"
 #include "tests/core/templates/test_hash_map.h"
 #include "tests/core/templates/test_hash_set.h"
 #include "tests/core/templates/test_list.h"
@@ -115,9 +125,11 @@
 #include "tests/scene/test_node_2d.h"
 #include "tests/scene/test_packed_scene.h"
 #include "tests/scene/test_path_2d.h"
+#include "tests/scene/test_scene_pool.h"
 #include "tests/scene/test_sprite_frames.h"
 #include "tests/scene/test_text_edit.h"
 #include "tests/scene/test_theme.h"
+#include "tests/scene/test_tile_map_layer.h"
 #include "tests/scene/test_timer.h"
 #include "tests/scene/test_viewport.h"
 #include "tests/scene/test_visual_shader.h"
@@ -127,6 +139,7 @@
 #include "tests/test_validate_testing.h"
 
 #ifndef _3D_DISABLED
+#include "tests/benchmarks/benchmark_navigation.h"
 #include "tests/scene/test_arraymesh.h"
 #include "tests/scene/test_camera_3d.h"
 #include "tests/scene/test_navigation_agent_2d.h"
@@ -144,8 +157,12 @@
 #include "modules/modules_tests.gen.h"
 
 #include "tests/display_server_mock.h"
+#include "tests/test_benchmark.h"
 #include "tests/test_macros.h"
 
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+
 #include "scene/theme/theme_db.h"
 #ifndef _3D_DISABLED
 #include "servers/navigation_server_2d.h"
@@ -190,11 +207,42 @@ int test_main(int argc, char *argv[]) {
 	doctest::Context test_context;
 	LocalVector<String> test_args;
 
-	// Clean arguments of "--test" from the args.
+	// Benchmark options, see `tests/test_benchmark.h`.
+	bool run_benchmarks = false;
+	bool has_test_case_filter = false;
+	String benchmark_file;
+	String benchmark_compare_file;
+
+	// Clean arguments of "--test" and benchmark options from the args.
 	for (int x = 0; x < argc; x++) {
 		String arg = String(argv[x]);
-		if (arg != "--test") {
-			test_args.push_back(arg);
+		if (arg == "--test") {
+			continue;
+		}
+		if (arg == "--benchmark") {
+			run_benchmarks = true;
+			continue;
+		}
+		if (arg == "--benchmark-file" || arg == "--benchmark-compare") {
+			if (x + 1 >= argc) {
+				OS::get_singleton()->print("Missing <path> argument for %s <path>.\n", arg.utf8().get_data());
+				return EXIT_FAILURE;
+			}
+			run_benchmarks = true;
+			x++;
+			(arg == "--benchmark-file" ? benchmark_file : benchmark_compare_file) = String::utf8(argv[x]);
+			continue;
+		}
+		if (arg.begins_with("--test-case=") || arg.begins_with("-tc=")) {
+			has_test_case_filter = true;
+		}
+		test_args.push_back(arg);
+	}
+
+	if (run_benchmarks) {
+		test_args.push_back("--no-skip");
+		if (!has_test_case_filter) {
+			test_args.push_back("--test-case=*[Benchmark]*");
 		}
 	}
 
@@ -219,7 +267,24 @@ int test_main(int argc, char *argv[]) {
 		delete[] doctest_args;
 	}
 
-	return test_context.run();
+	const int status = test_context.run();
+
+	if (run_benchmarks) {
+		Dictionary compare_with;
+		if (!benchmark_compare_file.is_empty()) {
+			const Variant previous = JSON::parse_string(FileAccess::get_file_as_string(benchmark_compare_file));
+			if (previous.get_type() == Variant::DICTIONARY) {
+				compare_with = Dictionary(previous).get("results_usec", Dictionary());
+			}
+		}
+		TestBenchmark::print_results(compare_with);
+		if (!benchmark_file.is_empty()) {
+			TestBenchmark::save_results(benchmark_file);
+		}
+		TestBenchmark::clear_results();
+	}
+
+	return status;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////